@@ -10,6 +10,7 @@
 from .atom import Atom
 from .catom import (
     CAtom,
+    ChangeDetection,
     ChangeType,
     DefaultValue,
     GetAttr,
@@ -20,20 +21,30 @@ from .catom import (
     PostValidate,
     SetAttr,
     Validate,
+    atomcdict,
     atomclist,
+    atomcset,
+    atomdeque,
     atomdict,
+    atomintset,
     atomlist,
+    atomnumlist,
     atomref,
     atomset,
+    atomsortedmap,
     defaultatomdict,
 )
 from .coerced import Coerced
+from .containerdict import ContainerDict
 from .containerlist import ContainerList
+from .containerset import ContainerSet
 from .delegator import Delegator
+from .deque import Deque
 from .dict import DefaultDict, Dict
 from .enum import Enum
 from .event import Event
 from .instance import ForwardInstance, Instance
+from .intset import IntSet
 from .list import List
 from .meta import (
     AtomMeta,
@@ -43,6 +54,7 @@ from .meta import (
     observe,
     set_default,
 )
+from .numericlist import NumericList
 from .property import Property, cached_property
 from .scalars import (
     Bool,
@@ -59,6 +71,7 @@ from .scalars import (
 )
 from .set import Set
 from .signal import Signal
+from .sortedmap import SortedMap
 from .subclass import ForwardSubclass, Subclass
 from .tuple import FixedTuple, Tuple
 from .typed import ForwardTyped, Typed
@@ -72,13 +85,17 @@ __all__ = [
     "CAtom",
     "Callable",
     "ChangeDict",
+    "ChangeDetection",
     "ChangeType",
     "Coerced",
     "Constant",
+    "ContainerDict",
     "ContainerList",
+    "ContainerSet",
     "DefaultDict",
     "DefaultValue",
     "Delegator",
+    "Deque",
     "Dict",
     "Enum",
     "Event",
@@ -92,9 +109,11 @@ __all__ = [
     "GetState",
     "Instance",
     "Int",
+    "IntSet",
     "List",
     "Member",
     "MissingMemberWarning",
+    "NumericList",
     "PostGetAttr",
     "PostSetAttr",
     "PostValidate",
@@ -104,6 +123,7 @@ __all__ = [
     "Set",
     "SetAttr",
     "Signal",
+    "SortedMap",
     "Str",
     "Subclass",
     "Tuple",
@@ -111,11 +131,17 @@ __all__ = [
     "Validate",
     "Value",
     "add_member",
+    "atomcdict",
     "atomclist",
+    "atomcset",
+    "atomdeque",
     "atomdict",
+    "atomintset",
     "atomlist",
+    "atomnumlist",
     "atomref",
     "atomset",
+    "atomsortedmap",
     "cached_property",
     "clone_if_needed",
     "defaultatomdict",
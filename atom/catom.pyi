@@ -7,12 +7,17 @@
 # --------------------------------------------------------------------------------------
 from enum import IntEnum, IntFlag
 from typing import (
+    AbstractSet,
     Any,
     Callable,
+    ContextManager,
     Dict,
     Generic,
+    Iterable,
+    Iterator,
     List,
     Literal,
+    Mapping,
     Optional,
     Sequence,
     Set,
@@ -25,6 +30,7 @@ from typing import (
 from typing_extensions import Self
 
 from .atom import Atom
+from .datastructures.sortedmap import sortedmap
 from .property import Property
 from .typing_utils import ChangeDict
 
@@ -57,6 +63,10 @@ class CAtom:
     ) -> None: ...
     def set_notifications_enabled(self, enabled: bool) -> bool: ...
     def unobserve(self, member: str, func: Callable[[ChangeDict], None]) -> None: ...
+    @classmethod
+    def validate_record(
+        cls, record: Mapping[str, Any]
+    ) -> Tuple[Dict[str, Any], List[Tuple[str, Exception]]]: ...
     def __sizeof__(self) -> int: ...
 
 T = TypeVar("T")
@@ -75,7 +85,9 @@ class Member(Generic[T, S]):
     post_validate_mode: Tuple[PostValidate, Any] = ...
     setattr_mode: Tuple[SetAttr, Any] = ...
     validate_mode: Tuple[Validate, Any] = ...
+    lazy_validation: bool = ...
     getstate_mode: Tuple[GetState, Any] = ...
+    change_detection_mode: Tuple[ChangeDetection, Any] = ...
     def __init__(self) -> None: ...
     @overload
     def __get__(self, instance: None, owner: Type[Atom]) -> Self: ...
@@ -85,6 +97,8 @@ class Member(Generic[T, S]):
     def __delete__(self, instance: Atom) -> None: ...
     def tag(self, **kwargs: Any) -> Self: ...
     def clone(self) -> Self: ...
+    def validate_cache_info(self) -> Optional[Tuple[int, int, int, int]]: ...
+    def clear_validate_cache(self) -> None: ...
     def add_static_observer(
         self,
         observer: str | Callable[[ChangeDict], None],
@@ -116,6 +130,11 @@ class Member(Generic[T, S]):
     def do_setattr(self, owner: CAtom, value: Any) -> Any: ...
     def do_validate(self, owner: CAtom, old: T, new: Any) -> T: ...
     def do_should_getstate(self, owner: CAtom) -> bool: ...
+    def try_set(self, owner: CAtom, value: Any) -> bool: ...
+    def try_set_many(
+        self, owners: Sequence[CAtom], values: Sequence[Any]
+    ) -> List[int]: ...
+    def validation_error(self, owner: CAtom, value: Any) -> Optional[Exception]: ...
     # Setter for the member
     def set_index(self, index: int) -> None: ...
     def set_name(self, name: str) -> None: ...
@@ -391,7 +410,8 @@ class Member(Generic[T, S]):
     def set_validate_mode(
         self,
         mode: Literal[Validate.Coerced],
-        context: Tuple[Type[T], Callable[[Any], T]],
+        context: Tuple[Type[T], Callable[[Any], T]]
+        | Tuple[Type[T], Callable[[Any], T], int],
     ) -> None: ...
     @overload
     def set_validate_mode(
@@ -423,14 +443,129 @@ class Member(Generic[T, S]):
         context: str,
     ) -> None: ...
 
+    # Change detection mode
+    @overload
+    def set_change_detection_mode(
+        self,
+        mode: Literal[ChangeDetection.Equality] | Literal[ChangeDetection.Identity],
+        context: None,
+    ) -> None: ...
+    @overload
+    def set_change_detection_mode(
+        self,
+        mode: Literal[ChangeDetection.Comparator],
+        context: Callable[[Any, Any], bool],
+    ) -> None: ...
+
 KT = TypeVar("KT")
 VT = TypeVar("VT")
 
-class atomlist(List[T]): ...
-class atomclist(atomlist[T]): ...
-class atomset(Set[T]): ...
-class atomdict(Dict[KT, VT]): ...
-class defaultatomdict(Dict[KT, VT]): ...
+class atomlist(List[T]):
+    validated: bool
+    def validate_all(self) -> None: ...
+
+class atomclist(atomlist[T]):
+    def batch(self) -> ContextManager[Self]: ...
+    def begin_batch(self) -> Self: ...
+    def end_batch(self) -> None: ...
+
+class atomset(Set[T]):
+    validated: bool
+    def validate_all(self) -> None: ...
+
+class atomdict(Dict[KT, VT]):
+    validated: bool
+    def validate_all(self) -> None: ...
+
+N = TypeVar("N", int, float, bool)
+
+class atomnumlist(Sequence[N]):
+    kind: Type[N]
+    itemsize: int
+    version: int
+    def __new__(cls, kind: Type[N], items: Iterable[N] = ...) -> atomnumlist[N]: ...
+    @overload
+    def __getitem__(self, index: int) -> N: ...
+    @overload
+    def __getitem__(self, index: slice) -> atomnumlist[N]: ...
+    @overload
+    def __setitem__(self, index: int, value: N) -> None: ...
+    @overload
+    def __setitem__(self, index: slice, value: Iterable[N]) -> None: ...
+    def __delitem__(self, index: int | slice) -> None: ...
+    def __len__(self) -> int: ...
+    def __iadd__(self, value: Iterable[N]) -> Self: ...
+    def __imul__(self, count: int) -> Self: ...
+    def __buffer__(self, flags: int) -> memoryview: ...
+    def append(self, value: N) -> None: ...
+    def insert(self, index: int, value: N) -> None: ...
+    def extend(self, value: Iterable[N]) -> None: ...
+    def pop(self, index: int = -1) -> N: ...
+    def remove(self, value: N) -> None: ...
+    def clear(self) -> None: ...
+    def reverse(self) -> None: ...
+    def sort(self, *, reverse: bool = False) -> None: ...
+    def tolist(self) -> List[N]: ...
+    def copy(self) -> atomnumlist[N]: ...
+    @classmethod
+    def from_buffer(cls, kind: Type[N], buffer: Any) -> atomnumlist[N]: ...
+
+class atomintset(AbstractSet[int]):
+    version: int
+    def __new__(cls, items: Iterable[int] = ...) -> atomintset: ...
+    def __contains__(self, value: object) -> bool: ...
+    def __iter__(self) -> Iterator[int]: ...
+    def __len__(self) -> int: ...
+    def __or__(self, other: AbstractSet[int]) -> atomintset: ...  # type: ignore[override]
+    def __and__(self, other: AbstractSet[Any]) -> atomintset: ...
+    def __sub__(self, other: AbstractSet[Any]) -> atomintset: ...
+    def __xor__(self, other: AbstractSet[int]) -> atomintset: ...  # type: ignore[override]
+    def __ior__(self, other: AbstractSet[int]) -> Self: ...
+    def __iand__(self, other: AbstractSet[Any]) -> Self: ...
+    def __isub__(self, other: AbstractSet[Any]) -> Self: ...
+    def __ixor__(self, other: AbstractSet[int]) -> Self: ...
+    def add(self, value: int) -> None: ...
+    def discard(self, value: int) -> None: ...
+    def remove(self, value: int) -> None: ...
+    def pop(self) -> int: ...
+    def clear(self) -> None: ...
+    def update(self, other: Iterable[int]) -> None: ...
+    def difference_update(self, other: Iterable[int]) -> None: ...
+    def intersection_update(self, other: Iterable[int]) -> None: ...
+    def symmetric_difference_update(self, other: Iterable[int]) -> None: ...
+    def union(self, *others: Iterable[int]) -> atomintset: ...
+    def intersection(self, *others: Iterable[int]) -> atomintset: ...
+    def difference(self, *others: Iterable[int]) -> atomintset: ...
+    def symmetric_difference(self, other: Iterable[int]) -> atomintset: ...
+    def issubset(self, other: Iterable[Any]) -> bool: ...
+    def issuperset(self, other: Iterable[Any]) -> bool: ...
+    def copy(self) -> atomintset: ...
+    def tolist(self) -> List[int]: ...
+
+class atomsortedmap(sortedmap[KT, VT]):
+    version: int
+
+class atomdeque(Sequence[T]):
+    maxlen: int
+    version: int
+    def __new__(cls, maxlen: int, items: Iterable[T] = ...) -> atomdeque[T]: ...
+    def __getitem__(self, index: int) -> T: ...  # type: ignore[override]
+    def __len__(self) -> int: ...
+    def append(self, value: T) -> None: ...
+    def appendleft(self, value: T) -> None: ...
+    def extend(self, value: Iterable[T]) -> None: ...
+    def pop(self) -> T: ...
+    def popleft(self) -> T: ...
+    def clear(self) -> None: ...
+    def count(self, value: Any) -> int: ...
+    def tolist(self) -> List[T]: ...
+    def copy(self) -> atomdeque[T]: ...
+
+class defaultatomdict(atomdict[KT, VT]): ...
+
+class atomcset(atomset[T]): ...
+
+class atomcdict(atomdict[KT, VT]): ...
 
 A = TypeVar("A", bound=CAtom)
 
@@ -455,6 +590,7 @@ class DefaultValue(IntEnum):
     CallObject_Object = ...
     CallObject_ObjectName = ...
     Delegate = ...
+    Deque = ...
     Dict = ...
     DefaultDict = ...
     List = ...
@@ -532,7 +668,9 @@ class Validate(IntEnum):
     BytesPromote = ...
     Callable = ...
     Coerced = ...
+    ContainerDict = ...
     ContainerList = ...
+    ContainerSet = ...
     Delegate = ...
     Dict = ...
     DefaultDict = ...
@@ -544,15 +682,18 @@ class Validate(IntEnum):
     Instance = ...
     Int = ...
     IntPromote = ...
+    IntSet = ...
     List = ...
     MemberMethod_ObjectOldNew = ...
     OptionalInstance = ...
     OptionalTyped = ...
     NoOp = ...
+    NumericList = ...
     ObjectMethod_NameOldNew = ...
     ObjectMethod_OldNew = ...
     Range = ...
     Set = ...
+    SortedMap = ...
     Str = ...
     StrPromote = ...
     Subclass = ...
@@ -566,3 +707,8 @@ class GetState(IntEnum):
     Property = ...
     MemberMethod_Object = ...
     ObjectMethod_Name = ...
+
+class ChangeDetection(IntEnum):
+    Equality = ...
+    Identity = ...
+    Comparator = ...
@@ -5,10 +5,21 @@
 #
 # The full license is in the file LICENSE, distributed with this software.
 # --------------------------------------------------------------------------------------
+from typing import NamedTuple
+
 from .catom import DefaultValue, Member, Validate
 from .typing_utils import extract_types, is_optional
 
 
+class CoercedCacheInfo(NamedTuple):
+    """Statistics of the coercion cache of a Coerced member."""
+
+    hits: int
+    misses: int
+    maxsize: int
+    currsize: int
+
+
 class Coerced(Member):
     """A member which will coerce a value to a given instance type.
 
@@ -19,7 +30,16 @@ class Coerced(Member):
 
     __slots__ = ()
 
-    def __init__(self, kind, args=None, kwargs=None, *, factory=None, coercer=None):
+    def __init__(
+        self,
+        kind,
+        args=None,
+        kwargs=None,
+        *,
+        factory=None,
+        coercer=None,
+        cache_size=0,
+    ):
         """Initialize a Coerced.
 
         Parameters
@@ -49,6 +69,14 @@ class Coerced(Member):
             callable type which will be called with the value to coerce
             the value to the appropriate type.
 
+        cache_size : int, optional
+            The maximum number of coerced values to cache, keyed by the
+            type and value of the hashable inputs. The least recently used
+            values are discarded first. Since a cached value is shared by
+            all the assignments of an equal input, this should only be used
+            when the coerced values are immutable. The default of 0
+            disables the cache.
+
         """
         origin = kind
         kind = extract_types(kind)
@@ -72,4 +100,16 @@ class Coerced(Member):
 
         if not coercer and (isinstance(origin, tuple) or len(temp) > 1):
             raise ValueError(f"No coercer was provided but {origin} is not callable.")
-        self.set_validate_mode(Validate.Coerced, (kind, coercer or temp[0]))
+        context = (kind, coercer or temp[0])
+        if cache_size:
+            context += (cache_size,)
+        self.set_validate_mode(Validate.Coerced, context)
+
+    def cache_info(self) -> CoercedCacheInfo:
+        """Get the statistics of the coercion cache."""
+        info = self.validate_cache_info()
+        return CoercedCacheInfo(*info) if info is not None else CoercedCacheInfo(0, 0, 0, 0)
+
+    def cache_clear(self) -> None:
+        """Clear the coercion cache and reset its statistics."""
+        self.clear_validate_cache()
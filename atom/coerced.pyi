@@ -5,7 +5,17 @@
 #
 # The full license is in the file LICENSE, distributed with this software.
 # --------------------------------------------------------------------------------------
-from typing import Any, Callable, Dict, Optional, Tuple, Type, TypeVar, overload
+from typing import (
+    Any,
+    Callable,
+    Dict,
+    NamedTuple,
+    Optional,
+    Tuple,
+    Type,
+    TypeVar,
+    overload,
+)
 
 from .catom import Member
 
@@ -15,6 +25,12 @@ T2 = TypeVar("T2")
 
 S = TypeVar("S")
 
+class CoercedCacheInfo(NamedTuple):
+    hits: int
+    misses: int
+    maxsize: int
+    currsize: int
+
 class Coerced(Member[T, S]):
     # No default
     # - type
@@ -27,6 +43,7 @@ class Coerced(Member[T, S]):
         *,
         factory: None = None,
         coercer: None = None,
+        cache_size: int = 0,
     ) -> Coerced[T, T]: ...
     @overload
     def __new__(
@@ -37,6 +54,7 @@ class Coerced(Member[T, S]):
         *,
         factory: None = None,
         coercer: Callable[[S], T],
+        cache_size: int = 0,
     ) -> Coerced[T, T | S]: ...
     # - 1-Tuple[Any, ...]
     @overload
@@ -48,6 +66,7 @@ class Coerced(Member[T, S]):
         *,
         factory: None = None,
         coercer: None = None,
+        cache_size: int = 0,
     ) -> Coerced[T, T]: ...
     @overload
     def __new__(
@@ -58,6 +77,7 @@ class Coerced(Member[T, S]):
         *,
         factory: None = None,
         coercer: Callable[[S], T],
+        cache_size: int = 0,
     ) -> Coerced[T, T | S]: ...
     # - 2-Tuple[Any, ...]
     @overload
@@ -69,6 +89,7 @@ class Coerced(Member[T, S]):
         *,
         factory: None = None,
         coercer: None = None,
+        cache_size: int = 0,
     ) -> Coerced[T | T1, T | T1]: ...
     @overload
     def __new__(
@@ -79,6 +100,7 @@ class Coerced(Member[T, S]):
         *,
         factory: None = None,
         coercer: Callable[[S], T | T1],
+        cache_size: int = 0,
     ) -> Coerced[T | T1, T | T1 | S]: ...
     # - 3-Tuple[Any, ...]
     @overload
@@ -90,6 +112,7 @@ class Coerced(Member[T, S]):
         *,
         factory: None = None,
         coercer: None = None,
+        cache_size: int = 0,
     ) -> Coerced[T | T1 | T2, T | T1 | T2]: ...
     @overload
     def __new__(
@@ -100,6 +123,7 @@ class Coerced(Member[T, S]):
         *,
         factory: None = None,
         coercer: Callable[[S], T | T1 | T2],
+        cache_size: int = 0,
     ) -> Coerced[T | T1 | T2, T | T1 | T2 | S]: ...
     # Default with factory
     # - type
@@ -112,6 +136,7 @@ class Coerced(Member[T, S]):
         *,
         factory: Callable[[], T],
         coercer: None = None,
+        cache_size: int = 0,
     ) -> Coerced[T, T]: ...
     @overload
     def __new__(
@@ -122,6 +147,7 @@ class Coerced(Member[T, S]):
         *,
         factory: Callable[[], T | S],
         coercer: Callable[[S], T],
+        cache_size: int = 0,
     ) -> Coerced[T, T | S]: ...
     # - 1-Tuple[Any, ...]
     @overload
@@ -133,6 +159,7 @@ class Coerced(Member[T, S]):
         *,
         factory: Callable[[], T],
         coercer: None = None,
+        cache_size: int = 0,
     ) -> Coerced[T, T]: ...
     @overload
     def __new__(
@@ -143,6 +170,7 @@ class Coerced(Member[T, S]):
         *,
         factory: Callable[[], T | S],
         coercer: Callable[[S], T],
+        cache_size: int = 0,
     ) -> Coerced[T, T | S]: ...
     # - 2-Tuple[Any, ...]
     @overload
@@ -154,6 +182,7 @@ class Coerced(Member[T, S]):
         *,
         factory: Callable[[], T | T1],
         coercer: None = None,
+        cache_size: int = 0,
     ) -> Coerced[T | T1, T | T1]: ...
     @overload
     def __new__(
@@ -164,6 +193,7 @@ class Coerced(Member[T, S]):
         *,
         factory: Callable[[], T | T1 | S],
         coercer: Callable[[S], T | T1],
+        cache_size: int = 0,
     ) -> Coerced[T | T1, T | T1 | S]: ...
     # - 3-Tuple[Any, ...]
     @overload
@@ -175,6 +205,7 @@ class Coerced(Member[T, S]):
         *,
         factory: Callable[[], T | T1 | T2],
         coercer: None = None,
+        cache_size: int = 0,
     ) -> Coerced[T | T1 | T2, T | T1 | T2]: ...
     @overload
     def __new__(
@@ -185,4 +216,7 @@ class Coerced(Member[T, S]):
         *,
         factory: Callable[[], S],
         coercer: Callable[[S], T | T1 | T2 | S],
+        cache_size: int = 0,
     ) -> Coerced[T | T1 | T2, T | T1 | T2 | S]: ...
+    def cache_info(self) -> CoercedCacheInfo: ...
+    def cache_clear(self) -> None: ...
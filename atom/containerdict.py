@@ -0,0 +1,20 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2013-2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+from .catom import Validate
+from .dict import Dict
+
+
+class ContainerDict(Dict):
+    """A Dict member which supports container notifications."""
+
+    __slots__ = ()
+
+    def __init__(self, key=None, value=None, default=None, *, lazy=False):
+        """Initialize a ContainerDict."""
+        super(ContainerDict, self).__init__(key, value, default, lazy=lazy)
+        self.set_validate_mode(Validate.ContainerDict, self.validate_mode[1])
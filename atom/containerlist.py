@@ -14,7 +14,7 @@ class ContainerList(List):
 
     __slots__ = ()
 
-    def __init__(self, item=None, default=None):
+    def __init__(self, item=None, default=None, *, lazy=False):
         """Initialize a ContainerList."""
-        super(ContainerList, self).__init__(item, default)
+        super(ContainerList, self).__init__(item, default, lazy=lazy)
         self.set_validate_mode(Validate.ContainerList, self.item)
@@ -17,58 +17,114 @@ class ContainerList(Member[List[T], List[T]]):
     # No default
     @overload
     def __new__(
-        cls, kind: None = None, default: Optional[List[Any]] = None
+        cls,
+        kind: None = None,
+        default: Optional[List[Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> ContainerList[Any]: ...
     @overload
-    def __new__(cls, kind: Type[T], default: None = None) -> ContainerList[T]: ...
+    def __new__(
+        cls,
+        kind: Type[T],
+        default: None = None,
+        *,
+        lazy: bool = False,
+    ) -> ContainerList[T]: ...
     @overload
     def __new__(
-        cls, kind: Tuple[Type[T]], default: None = None
+        cls,
+        kind: Tuple[Type[T]],
+        default: None = None,
+        *,
+        lazy: bool = False,
     ) -> ContainerList[T]: ...
     @overload
     def __new__(
-        cls, kind: Tuple[Type[T], Type[T1]], default: None = None
+        cls,
+        kind: Tuple[Type[T], Type[T1]],
+        default: None = None,
+        *,
+        lazy: bool = False,
     ) -> ContainerList[T | T1]: ...
     @overload
     def __new__(
         cls,
         kind: Tuple[Type[T], Type[T1], Type[T2]],
         default: None = None,
+        *,
+        lazy: bool = False,
     ) -> ContainerList[T | T1 | T2]: ...
     @overload
     def __new__(
-        cls, kind: Member[T, Any], default: None = None
+        cls,
+        kind: Member[T, Any],
+        default: None = None,
+        *,
+        lazy: bool = False,
     ) -> ContainerList[T]: ...
     # With default
     @overload
-    def __new__(cls, kind: Type[T], default: List[T]) -> ContainerList[T]: ...
+    def __new__(
+        cls,
+        kind: Type[T],
+        default: List[T],
+        *,
+        lazy: bool = False,
+    ) -> ContainerList[T]: ...
     @overload
-    def __new__(cls, kind: Tuple[Type[T]], default: List[T]) -> ContainerList[T]: ...
+    def __new__(
+        cls,
+        kind: Tuple[Type[T]],
+        default: List[T],
+        *,
+        lazy: bool = False,
+    ) -> ContainerList[T]: ...
     @overload
     def __new__(
-        cls, kind: Tuple[Type[T], Type[T1]], default: List[T | T1]
+        cls,
+        kind: Tuple[Type[T], Type[T1]],
+        default: List[T | T1],
+        *,
+        lazy: bool = False,
     ) -> ContainerList[T | T1]: ...
     @overload
     def __new__(
-        cls, kind: Tuple[Type[T], Type[T1]], default: List[T] | List[T1]
+        cls,
+        kind: Tuple[Type[T], Type[T1]],
+        default: List[T] | List[T1],
+        *,
+        lazy: bool = False,
     ) -> ContainerList[T | T1]: ...
     @overload
     def __new__(
-        cls, kind: Tuple[Type[T], Type[T1], Type[T2]], default: List[T | T1 | T2]
+        cls,
+        kind: Tuple[Type[T], Type[T1], Type[T2]],
+        default: List[T | T1 | T2],
+        *,
+        lazy: bool = False,
     ) -> ContainerList[T | T1 | T2]: ...
     @overload
     def __new__(
         cls,
         kind: Tuple[Type[T], Type[T1], Type[T2]],
         default: List[T | T1] | List[T | T2] | List[T1 | T2],
+        *,
+        lazy: bool = False,
     ) -> ContainerList[T | T1 | T2]: ...
     @overload
     def __new__(
         cls,
         kind: Tuple[Type[T], Type[T1], Type[T2]],
         default: List[T] | List[T1] | List[T2],
+        *,
+        lazy: bool = False,
     ) -> ContainerList[T | T1 | T2]: ...
     @overload
     def __new__(
-        cls, kind: Member[T, Any], default: Optional[List[T]] = None
+        cls,
+        kind: Member[T, Any],
+        default: Optional[List[T]] = None,
+        *,
+        lazy: bool = False,
     ) -> ContainerList[T]: ...
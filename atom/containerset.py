@@ -0,0 +1,20 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2013-2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+from .catom import Validate
+from .set import Set
+
+
+class ContainerSet(Set):
+    """A Set member which supports container notifications."""
+
+    __slots__ = ()
+
+    def __init__(self, item=None, default=None, *, lazy=False):
+        """Initialize a ContainerSet."""
+        super(ContainerSet, self).__init__(item, default, lazy=lazy)
+        self.set_validate_mode(Validate.ContainerSet, self.item)
@@ -5,6 +5,8 @@
 #
 # The full license is in the file LICENSE, distributed with this software.
 # --------------------------------------------------------------------------------------
+from .intervalmap import intervalmap
 from .sortedmap import sortedmap
+from .sortedset import sortedmultiset, sortedset
 
-__all__ = ["sortedmap"]
+__all__ = ["intervalmap", "sortedmap", "sortedmultiset", "sortedset"]
@@ -0,0 +1,55 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+from typing import (
+    Generic,
+    Iterable,
+    Iterator,
+    List,
+    Mapping,
+    Tuple,
+    TypeVar,
+    Union,
+    overload,
+)
+
+B = TypeVar("B")
+V = TypeVar("V")
+D = TypeVar("D")
+
+class intervalmap(Generic[B, V]):
+    def __init__(
+        self,
+        map: Union[Mapping[Tuple[B, B], V], Iterable[Tuple[Tuple[B, B], V]]] = ...,
+    ) -> None: ...
+    @overload
+    def get(self, interval: Tuple[B, B], default: None = None) -> Union[V, None]: ...
+    @overload
+    def get(self, interval: Tuple[B, B], default: D) -> Union[V, D]: ...
+    @overload
+    def pop(self, interval: Tuple[B, B]) -> V: ...
+    @overload
+    def pop(self, interval: Tuple[B, B], default: D) -> Union[V, D]: ...
+    def clear(self) -> None: ...
+    def values(self) -> Iterator[V]: ...
+    def items(self) -> Iterator[Tuple[Tuple[B, B], V]]: ...
+    def copy(self) -> "intervalmap[B, V]": ...
+    def update(
+        self,
+        other: Union[
+            Mapping[Tuple[B, B], V], Iterable[Tuple[Tuple[B, B], V]]
+        ] = ...,
+    ) -> None: ...
+    def at(self, point: B) -> List[Tuple[Tuple[B, B], V]]: ...
+    def overlap(self, start: B, end: B) -> List[Tuple[Tuple[B, B], V]]: ...
+    def __contains__(self, interval: Tuple[B, B]) -> bool: ...
+    def __getitem__(self, interval: Tuple[B, B]) -> V: ...
+    def __setitem__(self, interval: Tuple[B, B], value: V) -> None: ...
+    def __delitem__(self, interval: Tuple[B, B]) -> None: ...
+    def __len__(self) -> int: ...
+    def __iter__(self) -> Iterator[Tuple[B, B]]: ...
+    def __sizeof__(self) -> int: ...
@@ -5,13 +5,59 @@
 #
 # The full license is in the file LICENSE, distributed with this software.
 # --------------------------------------------------------------------------------------
-from typing import Generic, List, Optional, Tuple, TypeVar, Union, overload
+from typing import (
+    Any,
+    Callable,
+    Generic,
+    Iterable,
+    Iterator,
+    List,
+    Mapping,
+    Sequence,
+    Optional,
+    Tuple,
+    TypeVar,
+    Union,
+    overload,
+)
 
 K = TypeVar("K")
 V = TypeVar("V")
 D = TypeVar("D")
 
+class sortedmap_keys(Sequence[K]):
+    def __len__(self) -> int: ...
+    def __reversed__(self) -> Iterator[K]: ...
+    @overload
+    def __getitem__(self, index: int) -> K: ...
+    @overload
+    def __getitem__(self, index: slice) -> List[K]: ...
+
+class sortedmap_values(Sequence[V]):
+    def __len__(self) -> int: ...
+    def __reversed__(self) -> Iterator[V]: ...
+    @overload
+    def __getitem__(self, index: int) -> V: ...
+    @overload
+    def __getitem__(self, index: slice) -> List[V]: ...
+
+class sortedmap_items(Sequence[Tuple[K, V]]):
+    def __len__(self) -> int: ...
+    def __reversed__(self) -> Iterator[Tuple[K, V]]: ...
+    @overload
+    def __getitem__(self, index: int) -> Tuple[K, V]: ...
+    @overload
+    def __getitem__(self, index: slice) -> List[Tuple[K, V]]: ...
+
 class sortedmap(Generic[K, V]):
+    def __init__(
+        self,
+        map: Union[Mapping[K, V], Iterable[Tuple[K, V]]] = ...,
+        *,
+        key: Optional[Callable[[K], Any]] = None,
+    ) -> None: ...
+    @property
+    def key(self) -> Optional[Callable[[K], Any]]: ...
     @overload
     def get(self, key: K, default: None = None) -> Optional[V]: ...
     @overload
@@ -21,12 +67,57 @@ class sortedmap(Generic[K, V]):
     @overload
     def pop(self, key: K, default: D) -> Union[V, D]: ...
     def clear(self) -> None: ...
-    def keys(self) -> List[K]: ...
-    def values(self) -> List[V]: ...
-    def items(self) -> List[Tuple[K, V]]: ...
+    def keys(self) -> sortedmap_keys[K]: ...
+    def values(self) -> sortedmap_values[V]: ...
+    def items(self) -> sortedmap_items[K, V]: ...
     def copy(self) -> "sortedmap[K, V]": ...
+    def snapshot(self) -> "sortedmap[K, V]": ...
+    def update(
+        self,
+        other: Union[Mapping[K, V], Iterable[Tuple[K, V]]] = ...,
+        **kwargs: V,
+    ) -> None: ...
+    def merge(
+        self, other: Union[Mapping[K, V], Iterable[Tuple[K, V]]]
+    ) -> "sortedmap[K, V]": ...
+    def union(
+        self, other: Union[Mapping[K, V], Iterable[Tuple[K, V]]]
+    ) -> "sortedmap[K, V]": ...
+    def intersection(
+        self, other: Union[Mapping[K, Any], Iterable[Tuple[K, Any]]]
+    ) -> "sortedmap[K, V]": ...
+    def difference(
+        self, other: Union[Mapping[K, Any], Iterable[Tuple[K, Any]]]
+    ) -> "sortedmap[K, V]": ...
+    def diff(
+        self, other: Union[Mapping[K, V], Iterable[Tuple[K, V]]]
+    ) -> Tuple[
+        "sortedmap[K, V]", "sortedmap[K, V]", "sortedmap[K, Tuple[V, V]]"
+    ]: ...
+    def bisect_left(self, key: K) -> int: ...
+    def bisect_right(self, key: K) -> int: ...
+    @overload
+    def floor_key(self, key: K) -> K: ...
+    @overload
+    def floor_key(self, key: K, default: D) -> Union[K, D]: ...
+    @overload
+    def ceiling_key(self, key: K) -> K: ...
+    @overload
+    def ceiling_key(self, key: K, default: D) -> Union[K, D]: ...
+    def peekitem(self, index: int = -1) -> Tuple[K, V]: ...
+    def index(self, key: K) -> int: ...
+    def irange(
+        self,
+        minimum: Optional[K] = None,
+        maximum: Optional[K] = None,
+        inclusive: Tuple[bool, bool] = (True, True),
+        reverse: bool = False,
+    ) -> Iterator[K]: ...
     def __contains__(self, key: K) -> bool: ...
     def __getitem__(self, key: K) -> V: ...
     def __setitem__(self, key: K, value: V) -> None: ...
-    def __delitem__(self, key: K) -> None: ...
+    def __delitem__(self, key: Union[K, slice]) -> None: ...
+    def __len__(self) -> int: ...
+    def __iter__(self) -> Iterator[K]: ...
+    def __reversed__(self) -> Iterator[K]: ...
     def __sizeof__(self) -> int: ...
@@ -0,0 +1,104 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+from typing import (
+    Any,
+    Callable,
+    Generic,
+    Iterable,
+    Iterator,
+    List,
+    Optional,
+    Tuple,
+    TypeVar,
+    Union,
+    overload,
+)
+
+T = TypeVar("T")
+
+class sortedset(Generic[T]):
+    def __init__(
+        self,
+        iterable: Iterable[T] = ...,
+        *,
+        key: Optional[Callable[[T], Any]] = None,
+    ) -> None: ...
+    @property
+    def key(self) -> Optional[Callable[[T], Any]]: ...
+    def add(self, value: T) -> None: ...
+    def discard(self, value: T) -> None: ...
+    def remove(self, value: T) -> None: ...
+    def pop(self, index: int = -1) -> T: ...
+    def clear(self) -> None: ...
+    def copy(self) -> "sortedset[T]": ...
+    def snapshot(self) -> "sortedset[T]": ...
+    def update(self, iterable: Iterable[T]) -> None: ...
+    def union(self, other: Iterable[T]) -> "sortedset[T]": ...
+    def intersection(self, other: Iterable[T]) -> "sortedset[T]": ...
+    def difference(self, other: Iterable[T]) -> "sortedset[T]": ...
+    def symmetric_difference(self, other: Iterable[T]) -> "sortedset[T]": ...
+    def bisect_left(self, value: T) -> int: ...
+    def bisect_right(self, value: T) -> int: ...
+    def count(self, value: T) -> int: ...
+    def index(self, value: T) -> int: ...
+    def irange(
+        self,
+        minimum: Optional[T] = None,
+        maximum: Optional[T] = None,
+        inclusive: Tuple[bool, bool] = (True, True),
+        reverse: bool = False,
+    ) -> Iterator[T]: ...
+    def __contains__(self, value: T) -> bool: ...
+    @overload
+    def __getitem__(self, index: int) -> T: ...
+    @overload
+    def __getitem__(self, index: slice) -> List[T]: ...
+    def __delitem__(self, index: Union[int, slice]) -> None: ...
+    def __len__(self) -> int: ...
+    def __iter__(self) -> Iterator[T]: ...
+    def __reversed__(self) -> Iterator[T]: ...
+    def __sizeof__(self) -> int: ...
+
+class sortedmultiset(Generic[T]):
+    def __init__(
+        self,
+        iterable: Iterable[T] = ...,
+        *,
+        key: Optional[Callable[[T], Any]] = None,
+    ) -> None: ...
+    @property
+    def key(self) -> Optional[Callable[[T], Any]]: ...
+    def add(self, value: T) -> None: ...
+    def discard(self, value: T) -> None: ...
+    def remove(self, value: T) -> None: ...
+    def pop(self, index: int = -1) -> T: ...
+    def clear(self) -> None: ...
+    def copy(self) -> "sortedmultiset[T]": ...
+    def snapshot(self) -> "sortedmultiset[T]": ...
+    def update(self, iterable: Iterable[T]) -> None: ...
+    def bisect_left(self, value: T) -> int: ...
+    def bisect_right(self, value: T) -> int: ...
+    def count(self, value: T) -> int: ...
+    def index(self, value: T) -> int: ...
+    def irange(
+        self,
+        minimum: Optional[T] = None,
+        maximum: Optional[T] = None,
+        inclusive: Tuple[bool, bool] = (True, True),
+        reverse: bool = False,
+    ) -> Iterator[T]: ...
+    def __contains__(self, value: T) -> bool: ...
+    @overload
+    def __getitem__(self, index: int) -> T: ...
+    @overload
+    def __getitem__(self, index: slice) -> List[T]: ...
+    def __delitem__(self, index: Union[int, slice]) -> None: ...
+    def __len__(self) -> int: ...
+    def __iter__(self) -> Iterator[T]: ...
+    def __reversed__(self) -> Iterator[T]: ...
+    def __sizeof__(self) -> int: ...
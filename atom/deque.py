@@ -0,0 +1,99 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+from .catom import DefaultValue, Member, Validate
+from .instance import Instance
+from .typing_utils import extract_types, is_optional
+
+
+class Deque(Member):
+    """A member which allows deques holding a bounded number of items.
+
+    The value is an atomdeque storing its items in a ring buffer of at
+    most maxlen slots. Appending to a full deque evicts the item at the
+    opposite end, so that appending and popping from either end are
+    O(1). Items are validated by the item member when added and changes
+    are notified to container observers, each push emitting a single
+    change which carries the evicted item if any.
+
+    Assigning a list, a tuple or another deque creates a copy holding
+    the last maxlen items.
+
+    """
+
+    __slots__ = ()
+
+    def __init__(self, item=None, *, maxlen, default=None):
+        """Initialize a Deque.
+
+        Parameters
+        ----------
+        item : Member, type, or tuple of types, optional
+            A member to use for validating the items of the deque. This
+            can also be a type object or a tuple of types, in which case
+            it will be wrapped with an non-optional Instance member. If
+            this is not given, no item validation is performed.
+
+        maxlen : int
+            The maximum number of items held by the deque. It must be
+            positive.
+
+        default : iterable, optional
+            The default items. A new deque will be created for each atom
+            instance.
+
+        """
+        if item is not None and not isinstance(item, Member):
+            opt, types = is_optional(extract_types(item))
+            item = Instance(types, optional=opt)
+        if default is not None:
+            default = list(default)
+        self.set_default_value_mode(DefaultValue.List, default)
+        self.set_validate_mode(Validate.Deque, (item, maxlen))
+
+    @property
+    def item(self):
+        """The member validating the items of the deque, if any."""
+        return self.validate_mode[1][0]
+
+    @property
+    def maxlen(self):
+        """The maximum number of items held by the deque."""
+        return self.validate_mode[1][1]
+
+    def set_name(self, name):
+        """Set the name of the member.
+
+        This method ensures that the item member name is also updated.
+
+        """
+        super(Deque, self).set_name(name)
+        if self.item is not None:
+            self.item.set_name(name + "|item")
+
+    def set_index(self, index):
+        """Assign the index to this member.
+
+        This method ensures that the item member index is also updated.
+
+        """
+        super(Deque, self).set_index(index)
+        if self.item is not None:
+            self.item.set_index(index)
+
+    def clone(self):
+        """Create a clone of the member.
+
+        This will clone the internal item member if one is in use.
+
+        """
+        clone = super(Deque, self).clone()
+        item = self.item
+        if item is not None:
+            mode, (_, maxlen) = self.validate_mode
+            clone.set_validate_mode(mode, (item.clone(), maxlen))
+        return clone
@@ -0,0 +1,40 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+from typing import Any, Iterable, Optional, Tuple, Type, TypeVar, overload
+
+from .catom import Member, atomdeque
+
+T = TypeVar("T")
+
+class Deque(Member[atomdeque[T], Iterable[T]]):
+    item: Optional[Member]
+    maxlen: int
+    @overload
+    def __new__(
+        cls,
+        item: None = None,
+        *,
+        maxlen: int,
+        default: Optional[Iterable[Any]] = None,
+    ) -> Deque[Any]: ...
+    @overload
+    def __new__(
+        cls,
+        item: Type[T] | Tuple[Type[T], ...],
+        *,
+        maxlen: int,
+        default: Optional[Iterable[T]] = None,
+    ) -> Deque[T]: ...
+    @overload
+    def __new__(
+        cls,
+        item: Member[T, Any],
+        *,
+        maxlen: int,
+        default: Optional[Iterable[T]] = None,
+    ) -> Deque[T]: ...
@@ -17,7 +17,7 @@ class Dict(Member):
 
     __slots__ = ()
 
-    def __init__(self, key=None, value=None, default=None):
+    def __init__(self, key=None, value=None, default=None, *, lazy=False):
         """Initialize a Dict.
 
         Parameters
@@ -38,6 +38,15 @@ class Dict(Member):
             The default dict of items. A new copy of this dict will be
             created for each atom instance.
 
+        lazy : bool, optional
+            Defer the validation of the keys and values of an assigned
+            dict until it is first read or until its validate_all method
+            is called. Any operation but update and clear, including
+            comparisons and repr, counts as a read. Mutations of the dict
+            are always validated. A dict outliving its atom is left
+            unvalidated. This is meant for large dicts built from trusted
+            data. The default is False.
+
         """
         self.set_default_value_mode(DefaultValue.Dict, default)
         if key is not None and not isinstance(key, Member):
@@ -47,6 +56,7 @@ class Dict(Member):
             opt, types = is_optional(extract_types(value))
             value = Instance(types, optional=opt)
         self.set_validate_mode(Validate.Dict, (key, value))
+        self.lazy_validation = lazy
 
     def set_name(self, name):
         """Assign the name to this member.
@@ -112,7 +122,9 @@ class DefaultDict(Member):
 
     __slots__ = ()
 
-    def __init__(self, key=None, value=None, default=None, *, missing=None):
+    def __init__(
+        self, key=None, value=None, default=None, *, missing=None, lazy=False
+    ):
         """Initialize a DefaultDict.
 
         Parameters
@@ -136,6 +148,15 @@ class DefaultDict(Member):
         missing : Callable[[], Any] or None, optional
             Factory to build a default value for a missing key in the dictionary.
 
+        lazy : bool, optional
+            Defer the validation of the keys and values of an assigned
+            dict until it is first read or until its validate_all method
+            is called. Any operation but update and clear, including
+            comparisons and repr, counts as a read. Mutations of the dict
+            are always validated. A dict outliving its atom is left
+            unvalidated. This is meant for large dicts built from trusted
+            data. The default is False.
+
         """
         self.set_default_value_mode(DefaultValue.DefaultDict, default)
         if key is not None and not isinstance(key, Member):
@@ -186,6 +207,7 @@ class DefaultDict(Member):
             )
 
         self.set_validate_mode(Validate.DefaultDict, (key, value, missing))
+        self.lazy_validation = lazy
 
     def set_name(self, name):
         """Assign the name to this member.
@@ -36,6 +36,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: None = None,
         value: None = None,
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[Any, Any]: ...
     # No default
     # Typed keys
@@ -46,6 +48,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Type[KT],
         value: None = None,
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT, Any]: ...
     # - 1-tuple
     @overload
@@ -54,6 +58,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Tuple[Type[KT]],
         value: None = None,
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT, Any]: ...
     # - 2-tuple
     @overload
@@ -62,6 +68,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1]],
         value: None = None,
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT | KT1, Any]: ...
     # - 3-tuple
     @overload
@@ -70,6 +78,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1], Type[KT2]],
         value: None = None,
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT | KT1 | KT2, Any]: ...
     # - member
     @overload
@@ -78,12 +88,19 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Member[KT, Any],
         value: None = None,
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT, Any]: ...
     # Typed values
     # - type
     @overload
     def __new__(
-        cls, key: None, value: Type[VT], default: Optional[TDict[Any, Any]] = None
+        cls,
+        key: None,
+        value: Type[VT],
+        default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[Any, VT]: ...
     # - 1-tuple
     @overload
@@ -92,6 +109,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: None,
         value: Tuple[Type[VT]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[Any, VT]: ...
     # - 2-tuple
     @overload
@@ -100,6 +119,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: None,
         value: Tuple[Type[VT], Type[VT1]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[Any, VT | VT1]: ...
     # - 3-tuple
     @overload
@@ -108,6 +129,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: None,
         value: Tuple[Type[VT], Type[VT1], Type[VT2]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[Any, VT | VT1 | VT2]: ...
     # - member
     @overload
@@ -116,6 +139,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: None,
         value: Member[VT, Any],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[Any, VT]: ...
     # Typed value through keyword
     # - type
@@ -126,6 +151,7 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         *,
         value: Type[VT],
         default: Optional[TDict[Any, Any]] = None,
+        lazy: bool = False,
     ) -> Dict[Any, VT]: ...
     # - 1-tuple
     @overload
@@ -135,6 +161,7 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         *,
         value: Tuple[Type[VT]],
         default: Optional[TDict[Any, Any]] = None,
+        lazy: bool = False,
     ) -> Dict[Any, VT]: ...
     # - 2-tuple
     @overload
@@ -144,6 +171,7 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         *,
         value: Tuple[Type[VT], Type[VT1]],
         default: Optional[TDict[Any, Any]] = None,
+        lazy: bool = False,
     ) -> Dict[Any, VT | VT1]: ...
     # - 3-tuple
     @overload
@@ -153,6 +181,7 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         *,
         value: Tuple[Type[VT], Type[VT1], Type[VT2]],
         default: Optional[TDict[Any, Any]] = None,
+        lazy: bool = False,
     ) -> Dict[Any, VT | VT1 | VT2]: ...
     # - member
     @overload
@@ -162,13 +191,19 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         *,
         value: Member[VT, Any],
         default: Optional[TDict[Any, Any]] = None,
+        lazy: bool = False,
     ) -> Dict[Any, VT]: ...
     # Typed key and value
     # - value simple type
     #    - key type
     @overload
     def __new__(
-        cls, key: Type[KT], value: Type[VT], default: Optional[TDict[Any, Any]] = None
+        cls,
+        key: Type[KT],
+        value: Type[VT],
+        default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT, VT]: ...
     #    - key 1-tuple
     @overload
@@ -177,6 +212,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Tuple[Type[KT]],
         value: Type[VT],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT, VT]: ...
     #    - key 2-tuple
     @overload
@@ -185,6 +222,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1]],
         value: Type[VT],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT | KT1, VT]: ...
     #    - key 3-tuple
     @overload
@@ -193,6 +232,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1], Type[KT2]],
         value: Type[VT],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT | KT1 | KT2, VT]: ...
     #    - key member
     @overload
@@ -201,6 +242,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Member[KT, Any],
         value: Type[VT],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT, VT]: ...
     # - Value as single element tuple
     #    - key type
@@ -210,6 +253,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Type[KT],
         value: Tuple[Type[VT]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT, VT]: ...
     #    - key 1-tuple
     @overload
@@ -218,6 +263,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Tuple[Type[KT]],
         value: Tuple[Type[VT]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT, VT]: ...
     #    - key 2-tuple
     @overload
@@ -226,6 +273,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1]],
         value: Tuple[Type[VT]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT | KT1, VT]: ...
     #    - key 3-tuple
     @overload
@@ -234,6 +283,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1], Type[KT2]],
         value: Tuple[Type[VT]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT | KT1 | KT2, VT]: ...
     #    - key member
     @overload
@@ -242,6 +293,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Member[KT, Any],
         value: Tuple[Type[VT]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT, VT]: ...
     # - Value as 2-tuple
     #    - key type
@@ -251,6 +304,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Type[KT],
         value: Tuple[Type[VT], Type[VT1]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT, VT | VT1]: ...
     #    - key 1-tuple
     @overload
@@ -259,6 +314,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Tuple[Type[KT]],
         value: Tuple[Type[VT], Type[VT1]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT, VT | VT1]: ...
     #    - key 2-tuple
     @overload
@@ -267,6 +324,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1]],
         value: Tuple[Type[VT], Type[VT1]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT | KT1, VT | VT1]: ...
     #    - key 3-tuple
     @overload
@@ -275,6 +334,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1], Type[KT2]],
         value: Tuple[Type[VT], Type[VT1]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT | KT1 | KT2, VT | VT1]: ...
     #    - key member
     @overload
@@ -283,6 +344,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Member[KT, Any],
         value: Tuple[Type[VT], Type[VT1]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT, VT | VT1]: ...
     # - Value as 3-tuple
     #   - key type
@@ -292,6 +355,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Type[KT],
         value: Tuple[Type[VT], Type[VT1], Type[VT2]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT, VT | VT1 | VT2]: ...
     #   - key 1-tuple
     @overload
@@ -300,6 +365,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Tuple[Type[KT]],
         value: Tuple[Type[VT], Type[VT1], Type[VT2]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT, VT | VT1 | VT2]: ...
     #   - key 2-tuple
     @overload
@@ -308,6 +375,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1]],
         value: Tuple[Type[VT], Type[VT1], Type[VT2]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT | KT1, VT | VT1 | VT2]: ...
     #   - key 3-tuple
     @overload
@@ -316,6 +385,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1], Type[KT2]],
         value: Tuple[Type[VT], Type[VT1], Type[VT2]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT | KT1 | KT2, VT | VT1 | VT2]: ...
     #   - key member
     @overload
@@ -324,6 +395,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Member[KT, Any],
         value: Tuple[Type[VT], Type[VT1], Type[VT2]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT, VT | VT1 | VT2]: ...
     # - value as member
     #   - key type
@@ -333,6 +406,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Type[KT],
         value: Member[VT, Any],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT, VT]: ...
     #   - key 1-tuple
     @overload
@@ -341,6 +416,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Tuple[Type[KT]],
         value: Member[VT, Any],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT, VT]: ...
     #   - key 2-tuple
     @overload
@@ -349,6 +426,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1]],
         value: Member[VT, Any],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT | KT1, VT]: ...
     #   - key 3-tuple
     @overload
@@ -357,6 +436,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1], Type[KT2]],
         value: Member[VT, VT],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT | KT1 | KT2, VT]: ...
     #   - key member
     @overload
@@ -365,6 +446,8 @@ class Dict(Member[TDict[KT, VT], TDict[KT, VT]]):
         key: Member[KT, KT],
         value: Member[VT, VT],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Dict[KT, VT]: ...
 
 class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
@@ -377,6 +460,7 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         default: Optional[TDict[Any, Any]] = None,
         *,
         missing: None = None,
+        lazy: bool = False,
     ) -> DefaultDict[Any, Any]: ...
     # Typed by missing
     @overload
@@ -387,6 +471,7 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         default: Optional[TDict[Any, Any]] = None,
         *,
         missing: Callable[[], VT],
+        lazy: bool = False,
     ) -> DefaultDict[Any, VT]: ...
     # Typed by defaultdict default value
     @overload
@@ -397,6 +482,7 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         *,
         default: TDefaultDict[Any, VT],
         missing: Callable[[], VT],
+        lazy: bool = False,
     ) -> DefaultDict[Any, VT]: ...
     # No default
     # Typed keys
@@ -409,6 +495,7 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         default: Optional[TDict[Any, Any]] = None,
         *,
         missing: None = None,
+        lazy: bool = False,
     ) -> DefaultDict[KT, Any]: ...
     # - 1-tuple
     @overload
@@ -417,6 +504,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Tuple[Type[KT]],
         value: None = None,
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT, Any]: ...
     # - 2-tuple
     @overload
@@ -425,6 +514,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1]],
         value: None = None,
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT | KT1, Any]: ...
     # - 3-tuple
     @overload
@@ -433,6 +524,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1], Type[KT2]],
         value: None = None,
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT | KT1 | KT2, Any]: ...
     # - member
     @overload
@@ -441,12 +534,19 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Member[KT, Any],
         value: None = None,
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT, Any]: ...
     # Typed values
     # - type
     @overload
     def __new__(
-        cls, key: None, value: Type[VT], default: Optional[TDict[Any, Any]] = None
+        cls,
+        key: None,
+        value: Type[VT],
+        default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[Any, VT]: ...
     # - 1-tuple
     @overload
@@ -455,6 +555,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: None,
         value: Tuple[Type[VT]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[Any, VT]: ...
     # - 2-tuple
     @overload
@@ -463,6 +565,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: None,
         value: Tuple[Type[VT], Type[VT1]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[Any, VT | VT1]: ...
     # - 3-tuple
     @overload
@@ -471,6 +575,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: None,
         value: Tuple[Type[VT], Type[VT1], Type[VT2]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[Any, VT | VT1 | VT2]: ...
     # - member
     @overload
@@ -479,6 +585,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: None,
         value: Member[VT, Any],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[Any, VT]: ...
     # Typed value through keyword
     # - type
@@ -489,6 +597,7 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         *,
         value: Type[VT],
         default: Optional[TDict[Any, Any]] = None,
+        lazy: bool = False,
     ) -> DefaultDict[Any, VT]: ...
     # - 1-tuple
     @overload
@@ -498,6 +607,7 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         *,
         value: Tuple[Type[VT]],
         default: Optional[TDict[Any, Any]] = None,
+        lazy: bool = False,
     ) -> DefaultDict[Any, VT]: ...
     # - 2-tuple
     @overload
@@ -507,6 +617,7 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         *,
         value: Tuple[Type[VT], Type[VT1]],
         default: Optional[TDict[Any, Any]] = None,
+        lazy: bool = False,
     ) -> DefaultDict[Any, VT | VT1]: ...
     # - 3-tuple
     @overload
@@ -516,6 +627,7 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         *,
         value: Tuple[Type[VT], Type[VT1], Type[VT2]],
         default: Optional[TDict[Any, Any]] = None,
+        lazy: bool = False,
     ) -> DefaultDict[Any, VT | VT1 | VT2]: ...
     # - member
     @overload
@@ -525,13 +637,19 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         *,
         value: Member[VT, Any],
         default: Optional[TDict[Any, Any]] = None,
+        lazy: bool = False,
     ) -> DefaultDict[Any, VT]: ...
     # Typed key and value
     # - value simple type
     #    - key type
     @overload
     def __new__(
-        cls, key: Type[KT], value: Type[VT], default: Optional[TDict[Any, Any]] = None
+        cls,
+        key: Type[KT],
+        value: Type[VT],
+        default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT, VT]: ...
     #    - key 1-tuple
     @overload
@@ -540,6 +658,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Tuple[Type[KT]],
         value: Type[VT],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT, VT]: ...
     #    - key 2-tuple
     @overload
@@ -548,6 +668,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1]],
         value: Type[VT],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT | KT1, VT]: ...
     #    - key 3-tuple
     @overload
@@ -556,6 +678,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1], Type[KT2]],
         value: Type[VT],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT | KT1 | KT2, VT]: ...
     #    - key member
     @overload
@@ -564,6 +688,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Member[KT, Any],
         value: Type[VT],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT, VT]: ...
     # - Value as single element tuple
     #    - key type
@@ -573,6 +699,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Type[KT],
         value: Tuple[Type[VT]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT, VT]: ...
     #    - key 1-tuple
     @overload
@@ -581,6 +709,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Tuple[Type[KT]],
         value: Tuple[Type[VT]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT, VT]: ...
     #    - key 2-tuple
     @overload
@@ -589,6 +719,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1]],
         value: Tuple[Type[VT]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT | KT1, VT]: ...
     #    - key 3-tuple
     @overload
@@ -597,6 +729,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1], Type[KT2]],
         value: Tuple[Type[VT]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT | KT1 | KT2, VT]: ...
     #    - key member
     @overload
@@ -605,6 +739,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Member[KT, Any],
         value: Tuple[Type[VT]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT, VT]: ...
     # - Value as 2-tuple
     #    - key type
@@ -614,6 +750,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Type[KT],
         value: Tuple[Type[VT], Type[VT1]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT, VT | VT1]: ...
     #    - key 1-tuple
     @overload
@@ -622,6 +760,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Tuple[Type[KT]],
         value: Tuple[Type[VT], Type[VT1]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT, VT | VT1]: ...
     #    - key 2-tuple
     @overload
@@ -630,6 +770,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1]],
         value: Tuple[Type[VT], Type[VT1]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT | KT1, VT | VT1]: ...
     #    - key 3-tuple
     @overload
@@ -638,6 +780,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1], Type[KT2]],
         value: Tuple[Type[VT], Type[VT1]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT | KT1 | KT2, VT | VT1]: ...
     #    - key member
     @overload
@@ -646,6 +790,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Member[KT, Any],
         value: Tuple[Type[VT], Type[VT1]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT, VT | VT1]: ...
     # - Value as 3-tuple
     #   - key type
@@ -655,6 +801,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Type[KT],
         value: Tuple[Type[VT], Type[VT1], Type[VT2]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT, VT | VT1 | VT2]: ...
     #   - key 1-tuple
     @overload
@@ -663,6 +811,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Tuple[Type[KT]],
         value: Tuple[Type[VT], Type[VT1], Type[VT2]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT, VT | VT1 | VT2]: ...
     #   - key 2-tuple
     @overload
@@ -671,6 +821,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1]],
         value: Tuple[Type[VT], Type[VT1], Type[VT2]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT | KT1, VT | VT1 | VT2]: ...
     #   - key 3-tuple
     @overload
@@ -679,6 +831,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1], Type[KT2]],
         value: Tuple[Type[VT], Type[VT1], Type[VT2]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT | KT1 | KT2, VT | VT1 | VT2]: ...
     #   - key member
     @overload
@@ -687,6 +841,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Member[KT, Any],
         value: Tuple[Type[VT], Type[VT1], Type[VT2]],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT, VT | VT1 | VT2]: ...
     # - value as member
     #   - key type
@@ -696,6 +852,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Type[KT],
         value: Member[VT, Any],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT, VT]: ...
     #   - key 1-tuple
     @overload
@@ -704,6 +862,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Tuple[Type[KT]],
         value: Member[VT, Any],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT, VT]: ...
     #   - key 2-tuple
     @overload
@@ -712,6 +872,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1]],
         value: Member[VT, Any],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT | KT1, VT]: ...
     #   - key 3-tuple
     @overload
@@ -720,6 +882,8 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Tuple[Type[KT], Type[KT1], Type[KT2]],
         value: Member[VT, VT],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT | KT1 | KT2, VT]: ...
     #   - key member
     @overload
@@ -728,4 +892,6 @@ class DefaultDict(Member[TDefaultDict[KT, VT], TDefaultDict[KT, VT]]):
         key: Member[KT, KT],
         value: Member[VT, VT],
         default: Optional[TDict[Any, Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> DefaultDict[KT, VT]: ...
@@ -0,0 +1,39 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+from .catom import DefaultValue, Member, Validate
+
+
+class IntSet(Member):
+    """A member which allows sets of non-negative integers.
+
+    The value is an atomintset storing integers in the range [0, 2**32)
+    in a compressed bitmap, which is much smaller than a set of int
+    objects for dense ids and makes union, intersection and difference
+    proportional to the size of the bitmap. Changes to the set are
+    notified to container observers like a ContainerSet.
+
+    Assigning a set or another atomintset creates a copy.
+
+    """
+
+    __slots__ = ()
+
+    def __init__(self, default=None):
+        """Initialize an IntSet.
+
+        Parameters
+        ----------
+        default : iterable, optional
+            The default values. A new copy of the set will be created for
+            each atom instance.
+
+        """
+        if default is not None:
+            default = set(default)
+        self.set_default_value_mode(DefaultValue.Set, default)
+        self.set_validate_mode(Validate.IntSet, None)
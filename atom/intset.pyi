@@ -0,0 +1,13 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+from typing import AbstractSet, Iterable, Optional
+
+from .catom import Member, atomintset
+
+class IntSet(Member[atomintset, AbstractSet[int]]):
+    def __new__(cls, default: Optional[Iterable[int]] = None) -> IntSet: ...
@@ -21,7 +21,7 @@ class List(Member):
 
     __slots__ = "item"
 
-    def __init__(self, item=None, default=None):
+    def __init__(self, item=None, default=None, *, lazy=False):
         """Initialize a List.
 
         Parameters
@@ -36,6 +36,15 @@ class List(Member):
             The default list of values. A new copy of this list will be
             created for each atom instance.
 
+        lazy : bool, optional
+            Defer the validation of the items of an assigned list until
+            it is first read or until its validate_all method is called.
+            Any operation but append, insert, extend and clear, including
+            comparisons and repr, counts as a read. Mutations of the list
+            are always validated. A list outliving its atom is left
+            unvalidated. This is meant for large lists built from trusted
+            data. The default is False.
+
         """
         if item is not None and not isinstance(item, Member):
             opt, types = is_optional(extract_types(item))
@@ -43,6 +52,7 @@ class List(Member):
         self.item = item
         self.set_default_value_mode(DefaultValue.List, default)
         self.set_validate_mode(Validate.List, item)
+        self.lazy_validation = lazy
 
     def set_name(self, name):
         """Set the name of the member.
@@ -17,52 +17,114 @@ class List(Member[TList[T], TList[T]]):
     # No default
     @overload
     def __new__(
-        cls, kind: None = None, default: Optional[TList[Any]] = None
+        cls,
+        kind: None = None,
+        default: Optional[TList[Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> List[Any]: ...
     @overload
-    def __new__(cls, kind: Type[T], default: None = None) -> List[T]: ...
+    def __new__(
+        cls,
+        kind: Type[T],
+        default: None = None,
+        *,
+        lazy: bool = False,
+    ) -> List[T]: ...
     @overload
-    def __new__(cls, kind: Tuple[Type[T]], default: None = None) -> List[T]: ...
+    def __new__(
+        cls,
+        kind: Tuple[Type[T]],
+        default: None = None,
+        *,
+        lazy: bool = False,
+    ) -> List[T]: ...
     @overload
     def __new__(
-        cls, kind: Tuple[Type[T], Type[T1]], default: None = None
+        cls,
+        kind: Tuple[Type[T], Type[T1]],
+        default: None = None,
+        *,
+        lazy: bool = False,
     ) -> List[T | T1]: ...
     @overload
     def __new__(
         cls,
         kind: Tuple[Type[T], Type[T1], Type[T2]],
         default: None = None,
+        *,
+        lazy: bool = False,
     ) -> List[T | T1 | T2]: ...
     @overload
-    def __new__(cls, kind: Member[T, Any], default: None = None) -> List[T]: ...
+    def __new__(
+        cls,
+        kind: Member[T, Any],
+        default: None = None,
+        *,
+        lazy: bool = False,
+    ) -> List[T]: ...
     # With default
     @overload
-    def __new__(cls, kind: Type[T], default: TList[T]) -> List[T]: ...
+    def __new__(
+        cls,
+        kind: Type[T],
+        default: TList[T],
+        *,
+        lazy: bool = False,
+    ) -> List[T]: ...
     @overload
-    def __new__(cls, kind: Tuple[Type[T]], default: TList[T]) -> List[T]: ...
+    def __new__(
+        cls,
+        kind: Tuple[Type[T]],
+        default: TList[T],
+        *,
+        lazy: bool = False,
+    ) -> List[T]: ...
     @overload
     def __new__(
-        cls, kind: Tuple[Type[T], Type[T1]], default: TList[T | T1]
+        cls,
+        kind: Tuple[Type[T], Type[T1]],
+        default: TList[T | T1],
+        *,
+        lazy: bool = False,
     ) -> List[T | T1]: ...
     @overload
     def __new__(
-        cls, kind: Tuple[Type[T], Type[T1]], default: TList[T] | TList[T1]
+        cls,
+        kind: Tuple[Type[T], Type[T1]],
+        default: TList[T] | TList[T1],
+        *,
+        lazy: bool = False,
     ) -> List[T | T1]: ...
     @overload
     def __new__(
-        cls, kind: Tuple[Type[T], Type[T1], Type[T2]], default: TList[T | T1 | T2]
+        cls,
+        kind: Tuple[Type[T], Type[T1], Type[T2]],
+        default: TList[T | T1 | T2],
+        *,
+        lazy: bool = False,
     ) -> List[T | T1 | T2]: ...
     @overload
     def __new__(
         cls,
         kind: Tuple[Type[T], Type[T1], Type[T2]],
         default: TList[T | T1] | TList[T | T2] | TList[T1 | T2],
+        *,
+        lazy: bool = False,
     ) -> List[T | T1 | T2]: ...
     @overload
     def __new__(
         cls,
         kind: Tuple[Type[T], Type[T1], Type[T2]],
         default: TList[T] | TList[T1] | TList[T2],
+        *,
+        lazy: bool = False,
     ) -> List[T | T1 | T2]: ...
     @overload
-    def __new__(cls, kind: Member[T, Any], default: TList[T]) -> List[T]: ...
+    def __new__(
+        cls,
+        kind: Member[T, Any],
+        default: TList[T],
+        *,
+        lazy: bool = False,
+    ) -> List[T]: ...
@@ -0,0 +1,46 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+from .catom import DefaultValue, Member, Validate
+
+
+class NumericList(Member):
+    """A member which allows lists of numbers stored in native form.
+
+    The value is an atomnumlist holding 64-bit integers, 64-bit floats or
+    booleans in a contiguous buffer. Items are validated when written and
+    the buffer is exposed, read-only, through the buffer protocol so that
+    it can be viewed by memoryview or numpy without a copy. Changes to the
+    list are notified to container observers like a ContainerList.
+
+    Assigning a list, a tuple, another numeric list or an object exporting
+    a buffer creates a copy. A buffer whose items have the native type of
+    the list is copied without converting its items.
+
+    """
+
+    __slots__ = ()
+
+    def __init__(self, kind=float, default=None):
+        """Initialize a NumericList.
+
+        Parameters
+        ----------
+        kind : type, optional
+            The type of the items, one of int, float or bool. Integers
+            are stored as signed 64-bit values. Float lists also accept
+            integers. The default is float.
+
+        default : sequence, optional
+            The default items. A new copy of the list will be created
+            for each atom instance.
+
+        """
+        if default is not None:
+            default = list(default)
+        self.set_default_value_mode(DefaultValue.List, default)
+        self.set_validate_mode(Validate.NumericList, kind)
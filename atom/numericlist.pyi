@@ -0,0 +1,22 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+from typing import Iterable, Optional, Type, TypeVar, overload
+
+from .catom import Member, atomnumlist
+
+N = TypeVar("N", int, float, bool)
+
+class NumericList(Member[atomnumlist[N], Iterable[N]]):
+    @overload
+    def __new__(
+        cls, kind: None = None, default: Optional[Iterable[float]] = None
+    ) -> NumericList[float]: ...
+    @overload
+    def __new__(
+        cls, kind: Type[N], default: Optional[Iterable[N]] = None
+    ) -> NumericList[N]: ...
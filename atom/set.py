@@ -21,7 +21,7 @@ class Set(Member):
 
     __slots__ = "item"
 
-    def __init__(self, item=None, default=None):
+    def __init__(self, item=None, default=None, *, lazy=False):
         """Initialize a Set.
 
         Parameters
@@ -36,6 +36,15 @@ class Set(Member):
             The default list of values. A new copy of this list will be
             created for each atom instance.
 
+        lazy : bool, optional
+            Defer the validation of the items of an assigned set until
+            it is first read or until its validate_all method is called.
+            Any operation but add, update and clear, including comparisons,
+            set algebra and repr, counts as a read. Mutations of the set
+            are always validated. A set outliving its atom is left
+            unvalidated. This is meant for large sets built from trusted
+            data. The default is False.
+
         """
         self.set_default_value_mode(DefaultValue.Set, default)
         if item is not None and not isinstance(item, Member):
@@ -43,6 +52,7 @@ class Set(Member):
             item = Instance(types, optional=opt)
         self.item = item
         self.set_validate_mode(Validate.Set, item)
+        self.lazy_validation = lazy
 
     def set_name(self, name):
         """Assign the name to this member.
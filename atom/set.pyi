@@ -16,55 +16,115 @@ T2 = TypeVar("T2")
 class Set(Member[TSet[T], TSet[T]]):
     @overload
     def __new__(
-        cls, item: None = None, default: Optional[TSet[Any]] = None
+        cls,
+        item: None = None,
+        default: Optional[TSet[Any]] = None,
+        *,
+        lazy: bool = False,
     ) -> Set[Any]: ...
     @overload
-    def __new__(cls, item: Type[T], default: None = None) -> Set[T]: ...
+    def __new__(
+        cls,
+        item: Type[T],
+        default: None = None,
+        *,
+        lazy: bool = False,
+    ) -> Set[T]: ...
     @overload
-    def __new__(cls, item: Tuple[Type[T]], default: None = None) -> Set[T]: ...
+    def __new__(
+        cls,
+        item: Tuple[Type[T]],
+        default: None = None,
+        *,
+        lazy: bool = False,
+    ) -> Set[T]: ...
     @overload
     def __new__(
-        cls, item: Tuple[Type[T], Type[T1]], default: None = None
+        cls,
+        item: Tuple[Type[T], Type[T1]],
+        default: None = None,
+        *,
+        lazy: bool = False,
     ) -> Set[T | T1]: ...
     @overload
     def __new__(
         cls,
         item: Tuple[Type[T], Type[T1], Type[T2]],
         default: None = None,
+        *,
+        lazy: bool = False,
     ) -> Set[T | T1 | T2]: ...
     @overload
-    def __new__(cls, item: Member[T, Any], default: None = None) -> Set[T]: ...
+    def __new__(
+        cls,
+        item: Member[T, Any],
+        default: None = None,
+        *,
+        lazy: bool = False,
+    ) -> Set[T]: ...
     # With default
     # The splitting is necessary otherwise Mypy type inference fails
     @overload
-    def __new__(cls, item: Type[T], default: TSet[T]) -> Set[T]: ...
+    def __new__(
+        cls,
+        item: Type[T],
+        default: TSet[T],
+        *,
+        lazy: bool = False,
+    ) -> Set[T]: ...
     @overload
-    def __new__(cls, item: Tuple[Type[T]], default: TSet[T]) -> Set[T]: ...
+    def __new__(
+        cls,
+        item: Tuple[Type[T]],
+        default: TSet[T],
+        *,
+        lazy: bool = False,
+    ) -> Set[T]: ...
     @overload
     def __new__(
-        cls, item: Tuple[Type[T], Type[T1]], default: TSet[T | T1]
+        cls,
+        item: Tuple[Type[T], Type[T1]],
+        default: TSet[T | T1],
+        *,
+        lazy: bool = False,
     ) -> Set[T | T1]: ...
     @overload
     def __new__(
-        cls, item: Tuple[Type[T], Type[T1]], default: TSet[T] | TSet[T1]
+        cls,
+        item: Tuple[Type[T], Type[T1]],
+        default: TSet[T] | TSet[T1],
+        *,
+        lazy: bool = False,
     ) -> Set[T | T1]: ...
     @overload
     def __new__(
         cls,
         item: Tuple[Type[T], Type[T1], Type[T2]],
         default: TSet[T | T1 | T2],
+        *,
+        lazy: bool = False,
     ) -> Set[T | T1 | T2]: ...
     @overload
     def __new__(
         cls,
         item: Tuple[Type[T], Type[T1], Type[T2]],
         default: TSet[T | T1] | TSet[T | T2] | TSet[T1 | T2],
+        *,
+        lazy: bool = False,
     ) -> Set[T | T1 | T2]: ...
     @overload
     def __new__(
         cls,
         item: Tuple[Type[T], Type[T1], Type[T2]],
         default: TSet[T] | TSet[T1] | TSet[T2],
+        *,
+        lazy: bool = False,
     ) -> Set[T | T1 | T2]: ...
     @overload
-    def __new__(cls, item: Member[T, Any], default: TSet[T]) -> Set[T]: ...
+    def __new__(
+        cls,
+        item: Member[T, Any],
+        default: TSet[T],
+        *,
+        lazy: bool = False,
+    ) -> Set[T]: ...
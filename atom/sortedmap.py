@@ -0,0 +1,52 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+from .catom import Validate
+from .dict import Dict
+
+
+class SortedMap(Dict):
+    """A member which allows maps whose keys are kept sorted.
+
+    The value is an atomsortedmap, a subclass of the sortedmap of
+    atom.datastructures whose keys and values are validated by members
+    like the ones of a Dict. Changes to the map are notified to container
+    observers like a ContainerDict.
+
+    Assigning a dict or a sortedmap creates a copy. The copy of another
+    sortedmap shares its nodes until either map is modified.
+
+    """
+
+    __slots__ = ()
+
+    def __init__(self, key=None, value=None, default=None):
+        """Initialize a SortedMap.
+
+        Parameters
+        ----------
+        key : Member, type, tuple of types, or None, optional
+            A member to use for validating the keys of the map. This can
+            also be a type or a tuple of types, which will be wrapped with
+            an Instance member. If this is not given, no key validation is
+            performed.
+
+        value : Member, type, tuple of types, or None, optional
+            A member to use for validating the values of the map. This can
+            also be a type or a tuple of types, which will be wrapped with
+            an Instance member. If this is not given, no value validation
+            is performed.
+
+        default : mapping, optional
+            The default items. A new map will be created for each atom
+            instance.
+
+        """
+        if default is not None:
+            default = dict(default)
+        super(SortedMap, self).__init__(key, value, default)
+        self.set_validate_mode(Validate.SortedMap, self.validate_mode[1])
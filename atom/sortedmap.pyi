@@ -0,0 +1,55 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+from typing import Any, Mapping, Optional, Type, TypeVar, overload
+
+from .catom import Member, atomsortedmap
+
+KT = TypeVar("KT")
+VT = TypeVar("VT")
+
+class SortedMap(Member[atomsortedmap[KT, VT], Mapping[KT, VT]]):
+    # Untyped
+    @overload
+    def __new__(
+        cls,
+        key: None = None,
+        value: None = None,
+        default: Optional[Mapping[Any, Any]] = None,
+    ) -> SortedMap[Any, Any]: ...
+    # Typed keys
+    @overload
+    def __new__(
+        cls,
+        key: Type[KT] | Member[KT, Any],
+        value: None = None,
+        default: Optional[Mapping[Any, Any]] = None,
+    ) -> SortedMap[KT, Any]: ...
+    # Typed values
+    @overload
+    def __new__(
+        cls,
+        key: None,
+        value: Type[VT] | Member[VT, Any],
+        default: Optional[Mapping[Any, Any]] = None,
+    ) -> SortedMap[Any, VT]: ...
+    @overload
+    def __new__(
+        cls,
+        key: None = None,
+        *,
+        value: Type[VT] | Member[VT, Any],
+        default: Optional[Mapping[Any, Any]] = None,
+    ) -> SortedMap[Any, VT]: ...
+    # Typed keys and values
+    @overload
+    def __new__(
+        cls,
+        key: Type[KT] | Member[KT, Any],
+        value: Type[VT] | Member[VT, Any],
+        default: Optional[Mapping[Any, Any]] = None,
+    ) -> SortedMap[KT, VT]: ...
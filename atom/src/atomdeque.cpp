@@ -0,0 +1,816 @@
+/*-----------------------------------------------------------------------------
+| Copyright (c) 2025, Nucleic Development Team.
+|
+| Distributed under the terms of the Modified BSD License.
+|
+| The full license is in the file LICENSE, distributed with this software.
+|----------------------------------------------------------------------------*/
+#include <algorithm>
+#include <cppy/cppy.h>
+#include "atomdeque.h"
+#include "memberchange.h"
+#include "packagenaming.h"
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wdeprecated-writable-strings"
+#endif
+
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#endif
+
+namespace atom
+{
+
+
+namespace
+{
+
+// Index in the storage of the item at a position of the deque.
+inline Py_ssize_t
+slot( AtomDeque* deque, Py_ssize_t index )
+{
+    Py_ssize_t pos = deque->head + index;
+    return pos < deque->allocated ? pos : pos - deque->allocated;
+}
+
+
+bool
+check_maxlen( Py_ssize_t maxlen )
+{
+    if( maxlen < 1 )
+    {
+        PyErr_SetString( PyExc_ValueError, "maxlen must be positive" );
+        return false;
+    }
+    if( static_cast<size_t>( maxlen ) > PY_SSIZE_T_MAX / sizeof( PyObject* ) )
+    {
+        PyErr_SetString( PyExc_OverflowError, "maxlen is too large" );
+        return false;
+    }
+    return true;
+}
+
+
+// Make room for one more item. The storage grows geometrically up to maxlen
+// and the items are moved to its start.
+bool
+reserve( AtomDeque* deque )
+{
+    if( deque->size < deque->allocated )
+        return true;
+    Py_ssize_t allocated = std::min(
+        deque->maxlen, std::max<Py_ssize_t>( 8, deque->allocated * 2 )
+    );
+    PyObject** items = PyMem_New( PyObject*, allocated );
+    if( !items )
+    {
+        PyErr_NoMemory();  // LCOV_EXCL_LINE
+        return false;  // LCOV_EXCL_LINE
+    }
+    for( Py_ssize_t i = 0; i < deque->size; ++i )
+        items[ i ] = deque->items[ slot( deque, i ) ];
+    PyMem_Free( deque->items );
+    deque->items = items;
+    deque->head = 0;
+    deque->allocated = allocated;
+    return true;
+}
+
+
+// Add an item at the end, stealing the reference. The first item of a full
+// deque is evicted and its reference is handed to evicted.
+bool
+push_back( AtomDeque* deque, PyObject* item, cppy::ptr& evicted )
+{
+    if( deque->size == deque->maxlen )
+    {
+        // A full deque has allocated maxlen slots so the slot is reused.
+        evicted = deque->items[ deque->head ];
+        deque->items[ deque->head ] = item;
+        deque->head = slot( deque, 1 );
+        return true;
+    }
+    if( !reserve( deque ) )
+    {
+        Py_DECREF( item );  // LCOV_EXCL_LINE
+        return false;  // LCOV_EXCL_LINE
+    }
+    deque->items[ slot( deque, deque->size ) ] = item;
+    ++deque->size;
+    return true;
+}
+
+
+// Add an item at the start, stealing the reference. The last item of a full
+// deque is evicted and its reference is handed to evicted.
+bool
+push_front( AtomDeque* deque, PyObject* item, cppy::ptr& evicted )
+{
+    bool full = deque->size == deque->maxlen;
+    if( !full && !reserve( deque ) )
+    {
+        Py_DECREF( item );  // LCOV_EXCL_LINE
+        return false;  // LCOV_EXCL_LINE
+    }
+    deque->head = deque->head == 0 ? deque->allocated - 1 : deque->head - 1;
+    if( full )
+        evicted = deque->items[ deque->head ];
+    else
+        ++deque->size;
+    deque->items[ deque->head ] = item;
+    return true;
+}
+
+
+// Remove the first item of a non empty deque and return its reference.
+PyObject*
+pop_front( AtomDeque* deque )
+{
+    PyObject* item = deque->items[ deque->head ];
+    deque->head = slot( deque, 1 );
+    --deque->size;
+    return item;
+}
+
+
+// Remove the last item of a non empty deque and return its reference.
+PyObject*
+pop_back( AtomDeque* deque )
+{
+    --deque->size;
+    return deque->items[ slot( deque, deque->size ) ];
+}
+
+
+// A new list holding the items of the deque.
+PyObject*
+items_list( AtomDeque* deque )
+{
+    PyObject* list = PyList_New( deque->size );
+    if( !list )
+        return 0;  // LCOV_EXCL_LINE
+    for( Py_ssize_t i = 0; i < deque->size; ++i )
+        PyList_SET_ITEM( list, i, cppy::incref( deque->items[ slot( deque, i ) ] ) );
+    return list;
+}
+
+
+// Empty the deque and release its storage. The storage is detached first
+// since releasing the items may run arbitrary code.
+void
+release_items( AtomDeque* deque )
+{
+    PyObject** items = deque->items;
+    Py_ssize_t head = deque->head;
+    Py_ssize_t size = deque->size;
+    Py_ssize_t allocated = deque->allocated;
+    deque->items = 0;
+    deque->head = 0;
+    deque->size = 0;
+    deque->allocated = 0;
+    for( Py_ssize_t i = 0; i < size; ++i )
+    {
+        Py_ssize_t pos = head + i;
+        Py_DECREF( items[ pos < allocated ? pos : pos - allocated ] );
+    }
+    PyMem_Free( items );
+}
+
+
+PyObject*
+validate_item( AtomDeque* deque, PyObject* item )
+{
+    CAtom* atom = deque->pointer->data();
+    if( deque->validator && atom )
+        return deque->validator->full_validate( atom, Py_None, item );
+    return cppy::incref( item );
+}
+
+
+// A new list holding the items of an iterable, validated unless validate
+// is false.
+PyObject*
+validate_items( AtomDeque* deque, PyObject* value, bool validate )
+{
+    cppy::ptr items( PySequence_List( value ) );
+    if( !items )
+        return 0;
+    if( !validate || !deque->validator )
+        return items.release();
+    for( Py_ssize_t i = 0; i < PyList_GET_SIZE( items.get() ); ++i )
+    {
+        PyObject* item = validate_item( deque, PyList_GET_ITEM( items.get(), i ) );
+        if( !item )
+            return 0;
+        PyList_SetItem( items.get(), i, item );
+    }
+    return items.release();
+}
+
+
+// Whether the changes of the deque are observed. The atom is returned in atom.
+bool
+observed( AtomDeque* deque, CAtom*& atom )
+{
+    atom = deque->pointer->data();
+    return deque->member && atom && MemberChange::container_observed( atom, deque->member );
+}
+
+
+// Notify a change of the deque carrying up to two payload entries.
+bool
+post_change(
+    AtomDeque* deque,
+    CAtom* atom,
+    ContainerOp::Op operation,
+    const char* key = 0,
+    PyObject* value = 0,
+    const char* key2 = 0,
+    PyObject* value2 = 0 )
+{
+    cppy::ptr change( MemberChange::container( atom, deque->member, pyobject_cast( deque ), operation ) );
+    if( !change )
+        return false;
+    if( key && PyDict_SetItemString( change.get(), key, value ) != 0 )
+        return false;
+    if( key2 && PyDict_SetItemString( change.get(), key2, value2 ) != 0 )
+        return false;
+    return MemberChange::notify_container( atom, deque->member, change.get() );
+}
+
+
+// Iterator over the items of a deque, invalidated by any modification.
+struct AtomDequeIterator
+{
+    PyObject_HEAD
+    AtomDeque* deque;
+    Py_ssize_t index;
+    uint64_t version;
+
+    static PyType_Spec TypeObject_Spec;
+
+    static PyTypeObject* TypeObject;
+
+    static PyObject* New( AtomDeque* deque )
+    {
+        PyObject* pyiter = PyType_GenericAlloc( TypeObject, 0 );
+        if( !pyiter )
+            return 0;  // LCOV_EXCL_LINE
+        AtomDequeIterator* iter = reinterpret_cast<AtomDequeIterator*>( pyiter );
+        iter->deque = atomdeque_cast( cppy::incref( pyobject_cast( deque ) ) );
+        iter->version = deque->version;
+        return pyiter;
+    }
+};
+
+
+int
+AtomDequeIterator_traverse( AtomDequeIterator* self, visitproc visit, void* arg )
+{
+    Py_VISIT( pyobject_cast( self->deque ) );
+    Py_VISIT( Py_TYPE( self ) );
+    return 0;
+}
+
+
+int
+AtomDequeIterator_clear( AtomDequeIterator* self )
+{
+    Py_CLEAR( self->deque );
+    return 0;
+}
+
+
+void
+AtomDequeIterator_dealloc( AtomDequeIterator* self )
+{
+    PyObject_GC_UnTrack( self );
+    AtomDequeIterator_clear( self );
+    PyTypeObject* type = Py_TYPE( self );
+    type->tp_free( pyobject_cast( self ) );
+    Py_DECREF( type );
+}
+
+
+PyObject*
+AtomDequeIterator_next( AtomDequeIterator* self )
+{
+    if( !self->deque )
+        return 0;
+    if( self->deque->version != self->version )
+    {
+        PyErr_SetString( PyExc_RuntimeError, "atomdeque mutated during iteration" );
+        Py_CLEAR( self->deque );
+        return 0;
+    }
+    if( self->index >= self->deque->size )
+    {
+        Py_CLEAR( self->deque );
+        return 0;
+    }
+    return cppy::incref( self->deque->items[ slot( self->deque, self->index++ ) ] );
+}
+
+
+PyObject*
+AtomDequeIterator_length_hint( AtomDequeIterator* self )
+{
+    return PyLong_FromSsize_t( self->deque ? self->deque->size - self->index : 0 );
+}
+
+
+static PyMethodDef
+AtomDequeIterator_methods[] = {
+    { "__length_hint__", ( PyCFunction )AtomDequeIterator_length_hint, METH_NOARGS,
+      "" },
+    { 0 } // sentinel
+};
+
+
+static PyType_Slot AtomDequeIterator_Type_slots[] = {
+    { Py_tp_dealloc, void_cast( AtomDequeIterator_dealloc ) },      /* tp_dealloc */
+    { Py_tp_traverse, void_cast( AtomDequeIterator_traverse ) },    /* tp_traverse */
+    { Py_tp_clear, void_cast( AtomDequeIterator_clear ) },          /* tp_clear */
+    { Py_tp_iter, void_cast( PyObject_SelfIter ) },                 /* tp_iter */
+    { Py_tp_iternext, void_cast( AtomDequeIterator_next ) },        /* tp_iternext */
+    { Py_tp_methods, void_cast( AtomDequeIterator_methods ) },      /* tp_methods */
+    { 0, 0 },
+};
+
+
+PyTypeObject* AtomDequeIterator::TypeObject = NULL;
+
+
+PyType_Spec AtomDequeIterator::TypeObject_Spec = {
+    PACKAGE_TYPENAME( "atomdeque_iterator" ),   /* tp_name */
+    sizeof( AtomDequeIterator ),                /* tp_basicsize */
+    0,                                          /* tp_itemsize */
+    Py_TPFLAGS_DEFAULT
+    |Py_TPFLAGS_HAVE_GC,                        /* tp_flags */
+    AtomDequeIterator_Type_slots                /* slots */
+};
+
+
+PyObject*
+AtomDeque_new( PyTypeObject* type, PyObject* args, PyObject* kwargs )
+{
+    static char* kwlist[] = { "maxlen", "items", 0 };
+    Py_ssize_t maxlen;
+    PyObject* items = 0;
+    if( !PyArg_ParseTupleAndKeywords( args, kwargs, "n|O:atomdeque", kwlist, &maxlen, &items ) )
+        return 0;
+    if( !check_maxlen( maxlen ) )
+        return 0;
+    cppy::ptr self( PyType_GenericAlloc( type, 0 ) );
+    if( !self )
+        return 0;  // LCOV_EXCL_LINE (failed instance creation)
+    AtomDeque* deque = atomdeque_cast( self.get() );
+    deque->maxlen = maxlen;
+    deque->pointer = new CAtomPointer();
+    deque->touch();
+    if( items && AtomDeque::Assign( deque, items, false ) < 0 )
+        return 0;
+    return self.release();
+}
+
+
+int
+AtomDeque_clear( AtomDeque* self )
+{
+    Py_CLEAR( self->validator );
+    Py_CLEAR( self->member );
+    release_items( self );
+    return 0;
+}
+
+
+int
+AtomDeque_traverse( AtomDeque* self, visitproc visit, void* arg )
+{
+    Py_VISIT( self->validator );
+    Py_VISIT( self->member );
+    for( Py_ssize_t i = 0; i < self->size; ++i )
+        Py_VISIT( self->items[ slot( self, i ) ] );
+    Py_VISIT( Py_TYPE( self ) );
+    return 0;
+}
+
+
+void
+AtomDeque_dealloc( AtomDeque* self )
+{
+    PyObject_GC_UnTrack( self );
+    AtomDeque_clear( self );
+    delete self->pointer;
+    self->pointer = 0;
+    PyTypeObject* type = Py_TYPE( self );
+    type->tp_free( pyobject_cast( self ) );
+    Py_DECREF( type );
+}
+
+
+Py_ssize_t
+AtomDeque_length( AtomDeque* self )
+{
+    return self->size;
+}
+
+
+PyObject*
+AtomDeque_item( AtomDeque* self, Py_ssize_t index )
+{
+    if( index < 0 || index >= self->size )
+    {
+        PyErr_SetString( PyExc_IndexError, "atomdeque index out of range" );
+        return 0;
+    }
+    return cppy::incref( self->items[ slot( self, index ) ] );
+}
+
+
+// Return the position of the first item equal to value, -1 if there is
+// none and -2 on error. The size is read anew since comparisons may run
+// arbitrary code.
+Py_ssize_t
+find_item( AtomDeque* self, PyObject* value, Py_ssize_t start )
+{
+    for( Py_ssize_t i = start; i < self->size; ++i )
+    {
+        cppy::ptr item( cppy::incref( self->items[ slot( self, i ) ] ) );
+        int res = PyObject_RichCompareBool( item.get(), value, Py_EQ );
+        if( res < 0 )
+            return -2;
+        if( res == 1 )
+            return i;
+    }
+    return -1;
+}
+
+
+int
+AtomDeque_contains( AtomDeque* self, PyObject* value )
+{
+    Py_ssize_t index = find_item( self, value, 0 );
+    return index == -2 ? -1 : index >= 0;
+}
+
+
+PyObject*
+AtomDeque_iter( AtomDeque* self )
+{
+    return AtomDequeIterator::New( self );
+}
+
+
+PyObject*
+AtomDeque_richcompare( AtomDeque* self, PyObject* other, int op )
+{
+    if( ( op != Py_EQ && op != Py_NE ) ||
+        !( AtomDeque::TypeCheck( other ) || PyList_Check( other ) || PyTuple_Check( other ) ) )
+        return cppy::incref( Py_NotImplemented );
+    cppy::ptr items( items_list( self ) );
+    if( !items )
+        return 0;  // LCOV_EXCL_LINE
+    cppy::ptr otheritems( PySequence_List( other ) );
+    if( !otheritems )
+        return 0;  // LCOV_EXCL_LINE
+    return PyObject_RichCompare( items.get(), otheritems.get(), op );
+}
+
+
+PyObject*
+AtomDeque_repr( AtomDeque* self )
+{
+    int res = Py_ReprEnter( pyobject_cast( self ) );
+    if( res != 0 )
+        return res > 0 ? PyUnicode_FromString( "[...]" ) : 0;
+    cppy::ptr items( items_list( self ) );
+    PyObject* repr = items ?
+        PyUnicode_FromFormat( "atomdeque(%R, maxlen=%zd)", items.get(), self->maxlen ) : 0;
+    Py_ReprLeave( pyobject_cast( self ) );
+    return repr;
+}
+
+
+PyObject*
+AtomDeque_append( AtomDeque* self, PyObject* value )
+{
+    cppy::ptr item( validate_item( self, value ) );
+    if( !item )
+        return 0;
+    cppy::ptr evicted;
+    if( !push_back( self, cppy::incref( item.get() ), evicted ) )
+        return 0;  // LCOV_EXCL_LINE
+    self->touch();
+    CAtom* atom;
+    if( observed( self, atom ) &&
+        !post_change( self, atom, ContainerOp::Append, "item", item.get(), evicted ? "evicted" : 0, evicted.get() ) )
+        return 0;
+    return cppy::incref( Py_None );
+}
+
+
+PyObject*
+AtomDeque_appendleft( AtomDeque* self, PyObject* value )
+{
+    cppy::ptr item( validate_item( self, value ) );
+    if( !item )
+        return 0;
+    cppy::ptr evicted;
+    if( !push_front( self, cppy::incref( item.get() ), evicted ) )
+        return 0;  // LCOV_EXCL_LINE
+    self->touch();
+    CAtom* atom;
+    if( observed( self, atom ) &&
+        !post_change( self, atom, ContainerOp::AppendLeft, "item", item.get(), evicted ? "evicted" : 0, evicted.get() ) )
+        return 0;
+    return cppy::incref( Py_None );
+}
+
+
+PyObject*
+AtomDeque_extend( AtomDeque* self, PyObject* value )
+{
+    // All the items are validated before the deque is modified.
+    cppy::ptr items( validate_items( self, value, true ) );
+    if( !items )
+        return 0;
+    cppy::ptr evicted( PyList_New( 0 ) );
+    if( !evicted )
+        return 0;  // LCOV_EXCL_LINE
+    for( Py_ssize_t i = 0; i < PyList_GET_SIZE( items.get() ); ++i )
+    {
+        cppy::ptr old;
+        if( !push_back( self, cppy::incref( PyList_GET_ITEM( items.get(), i ) ), old ) )
+            return 0;  // LCOV_EXCL_LINE
+        if( old && PyList_Append( evicted.get(), old.get() ) != 0 )
+            return 0;  // LCOV_EXCL_LINE
+    }
+    self->touch();
+    CAtom* atom;
+    if( observed( self, atom ) &&
+        !post_change(
+            self, atom, ContainerOp::Extend, "items", items.get(),
+            PyList_GET_SIZE( evicted.get() ) > 0 ? "evicted" : 0, evicted.get()
+        ) )
+        return 0;
+    return cppy::incref( Py_None );
+}
+
+
+PyObject*
+pop_item( AtomDeque* self, bool front )
+{
+    if( self->size == 0 )
+    {
+        PyErr_SetString( PyExc_IndexError, "pop from an empty atomdeque" );
+        return 0;
+    }
+    cppy::ptr item( front ? pop_front( self ) : pop_back( self ) );
+    self->touch();
+    CAtom* atom;
+    if( observed( self, atom ) &&
+        !post_change( self, atom, front ? ContainerOp::PopLeft : ContainerOp::Pop, "item", item.get() ) )
+        return 0;
+    return item.release();
+}
+
+
+PyObject*
+AtomDeque_pop( AtomDeque* self )
+{
+    return pop_item( self, false );
+}
+
+
+PyObject*
+AtomDeque_popleft( AtomDeque* self )
+{
+    return pop_item( self, true );
+}
+
+
+PyObject*
+AtomDeque_clear_items( AtomDeque* self )
+{
+    cppy::ptr items( items_list( self ) );
+    if( !items )
+        return 0;  // LCOV_EXCL_LINE
+    release_items( self );
+    self->touch();
+    CAtom* atom;
+    if( observed( self, atom ) && !post_change( self, atom, ContainerOp::Clear, "items", items.get() ) )
+        return 0;
+    return cppy::incref( Py_None );
+}
+
+
+PyObject*
+AtomDeque_count( AtomDeque* self, PyObject* value )
+{
+    Py_ssize_t count = 0;
+    Py_ssize_t index = find_item( self, value, 0 );
+    while( index >= 0 )
+    {
+        ++count;
+        index = find_item( self, value, index + 1 );
+    }
+    if( index == -2 )
+        return 0;
+    return PyLong_FromSsize_t( count );
+}
+
+
+PyObject*
+AtomDeque_tolist( AtomDeque* self )
+{
+    return items_list( self );
+}
+
+
+PyObject*
+AtomDeque_copy( AtomDeque* self )
+{
+    cppy::ptr res( AtomDeque::New( self->maxlen, 0, 0, 0 ) );
+    if( !res || AtomDeque::Assign( atomdeque_cast( res.get() ), pyobject_cast( self ), false ) < 0 )
+        return 0;  // LCOV_EXCL_LINE
+    return res.release();
+}
+
+
+PyObject*
+AtomDeque_reduce( AtomDeque* self )
+{
+    cppy::ptr items( items_list( self ) );
+    if( !items )
+        return 0;  // LCOV_EXCL_LINE
+    return Py_BuildValue( "(O(nO))", pyobject_cast( Py_TYPE( self ) ), self->maxlen, items.get() );
+}
+
+
+PyObject*
+AtomDeque_sizeof( AtomDeque* self )
+{
+    Py_ssize_t size = Py_TYPE( self )->tp_basicsize + self->allocated * sizeof( PyObject* );
+    return PyLong_FromSsize_t( size );
+}
+
+
+PyObject*
+AtomDeque_get_maxlen( AtomDeque* self, void* context )
+{
+    return PyLong_FromSsize_t( self->maxlen );
+}
+
+
+PyObject*
+AtomDeque_get_version( AtomDeque* self, void* context )
+{
+    return PyLong_FromUnsignedLongLong( self->version );
+}
+
+
+PyDoc_STRVAR(append_doc,
+"D.append(object) -- add object to the right end, evicting the leftmost item\n"
+"if the deque is full");
+PyDoc_STRVAR(appendleft_doc,
+"D.appendleft(object) -- add object to the left end, evicting the rightmost\n"
+"item if the deque is full");
+PyDoc_STRVAR(extend_doc,
+"D.extend(iterable) -- append the items of the iterable to the right end");
+PyDoc_STRVAR(pop_doc,
+"D.pop() -> item -- remove and return the rightmost item.\n"
+"Raises IndexError if the deque is empty.");
+PyDoc_STRVAR(popleft_doc,
+"D.popleft() -> item -- remove and return the leftmost item.\n"
+"Raises IndexError if the deque is empty.");
+PyDoc_STRVAR(clear_doc,
+"D.clear() -- remove all items");
+PyDoc_STRVAR(count_doc,
+"D.count(value) -> integer -- return number of occurrences of value");
+PyDoc_STRVAR(tolist_doc,
+"D.tolist() -> list -- return the items as a list");
+PyDoc_STRVAR(copy_doc,
+"D.copy() -> atomdeque -- return a copy not bound to any atom");
+
+
+static PyMethodDef
+AtomDeque_methods[] = {
+    { "append", ( PyCFunction )AtomDeque_append, METH_O, append_doc },
+    { "appendleft", ( PyCFunction )AtomDeque_appendleft, METH_O, appendleft_doc },
+    { "extend", ( PyCFunction )AtomDeque_extend, METH_O, extend_doc },
+    { "pop", ( PyCFunction )AtomDeque_pop, METH_NOARGS, pop_doc },
+    { "popleft", ( PyCFunction )AtomDeque_popleft, METH_NOARGS, popleft_doc },
+    { "clear", ( PyCFunction )AtomDeque_clear_items, METH_NOARGS, clear_doc },
+    { "count", ( PyCFunction )AtomDeque_count, METH_O, count_doc },
+    { "tolist", ( PyCFunction )AtomDeque_tolist, METH_NOARGS, tolist_doc },
+    { "copy", ( PyCFunction )AtomDeque_copy, METH_NOARGS, copy_doc },
+    { "__reduce__", ( PyCFunction )AtomDeque_reduce, METH_NOARGS, "" },
+    { "__sizeof__", ( PyCFunction )AtomDeque_sizeof, METH_NOARGS, "" },
+    { 0 }  /* sentinel */
+};
+
+
+static PyGetSetDef
+AtomDeque_getset[] = {
+    { "maxlen", ( getter )AtomDeque_get_maxlen, 0,
+      "The maximum number of items held by the deque." },
+    { "version", ( getter )AtomDeque_get_version, 0,
+      "A number drawn anew each time the deque is modified." },
+    { 0 }  // sentinel
+};
+
+
+static PyType_Slot AtomDeque_Type_slots[] = {
+    { Py_tp_new, void_cast( AtomDeque_new ) },                          /* tp_new */
+    { Py_tp_dealloc, void_cast( AtomDeque_dealloc ) },                  /* tp_dealloc */
+    { Py_tp_traverse, void_cast( AtomDeque_traverse ) },                /* tp_traverse */
+    { Py_tp_clear, void_cast( AtomDeque_clear ) },                      /* tp_clear */
+    { Py_tp_repr, void_cast( AtomDeque_repr ) },                        /* tp_repr */
+    { Py_tp_hash, void_cast( PyObject_HashNotImplemented ) },           /* tp_hash */
+    { Py_tp_richcompare, void_cast( AtomDeque_richcompare ) },          /* tp_richcompare */
+    { Py_tp_iter, void_cast( AtomDeque_iter ) },                        /* tp_iter */
+    { Py_tp_methods, void_cast( AtomDeque_methods ) },                  /* tp_methods */
+    { Py_tp_getset, void_cast( AtomDeque_getset ) },                    /* tp_getset */
+    { Py_sq_length, void_cast( AtomDeque_length ) },                    /* sq_length */
+    { Py_sq_item, void_cast( AtomDeque_item ) },                        /* sq_item */
+    { Py_sq_contains, void_cast( AtomDeque_contains ) },                /* sq_contains */
+    { 0, 0 },
+};
+
+
+}  // namespace
+
+
+PyTypeObject* AtomDeque::TypeObject = NULL;
+
+
+PyType_Spec AtomDeque::TypeObject_Spec = {
+    PACKAGE_TYPENAME( "atomdeque" ),            /* tp_name */
+    sizeof( AtomDeque ),                        /* tp_basicsize */
+    0,                                          /* tp_itemsize */
+    Py_TPFLAGS_DEFAULT
+    |Py_TPFLAGS_BASETYPE
+    |Py_TPFLAGS_HAVE_GC,                        /* tp_flags */
+    AtomDeque_Type_slots                        /* slots */
+};
+
+
+PyObject*
+AtomDeque::New( Py_ssize_t maxlen, CAtom* atom, Member* validator, Member* member )
+{
+    cppy::ptr ptr( PyType_GenericAlloc( AtomDeque::TypeObject, 0 ) );
+    if( !ptr )
+        return 0;  // LCOV_EXCL_LINE (failed instance creation)
+    AtomDeque* deque = atomdeque_cast( ptr.get() );
+    deque->maxlen = maxlen;
+    deque->pointer = new CAtomPointer( atom );
+    deque->validator = reinterpret_cast<Member*>( cppy::xincref( pyobject_cast( validator ) ) );
+    deque->member = reinterpret_cast<Member*>( cppy::xincref( pyobject_cast( member ) ) );
+    deque->touch();
+    return ptr.release();
+}
+
+
+int
+AtomDeque::Assign( AtomDeque* deque, PyObject* value, bool validate )
+{
+    cppy::ptr items( validate_items( deque, value, validate ) );
+    if( !items )
+        return -1;
+    Py_ssize_t size = PyList_GET_SIZE( items.get() );
+    Py_ssize_t start = std::max<Py_ssize_t>( 0, size - deque->maxlen );
+    for( Py_ssize_t i = start; i < size; ++i )
+    {
+        cppy::ptr evicted;
+        if( !push_back( deque, cppy::incref( PyList_GET_ITEM( items.get(), i ) ), evicted ) )
+            return -1;  // LCOV_EXCL_LINE
+    }
+    deque->touch();
+    // A verbatim copy holds the same items as its source.
+    if( AtomDeque::TypeCheck( value ) && start == 0 && !( validate && deque->validator ) )
+        deque->version = atomdeque_cast( value )->version;
+    return 0;
+}
+
+
+bool
+AtomDeque::Ready()
+{
+    AtomDequeIterator::TypeObject = pytype_cast( PyType_FromSpec( &AtomDequeIterator::TypeObject_Spec ) );
+    if( !AtomDequeIterator::TypeObject )
+    {
+        return false;  // LCOV_EXCL_LINE (failed type creation)
+    }
+    // The reference will be handled by the module to which we will add the type
+    TypeObject = pytype_cast( PyType_FromSpec( &TypeObject_Spec ) );
+    if( !TypeObject )
+    {
+        return false;  // LCOV_EXCL_LINE (failed type creation)
+    }
+    return true;
+}
+
+
+}  // namespace atom
@@ -0,0 +1,64 @@
+/*-----------------------------------------------------------------------------
+| Copyright (c) 2025, Nucleic Development Team.
+|
+| Distributed under the terms of the Modified BSD License.
+|
+| The full license is in the file LICENSE, distributed with this software.
+|----------------------------------------------------------------------------*/
+#pragma once
+#include <cppy/cppy.h>
+#include "catom.h"
+#include "catompointer.h"
+#include "containerversion.h"
+#include "member.h"
+
+
+#define atomdeque_cast( o ) ( reinterpret_cast<atom::AtomDeque*>( o ) )
+
+namespace atom
+{
+
+
+// POD struct - all member fields are considered private
+struct AtomDeque
+{
+    PyObject_HEAD
+    PyObject** items;  // circular buffer of allocated slots
+    Py_ssize_t head;  // slot of the first item
+    Py_ssize_t size;
+    Py_ssize_t allocated;  // grows on demand up to maxlen
+    Py_ssize_t maxlen;
+    CAtomPointer* pointer;
+    Member* validator;  // validator of the items, null if unvalidated
+    Member* member;  // member notified of the changes, null if standalone
+    uint64_t version;  // drawn anew on each modification
+
+    static PyType_Spec TypeObject_Spec;
+
+    static PyTypeObject* TypeObject;
+
+    static bool Ready();
+
+    // Create an empty deque holding at most maxlen items whose changes are
+    // notified by the given member.
+    static PyObject* New( Py_ssize_t maxlen, CAtom* atom, Member* validator, Member* member );
+
+    // Replace the content of an empty deque by the items of an iterable,
+    // keeping the last maxlen ones. The items are validated by the validator
+    // of the deque unless validate is false.
+    static int Assign( AtomDeque* deque, PyObject* value, bool validate );
+
+    void touch()
+    {
+        version = next_container_version();
+    }
+
+    static bool TypeCheck( PyObject* ob )
+    {
+        return PyObject_TypeCheck( ob, TypeObject ) != 0;
+    }
+
+};
+
+
+}  // namespace atom
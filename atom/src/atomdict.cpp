@@ -9,11 +9,41 @@
 #include <sstream>
 #include <cppy/cppy.h>
 #include "atomdict.h"
+#include "memberchange.h"
 #include "packagenaming.h"
 
 namespace atom
 {
 
+namespace DictMethods
+{
+    static PyObject* get;
+    static PyObject* keys;
+    static PyObject* values;
+    static PyObject* items;
+    static PyObject* pop;
+    static PyObject* popitem;
+    static PyObject* reversed;
+
+bool
+init_methods()
+{
+    get = PyObject_GetAttrString( pyobject_cast( &PyDict_Type ), "get" );
+    keys = PyObject_GetAttrString( pyobject_cast( &PyDict_Type ), "keys" );
+    values = PyObject_GetAttrString( pyobject_cast( &PyDict_Type ), "values" );
+    items = PyObject_GetAttrString( pyobject_cast( &PyDict_Type ), "items" );
+    pop = PyObject_GetAttrString( pyobject_cast( &PyDict_Type ), "pop" );
+    popitem = PyObject_GetAttrString( pyobject_cast( &PyDict_Type ), "popitem" );
+    reversed = PyObject_GetAttrString( pyobject_cast( &PyDict_Type ), "__reversed__" );
+    if( !get || !keys || !values || !items || !pop || !popitem || !reversed )
+    {
+        return false;  // LCOV_EXCL_LINE (failed to load dict methods, impossible)
+    }
+    return true;
+}
+
+}  // namespace DictMethods
+
 namespace
 {
 
@@ -57,6 +87,41 @@ PyObject* validate_value( AtomDict* dict, PyObject* value )
 }
 
 
+// Build a new dict holding the validated keys and values of a dict.
+PyObject* validate_dict( AtomDict* dict, PyObject* value )
+{
+	cppy::ptr validated_dict( PyDict_New() );
+	if( !validated_dict )
+	{
+		return 0;  // LCOV_EXCL_LINE (failed dict creation)
+	}
+	PyObject* key;
+	PyObject* val;
+	Py_ssize_t index = 0;
+	while( PyDict_Next( value, &index, &key, &val ) )
+	{
+        cppy::ptr key_ptr( validate_key( dict, key ) );
+		if( !key_ptr )
+		{
+			return 0;
+		}
+
+        cppy::ptr val_ptr( validate_value( dict, val ) );
+		if( !val_ptr )
+		{
+			return 0;
+		}
+
+        if( PyDict_SetItem( validated_dict.get(), key_ptr.get(), val_ptr.get() ) != 0 )
+        {
+            return 0;
+        }
+
+	}
+	return validated_dict.release();
+}
+
+
 int merge_items( PyObject* dict, PyObject* item, PyObject* kwargs )
 {
 	int ok = 0;
@@ -206,6 +271,178 @@ PyObject* AtomDict_update( AtomDict* dict, PyObject* args, PyObject* kwargs )
 }
 
 
+// Read access to a dict whose validation was deferred validates it first.
+inline bool ensure_validated( AtomDict* self )
+{
+	return !self->unvalidated || AtomDict::ValidateAll( self ) == 0;
+}
+
+
+PyObject* AtomDict_subscript( AtomDict* self, PyObject* key )
+{
+	if( !ensure_validated( self ) )
+	{
+		return 0;
+	}
+	return PyDict_Type.tp_as_mapping->mp_subscript( pyobject_cast( self ), key );
+}
+
+
+int AtomDict_contains( AtomDict* self, PyObject* key )
+{
+	if( !ensure_validated( self ) )
+	{
+		return -1;
+	}
+	return PyDict_Type.tp_as_sequence->sq_contains( pyobject_cast( self ), key );
+}
+
+
+PyObject* AtomDict_iter( AtomDict* self )
+{
+	if( !ensure_validated( self ) )
+	{
+		return 0;
+	}
+	return PyDict_Type.tp_iter( pyobject_cast( self ) );
+}
+
+
+PyObject* call_dict_method( AtomDict* self, PyObject* method, PyObject*const *args, Py_ssize_t nargs )
+{
+	if( !ensure_validated( self ) )
+	{
+		return 0;
+	}
+	PyObject* fargs[3] = { pyobject_cast( self ), 0, 0 };
+	if( nargs > 2 )
+	{
+		return cppy::type_error( "too many arguments" );
+	}
+	for( Py_ssize_t i = 0; i < nargs; ++i )
+	{
+		fargs[i + 1] = args[i];
+	}
+	return PyObject_Vectorcall( method, fargs, nargs + 1, 0 );
+}
+
+
+PyObject* AtomDict_get( AtomDict* self, PyObject*const *args, Py_ssize_t nargs )
+{
+	return call_dict_method( self, DictMethods::get, args, nargs );
+}
+
+
+PyObject* AtomDict_keys( AtomDict* self )
+{
+	return call_dict_method( self, DictMethods::keys, 0, 0 );
+}
+
+
+PyObject* AtomDict_values( AtomDict* self )
+{
+	return call_dict_method( self, DictMethods::values, 0, 0 );
+}
+
+
+PyObject* AtomDict_items( AtomDict* self )
+{
+	return call_dict_method( self, DictMethods::items, 0, 0 );
+}
+
+
+PyObject* AtomDict_reversed( AtomDict* self )
+{
+	return call_dict_method( self, DictMethods::reversed, 0, 0 );
+}
+
+
+PyObject* AtomDict_repr( AtomDict* self )
+{
+	if( !ensure_validated( self ) )
+	{
+		return 0;
+	}
+	return PyDict_Type.tp_repr( pyobject_cast( self ) );
+}
+
+
+PyObject* AtomDict_richcompare( AtomDict* self, PyObject* other, int op )
+{
+	if( !ensure_validated( self ) )
+	{
+		return 0;
+	}
+	if( AtomDict::TypeCheck( other ) && !ensure_validated( atomdict_cast( other ) ) )
+	{
+		return 0;
+	}
+	return PyDict_Type.tp_richcompare( pyobject_cast( self ), other, op );
+}
+
+
+PyObject* AtomDict_or( PyObject* left, PyObject* right )
+{
+	if( AtomDict::TypeCheck( left ) && !ensure_validated( atomdict_cast( left ) ) )
+	{
+		return 0;
+	}
+	if( AtomDict::TypeCheck( right ) && !ensure_validated( atomdict_cast( right ) ) )
+	{
+		return 0;
+	}
+	return PyDict_Type.tp_as_number->nb_or( left, right );
+}
+
+
+// The attributes which do not read the items of the dict. Accessing any
+// other attribute, such as the inherited copy, pop or setdefault methods,
+// validates the deferred items first.
+bool is_lazy_dict_attribute( PyObject* name )
+{
+	static const char* names[] = {
+		"validated", "validate_all", "update", "clear", 0
+	};
+	for( const char** it = names; *it; ++it )
+	{
+		if( PyUnicode_CompareWithASCIIString( name, *it ) == 0 )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+PyObject* AtomDict_getattro( AtomDict* self, PyObject* name )
+{
+	if( self->unvalidated && PyUnicode_Check( name ) && !is_lazy_dict_attribute( name ) )
+	{
+		if( AtomDict::ValidateAll( self ) < 0 )
+		{
+			return 0;
+		}
+	}
+	return PyObject_GenericGetAttr( pyobject_cast( self ), name );
+}
+
+
+PyObject* AtomDict_validate_all( AtomDict* self )
+{
+	if( !ensure_validated( self ) )
+	{
+		return 0;
+	}
+	return cppy::incref( Py_None );
+}
+
+
+PyObject* AtomDict_get_validated( AtomDict* self, void* ctxt )
+{
+	return cppy::incref( self->unvalidated ? Py_False : Py_True );
+}
+
+
 static PyMethodDef AtomDict_methods[] = {
 	{ "setdefault",
 		( PyCFunction )AtomDict_setdefault,
@@ -215,18 +452,61 @@ static PyMethodDef AtomDict_methods[] = {
 		( PyCFunction )AtomDict_update,
 		METH_VARARGS | METH_KEYWORDS,
 		"D.update([E, ]**F) -> None. Update D from dict/iterable E and F" },
+	{ "get",
+		( PyCFunction )AtomDict_get,
+		METH_FASTCALL,
+		"D.get(k[,d]) -> D[k] if k in D, else d. d defaults to None" },
+	{ "keys",
+		( PyCFunction )AtomDict_keys,
+		METH_NOARGS,
+		"D.keys() -> a set-like object providing a view on D's keys" },
+	{ "values",
+		( PyCFunction )AtomDict_values,
+		METH_NOARGS,
+		"D.values() -> an object providing a view on D's values" },
+	{ "items",
+		( PyCFunction )AtomDict_items,
+		METH_NOARGS,
+		"D.items() -> a set-like object providing a view on D's items" },
+	{ "__reversed__",
+		( PyCFunction )AtomDict_reversed,
+		METH_NOARGS,
+		"Return a reverse iterator over the dict keys." },
+	{ "validate_all",
+		( PyCFunction )AtomDict_validate_all,
+		METH_NOARGS,
+		"D.validate_all() -> None. Validate the items whose validation was deferred" },
+	{ 0 } // sentinel
+};
+
+
+static PyGetSetDef AtomDict_getset[] = {
+	{ "validated",
+		( getter )AtomDict_get_validated,
+		0,
+		"Whether all the items of the dict have been validated. A dict outliving "
+		"its atom stays unvalidated." },
 	{ 0 } // sentinel
 };
 
 
 static PyType_Slot AtomDict_Type_slots[] = {
     { Py_tp_dealloc, void_cast( AtomDict_dealloc ) },              /* tp_dealloc */
+    { Py_mp_subscript, void_cast( AtomDict_subscript ) },          /* mp_subscript */
     { Py_mp_ass_subscript, void_cast( AtomDict_ass_subscript ) },  /* mp_ass_subscript */
+    { Py_sq_contains, void_cast( AtomDict_contains ) },            /* sq_contains */
+    { Py_tp_iter, void_cast( AtomDict_iter ) },                    /* tp_iter */
     { Py_tp_traverse, void_cast( AtomDict_traverse ) },            /* tp_traverse */
     { Py_tp_clear, void_cast( AtomDict_clear ) },                  /* tp_clear */
     { Py_tp_methods, void_cast( AtomDict_methods ) },              /* tp_methods */
+    { Py_tp_getset, void_cast( AtomDict_getset ) },                /* tp_getset */
     { Py_tp_base, void_cast( &PyDict_Type ) },                     /* tp_base */
     { Py_tp_new, void_cast( AtomDict_new ) },                      /* tp_new */
+    { Py_nb_or, void_cast( AtomDict_or ) },                        /* nb_or */
+    { Py_tp_getattro, void_cast( AtomDict_getattro ) },            /* tp_getattro */
+    { Py_tp_repr, void_cast( AtomDict_repr ) },                    /* tp_repr */
+    { Py_tp_richcompare, void_cast( AtomDict_richcompare ) },      /* tp_richcompare */
+    { Py_tp_hash, void_cast( PyObject_HashNotImplemented ) },      /* tp_hash */
     { 0, 0 },
 };
 
@@ -264,7 +544,7 @@ static PyObject* DefaultAtomDict_repr( DefaultAtomDict* self )
 	}
 	ostr << PyUnicode_AsUTF8( repr.get() );
 	ostr << ", ";
-	repr = PyDict_Type.tp_repr( pyobject_cast( self ) );
+	repr = AtomDict_repr( atomdict_cast( self ) );
 	if( !repr )
 	{
 		return 0;
@@ -332,6 +612,326 @@ static PyType_Slot DefaultAtomDict_Type_slots[] = {
 };
 
 
+// AtomCDict
+
+int AtomCDict_clear( AtomCDict* self )
+{
+	Py_CLEAR( self->member );
+	return AtomDict_clear( atomdict_cast( self ) );
+}
+
+
+int AtomCDict_traverse( AtomCDict* self, visitproc visit, void* arg )
+{
+	Py_VISIT( self->member );
+	return AtomDict_traverse( atomdict_cast( self ), visit, arg );
+}
+
+
+void AtomCDict_dealloc( AtomCDict* self )
+{
+	cppy::clear( &self->member );
+	AtomDict_dealloc( atomdict_cast( self ) );
+}
+
+
+// Whether the changes of the dict are observed. The atom is returned in atom.
+bool observed( AtomCDict* self, CAtom*& atom )
+{
+	atom = self->dict.pointer->data();
+	return self->member && atom && MemberChange::container_observed( atom, self->member );
+}
+
+
+// Notify a change of the dict carrying up to three payload entries.
+bool post_change(
+	AtomCDict* self,
+	CAtom* atom,
+	ContainerOp::Op operation,
+	const char* key,
+	PyObject* value,
+	const char* key2 = 0,
+	PyObject* value2 = 0,
+	const char* key3 = 0,
+	PyObject* value3 = 0 )
+{
+	cppy::ptr change( MemberChange::container( atom, self->member, pyobject_cast( self ), operation ) );
+	if( !change )
+	{
+		return false;
+	}
+	if( key && PyDict_SetItemString( change.get(), key, value ) != 0 )
+	{
+		return false;
+	}
+	if( key2 && PyDict_SetItemString( change.get(), key2, value2 ) != 0 )
+	{
+		return false;
+	}
+	if( key3 && PyDict_SetItemString( change.get(), key3, value3 ) != 0 )
+	{
+		return false;
+	}
+	return MemberChange::notify_container( atom, self->member, change.get() );
+}
+
+
+int AtomCDict_ass_subscript( AtomCDict* self, PyObject* key, PyObject* value )
+{
+	CAtom* atom;
+	if( !observed( self, atom ) )
+	{
+		return AtomDict_ass_subscript( atomdict_cast( self ), key, value );
+	}
+	PyObject* pyself = pyobject_cast( self );
+	if( !value )
+	{
+		cppy::ptr olditem( cppy::xincref( PyDict_GetItemWithError( pyself, key ) ) );
+		if( !olditem && PyErr_Occurred() )
+		{
+			return -1;
+		}
+		if( PyDict_Type.tp_as_mapping->mp_ass_subscript( pyself, key, 0 ) < 0 )
+		{
+			return -1;
+		}
+		return post_change( self, atom, ContainerOp::DelItem, "key", key, "item", olditem.get() ) ? 0 : -1;
+	}
+	cppy::ptr key_ptr( validate_key( atomdict_cast( self ), key ) );
+	if( !key_ptr )
+	{
+		return -1;
+	}
+	cppy::ptr value_ptr( validate_value( atomdict_cast( self ), value ) );
+	if( !value_ptr )
+	{
+		return -1;
+	}
+	cppy::ptr olditem( cppy::xincref( PyDict_GetItemWithError( pyself, key_ptr.get() ) ) );
+	if( !olditem && PyErr_Occurred() )
+	{
+		return -1;
+	}
+	if( PyDict_SetItem( pyself, key_ptr.get(), value_ptr.get() ) < 0 )
+	{
+		return -1;
+	}
+	if( olditem == value_ptr )
+	{
+		return 0;
+	}
+	bool ok = olditem ?
+		post_change( self, atom, ContainerOp::SetItem, "key", key_ptr.get(), "olditem", olditem.get(), "newitem", value_ptr.get() ) :
+		post_change( self, atom, ContainerOp::SetItem, "key", key_ptr.get(), "newitem", value_ptr.get() );
+	return ok ? 0 : -1;
+}
+
+
+PyObject* AtomCDict_setdefault( AtomCDict* self, PyObject* args )
+{
+	PyObject* key;
+	PyObject* dfv = Py_None;
+	if( !PyArg_UnpackTuple( args, "setdefault", 1, 2, &key, &dfv ) )
+	{
+		return 0;
+	}
+	PyObject* value = PyDict_GetItem( pyobject_cast( self ), key );
+	if( value )
+	{
+		return cppy::incref( value );
+	}
+	if( AtomCDict_ass_subscript( self, key, dfv ) < 0 )
+	{
+		return 0;
+	}
+	// Get the dictionary from the dict itself in case it was coerced.
+	return cppy::incref( PyDict_GetItem( pyobject_cast( self ), key ) );
+}
+
+
+// Merge validated items and notify them along with the values they replaced.
+bool update_items( AtomCDict* self, PyObject* item, PyObject* kwargs, ContainerOp::Op operation )
+{
+	cppy::ptr temp( PyDict_New() );
+	if( !temp )
+	{
+		return false;
+	}
+	if( merge_items( temp.get(), item, kwargs ) < 0 )
+	{
+		return false;
+	}
+	if( should_validate( atomdict_cast( self ) ) )
+	{
+		temp = validate_dict( atomdict_cast( self ), temp.get() );
+		if( !temp )
+		{
+			return false;
+		}
+	}
+	CAtom* atom;
+	if( PyDict_GET_SIZE( temp.get() ) == 0 || !observed( self, atom ) )
+	{
+		return PyDict_Update( pyobject_cast( self ), temp.get() ) == 0;
+	}
+	cppy::ptr olditems( PyDict_New() );
+	if( !olditems )
+	{
+		return false;
+	}
+	PyObject* key;
+	PyObject* val;
+	Py_ssize_t index = 0;
+	while( PyDict_Next( temp.get(), &index, &key, &val ) )
+	{
+		PyObject* olditem = PyDict_GetItemWithError( pyobject_cast( self ), key );
+		if( !olditem && PyErr_Occurred() )
+		{
+			return false;
+		}
+		if( olditem && PyDict_SetItem( olditems.get(), key, olditem ) < 0 )
+		{
+			return false;
+		}
+	}
+	if( PyDict_Update( pyobject_cast( self ), temp.get() ) < 0 )
+	{
+		return false;
+	}
+	return post_change( self, atom, operation, "items", temp.get(), "olditems", olditems.get() );
+}
+
+
+PyObject* AtomCDict_update( AtomCDict* self, PyObject* args, PyObject* kwargs )
+{
+	PyObject* item = 0;
+	if( !PyArg_UnpackTuple( args, "update", 0, 1, &item ) )
+	{
+		return 0;
+	}
+	if( !update_items( self, item, kwargs, ContainerOp::Update ) )
+	{
+		return 0;
+	}
+	return cppy::incref( Py_None );
+}
+
+
+PyObject* AtomCDict_ior( AtomCDict* self, PyObject* other )
+{
+	if( !update_items( self, other, 0, ContainerOp::Ior ) )
+	{
+		return 0;
+	}
+	return cppy::incref( pyobject_cast( self ) );
+}
+
+
+PyObject* AtomCDict_pop( AtomCDict* self, PyObject*const *args, Py_ssize_t nargs )
+{
+	Py_ssize_t size = PyDict_GET_SIZE( pyobject_cast( self ) );
+	if( nargs < 1 || nargs > 2 )
+	{
+		return cppy::type_error( "pop expected 1 or 2 arguments" );
+	}
+	PyObject* fargs[3] = { pyobject_cast( self ), args[0], nargs > 1 ? args[1] : 0 };
+	cppy::ptr res( PyObject_Vectorcall( DictMethods::pop, fargs, nargs + 1, 0 ) );
+	if( !res )
+	{
+		return 0;
+	}
+	CAtom* atom;
+	if( PyDict_GET_SIZE( pyobject_cast( self ) ) != size && observed( self, atom ) )
+	{
+		if( !post_change( self, atom, ContainerOp::Pop, "key", args[0], "item", res.get() ) )
+		{
+			return 0;
+		}
+	}
+	return res.release();
+}
+
+
+PyObject* AtomCDict_popitem( AtomCDict* self )
+{
+	PyObject* fargs[1] = { pyobject_cast( self ) };
+	cppy::ptr res( PyObject_Vectorcall( DictMethods::popitem, fargs, 1, 0 ) );
+	if( !res )
+	{
+		return 0;
+	}
+	CAtom* atom;
+	if( observed( self, atom ) )
+	{
+		PyObject* key = PyTuple_GET_ITEM( res.get(), 0 );
+		PyObject* item = PyTuple_GET_ITEM( res.get(), 1 );
+		if( !post_change( self, atom, ContainerOp::PopItem, "key", key, "item", item ) )
+		{
+			return 0;
+		}
+	}
+	return res.release();
+}
+
+
+PyObject* AtomCDict_clear_items( AtomCDict* self )
+{
+	CAtom* atom;
+	cppy::ptr items;
+	if( PyDict_GET_SIZE( pyobject_cast( self ) ) > 0 && observed( self, atom ) )
+	{
+		items = PyDict_Copy( pyobject_cast( self ) );
+		if( !items )
+		{
+			return 0;
+		}
+	}
+	PyDict_Clear( pyobject_cast( self ) );
+	if( items && !post_change( self, atom, ContainerOp::Clear, "items", items.get() ) )
+	{
+		return 0;
+	}
+	return cppy::incref( Py_None );
+}
+
+
+static PyMethodDef AtomCDict_methods[] = {
+	{ "setdefault",
+		( PyCFunction )AtomCDict_setdefault,
+		METH_VARARGS,
+		"D.setdefault(k[,d]) -> D.get(k,d), also set D[k]=d if k not in D" },
+	{ "update",
+		( PyCFunction )AtomCDict_update,
+		METH_VARARGS | METH_KEYWORDS,
+		"D.update([E, ]**F) -> None. Update D from dict/iterable E and F" },
+	{ "pop",
+		( PyCFunction )AtomCDict_pop,
+		METH_FASTCALL,
+		"D.pop(k[,d]) -> v, remove specified key and return the corresponding value" },
+	{ "popitem",
+		( PyCFunction )AtomCDict_popitem,
+		METH_NOARGS,
+		"D.popitem() -> (k, v), remove and return the last inserted item" },
+	{ "clear",
+		( PyCFunction )AtomCDict_clear_items,
+		METH_NOARGS,
+		"D.clear() -> None. Remove all items from D" },
+	{ 0 } // sentinel
+};
+
+
+static PyType_Slot AtomCDict_Type_slots[] = {
+    { Py_tp_dealloc, void_cast( AtomCDict_dealloc ) },              /* tp_dealloc */
+    { Py_tp_traverse, void_cast( AtomCDict_traverse ) },            /* tp_traverse */
+    { Py_tp_clear, void_cast( AtomCDict_clear ) },                  /* tp_clear */
+    { Py_tp_methods, void_cast( AtomCDict_methods ) },              /* tp_methods */
+    { Py_mp_ass_subscript, void_cast( AtomCDict_ass_subscript ) },  /* mp_ass_subscript */
+    { Py_nb_inplace_or, void_cast( AtomCDict_ior ) },               /* nb_inplace_or */
+    /* tp_base cannot be set at this stage */
+    { 0, 0 },
+};
+
+
 } // namespace
 
 
@@ -369,33 +969,11 @@ PyObject* AtomDict::New( CAtom* atom, Member* key_validator, Member* value_valid
 
 int AtomDict::Update( AtomDict* dict, PyObject* value )
 {
-	cppy::ptr validated_dict( PyDict_New() );
-	PyObject* key;
-	PyObject* val;
-	Py_ssize_t index = 0;
-	while( PyDict_Next( value, &index, &key, &val ) )
+	cppy::ptr validated_dict( validate_dict( dict, value ) );
+	if( !validated_dict )
 	{
-        cppy::ptr key_ptr( cppy::incref( key ) );
-        key_ptr = validate_key( dict, key_ptr.get() );
-		if( !key_ptr )
-		{
-			return -1;
-		}
-
-        cppy::ptr val_ptr( cppy::incref( val ) );
-        val_ptr = validate_value( dict, val_ptr.get() );
-		if( !val_ptr )
-		{
-			return -1;
-		}
-
-        if( PyDict_SetItem( validated_dict.get(), key_ptr.get(), val_ptr.get() ) != 0 )
-        {
-            return -1;
-        }
-
+		return -1;
 	}
-
 	if( PyDict_Update( pyobject_cast( dict ), validated_dict.get() ) < 0 )
 	{
 		return -1;
@@ -405,8 +983,76 @@ int AtomDict::Update( AtomDict* dict, PyObject* value )
 }
 
 
+int AtomDict::UpdateUnvalidated( AtomDict* dict, PyObject* value )
+{
+	if( PyDict_Update( pyobject_cast( dict ), value ) < 0 )
+	{
+		return -1;
+	}
+	dict->unvalidated = PyDict_GET_SIZE( pyobject_cast( dict ) ) > 0;
+	return 0;
+}
+
+
+int AtomDict::ValidateAll( AtomDict* dict )
+{
+	// Reads made by the validators see the items as they stand.
+	if( dict->validating )
+	{
+		return 0;
+	}
+	// The items of a dict outliving its atom cannot be validated.
+	if( !dict->pointer->data() )
+	{
+		return 0;
+	}
+	if( !should_validate( dict ) )
+	{
+		dict->unvalidated = false;
+		return 0;
+	}
+	cppy::ptr validated_dict( PyDict_New() );
+	if( !validated_dict )
+	{
+		return -1;  // LCOV_EXCL_LINE (failed dict creation)
+	}
+	cppy::ptr items( PyDict_Items( pyobject_cast( dict ) ) );
+	if( !items )
+	{
+		return -1;  // LCOV_EXCL_LINE (failed list creation)
+	}
+	dict->validating = true;
+	bool keys_changed = false;
+	Py_ssize_t size = PyList_GET_SIZE( items.get() );
+	for( Py_ssize_t i = 0; i < size; ++i )
+	{
+		PyObject* item = PyList_GET_ITEM( items.get(), i );
+		PyObject* key = PyTuple_GET_ITEM( item, 0 );
+		cppy::ptr key_ptr( validate_key( dict, key ) );
+		cppy::ptr val_ptr( key_ptr ? validate_value( dict, PyTuple_GET_ITEM( item, 1 ) ) : 0 );
+		if( !val_ptr || PyDict_SetItem( validated_dict.get(), key_ptr.get(), val_ptr.get() ) != 0 )
+		{
+			dict->validating = false;
+			return -1;
+		}
+		keys_changed |= key_ptr.get() != key;
+	}
+	dict->validating = false;
+	dict->unvalidated = false;
+	// Rebuild the dict if a key was coerced to preserve the items order.
+	if( keys_changed )
+	{
+		PyDict_Clear( pyobject_cast( dict ) );
+	}
+	return PyDict_Update( pyobject_cast( dict ), validated_dict.get() );
+}
+
+
 bool AtomDict::Ready()
 {
+	if( !DictMethods::init_methods() ) {
+        return false;  // LCOV_EXCL_LINE (failed method lookup, impossible)
+    }
     // The reference will be handled by the module to which we will add the type
 	TypeObject = pytype_cast( PyType_FromSpec( &TypeObject_Spec ) );
     if( !TypeObject )
@@ -468,4 +1114,58 @@ bool DefaultAtomDict::Ready()
 }
 
 
+// Initialize static variables (otherwise the compiler eliminates them)
+PyTypeObject* AtomCDict::TypeObject = NULL;
+
+
+PyType_Spec AtomCDict::TypeObject_Spec = {
+	PACKAGE_TYPENAME( "atomcdict" ),            /* tp_name */
+	sizeof( AtomCDict ),                        /* tp_basicsize */
+	0,                                          /* tp_itemsize */
+	Py_TPFLAGS_DEFAULT
+	| Py_TPFLAGS_BASETYPE
+	| Py_TPFLAGS_HAVE_GC
+	| Py_TPFLAGS_HAVE_VERSION_TAG,              /* tp_flags */
+    AtomCDict_Type_slots                        /* slots */
+};
+
+
+PyObject* AtomCDict::New( CAtom* atom, Member* key_validator, Member* value_validator, Member* member )
+{
+    cppy::ptr self( PyDict_Type.tp_new( AtomCDict::TypeObject, 0, 0 ) );
+	if( !self )
+	{
+		return 0;  // LCOV_EXCL_LINE (failed instance creation)
+	}
+    cppy::xincref( pyobject_cast( key_validator ) );
+    atomdict_cast( self.get() )->m_key_validator = key_validator;
+    cppy::xincref( pyobject_cast( value_validator ) );
+    atomdict_cast( self.get() )->m_value_validator = value_validator;
+    atomdict_cast( self.get() )->pointer = new CAtomPointer( atom );
+    cppy::xincref( pyobject_cast( member ) );
+    atomcdict_cast( self.get() )->member = member;
+    return self.release();
+}
+
+
+bool AtomCDict::Ready()
+{
+	// This will work only if we create this type after the standard AtomDict
+    // The reference will be handled by the module to which we will add the type
+	cppy::ptr bases( PyTuple_Pack( 1, pyobject_cast( AtomDict::TypeObject ) ) );
+	if( !bases )
+	{
+        return false;  // LCOV_EXCL_LINE (failed tuple creation)
+	}
+	TypeObject = pytype_cast(
+		PyType_FromSpecWithBases( &TypeObject_Spec, bases.get() )
+	);
+    if( !TypeObject )
+    {
+        return false;  // LCOV_EXCL_LINE (failed type creation)
+    }
+    return true;
+}
+
+
 } // namespace atom
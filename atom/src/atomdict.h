@@ -14,6 +14,7 @@
 
 #define atomdict_cast( o ) ( reinterpret_cast<atom::AtomDict*>( o ) )
 #define defaultatomdict_cast( o ) ( reinterpret_cast<atom::DefaultAtomDict*>( o ) )
+#define atomcdict_cast( o ) ( reinterpret_cast<atom::AtomCDict*>( o ) )
 
 
 namespace atom
@@ -26,6 +27,8 @@ struct AtomDict
 	Member* m_key_validator;
 	Member* m_value_validator;
     CAtomPointer* pointer;
+    bool unvalidated;
+    bool validating;  // a deferred validation is running
 
 	static PyType_Spec TypeObject_Spec;
 
@@ -37,6 +40,12 @@ struct AtomDict
 
     static int Update( AtomDict* dict, PyObject* value );
 
+    // Update the dict without validating the items, which are validated on
+    // first access or when calling ValidateAll.
+    static int UpdateUnvalidated( AtomDict* dict, PyObject* value );
+
+    static int ValidateAll( AtomDict* dict );
+
     static bool TypeCheck( PyObject* ob )
 	{
 		return PyObject_TypeCheck( ob, TypeObject ) != 0;
@@ -67,4 +76,27 @@ struct DefaultAtomDict
 
 };
 
+// POD struct - all member fields are considered private
+struct AtomCDict
+{
+	AtomDict dict;
+	Member* member;
+
+	static PyType_Spec TypeObject_Spec;
+
+    static PyTypeObject* TypeObject;
+
+	static bool Ready();
+
+    static PyObject* New(
+		CAtom* atom, Member* key_validator, Member* value_validator, Member* member
+	);
+
+    static bool TypeCheck( PyObject* ob )
+	{
+		return PyObject_TypeCheck( ob, TypeObject ) != 0;
+	}
+
+};
+
 } // namespace atom
@@ -0,0 +1,1417 @@
+/*-----------------------------------------------------------------------------
+| Copyright (c) 2025, Nucleic Development Team.
+|
+| Distributed under the terms of the Modified BSD License.
+|
+| The full license is in the file LICENSE, distributed with this software.
+|----------------------------------------------------------------------------*/
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <cppy/cppy.h>
+#include "atomintset.h"
+#include "memberchange.h"
+#include "packagenaming.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wdeprecated-writable-strings"
+#endif
+
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#endif
+
+namespace atom
+{
+
+
+namespace
+{
+
+inline int
+popcount( uint64_t word )
+{
+#ifdef _MSC_VER
+    return static_cast<int>( __popcnt64( word ) );
+#else
+    return __builtin_popcountll( word );
+#endif
+}
+
+
+inline int
+trailing_zeros( uint64_t word )
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64( &index, word );
+    return static_cast<int>( index );
+#else
+    return __builtin_ctzll( word );
+#endif
+}
+
+}  // namespace
+
+
+// The values are split by their high 16 bits into chunks holding their low
+// 16 bits. A chunk stores a sorted array while it holds at most ArrayMax
+// values and a bitmap of 65536 bits past that, so that no chunk takes more
+// than 8kB. Chunks are always normalized so that equal sets share the same
+// representation.
+class IntBitmap
+{
+
+public:
+
+    enum Op { Or, And, Sub, Xor };
+
+    static const uint32_t ArrayMax = 4096;
+
+    static const size_t Words = 1024;
+
+    struct Chunk
+    {
+        uint16_t key;
+        uint32_t count;
+        std::vector<uint16_t> values;  // sorted values of a sparse chunk
+        std::vector<uint64_t> words;  // bits of a dense chunk
+
+        bool dense() const
+        {
+            return !words.empty();
+        }
+
+        bool contains( uint16_t value ) const
+        {
+            if( dense() )
+                return ( words[ value >> 6 ] >> ( value & 63 ) ) & 1;
+            return std::binary_search( values.begin(), values.end(), value );
+        }
+
+        bool add( uint16_t value )
+        {
+            if( dense() )
+            {
+                uint64_t& word = words[ value >> 6 ];
+                uint64_t bit = uint64_t( 1 ) << ( value & 63 );
+                if( word & bit )
+                    return false;
+                word |= bit;
+                ++count;
+                return true;
+            }
+            auto it = std::lower_bound( values.begin(), values.end(), value );
+            if( it != values.end() && *it == value )
+                return false;
+            values.insert( it, value );
+            ++count;
+            normalize();
+            return true;
+        }
+
+        bool remove( uint16_t value )
+        {
+            if( dense() )
+            {
+                uint64_t& word = words[ value >> 6 ];
+                uint64_t bit = uint64_t( 1 ) << ( value & 63 );
+                if( !( word & bit ) )
+                    return false;
+                word &= ~bit;
+                --count;
+                normalize();
+                return true;
+            }
+            auto it = std::lower_bound( values.begin(), values.end(), value );
+            if( it == values.end() || *it != value )
+                return false;
+            values.erase( it );
+            --count;
+            return true;
+        }
+
+        uint16_t first() const
+        {
+            if( !dense() )
+                return values.front();
+            size_t i = 0;
+            while( !words[ i ] )
+                ++i;
+            return static_cast<uint16_t>( i * 64 + trailing_zeros( words[ i ] ) );
+        }
+
+        void to_words( std::vector<uint64_t>& out ) const
+        {
+            if( dense() )
+            {
+                out = words;
+                return;
+            }
+            out.assign( Words, 0 );
+            for( uint16_t value : values )
+                out[ value >> 6 ] |= uint64_t( 1 ) << ( value & 63 );
+        }
+
+        // Switch to the representation matching the count.
+        void normalize()
+        {
+            if( dense() && count <= ArrayMax )
+            {
+                values.clear();
+                values.reserve( count );
+                for( size_t i = 0; i < Words; ++i )
+                {
+                    uint64_t word = words[ i ];
+                    while( word )
+                    {
+                        values.push_back( static_cast<uint16_t>( i * 64 + trailing_zeros( word ) ) );
+                        word &= word - 1;
+                    }
+                }
+                std::vector<uint64_t>().swap( words );
+            }
+            else if( !dense() && count > ArrayMax )
+            {
+                to_words( words );
+                std::vector<uint16_t>().swap( values );
+            }
+        }
+
+        bool operator==( const Chunk& other ) const
+        {
+            return key == other.key && count == other.count &&
+                values == other.values && words == other.words;
+        }
+
+        size_t memory() const
+        {
+            return values.capacity() * sizeof( uint16_t ) + words.capacity() * sizeof( uint64_t );
+        }
+    };
+
+    IntBitmap() : m_size( 0 ) {}
+
+    uint64_t size() const
+    {
+        return m_size;
+    }
+
+    const std::vector<Chunk>& chunks() const
+    {
+        return m_chunks;
+    }
+
+    bool contains( uint32_t value ) const
+    {
+        const Chunk* chunk = find( value >> 16 );
+        return chunk && chunk->contains( value & 0xFFFF );
+    }
+
+    bool add( uint32_t value )
+    {
+        uint16_t key = value >> 16;
+        auto it = lower_bound( key );
+        if( it == m_chunks.end() || it->key != key )
+        {
+            it = m_chunks.insert( it, Chunk() );
+            it->key = key;
+            it->count = 0;
+        }
+        if( !it->add( value & 0xFFFF ) )
+            return false;
+        ++m_size;
+        return true;
+    }
+
+    bool remove( uint32_t value )
+    {
+        uint16_t key = value >> 16;
+        auto it = lower_bound( key );
+        if( it == m_chunks.end() || it->key != key || !it->remove( value & 0xFFFF ) )
+            return false;
+        if( it->count == 0 )
+            m_chunks.erase( it );
+        --m_size;
+        return true;
+    }
+
+    // The smallest value, the set must not be empty.
+    uint32_t first() const
+    {
+        const Chunk& chunk = m_chunks.front();
+        return ( uint32_t( chunk.key ) << 16 ) | chunk.first();
+    }
+
+    void clear()
+    {
+        m_chunks.clear();
+        m_size = 0;
+    }
+
+    bool operator==( const IntBitmap& other ) const
+    {
+        return m_size == other.m_size && m_chunks == other.m_chunks;
+    }
+
+    // Whether every value of this set belongs to other.
+    bool is_subset( const IntBitmap& other ) const
+    {
+        if( m_size > other.m_size )
+            return false;
+        for( const Chunk& chunk : m_chunks )
+        {
+            const Chunk* peer = other.find( chunk.key );
+            if( !peer || chunk.count > peer->count )
+                return false;
+            if( combine_chunks( chunk, *peer, And ).count != chunk.count )
+                return false;
+        }
+        return true;
+    }
+
+    size_t memory() const
+    {
+        size_t total = m_chunks.capacity() * sizeof( Chunk );
+        for( const Chunk& chunk : m_chunks )
+            total += chunk.memory();
+        return total;
+    }
+
+    // Combine two sets chunk by chunk, out must be distinct from a and b.
+    static void combine( const IntBitmap& a, const IntBitmap& b, Op op, IntBitmap& out )
+    {
+        out.clear();
+        auto first = a.m_chunks.begin();
+        auto second = b.m_chunks.begin();
+        while( first != a.m_chunks.end() || second != b.m_chunks.end() )
+        {
+            bool has_first = first != a.m_chunks.end() &&
+                ( second == b.m_chunks.end() || first->key <= second->key );
+            bool has_second = second != b.m_chunks.end() &&
+                ( first == a.m_chunks.end() || second->key <= first->key );
+            if( has_first && has_second )
+                out.push( combine_chunks( *first++, *second++, op ) );
+            else if( has_first )
+            {
+                if( op != And )
+                    out.push( *first );
+                ++first;
+            }
+            else
+            {
+                if( op == Or || op == Xor )
+                    out.push( *second );
+                ++second;
+            }
+        }
+    }
+
+private:
+
+    std::vector<Chunk>::iterator lower_bound( uint16_t key )
+    {
+        return std::lower_bound(
+            m_chunks.begin(), m_chunks.end(), key,
+            []( const Chunk& chunk, uint16_t k ) { return chunk.key < k; }
+        );
+    }
+
+    const Chunk* find( uint16_t key ) const
+    {
+        auto it = std::lower_bound(
+            m_chunks.begin(), m_chunks.end(), key,
+            []( const Chunk& chunk, uint16_t k ) { return chunk.key < k; }
+        );
+        return it != m_chunks.end() && it->key == key ? &*it : 0;
+    }
+
+    void push( const Chunk& chunk )
+    {
+        if( chunk.count == 0 )
+            return;
+        m_chunks.push_back( chunk );
+        m_size += chunk.count;
+    }
+
+    static Chunk combine_chunks( const Chunk& a, const Chunk& b, Op op )
+    {
+        Chunk res;
+        res.key = a.key;
+        if( !a.dense() && !b.dense() )
+        {
+            auto out = std::back_inserter( res.values );
+            auto a0 = a.values.begin(), a1 = a.values.end();
+            auto b0 = b.values.begin(), b1 = b.values.end();
+            switch( op )
+            {
+                case Or:
+                    std::set_union( a0, a1, b0, b1, out );
+                    break;
+                case And:
+                    std::set_intersection( a0, a1, b0, b1, out );
+                    break;
+                case Sub:
+                    std::set_difference( a0, a1, b0, b1, out );
+                    break;
+                default:
+                    std::set_symmetric_difference( a0, a1, b0, b1, out );
+                    break;
+            }
+            res.count = static_cast<uint32_t>( res.values.size() );
+            res.normalize();
+            return res;
+        }
+        // Filtering a sparse chunk avoids expanding it.
+        if( !a.dense() && ( op == And || op == Sub ) )
+        {
+            for( uint16_t value : a.values )
+            {
+                if( b.contains( value ) == ( op == And ) )
+                    res.values.push_back( value );
+            }
+            res.count = static_cast<uint32_t>( res.values.size() );
+            return res;
+        }
+        if( op == And && !b.dense() )
+            return combine_chunks( b, a, op );
+        std::vector<uint64_t> other;
+        a.to_words( res.words );
+        b.to_words( other );
+        uint32_t count = 0;
+        for( size_t i = 0; i < Words; ++i )
+        {
+            uint64_t& word = res.words[ i ];
+            switch( op )
+            {
+                case Or:
+                    word |= other[ i ];
+                    break;
+                case And:
+                    word &= other[ i ];
+                    break;
+                case Sub:
+                    word &= ~other[ i ];
+                    break;
+                default:
+                    word ^= other[ i ];
+                    break;
+            }
+            count += popcount( word );
+        }
+        res.count = count;
+        res.normalize();
+        return res;
+    }
+
+    std::vector<Chunk> m_chunks;
+    uint64_t m_size;
+};
+
+
+namespace
+{
+
+
+PyObject*
+item_type_fail( AtomIntSet* set, PyObject* item )
+{
+    if( QuietValidation::fail( set->member, set->pointer->data(), PyExc_TypeError ) )
+        return 0;
+    CAtom* atom = set->pointer->data();
+    if( set->member && atom )
+        return PyErr_Format(
+            PyExc_TypeError,
+            "The items of the '%s' member on the '%s' object must be of type 'int'. "
+            "Got object of type '%s' instead.",
+            PyUnicode_AsUTF8( set->member->name ),
+            Py_TYPE( pyobject_cast( atom ) )->tp_name,
+            Py_TYPE( item )->tp_name
+        );
+    return PyErr_Format(
+        PyExc_TypeError,
+        "The items of the atomintset must be of type 'int'. "
+        "Got object of type '%s' instead.",
+        Py_TYPE( item )->tp_name
+    );
+}
+
+
+PyObject*
+item_range_fail( AtomIntSet* set )
+{
+    if( QuietValidation::fail( set->member, set->pointer->data(), PyExc_ValueError ) )
+        return 0;
+    CAtom* atom = set->pointer->data();
+    if( set->member && atom )
+        return PyErr_Format(
+            PyExc_ValueError,
+            "The items of the '%s' member on the '%s' object must be in the range "
+            "[0, 2**32).",
+            PyUnicode_AsUTF8( set->member->name ),
+            Py_TYPE( pyobject_cast( atom ) )->tp_name
+        );
+    PyErr_SetString( PyExc_ValueError, "The items of the atomintset must be in the range [0, 2**32)." );
+    return 0;
+}
+
+
+// Convert an item to a value of the set. Returns 1 on success, 0 if the item
+// is not a valid value and -1 on error. When strict is false an invalid item
+// is reported without setting an error.
+int
+convert_item( AtomIntSet* set, PyObject* item, uint32_t& out, bool strict = true )
+{
+    if( !PyLong_Check( item ) )
+    {
+        if( strict )
+            item_type_fail( set, item );
+        return strict ? -1 : 0;
+    }
+    int overflow = 0;
+    long long value = PyLong_AsLongLongAndOverflow( item, &overflow );
+    if( value == -1 && PyErr_Occurred() )
+        return -1;  // LCOV_EXCL_LINE
+    if( overflow || value < 0 || value > 0xFFFFFFFFLL )
+    {
+        if( strict )
+            item_range_fail( set );
+        return strict ? -1 : 0;
+    }
+    out = static_cast<uint32_t>( value );
+    return 1;
+}
+
+
+// Fill a bitmap with the items of an iterable. When strict is false, invalid
+// items are skipped and reported in skipped.
+bool
+collect_items( AtomIntSet* set, PyObject* value, IntBitmap& bitmap, bool strict = true, bool* skipped = 0 )
+{
+    if( AtomIntSet::TypeCheck( value ) )
+    {
+        bitmap = *atomintset_cast( value )->bitmap;
+        return true;
+    }
+    cppy::ptr iter( PyObject_GetIter( value ) );
+    if( !iter )
+        return false;
+    cppy::ptr item;
+    while( ( item = PyIter_Next( iter.get() ) ) )
+    {
+        uint32_t v;
+        int res = convert_item( set, item.get(), v, strict );
+        if( res < 0 )
+            return false;
+        if( res == 0 && skipped )
+            *skipped = true;
+        if( res == 1 )
+            bitmap.add( v );
+    }
+    return !PyErr_Occurred();
+}
+
+
+// Borrow the bitmap of an int set or build one from the items of a set.
+const IntBitmap*
+as_bitmap( AtomIntSet* set, PyObject* value, IntBitmap& temp )
+{
+    if( AtomIntSet::TypeCheck( value ) )
+        return atomintset_cast( value )->bitmap;
+    return collect_items( set, value, temp ) ? &temp : 0;
+}
+
+
+PyObject*
+new_set( const IntBitmap& bitmap )
+{
+    cppy::ptr res( AtomIntSet::New( 0, 0 ) );
+    if( !res )
+        return 0;  // LCOV_EXCL_LINE
+    *atomintset_cast( res.get() )->bitmap = bitmap;
+    return res.release();
+}
+
+
+PyObject*
+to_list( AtomIntSet* set )
+{
+    const IntBitmap& bitmap = *set->bitmap;
+    cppy::ptr items( PyList_New( static_cast<Py_ssize_t>( bitmap.size() ) ) );
+    if( !items )
+        return 0;  // LCOV_EXCL_LINE
+    Py_ssize_t i = 0;
+    for( const IntBitmap::Chunk& chunk : bitmap.chunks() )
+    {
+        uint32_t high = uint32_t( chunk.key ) << 16;
+        auto push = [&]( uint32_t low ) -> bool
+        {
+            PyObject* item = PyLong_FromUnsignedLong( high | low );
+            if( !item )
+                return false;  // LCOV_EXCL_LINE
+            PyList_SET_ITEM( items.get(), i++, item );
+            return true;
+        };
+        if( !chunk.dense() )
+        {
+            for( uint16_t value : chunk.values )
+            {
+                if( !push( value ) )
+                    return 0;  // LCOV_EXCL_LINE
+            }
+            continue;
+        }
+        for( size_t w = 0; w < IntBitmap::Words; ++w )
+        {
+            uint64_t word = chunk.words[ w ];
+            while( word )
+            {
+                if( !push( static_cast<uint32_t>( w * 64 + trailing_zeros( word ) ) ) )
+                    return 0;  // LCOV_EXCL_LINE
+                word &= word - 1;
+            }
+        }
+    }
+    return items.release();
+}
+
+
+// Whether the changes of the set are observed. The atom is returned in atom.
+bool
+observed( AtomIntSet* set, CAtom*& atom )
+{
+    atom = set->pointer->data();
+    return set->member && atom && MemberChange::container_observed( atom, set->member );
+}
+
+
+// Notify a change of the set carrying up to two payload entries.
+bool
+post_change(
+    AtomIntSet* set,
+    CAtom* atom,
+    ContainerOp::Op operation,
+    const char* key = 0,
+    PyObject* value = 0,
+    const char* key2 = 0,
+    PyObject* value2 = 0 )
+{
+    cppy::ptr change( MemberChange::container( atom, set->member, pyobject_cast( set ), operation ) );
+    if( !change )
+        return false;
+    if( key && PyDict_SetItemString( change.get(), key, value ) != 0 )
+        return false;
+    if( key2 && PyDict_SetItemString( change.get(), key2, value2 ) != 0 )
+        return false;
+    return MemberChange::notify_container( atom, set->member, change.get() );
+}
+
+
+PyObject*
+AtomIntSet_new( PyTypeObject* type, PyObject* args, PyObject* kwargs )
+{
+    static char* kwlist[] = { "items", 0 };
+    PyObject* items = 0;
+    if( !PyArg_ParseTupleAndKeywords( args, kwargs, "|O:atomintset", kwlist, &items ) )
+        return 0;
+    cppy::ptr self( PyType_GenericAlloc( type, 0 ) );
+    if( !self )
+        return 0;  // LCOV_EXCL_LINE (failed instance creation)
+    AtomIntSet* set = atomintset_cast( self.get() );
+    set->bitmap = new IntBitmap();
+    set->pointer = new CAtomPointer();
+    set->touch();
+    if( items && AtomIntSet::Assign( set, items ) < 0 )
+        return 0;
+    return self.release();
+}
+
+
+int
+AtomIntSet_clear( AtomIntSet* self )
+{
+    Py_CLEAR( self->member );
+    return 0;
+}
+
+
+int
+AtomIntSet_traverse( AtomIntSet* self, visitproc visit, void* arg )
+{
+    Py_VISIT( self->member );
+    Py_VISIT( Py_TYPE( self ) );
+    return 0;
+}
+
+
+void
+AtomIntSet_dealloc( AtomIntSet* self )
+{
+    PyObject_GC_UnTrack( self );
+    cppy::clear( &self->member );
+    delete self->pointer;
+    self->pointer = 0;
+    delete self->bitmap;
+    self->bitmap = 0;
+    PyTypeObject* type = Py_TYPE( self );
+    type->tp_free( pyobject_cast( self ) );
+    Py_DECREF( type );
+}
+
+
+Py_ssize_t
+AtomIntSet_length( AtomIntSet* self )
+{
+    return static_cast<Py_ssize_t>( self->bitmap->size() );
+}
+
+
+int
+AtomIntSet_contains( AtomIntSet* self, PyObject* value )
+{
+    uint32_t v;
+    int res = convert_item( self, value, v, false );
+    if( res <= 0 )
+        return res;
+    return self->bitmap->contains( v ) ? 1 : 0;
+}
+
+
+PyObject*
+AtomIntSet_repr( AtomIntSet* self )
+{
+    if( self->bitmap->size() == 0 )
+        return PyUnicode_FromString( "atomintset()" );
+    // The items are listed in increasing order, unlike the repr of a set.
+    cppy::ptr items( to_list( self ) );
+    if( !items )
+        return 0;  // LCOV_EXCL_LINE
+    cppy::ptr repr( PyObject_Repr( items.get() ) );
+    if( !repr )
+        return 0;  // LCOV_EXCL_LINE
+    Py_ssize_t length = PyUnicode_GET_LENGTH( repr.get() );
+    cppy::ptr inner( PyUnicode_Substring( repr.get(), 1, length - 1 ) );
+    if( !inner )
+        return 0;  // LCOV_EXCL_LINE
+    return PyUnicode_FromFormat( "atomintset({%U})", inner.get() );
+}
+
+
+PyObject*
+AtomIntSet_richcompare( AtomIntSet* self, PyObject* other, int op )
+{
+    if( !AtomIntSet::TypeCheck( other ) && !PyAnySet_Check( other ) )
+        return cppy::incref( Py_NotImplemented );
+    // Items of a set which cannot belong to an int set make it a strict superset.
+    IntBitmap temp;
+    bool extra = false;
+    const IntBitmap* bitmap = atomintset_cast( other )->bitmap;
+    if( !AtomIntSet::TypeCheck( other ) )
+    {
+        if( !collect_items( self, other, temp, false, &extra ) )
+            return 0;
+        bitmap = &temp;
+    }
+    const IntBitmap& mine = *self->bitmap;
+    bool res;
+    switch( op )
+    {
+        case Py_EQ:
+            res = !extra && mine == *bitmap;
+            break;
+        case Py_NE:
+            res = extra || !( mine == *bitmap );
+            break;
+        case Py_LE:
+            res = mine.is_subset( *bitmap );
+            break;
+        case Py_LT:
+            res = mine.is_subset( *bitmap ) && ( extra || mine.size() < bitmap->size() );
+            break;
+        case Py_GE:
+            res = !extra && bitmap->is_subset( mine );
+            break;
+        default:
+            res = !extra && bitmap->is_subset( mine ) && bitmap->size() < mine.size();
+            break;
+    }
+    return cppy::incref( res ? Py_True : Py_False );
+}
+
+
+// Combine two operands, one of which at least is an int set, into a new set.
+PyObject*
+binary_op( PyObject* first, PyObject* second, IntBitmap::Op op )
+{
+    if( ( !AtomIntSet::TypeCheck( first ) && !PyAnySet_Check( first ) ) ||
+        ( !AtomIntSet::TypeCheck( second ) && !PyAnySet_Check( second ) ) )
+        return cppy::incref( Py_NotImplemented );
+    AtomIntSet* set = atomintset_cast( AtomIntSet::TypeCheck( first ) ? first : second );
+    IntBitmap temp1, temp2;
+    const IntBitmap* a = as_bitmap( set, first, temp1 );
+    const IntBitmap* b = a ? as_bitmap( set, second, temp2 ) : 0;
+    if( !b )
+        return 0;
+    cppy::ptr res( AtomIntSet::New( 0, 0 ) );
+    if( !res )
+        return 0;  // LCOV_EXCL_LINE
+    IntBitmap::combine( *a, *b, op, *atomintset_cast( res.get() )->bitmap );
+    return res.release();
+}
+
+
+PyObject*
+AtomIntSet_or( PyObject* first, PyObject* second )
+{
+    return binary_op( first, second, IntBitmap::Or );
+}
+
+
+PyObject*
+AtomIntSet_and( PyObject* first, PyObject* second )
+{
+    return binary_op( first, second, IntBitmap::And );
+}
+
+
+PyObject*
+AtomIntSet_sub( PyObject* first, PyObject* second )
+{
+    return binary_op( first, second, IntBitmap::Sub );
+}
+
+
+PyObject*
+AtomIntSet_xor( PyObject* first, PyObject* second )
+{
+    return binary_op( first, second, IntBitmap::Xor );
+}
+
+
+// Apply an operation with the items of an iterable in place and notify the
+// values which were added and removed by the operation.
+bool
+inplace_op( AtomIntSet* self, PyObject* other, IntBitmap::Op op, ContainerOp::Op operation )
+{
+    IntBitmap temp;
+    const IntBitmap* operand = as_bitmap( self, other, temp );
+    if( !operand )
+        return false;
+    IntBitmap result;
+    IntBitmap::combine( *self->bitmap, *operand, op, result );
+    CAtom* atom;
+    bool obs = observed( self, atom );
+    cppy::ptr added;
+    cppy::ptr removed;
+    if( obs )
+    {
+        IntBitmap diff;
+        if( op == IntBitmap::Or || op == IntBitmap::Xor )
+        {
+            IntBitmap::combine( result, *self->bitmap, IntBitmap::Sub, diff );
+            if( diff.size() > 0 && !( added = new_set( diff ) ) )
+                return false;  // LCOV_EXCL_LINE
+        }
+        if( op != IntBitmap::Or )
+        {
+            IntBitmap::combine( *self->bitmap, result, IntBitmap::Sub, diff );
+            if( diff.size() > 0 && !( removed = new_set( diff ) ) )
+                return false;  // LCOV_EXCL_LINE
+        }
+    }
+    if( result.size() != self->bitmap->size() || !( result == *self->bitmap ) )
+    {
+        self->touch();
+        *self->bitmap = std::move( result );
+    }
+    if( added && removed )
+        return post_change( self, atom, operation, "added", added.get(), "removed", removed.get() );
+    if( added )
+        return post_change( self, atom, operation, "added", added.get() );
+    if( removed )
+        return post_change( self, atom, operation, "removed", removed.get() );
+    return true;
+}
+
+
+PyObject*
+inplace_number_op( AtomIntSet* self, PyObject* other, IntBitmap::Op op, ContainerOp::Op operation )
+{
+    if( !AtomIntSet::TypeCheck( other ) && !PyAnySet_Check( other ) )
+        return cppy::incref( Py_NotImplemented );
+    if( !inplace_op( self, other, op, operation ) )
+        return 0;
+    return cppy::incref( pyobject_cast( self ) );
+}
+
+
+PyObject*
+AtomIntSet_ior( AtomIntSet* self, PyObject* other )
+{
+    return inplace_number_op( self, other, IntBitmap::Or, ContainerOp::Ior );
+}
+
+
+PyObject*
+AtomIntSet_iand( AtomIntSet* self, PyObject* other )
+{
+    return inplace_number_op( self, other, IntBitmap::And, ContainerOp::Iand );
+}
+
+
+PyObject*
+AtomIntSet_isub( AtomIntSet* self, PyObject* other )
+{
+    return inplace_number_op( self, other, IntBitmap::Sub, ContainerOp::Isub );
+}
+
+
+PyObject*
+AtomIntSet_ixor( AtomIntSet* self, PyObject* other )
+{
+    return inplace_number_op( self, other, IntBitmap::Xor, ContainerOp::Ixor );
+}
+
+
+// Notify the change of a single item, reported as the stored int.
+bool
+post_item_change( AtomIntSet* self, CAtom* atom, ContainerOp::Op operation, uint32_t v )
+{
+    cppy::ptr item( PyLong_FromUnsignedLong( v ) );
+    return item && post_change( self, atom, operation, "item", item.get() );
+}
+
+
+PyObject*
+AtomIntSet_add( AtomIntSet* self, PyObject* value )
+{
+    uint32_t v;
+    if( convert_item( self, value, v ) < 0 )
+        return 0;
+    if( !self->bitmap->add( v ) )
+        return cppy::incref( Py_None );
+    self->touch();
+    CAtom* atom;
+    if( observed( self, atom ) && !post_item_change( self, atom, ContainerOp::Add, v ) )
+        return 0;
+    return cppy::incref( Py_None );
+}
+
+
+// Remove a value and notify its removal. Returns 1 if the value was removed,
+// 0 if it was not in the set and -1 on error.
+int
+remove_one( AtomIntSet* self, PyObject* value, ContainerOp::Op operation )
+{
+    uint32_t v;
+    int res = convert_item( self, value, v, false );
+    if( res <= 0 )
+        return res;
+    if( !self->bitmap->remove( v ) )
+        return 0;
+    self->touch();
+    CAtom* atom;
+    if( observed( self, atom ) && !post_item_change( self, atom, operation, v ) )
+        return -1;
+    return 1;
+}
+
+
+PyObject*
+AtomIntSet_discard( AtomIntSet* self, PyObject* value )
+{
+    if( remove_one( self, value, ContainerOp::Discard ) < 0 )
+        return 0;
+    return cppy::incref( Py_None );
+}
+
+
+PyObject*
+AtomIntSet_remove( AtomIntSet* self, PyObject* value )
+{
+    int res = remove_one( self, value, ContainerOp::Remove );
+    if( res < 0 )
+        return 0;
+    if( res == 0 )
+    {
+        PyErr_SetObject( PyExc_KeyError, value );
+        return 0;
+    }
+    return cppy::incref( Py_None );
+}
+
+
+PyObject*
+AtomIntSet_pop( AtomIntSet* self )
+{
+    if( self->bitmap->size() == 0 )
+    {
+        PyErr_SetString( PyExc_KeyError, "pop from an empty set" );
+        return 0;
+    }
+    cppy::ptr item( PyLong_FromUnsignedLong( self->bitmap->first() ) );
+    if( !item || remove_one( self, item.get(), ContainerOp::Pop ) < 0 )
+        return 0;
+    return item.release();
+}
+
+
+PyObject*
+AtomIntSet_clear_items( AtomIntSet* self )
+{
+    if( self->bitmap->size() == 0 )
+        return cppy::incref( Py_None );
+    CAtom* atom;
+    cppy::ptr items;
+    if( observed( self, atom ) && !( items = new_set( *self->bitmap ) ) )
+        return 0;  // LCOV_EXCL_LINE
+    self->touch();
+    self->bitmap->clear();
+    if( items && !post_change( self, atom, ContainerOp::Clear, "items", items.get() ) )
+        return 0;
+    return cppy::incref( Py_None );
+}
+
+
+PyObject*
+update_op( AtomIntSet* self, PyObject* value, IntBitmap::Op op, ContainerOp::Op operation )
+{
+    if( !inplace_op( self, value, op, operation ) )
+        return 0;
+    return cppy::incref( Py_None );
+}
+
+
+PyObject*
+AtomIntSet_update( AtomIntSet* self, PyObject* value )
+{
+    return update_op( self, value, IntBitmap::Or, ContainerOp::Update );
+}
+
+
+PyObject*
+AtomIntSet_difference_update( AtomIntSet* self, PyObject* value )
+{
+    return update_op( self, value, IntBitmap::Sub, ContainerOp::DifferenceUpdate );
+}
+
+
+PyObject*
+AtomIntSet_intersection_update( AtomIntSet* self, PyObject* value )
+{
+    return update_op( self, value, IntBitmap::And, ContainerOp::IntersectionUpdate );
+}
+
+
+PyObject*
+AtomIntSet_symmetric_difference_update( AtomIntSet* self, PyObject* value )
+{
+    return update_op( self, value, IntBitmap::Xor, ContainerOp::SymmetricDifferenceUpdate );
+}
+
+
+// Method form of the binary operations combining the set with any number of
+// iterables in turn.
+PyObject*
+method_op( AtomIntSet* self, PyObject*const *args, Py_ssize_t nargs, IntBitmap::Op op )
+{
+    cppy::ptr res( new_set( *self->bitmap ) );
+    if( !res )
+        return 0;  // LCOV_EXCL_LINE
+    IntBitmap& bitmap = *atomintset_cast( res.get() )->bitmap;
+    for( Py_ssize_t i = 0; i < nargs; ++i )
+    {
+        IntBitmap temp;
+        const IntBitmap* operand = as_bitmap( self, args[ i ], temp );
+        if( !operand )
+            return 0;
+        IntBitmap result;
+        IntBitmap::combine( bitmap, *operand, op, result );
+        bitmap = std::move( result );
+    }
+    return res.release();
+}
+
+
+PyObject*
+AtomIntSet_union( AtomIntSet* self, PyObject*const *args, Py_ssize_t nargs )
+{
+    return method_op( self, args, nargs, IntBitmap::Or );
+}
+
+
+PyObject*
+AtomIntSet_intersection( AtomIntSet* self, PyObject*const *args, Py_ssize_t nargs )
+{
+    return method_op( self, args, nargs, IntBitmap::And );
+}
+
+
+PyObject*
+AtomIntSet_difference( AtomIntSet* self, PyObject*const *args, Py_ssize_t nargs )
+{
+    return method_op( self, args, nargs, IntBitmap::Sub );
+}
+
+
+// Like the builtin set, the symmetric difference takes a single iterable.
+PyObject*
+AtomIntSet_symmetric_difference( AtomIntSet* self, PyObject* value )
+{
+    return method_op( self, &value, 1, IntBitmap::Xor );
+}
+
+
+PyObject*
+AtomIntSet_issubset( AtomIntSet* self, PyObject* value )
+{
+    IntBitmap temp;
+    bool extra = false;
+    if( !AtomIntSet::TypeCheck( value ) && !collect_items( self, value, temp, false, &extra ) )
+        return 0;
+    const IntBitmap& other = AtomIntSet::TypeCheck( value ) ? *atomintset_cast( value )->bitmap : temp;
+    return cppy::incref( self->bitmap->is_subset( other ) ? Py_True : Py_False );
+}
+
+
+PyObject*
+AtomIntSet_issuperset( AtomIntSet* self, PyObject* value )
+{
+    IntBitmap temp;
+    bool extra = false;
+    if( !AtomIntSet::TypeCheck( value ) && !collect_items( self, value, temp, false, &extra ) )
+        return 0;
+    const IntBitmap& other = AtomIntSet::TypeCheck( value ) ? *atomintset_cast( value )->bitmap : temp;
+    return cppy::incref( !extra && other.is_subset( *self->bitmap ) ? Py_True : Py_False );
+}
+
+
+PyObject*
+AtomIntSet_isdisjoint( AtomIntSet* self, PyObject* value )
+{
+    IntBitmap temp;
+    if( !AtomIntSet::TypeCheck( value ) && !collect_items( self, value, temp, false ) )
+        return 0;
+    const IntBitmap& other = AtomIntSet::TypeCheck( value ) ? *atomintset_cast( value )->bitmap : temp;
+    IntBitmap common;
+    IntBitmap::combine( *self->bitmap, other, IntBitmap::And, common );
+    return cppy::incref( common.size() == 0 ? Py_True : Py_False );
+}
+
+
+PyObject*
+AtomIntSet_copy( AtomIntSet* self )
+{
+    return new_set( *self->bitmap );
+}
+
+
+PyObject*
+AtomIntSet_tolist( AtomIntSet* self )
+{
+    return to_list( self );
+}
+
+
+PyObject*
+AtomIntSet_reduce( AtomIntSet* self )
+{
+    cppy::ptr items( to_list( self ) );
+    if( !items )
+        return 0;  // LCOV_EXCL_LINE
+    return Py_BuildValue( "(O(O))", pyobject_cast( AtomIntSet::TypeObject ), items.get() );
+}
+
+
+PyObject*
+AtomIntSet_sizeof( AtomIntSet* self )
+{
+    size_t size = Py_TYPE( self )->tp_basicsize + sizeof( IntBitmap ) + self->bitmap->memory();
+    return PyLong_FromSize_t( size );
+}
+
+
+PyObject*
+AtomIntSet_get_version( AtomIntSet* self, void* context )
+{
+    return PyLong_FromUnsignedLongLong( self->version );
+}
+
+
+// Iterator over the values of an int set in increasing order.
+struct AtomIntSetIterator
+{
+    PyObject_HEAD
+    AtomIntSet* set;
+    uint64_t version;
+    size_t chunk;
+    uint32_t position;  // index of a sparse value or bit of a dense chunk
+};
+
+
+PyTypeObject* AtomIntSetIterator_Type = 0;
+
+
+PyObject*
+AtomIntSet_iter( AtomIntSet* self )
+{
+    PyObject* pyiter = PyType_GenericAlloc( AtomIntSetIterator_Type, 0 );
+    if( !pyiter )
+        return 0;  // LCOV_EXCL_LINE
+    AtomIntSetIterator* iter = reinterpret_cast<AtomIntSetIterator*>( pyiter );
+    iter->set = atomintset_cast( cppy::incref( pyobject_cast( self ) ) );
+    iter->version = self->version;
+    return pyiter;
+}
+
+
+void
+AtomIntSetIterator_dealloc( AtomIntSetIterator* self )
+{
+    PyTypeObject* type = Py_TYPE( self );
+    Py_CLEAR( self->set );
+    type->tp_free( pyobject_cast( self ) );
+    Py_DECREF( type );
+}
+
+
+PyObject*
+AtomIntSetIterator_next( AtomIntSetIterator* self )
+{
+    if( !self->set )
+        return 0;
+    if( self->set->version != self->version )
+    {
+        Py_CLEAR( self->set );
+        PyErr_SetString( PyExc_RuntimeError, "atomintset changed during iteration" );
+        return 0;
+    }
+    const std::vector<IntBitmap::Chunk>& chunks = self->set->bitmap->chunks();
+    for( ; self->chunk < chunks.size(); ++self->chunk, self->position = 0 )
+    {
+        const IntBitmap::Chunk& chunk = chunks[ self->chunk ];
+        uint32_t high = uint32_t( chunk.key ) << 16;
+        if( !chunk.dense() )
+        {
+            if( self->position < chunk.values.size() )
+                return PyLong_FromUnsignedLong( high | chunk.values[ self->position++ ] );
+            continue;
+        }
+        size_t w = self->position >> 6;
+        if( w >= IntBitmap::Words )
+            continue;
+        uint64_t word = chunk.words[ w ] & ( ~uint64_t( 0 ) << ( self->position & 63 ) );
+        while( !word && ++w < IntBitmap::Words )
+            word = chunk.words[ w ];
+        if( word )
+        {
+            uint32_t low = static_cast<uint32_t>( w * 64 + trailing_zeros( word ) );
+            self->position = low + 1;
+            return PyLong_FromUnsignedLong( high | low );
+        }
+    }
+    Py_CLEAR( self->set );
+    return 0;
+}
+
+
+static PyType_Slot AtomIntSetIterator_Type_slots[] = {
+    { Py_tp_dealloc, void_cast( AtomIntSetIterator_dealloc ) },      /* tp_dealloc */
+    { Py_tp_iter, void_cast( PyObject_SelfIter ) },                  /* tp_iter */
+    { Py_tp_iternext, void_cast( AtomIntSetIterator_next ) },        /* tp_iternext */
+    { 0, 0 },
+};
+
+
+PyType_Spec AtomIntSetIterator_TypeObject_Spec = {
+    PACKAGE_TYPENAME( "atomintsetiterator" ),   /* tp_name */
+    sizeof( AtomIntSetIterator ),               /* tp_basicsize */
+    0,                                          /* tp_itemsize */
+    Py_TPFLAGS_DEFAULT,                         /* tp_flags */
+    AtomIntSetIterator_Type_slots               /* slots */
+};
+
+
+static PyMethodDef
+AtomIntSet_methods[] = {
+    { "add",
+      ( PyCFunction )AtomIntSet_add,
+      METH_O,
+      "Add an element to a set." },
+    { "discard",
+      ( PyCFunction )AtomIntSet_discard,
+      METH_O,
+      "Remove an element from a set if it is a member." },
+    { "remove",
+      ( PyCFunction )AtomIntSet_remove,
+      METH_O,
+      "Remove an element from a set; it must be a member." },
+    { "pop",
+      ( PyCFunction )AtomIntSet_pop,
+      METH_NOARGS,
+      "Remove and return the smallest set element." },
+    { "clear",
+      ( PyCFunction )AtomIntSet_clear_items,
+      METH_NOARGS,
+      "Remove all elements from this set." },
+    { "update",
+      ( PyCFunction )AtomIntSet_update,
+      METH_O,
+      "Update a set with the union of itself and another." },
+    { "difference_update",
+      ( PyCFunction )AtomIntSet_difference_update,
+      METH_O,
+      "Update a set with the difference of itself and another." },
+    { "intersection_update",
+      ( PyCFunction )AtomIntSet_intersection_update,
+      METH_O,
+      "Update a set with the intersection of itself and another." },
+    { "symmetric_difference_update",
+      ( PyCFunction )AtomIntSet_symmetric_difference_update,
+      METH_O,
+      "Update a set with the symmetric difference of itself and another." },
+    { "union",
+      ( PyCFunction )AtomIntSet_union,
+      METH_FASTCALL,
+      "Return the union of a set and any number of iterables as a new set." },
+    { "intersection",
+      ( PyCFunction )AtomIntSet_intersection,
+      METH_FASTCALL,
+      "Return the intersection of a set and any number of iterables as a new set." },
+    { "difference",
+      ( PyCFunction )AtomIntSet_difference,
+      METH_FASTCALL,
+      "Return the difference of a set and any number of iterables as a new set." },
+    { "symmetric_difference",
+      ( PyCFunction )AtomIntSet_symmetric_difference,
+      METH_O,
+      "Return the symmetric difference of a set and another as a new set." },
+    { "issubset",
+      ( PyCFunction )AtomIntSet_issubset,
+      METH_O,
+      "Report whether another set contains this set." },
+    { "issuperset",
+      ( PyCFunction )AtomIntSet_issuperset,
+      METH_O,
+      "Report whether this set contains another set." },
+    { "isdisjoint",
+      ( PyCFunction )AtomIntSet_isdisjoint,
+      METH_O,
+      "Return True if two sets have a null intersection." },
+    { "copy",
+      ( PyCFunction )AtomIntSet_copy,
+      METH_NOARGS,
+      "Return a copy of a set not bound to any atom." },
+    { "tolist",
+      ( PyCFunction )AtomIntSet_tolist,
+      METH_NOARGS,
+      "Return the elements of a set as a sorted list." },
+    { "__reduce__", ( PyCFunction )AtomIntSet_reduce, METH_NOARGS, "" },
+    { "__sizeof__", ( PyCFunction )AtomIntSet_sizeof, METH_NOARGS, "" },
+    { 0 } // sentinel
+};
+
+
+static PyGetSetDef
+AtomIntSet_getset[] = {
+    { "version", ( getter )AtomIntSet_get_version, 0,
+      "A number drawn anew each time the set is modified." },
+    { 0 }  // sentinel
+};
+
+
+static PyType_Slot AtomIntSet_Type_slots[] = {
+    { Py_tp_new, void_cast( AtomIntSet_new ) },                 /* tp_new */
+    { Py_tp_dealloc, void_cast( AtomIntSet_dealloc ) },         /* tp_dealloc */
+    { Py_tp_traverse, void_cast( AtomIntSet_traverse ) },       /* tp_traverse */
+    { Py_tp_clear, void_cast( AtomIntSet_clear ) },             /* tp_clear */
+    { Py_tp_repr, void_cast( AtomIntSet_repr ) },               /* tp_repr */
+    { Py_tp_hash, void_cast( PyObject_HashNotImplemented ) },   /* tp_hash */
+    { Py_tp_richcompare, void_cast( AtomIntSet_richcompare ) }, /* tp_richcompare */
+    { Py_tp_iter, void_cast( AtomIntSet_iter ) },               /* tp_iter */
+    { Py_tp_methods, void_cast( AtomIntSet_methods ) },         /* tp_methods */
+    { Py_tp_getset, void_cast( AtomIntSet_getset ) },           /* tp_getset */
+    { Py_sq_length, void_cast( AtomIntSet_length ) },           /* sq_length */
+    { Py_sq_contains, void_cast( AtomIntSet_contains ) },       /* sq_contains */
+    { Py_nb_or, void_cast( AtomIntSet_or ) },                   /* nb_or */
+    { Py_nb_and, void_cast( AtomIntSet_and ) },                 /* nb_and */
+    { Py_nb_subtract, void_cast( AtomIntSet_sub ) },            /* nb_subtract */
+    { Py_nb_xor, void_cast( AtomIntSet_xor ) },                 /* nb_xor */
+    { Py_nb_inplace_or, void_cast( AtomIntSet_ior ) },          /* nb_inplace_or */
+    { Py_nb_inplace_and, void_cast( AtomIntSet_iand ) },        /* nb_inplace_and */
+    { Py_nb_inplace_subtract, void_cast( AtomIntSet_isub ) },   /* nb_inplace_subtract */
+    { Py_nb_inplace_xor, void_cast( AtomIntSet_ixor ) },        /* nb_inplace_xor */
+    { 0, 0 },
+};
+
+
+}  // namespace
+
+
+PyTypeObject* AtomIntSet::TypeObject = NULL;
+
+
+PyType_Spec AtomIntSet::TypeObject_Spec = {
+    PACKAGE_TYPENAME( "atomintset" ),           /* tp_name */
+    sizeof( AtomIntSet ),                       /* tp_basicsize */
+    0,                                          /* tp_itemsize */
+    Py_TPFLAGS_DEFAULT
+    |Py_TPFLAGS_BASETYPE
+    |Py_TPFLAGS_HAVE_GC,                        /* tp_flags */
+    AtomIntSet_Type_slots                       /* slots */
+};
+
+
+PyObject*
+AtomIntSet::New( CAtom* atom, Member* member )
+{
+    cppy::ptr ptr( PyType_GenericAlloc( AtomIntSet::TypeObject, 0 ) );
+    if( !ptr )
+        return 0;  // LCOV_EXCL_LINE (failed instance creation)
+    AtomIntSet* set = atomintset_cast( ptr.get() );
+    set->bitmap = new IntBitmap();
+    set->pointer = new CAtomPointer( atom );
+    set->member = reinterpret_cast<Member*>( cppy::xincref( pyobject_cast( member ) ) );
+    set->touch();
+    return ptr.release();
+}
+
+
+int
+AtomIntSet::Assign( AtomIntSet* set, PyObject* value )
+{
+    IntBitmap bitmap;
+    if( !collect_items( set, value, bitmap ) )
+        return -1;
+    set->touch();
+    *set->bitmap = std::move( bitmap );
+    // A verbatim copy holds the same items as its source.
+    if( AtomIntSet::TypeCheck( value ) )
+        set->version = atomintset_cast( value )->version;
+    return 0;
+}
+
+
+bool
+AtomIntSet::Ready()
+{
+    AtomIntSetIterator_Type = pytype_cast( PyType_FromSpec( &AtomIntSetIterator_TypeObject_Spec ) );
+    if( !AtomIntSetIterator_Type )
+    {
+        return false;  // LCOV_EXCL_LINE (failed type creation)
+    }
+    // The reference will be handled by the module to which we will add the type
+    TypeObject = pytype_cast( PyType_FromSpec( &TypeObject_Spec ) );
+    if( !TypeObject )
+    {
+        return false;  // LCOV_EXCL_LINE (failed type creation)
+    }
+    return true;
+}
+
+
+}  // namespace atom
@@ -0,0 +1,61 @@
+/*-----------------------------------------------------------------------------
+| Copyright (c) 2025, Nucleic Development Team.
+|
+| Distributed under the terms of the Modified BSD License.
+|
+| The full license is in the file LICENSE, distributed with this software.
+|----------------------------------------------------------------------------*/
+#pragma once
+#include <cppy/cppy.h>
+#include "catom.h"
+#include "catompointer.h"
+#include "containerversion.h"
+#include "member.h"
+
+
+#define atomintset_cast( o ) ( reinterpret_cast<atom::AtomIntSet*>( o ) )
+
+namespace atom
+{
+
+
+// Compressed bitmap of 32-bit unsigned integers, defined in atomintset.cpp.
+class IntBitmap;
+
+
+// POD struct - all member fields are considered private
+struct AtomIntSet
+{
+    PyObject_HEAD
+    IntBitmap* bitmap;
+    CAtomPointer* pointer;
+    Member* member;  // member notified of the changes, null if standalone
+    uint64_t version;  // drawn anew on each modification
+
+    static PyType_Spec TypeObject_Spec;
+
+    static PyTypeObject* TypeObject;
+
+    static bool Ready();
+
+    // Create an empty set whose changes are notified by the given member.
+    static PyObject* New( CAtom* atom, Member* member );
+
+    // Replace the content of a set by the items of an iterable. The bitmap
+    // of another int set is copied as is.
+    static int Assign( AtomIntSet* set, PyObject* value );
+
+    void touch()
+    {
+        version = next_container_version();
+    }
+
+    static bool TypeCheck( PyObject* ob )
+    {
+        return PyObject_TypeCheck( ob, TypeObject ) != 0;
+    }
+
+};
+
+
+}  // namespace atom
@@ -31,6 +31,7 @@ namespace ListMethods
     pycfunc extend = 0;
     static pycfunc_f pop = 0;
     static pycfunc remove = 0;
+    static pycfunc reversed = 0;
 
     inline PyCFunction
     lookup_method( PyTypeObject* type, const char* name )
@@ -70,6 +71,14 @@ namespace ListMethods
     // LCOV_EXCL_START
             cppy::system_error( "failed to load list 'remove' method" );
             return false;
+    // LCOV_EXCL_STOP
+        }
+        reversed = lookup_method( &PyList_Type, "__reversed__" );
+        if( !reversed )
+        {
+    // LCOV_EXCL_START
+            cppy::system_error( "failed to load list '__reversed__' method" );
+            return false;
     // LCOV_EXCL_STOP
         }
         return true;
@@ -195,6 +204,40 @@ public:
             m_list.get(), key, item.get() );
     }
 
+    int validate_all()
+    {
+        // Reads made by the validators see the items as they stand.
+        if( alist()->validating )
+            return 0;
+        if( !validator() )
+        {
+            alist()->unvalidated = false;
+            return 0;
+        }
+        // The items of a list outliving its atom cannot be validated.
+        if( !atom() )
+            return 0;
+        cppy::ptr vd( cppy::incref( pyobject_cast( validator() ) ) );
+        CAtom* atm = atom();
+        alist()->validating = true;
+        for( Py_ssize_t i = 0; i < PyList_GET_SIZE( m_list.get() ); ++i )
+        {
+            cppy::ptr item( cppy::incref( PyList_GET_ITEM( m_list.get(), i ) ) );
+            cppy::ptr valid_item( member_cast( vd.get() )->full_validate( atm, Py_None, item.get() ) );
+            if( !valid_item )
+            {
+                alist()->validating = false;
+                return -1;
+            }
+            // The validator may have shrunk the list.
+            if( valid_item != item && i < PyList_GET_SIZE( m_list.get() ) )
+                PyList_SetItem( m_list.get(), i, valid_item.release() );
+        }
+        alist()->validating = false;
+        alist()->unvalidated = false;
+        return 0;
+    }
+
 protected:
 
     AtomList* alist()
@@ -369,6 +412,145 @@ AtomList_ass_subscript( AtomList* self, PyObject* key, PyObject* value )
 }
 
 
+// Read access to a list whose validation was deferred validates it first.
+inline bool
+ensure_validated( AtomList* self )
+{
+    return !self->unvalidated || AtomList::ValidateAll( self ) == 0;
+}
+
+
+PyObject*
+AtomList_item( AtomList* self, Py_ssize_t index )
+{
+    if( !ensure_validated( self ) )
+        return 0;
+    return PyList_Type.tp_as_sequence->sq_item( pyobject_cast( self ), index );
+}
+
+
+PyObject*
+AtomList_subscript( AtomList* self, PyObject* key )
+{
+    if( !ensure_validated( self ) )
+        return 0;
+    return PyList_Type.tp_as_mapping->mp_subscript( pyobject_cast( self ), key );
+}
+
+
+int
+AtomList_contains( AtomList* self, PyObject* value )
+{
+    if( !ensure_validated( self ) )
+        return -1;
+    return PyList_Type.tp_as_sequence->sq_contains( pyobject_cast( self ), value );
+}
+
+
+PyObject*
+AtomList_iter( AtomList* self )
+{
+    if( !ensure_validated( self ) )
+        return 0;
+    return PyList_Type.tp_iter( pyobject_cast( self ) );
+}
+
+
+PyObject*
+AtomList_reversed( AtomList* self )
+{
+    if( !ensure_validated( self ) )
+        return 0;
+    return ListMethods::reversed( pyobject_cast( self ), 0 );
+}
+
+
+PyObject*
+AtomList_repr( AtomList* self )
+{
+    if( !ensure_validated( self ) )
+        return 0;
+    return PyList_Type.tp_repr( pyobject_cast( self ) );
+}
+
+
+PyObject*
+AtomList_richcompare( AtomList* self, PyObject* other, int op )
+{
+    if( !ensure_validated( self ) )
+        return 0;
+    if( AtomList::TypeCheck( other ) && !ensure_validated( atomlist_cast( other ) ) )
+        return 0;
+    return PyList_Type.tp_richcompare( pyobject_cast( self ), other, op );
+}
+
+
+PyObject*
+AtomList_concat( AtomList* self, PyObject* other )
+{
+    if( !ensure_validated( self ) )
+        return 0;
+    if( AtomList::TypeCheck( other ) && !ensure_validated( atomlist_cast( other ) ) )
+        return 0;
+    return PyList_Type.tp_as_sequence->sq_concat( pyobject_cast( self ), other );
+}
+
+
+PyObject*
+AtomList_repeat( AtomList* self, Py_ssize_t count )
+{
+    if( !ensure_validated( self ) )
+        return 0;
+    return PyList_Type.tp_as_sequence->sq_repeat( pyobject_cast( self ), count );
+}
+
+
+// The attributes which do not read the items of the list. Accessing any
+// other attribute, such as the inherited copy, index or count methods,
+// validates the deferred items first.
+bool
+is_lazy_list_attribute( PyObject* name )
+{
+    static const char* names[] = {
+        "validated", "validate_all", "append", "insert", "extend", "clear", 0
+    };
+    for( const char** it = names; *it; ++it )
+    {
+        if( PyUnicode_CompareWithASCIIString( name, *it ) == 0 )
+            return true;
+    }
+    return false;
+}
+
+
+PyObject*
+AtomList_getattro( AtomList* self, PyObject* name )
+{
+    if( self->unvalidated && PyUnicode_Check( name ) && !is_lazy_list_attribute( name ) )
+    {
+        if( AtomList::ValidateAll( self ) < 0 )
+            return 0;
+    }
+    return PyObject_GenericGetAttr( pyobject_cast( self ), name );
+}
+
+
+PyObject*
+AtomList_validate_all( AtomList* self )
+{
+    if( self->unvalidated && AtomList::ValidateAll( self ) < 0 )
+        return 0;
+    Py_RETURN_NONE;
+}
+
+
+PyObject*
+AtomList_get_validated( AtomList* self, void* ctxt )
+{
+    return cppy::incref( self->unvalidated ? Py_False : Py_True );
+}
+
+
 PyDoc_STRVAR( a_append_doc,
 "L.append(object) -- append object to end" );
 
@@ -384,6 +566,18 @@ static PyMethodDef AtomList_methods[] = {
     { "insert", ( PyCFunction )AtomList_insert, METH_FASTCALL, a_insert_doc },
     { "extend", ( PyCFunction )AtomList_extend, METH_O, a_extend_doc },
     { "__reduce_ex__", ( PyCFunction )AtomList_reduce_ex, METH_O, "" },
+    { "__reversed__", ( PyCFunction )AtomList_reversed, METH_NOARGS,
+      "L.__reversed__() -- return a reverse iterator over the list" },
+    { "validate_all", ( PyCFunction )AtomList_validate_all, METH_NOARGS,
+      "L.validate_all() -- validate the items whose validation was deferred" },
+    { 0 }  /* sentinel */
+};
+
+
+static PyGetSetDef AtomList_getset[] = {
+    { "validated", ( getter )AtomList_get_validated, 0,
+      "Whether all the items of the list have been validated. A list outliving "
+      "its atom stays unvalidated." },
     { 0 }  /* sentinel */
 };
 
@@ -396,9 +590,20 @@ static PyType_Slot AtomList_Type_slots[] = {
     { Py_tp_traverse, void_cast( AtomList_traverse ) },             /* tp_traverse */
     { Py_tp_clear, void_cast( AtomList_clear ) },                   /* tp_clear */
     { Py_tp_methods, void_cast( AtomList_methods ) },               /* tp_methods */
+    { Py_tp_getset, void_cast( AtomList_getset ) },                 /* tp_getset */
+    { Py_tp_iter, void_cast( AtomList_iter ) },                     /* tp_iter */
+    { Py_sq_item, void_cast( AtomList_item ) },                     /* sq_item */
+    { Py_sq_contains, void_cast( AtomList_contains ) },             /* sq_contains */
     { Py_sq_ass_item, void_cast( AtomList_ass_item ) },             /* sq_ass_item */
     { Py_sq_inplace_concat, void_cast( AtomList_inplace_concat ) }, /* sq_ass_item */
+    { Py_mp_subscript, void_cast( AtomList_subscript ) },           /* mp_subscript */
     { Py_mp_ass_subscript, void_cast( AtomList_ass_subscript ) },   /* mp_ass_subscript */
+    { Py_tp_getattro, void_cast( AtomList_getattro ) },             /* tp_getattro */
+    { Py_tp_repr, void_cast( AtomList_repr ) },                     /* tp_repr */
+    { Py_tp_richcompare, void_cast( AtomList_richcompare ) },       /* tp_richcompare */
+    { Py_tp_hash, void_cast( PyObject_HashNotImplemented ) },       /* tp_hash */
+    { Py_sq_concat, void_cast( AtomList_concat ) },                 /* sq_concat */
+    { Py_sq_repeat, void_cast( AtomList_repeat ) },                 /* sq_repeat */
     { 0, 0 },
 };
 
@@ -433,6 +638,13 @@ AtomList::New( Py_ssize_t size, CAtom* atom, Member* validator )
 }
 
 
+int
+AtomList::ValidateAll( AtomList* list )
+{
+    return AtomListHandler( list ).validate_all();
+}
+
+
 bool AtomList::Ready()
 {
     if( !ListMethods::init_methods() ) {
@@ -458,6 +670,7 @@ namespace PySStr
     static PyObject* namestr;
     static PyObject* objectstr;
     static PyObject* valuestr ;
+    static PyObject* oldvaluestr ;
     static PyObject* operationstr ;
     static PyObject* itemstr ;
     static PyObject* itemsstr ;
@@ -478,6 +691,8 @@ namespace PySStr
     static PyObject* olditemstr ;
     static PyObject* newitemstr ;
     static PyObject* countstr ;
+    static PyObject* batchstr ;
+    static PyObject* changesstr ;
 
 }  // namespace PySStr
 
@@ -511,6 +726,11 @@ init_containerlistchange()
     {
         return false;  // LCOV_EXCL_LINE (failed interned string creation)
     }
+    PySStr::oldvaluestr = PyUnicode_InternFromString( "oldvalue" );
+    if( !PySStr::oldvaluestr )
+    {
+        return false;  // LCOV_EXCL_LINE (failed interned string creation)
+    }
     PySStr::operationstr = PyUnicode_InternFromString( "operation" );
     if( !PySStr::operationstr )
     {
@@ -611,6 +831,16 @@ init_containerlistchange()
     {
         return false;  // LCOV_EXCL_LINE (failed interned string creation)
     }
+    PySStr::batchstr = PyUnicode_InternFromString( "batch" );
+    if( !PySStr::batchstr )
+    {
+        return false;  // LCOV_EXCL_LINE (failed interned string creation)
+    }
+    PySStr::changesstr = PyUnicode_InternFromString( "changes" );
+    if( !PySStr::changesstr )
+    {
+        return false;  // LCOV_EXCL_LINE (failed interned string creation)
+    }
     alloced = true;
     return true;
 }
@@ -917,6 +1147,54 @@ public:
         return res;
     }
 
+    PyObject* begin_batch()
+    {
+        AtomCList* list = clist();
+        if( list->batch_depth == 0 )
+        {
+            list->batch_changes = PyList_New( 0 );
+            if( !list->batch_changes )
+                return 0;  // LCOV_EXCL_LINE
+            list->batch_merging = false;
+        }
+        ++list->batch_depth;
+        return cppy::incref( m_list.get() );
+    }
+
+    PyObject* end_batch()
+    {
+        AtomCList* list = clist();
+        if( list->batch_depth == 0 )
+            return cppy::runtime_error( "no batch in progress" );
+        if( --list->batch_depth > 0 )
+            return cppy::incref( Py_None );
+        cppy::ptr changes( list->batch_changes );
+        list->batch_changes = 0;
+        list->batch_merging = false;
+        Py_ssize_t count = PyList_GET_SIZE( changes.get() );
+        if( count == 0 || !observer_check() )
+            return cppy::incref( Py_None );
+        cppy::ptr c( prepare_change() );
+        if( !c )
+            return 0;  // LCOV_EXCL_LINE
+        // A single change is delivered as is, with the common fields.
+        if( count == 1 )
+        {
+            if( PyDict_Update( c.get(), PyList_GET_ITEM( changes.get(), 0 ) ) != 0 )
+                return 0;  // LCOV_EXCL_LINE
+        }
+        else
+        {
+            if( PyDict_SetItem( c.get(), PySStr::operationstr, PySStr::batchstr ) != 0 )
+                return 0;
+            if( PyDict_SetItem( c.get(), PySStr::changesstr, changes.get() ) != 0 )
+                return 0;
+        }
+        if( !post_change( c ) )
+            return 0;
+        return cppy::incref( Py_None );
+    }
+
 private:
 
     AtomCListHandler();
@@ -942,24 +1220,68 @@ private:
         return m_obsm || m_obsa;
     }
 
+    // Within a batch only the operation specific fields are recorded and
+    // the common ones are added once when the batch is delivered.
     PyObject* prepare_change()
     {
         cppy::ptr c( PyDict_New() );
         if( !c )
             return 0;
+        if( clist()->batch_changes )
+            return c.release();
         if( PyDict_SetItem( c.get(), PySStr::typestr, PySStr::containerstr ) != 0 )
             return 0;
         if( PyDict_SetItem( c.get(), PySStr::namestr, member()->name ) != 0 )
             return 0;
         if( PyDict_SetItem( c.get(), PySStr::objectstr, pyobject_cast( atom() ) ) != 0 )
             return 0;
+        if( PyDict_SetItem( c.get(), PySStr::oldvaluestr, m_list.get() ) != 0 )
+            return 0;
         if( PyDict_SetItem( c.get(), PySStr::valuestr, m_list.get() ) != 0 )
             return 0;
         return c.release();
     }
 
+    // Record a change of the current batch. Consecutive appends are merged
+    // into a single extend change.
+    bool record_change( cppy::ptr& change )
+    {
+        AtomCList* list = clist();
+        PyObject* changes = list->batch_changes;
+        Py_ssize_t count = PyList_GET_SIZE( changes );
+        PyObject* op = PyDict_GetItem( change.get(), PySStr::operationstr );
+        if( op == PySStr::appendstr && count > 0 )
+        {
+            PyObject* item = PyDict_GetItem( change.get(), PySStr::itemstr );
+            PyObject* last = PyList_GET_ITEM( changes, count - 1 );
+            if( list->batch_merging )
+                return PyList_Append( PyDict_GetItem( last, PySStr::itemsstr ), item ) == 0;
+            if( PyDict_GetItem( last, PySStr::operationstr ) == PySStr::appendstr )
+            {
+                cppy::ptr items( PyList_New( 2 ) );
+                if( !items )
+                    return false;  // LCOV_EXCL_LINE
+                PyList_SET_ITEM( items.get(), 0, cppy::incref( PyDict_GetItem( last, PySStr::itemstr ) ) );
+                PyList_SET_ITEM( items.get(), 1, cppy::incref( item ) );
+                cppy::ptr merged( PyDict_New() );
+                if( !merged )
+                    return false;  // LCOV_EXCL_LINE
+                if( PyDict_SetItem( merged.get(), PySStr::operationstr, PySStr::extendstr ) != 0 )
+                    return false;
+                if( PyDict_SetItem( merged.get(), PySStr::itemsstr, items.get() ) != 0 )
+                    return false;
+                list->batch_merging = true;
+                return PyList_SetItem( changes, count - 1, merged.release() ) == 0;
+            }
+        }
+        list->batch_merging = false;
+        return PyList_Append( changes, change.get() ) == 0;
+    }
+
     bool post_change( cppy::ptr& change )
     {
+        if( clist()->batch_changes )
+            return record_change( change );
         cppy::ptr args( PyTuple_New( 1 ) );
         if( !args )
             return false;
@@ -1010,6 +1332,80 @@ private:
 };
 
 
+// Context manager returned by atomclist.batch
+struct AtomCListBatch
+{
+    PyObject_HEAD
+    AtomCList* list;
+};
+
+
+PyTypeObject* AtomCListBatch_Type = 0;
+
+
+PyObject*
+AtomCListBatch_New( AtomCList* list )
+{
+    PyObject* pybatch = PyType_GenericAlloc( AtomCListBatch_Type, 0 );
+    if( !pybatch )
+        return 0;  // LCOV_EXCL_LINE
+    reinterpret_cast<AtomCListBatch*>( pybatch )->list = atomclist_cast( cppy::incref( pyobject_cast( list ) ) );
+    return pybatch;
+}
+
+
+void
+AtomCListBatch_dealloc( AtomCListBatch* self )
+{
+    PyTypeObject* type = Py_TYPE( self );
+    Py_CLEAR( self->list );
+    type->tp_free( pyobject_cast( self ) );
+    Py_DECREF( type );
+}
+
+
+PyObject*
+AtomCListBatch_enter( AtomCListBatch* self )
+{
+    if( !self->list )
+        return cppy::type_error( "batch is not bound to a list" );
+    return AtomCListHandler( self->list ).begin_batch();
+}
+
+
+PyObject*
+AtomCListBatch_exit( AtomCListBatch* self, PyObject* args )
+{
+    if( !self->list )
+        return cppy::type_error( "batch is not bound to a list" );
+    return AtomCListHandler( self->list ).end_batch();
+}
+
+
+static PyMethodDef
+AtomCListBatch_methods[] = {
+    { "__enter__", ( PyCFunction )AtomCListBatch_enter, METH_NOARGS, "" },
+    { "__exit__", ( PyCFunction )AtomCListBatch_exit, METH_VARARGS, "" },
+    { 0 }  /* sentinel */
+};
+
+
+static PyType_Slot AtomCListBatch_Type_slots[] = {
+    { Py_tp_dealloc, void_cast( AtomCListBatch_dealloc ) },          /* tp_dealloc */
+    { Py_tp_methods, void_cast( AtomCListBatch_methods ) },          /* tp_methods */
+    { 0, 0 },
+};
+
+
+PyType_Spec AtomCListBatch_TypeObject_Spec = {
+	PACKAGE_TYPENAME( "atomclistbatch" ),        /* tp_name */
+	sizeof( AtomCListBatch ),                    /* tp_basicsize */
+	0,                                           /* tp_itemsize */
+	Py_TPFLAGS_DEFAULT,                          /* tp_flags */
+    AtomCListBatch_Type_slots                    /* slots */
+};
+
+
 PyObject*
 AtomCList_new( PyTypeObject* type, PyObject* args, PyObject* kwargs )
 {
@@ -1020,6 +1416,7 @@ AtomCList_new( PyTypeObject* type, PyObject* args, PyObject* kwargs )
 int AtomCList_clear( AtomCList* self )
 {
     Py_CLEAR( self->member );
+    Py_CLEAR( self->batch_changes );
     return AtomList_clear( atomlist_cast( self )  );
 }
 
@@ -1027,6 +1424,7 @@ int AtomCList_clear( AtomCList* self )
 int AtomCList_traverse( AtomCList* self, visitproc visit, void* arg )
 {
     Py_VISIT( self->member );
+    Py_VISIT( self->batch_changes );
     return AtomList_traverse( atomlist_cast( self ) , visit, arg );
 }
 
@@ -1036,6 +1434,7 @@ AtomCList_dealloc( AtomCList* self )
 {
     PyObject_GC_UnTrack( self );
     cppy::clear( &self->member );
+    cppy::clear( &self->batch_changes );
     cppy::clear( &atomlist_cast( self )->validator );
     delete atomlist_cast( self )->pointer;
     atomlist_cast( self )->pointer = 0;
@@ -1085,6 +1484,27 @@ AtomCList_reverse( AtomCList* self )
 }
 
 
+PyObject*
+AtomCList_batch( AtomCList* self )
+{
+    return AtomCListBatch_New( self );
+}
+
+
+PyObject*
+AtomCList_begin_batch( AtomCList* self )
+{
+    return AtomCListHandler( self ).begin_batch();
+}
+
+
+PyObject*
+AtomCList_end_batch( AtomCList* self )
+{
+    return AtomCListHandler( self ).end_batch();
+}
+
+
 PyObject*
 AtomCList_sort( AtomCList* self, PyObject* args, PyObject* kwargs )
 {
@@ -1120,6 +1540,13 @@ AtomCList_ass_subscript( AtomCList* self, PyObject* key, PyObject* value )
 }
 
 
+PyDoc_STRVAR(c_batch_doc,
+"L.batch() -> context manager -- coalesce the changes notified within the\n"
+"context into a single change, delivered on exit");
+PyDoc_STRVAR(c_begin_batch_doc,
+"L.begin_batch() -> list -- start coalescing the notified changes");
+PyDoc_STRVAR(c_end_batch_doc,
+"L.end_batch() -- stop coalescing and deliver the pending changes");
 PyDoc_STRVAR(c_append_doc,
 "L.append(object) -- append object to end");
 PyDoc_STRVAR(c_insert_doc,
@@ -1148,6 +1575,9 @@ AtomCList_methods[] = {
     { "remove", ( PyCFunction )AtomCList_remove, METH_O, c_remove_doc },
     { "reverse", ( PyCFunction )AtomCList_reverse, METH_NOARGS, c_reverse_doc },
     { "sort", ( PyCFunction )AtomCList_sort, METH_VARARGS | METH_KEYWORDS, c_sort_doc },
+    { "batch", ( PyCFunction )AtomCList_batch, METH_NOARGS, c_batch_doc },
+    { "begin_batch", ( PyCFunction )AtomCList_begin_batch, METH_NOARGS, c_begin_batch_doc },
+    { "end_batch", ( PyCFunction )AtomCList_end_batch, METH_NOARGS, c_end_batch_doc },
     { 0 }  /* sentinel */
 };
 
@@ -1207,6 +1637,12 @@ bool AtomCList::Ready()
     }
     AtomCList_Type_slots[0].pfunc = void_cast( AtomList::TypeObject );
 
+    AtomCListBatch_Type = pytype_cast( PyType_FromSpec( &AtomCListBatch_TypeObject_Spec ) );
+    if( !AtomCListBatch_Type )
+    {
+        return false;  // LCOV_EXCL_LINE (failed type creation)
+    }
+
     // The reference will be handled by the module to which we will add the type
 	TypeObject = pytype_cast( PyType_FromSpec( &TypeObject_Spec ) );
     if( !TypeObject )
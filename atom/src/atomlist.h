@@ -25,6 +25,8 @@ struct AtomList
 	PyListObject list;
     Member* validator;
     CAtomPointer* pointer;
+    bool unvalidated;
+    bool validating;  // a deferred validation is running
 
 	static PyType_Spec TypeObject_Spec;
 
@@ -34,6 +36,9 @@ struct AtomList
 
     static PyObject* New( Py_ssize_t size, CAtom* atom, Member* validator );
 
+    // Validate the items of a list whose validation was deferred.
+    static int ValidateAll( AtomList* list );
+
     static bool TypeCheck( PyObject* ob )
 	{
 		return PyObject_TypeCheck( ob, TypeObject ) != 0;
@@ -51,7 +56,12 @@ struct AtomCList
 	PyListObject list;
     Member* validator;
     CAtomPointer* pointer;
+    bool unvalidated;  // must share the AtomList layout
+    bool validating;
     Member* member;
+    PyObject* batch_changes;  // list of pending changes, null out of a batch
+    Py_ssize_t batch_depth;
+    bool batch_merging;  // the last pending change merges appends
 
 	static PyType_Spec TypeObject_Spec;
 
@@ -0,0 +1,1409 @@
+/*-----------------------------------------------------------------------------
+| Copyright (c) 2025, Nucleic Development Team.
+|
+| Distributed under the terms of the Modified BSD License.
+|
+| The full license is in the file LICENSE, distributed with this software.
+|----------------------------------------------------------------------------*/
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <vector>
+#include <cppy/cppy.h>
+#include "atomnumlist.h"
+#include "memberchange.h"
+#include "packagenaming.h"
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wdeprecated-writable-strings"
+#endif
+
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#endif
+
+namespace atom
+{
+
+
+namespace
+{
+
+const char* kind_names[] = { "int", "float", "bool" };
+
+const char* kind_formats[] = { "q", "d", "?" };
+
+// Exported in place of the storage of an empty list.
+char empty_storage[ 8 ];
+
+
+inline Py_ssize_t
+itemsize( NumericKind::Kind kind )
+{
+    return kind == NumericKind::Bool ? 1 : 8;
+}
+
+
+// Borrowed reference to the type of the items of a kind.
+inline PyObject*
+kind_type( NumericKind::Kind kind )
+{
+    switch( kind )
+    {
+        case NumericKind::Int:
+            return pyobject_cast( &PyLong_Type );
+        case NumericKind::Float:
+            return pyobject_cast( &PyFloat_Type );
+        default:
+            return pyobject_cast( &PyBool_Type );
+    }
+}
+
+
+inline char*
+item_ptr( AtomNumList* list, Py_ssize_t index )
+{
+    return list->data + index * itemsize( list->kind );
+}
+
+
+PyObject*
+box( AtomNumList* list, Py_ssize_t index )
+{
+    const char* p = item_ptr( list, index );
+    switch( list->kind )
+    {
+        case NumericKind::Int:
+            return PyLong_FromLongLong( *reinterpret_cast<const int64_t*>( p ) );
+        case NumericKind::Float:
+            return PyFloat_FromDouble( *reinterpret_cast<const double*>( p ) );
+        default:
+            return cppy::incref( *p ? Py_True : Py_False );
+    }
+}
+
+
+// Box count items starting at start into a new list.
+PyObject*
+box_items( AtomNumList* list, Py_ssize_t start, Py_ssize_t count, Py_ssize_t step = 1 )
+{
+    cppy::ptr items( PyList_New( count ) );
+    if( !items )
+        return 0;  // LCOV_EXCL_LINE
+    for( Py_ssize_t i = 0, cur = start; i < count; ++i, cur += step )
+    {
+        PyObject* item = box( list, cur );
+        if( !item )
+            return 0;  // LCOV_EXCL_LINE
+        PyList_SET_ITEM( items.get(), i, item );
+    }
+    return items.release();
+}
+
+
+PyObject*
+item_type_fail( AtomNumList* list, PyObject* item )
+{
+    if( QuietValidation::fail( list->member, list->pointer->data(), PyExc_TypeError ) )
+        return 0;
+    CAtom* atom = list->pointer->data();
+    if( list->member && atom )
+        return PyErr_Format(
+            PyExc_TypeError,
+            "The items of the '%s' member on the '%s' object must be of type '%s'. "
+            "Got object of type '%s' instead.",
+            PyUnicode_AsUTF8( list->member->name ),
+            Py_TYPE( pyobject_cast( atom ) )->tp_name,
+            kind_names[ list->kind ],
+            Py_TYPE( item )->tp_name
+        );
+    return PyErr_Format(
+        PyExc_TypeError,
+        "The items of the atomnumlist must be of type '%s'. "
+        "Got object of type '%s' instead.",
+        kind_names[ list->kind ],
+        Py_TYPE( item )->tp_name
+    );
+}
+
+
+PyObject*
+item_range_fail( AtomNumList* list )
+{
+    if( QuietValidation::fail( list->member, list->pointer->data(), PyExc_ValueError ) )
+        return 0;
+    const char* type = list->kind == NumericKind::Int ? "integer" : "float";
+    CAtom* atom = list->pointer->data();
+    if( list->member && atom )
+        return PyErr_Format(
+            PyExc_ValueError,
+            "The items of the '%s' member on the '%s' object must be representable "
+            "as a 64-bit %s.",
+            PyUnicode_AsUTF8( list->member->name ),
+            Py_TYPE( pyobject_cast( atom ) )->tp_name,
+            type
+        );
+    return PyErr_Format(
+        PyExc_ValueError,
+        "The items of the atomnumlist must be representable as a 64-bit %s.",
+        type
+    );
+}
+
+
+// Convert an item to the native type of the list, written at out.
+bool
+convert_item( AtomNumList* list, PyObject* item, char* out )
+{
+    switch( list->kind )
+    {
+        case NumericKind::Int:
+        {
+            if( !PyLong_Check( item ) )
+            {
+                item_type_fail( list, item );
+                return false;
+            }
+            int overflow = 0;
+            long long value = PyLong_AsLongLongAndOverflow( item, &overflow );
+            if( overflow )
+            {
+                item_range_fail( list );
+                return false;
+            }
+            if( value == -1 && PyErr_Occurred() )
+                return false;  // LCOV_EXCL_LINE
+            *reinterpret_cast<int64_t*>( out ) = value;
+            return true;
+        }
+        case NumericKind::Float:
+        {
+            double value;
+            if( PyFloat_Check( item ) )
+                value = PyFloat_AS_DOUBLE( item );
+            else if( PyLong_Check( item ) )
+            {
+                value = PyLong_AsDouble( item );
+                if( value == -1.0 && PyErr_Occurred() )
+                {
+                    PyErr_Clear();
+                    item_range_fail( list );
+                    return false;
+                }
+            }
+            else
+            {
+                item_type_fail( list, item );
+                return false;
+            }
+            *reinterpret_cast<double*>( out ) = value;
+            return true;
+        }
+        default:
+        {
+            if( !PyBool_Check( item ) )
+            {
+                item_type_fail( list, item );
+                return false;
+            }
+            *out = item == Py_True ? 1 : 0;
+            return true;
+        }
+    }
+}
+
+
+// Bytes of a foreign buffer may hold any value, stored bools are 0 or 1.
+void
+normalize_bools( char* data, Py_ssize_t count )
+{
+    for( Py_ssize_t i = 0; i < count; ++i )
+        data[ i ] = data[ i ] != 0;
+}
+
+
+// Whether a buffer format describes the native items of a kind.
+bool
+same_format( const char* format, NumericKind::Kind kind )
+{
+    if( !format )
+        return false;
+#if PY_LITTLE_ENDIAN
+    if( *format == '@' || *format == '=' || *format == '<' )
+#else
+    if( *format == '@' || *format == '=' || *format == '>' || *format == '!' )
+#endif
+        ++format;
+    if( format[ 0 ] == '\0' || format[ 1 ] != '\0' )
+        return false;
+    switch( kind )
+    {
+        case NumericKind::Int:
+            return format[ 0 ] == 'q' || format[ 0 ] == 'l' || format[ 0 ] == 'n';
+        case NumericKind::Float:
+            return format[ 0 ] == 'd';
+        default:
+            return format[ 0 ] == '?';
+    }
+}
+
+
+bool
+check_resizable( AtomNumList* list )
+{
+    if( list->exports > 0 )
+    {
+        PyErr_SetString(
+            PyExc_BufferError,
+            "Existing exports of data: object cannot be re-sized"
+        );
+        return false;
+    }
+    return true;
+}
+
+
+// Resize the storage, the content of the added items is left undefined.
+bool
+resize( AtomNumList* list, Py_ssize_t newsize )
+{
+    if( newsize == list->size )
+        return true;
+    if( !check_resizable( list ) )
+        return false;
+    if( newsize <= list->allocated && newsize >= ( list->allocated >> 1 ) )
+    {
+        list->size = newsize;
+        return true;
+    }
+    // Over allocate proportionally to the size like lists do.
+    size_t isize = static_cast<size_t>( itemsize( list->kind ) );
+    size_t allocated = newsize + ( newsize >> 3 ) + ( newsize < 9 ? 3 : 6 );
+    if( newsize == 0 )
+        allocated = 0;
+    if( allocated > static_cast<size_t>( PY_SSIZE_T_MAX ) / isize )
+    {
+        PyErr_NoMemory();
+        return false;
+    }
+    char* data = 0;
+    if( allocated > 0 )
+    {
+        data = reinterpret_cast<char*>( PyMem_Realloc( list->data, allocated * isize ) );
+        if( !data )
+        {
+            PyErr_NoMemory();
+            return false;
+        }
+    }
+    else
+        PyMem_Free( list->data );
+    list->data = data;
+    list->allocated = allocated;
+    list->size = newsize;
+    return true;
+}
+
+
+// Replace the items in [low, high) by count native items read from src.
+bool
+replace_items( AtomNumList* list, Py_ssize_t low, Py_ssize_t high, const char* src, Py_ssize_t count )
+{
+    Py_ssize_t isize = itemsize( list->kind );
+    Py_ssize_t oldsize = list->size;
+    Py_ssize_t delta = count - ( high - low );
+    list->touch();
+    if( delta > 0 )
+    {
+        if( !resize( list, oldsize + delta ) )
+            return false;
+        memmove( item_ptr( list, high + delta ), item_ptr( list, high ), ( oldsize - high ) * isize );
+    }
+    else if( delta < 0 )
+    {
+        if( !check_resizable( list ) )
+            return false;
+        memmove( item_ptr( list, low + count ), item_ptr( list, high ), ( oldsize - high ) * isize );
+        if( !resize( list, oldsize + delta ) )
+            return false;  // LCOV_EXCL_LINE (shrinking cannot fail)
+    }
+    if( count > 0 )
+        memcpy( item_ptr( list, low ), src, count * isize );
+    return true;
+}
+
+
+// Convert the items of a value into native items. A numeric list of the same
+// kind or a buffer of matching format is copied as is.
+bool
+collect_items( AtomNumList* list, PyObject* value, std::vector<char>& items )
+{
+    Py_ssize_t isize = itemsize( list->kind );
+    if( AtomNumList::TypeCheck( value ) )
+    {
+        AtomNumList* source = atomnumlist_cast( value );
+        if( source->kind == list->kind )
+        {
+            items.assign( source->data, source->data + source->size * isize );
+            return true;
+        }
+    }
+    else if( PyObject_CheckBuffer( value ) )
+    {
+        Py_buffer view;
+        if( PyObject_GetBuffer( value, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS ) == 0 )
+        {
+            bool match = view.ndim <= 1 && view.itemsize == isize &&
+                same_format( view.format, list->kind );
+            if( match )
+            {
+                const char* buf = reinterpret_cast<const char*>( view.buf );
+                items.assign( buf, buf + view.len );
+                if( list->kind == NumericKind::Bool )
+                    normalize_bools( items.data(), view.len );
+            }
+            PyBuffer_Release( &view );
+            if( match )
+                return true;
+        }
+        else
+            PyErr_Clear();
+    }
+    cppy::ptr seq( PySequence_Fast( value, "expected a sequence of numbers" ) );
+    if( !seq )
+        return false;
+    Py_ssize_t count = PySequence_Fast_GET_SIZE( seq.get() );
+    items.resize( count * isize );
+    PyObject** source = PySequence_Fast_ITEMS( seq.get() );
+    for( Py_ssize_t i = 0; i < count; ++i )
+    {
+        if( !convert_item( list, source[ i ], &items[ i * isize ] ) )
+            return false;
+    }
+    return true;
+}
+
+
+// Index of the first item equal to value in [start, stop), -1 if there is
+// none and -2 on error. Values of the native type are compared unboxed.
+Py_ssize_t
+find_item( AtomNumList* list, PyObject* value, Py_ssize_t start, Py_ssize_t stop )
+{
+    stop = std::min( stop, list->size );
+    char native[ 8 ];
+    bool exact = false;
+    switch( list->kind )
+    {
+        case NumericKind::Int:
+            exact = PyLong_CheckExact( value );
+            break;
+        case NumericKind::Float:
+            exact = PyFloat_CheckExact( value );
+            break;
+        default:
+            exact = PyBool_Check( value );
+            break;
+    }
+    if( exact )
+    {
+        if( !convert_item( list, value, native ) )
+        {
+            // An int out of the int64 range is not in the list.
+            PyErr_Clear();
+            return -1;
+        }
+        Py_ssize_t isize = itemsize( list->kind );
+        for( Py_ssize_t i = start; i < stop; ++i )
+        {
+            if( list->kind == NumericKind::Float ?
+                    *reinterpret_cast<double*>( item_ptr( list, i ) ) ==
+                    *reinterpret_cast<double*>( native ) :
+                    memcmp( item_ptr( list, i ), native, isize ) == 0 )
+                return i;
+        }
+        return -1;
+    }
+    for( Py_ssize_t i = start; i < std::min( stop, list->size ); ++i )
+    {
+        cppy::ptr item( box( list, i ) );
+        if( !item )
+            return -2;  // LCOV_EXCL_LINE
+        int res = PyObject_RichCompareBool( item.get(), value, Py_EQ );
+        if( res < 0 )
+            return -2;
+        if( res == 1 )
+            return i;
+    }
+    return -1;
+}
+
+
+// Whether the changes of the list are observed. The atom is returned in atom.
+bool
+observed( AtomNumList* list, CAtom*& atom )
+{
+    atom = list->pointer->data();
+    return list->member && atom && MemberChange::container_observed( atom, list->member );
+}
+
+
+// Notify a change of the list carrying up to three payload entries.
+bool
+post_change(
+    AtomNumList* list,
+    CAtom* atom,
+    ContainerOp::Op operation,
+    const char* key = 0,
+    PyObject* value = 0,
+    const char* key2 = 0,
+    PyObject* value2 = 0,
+    const char* key3 = 0,
+    PyObject* value3 = 0 )
+{
+    cppy::ptr change( MemberChange::container( atom, list->member, pyobject_cast( list ), operation ) );
+    if( !change )
+        return false;
+    if( key && PyDict_SetItemString( change.get(), key, value ) != 0 )
+        return false;
+    if( key2 && PyDict_SetItemString( change.get(), key2, value2 ) != 0 )
+        return false;
+    if( key3 && PyDict_SetItemString( change.get(), key3, value3 ) != 0 )
+        return false;
+    return MemberChange::notify_container( atom, list->member, change.get() );
+}
+
+
+PyObject*
+AtomNumList_new( PyTypeObject* type, PyObject* args, PyObject* kwargs )
+{
+    static char* kwlist[] = { "kind", "items", 0 };
+    PyObject* pykind;
+    PyObject* items = 0;
+    if( !PyArg_ParseTupleAndKeywords( args, kwargs, "O|O:atomnumlist", kwlist, &pykind, &items ) )
+        return 0;
+    NumericKind::Kind kind;
+    if( !AtomNumList::KindFromType( pykind, kind ) )
+        return cppy::type_error( pykind, "int, float or bool" );
+    cppy::ptr self( PyType_GenericAlloc( type, 0 ) );
+    if( !self )
+        return 0;  // LCOV_EXCL_LINE (failed instance creation)
+    AtomNumList* list = atomnumlist_cast( self.get() );
+    list->kind = kind;
+    list->pointer = new CAtomPointer();
+    list->touch();
+    if( items && AtomNumList::Assign( list, items ) < 0 )
+        return 0;
+    return self.release();
+}
+
+
+int
+AtomNumList_clear( AtomNumList* self )
+{
+    Py_CLEAR( self->member );
+    return 0;
+}
+
+
+int
+AtomNumList_traverse( AtomNumList* self, visitproc visit, void* arg )
+{
+    Py_VISIT( self->member );
+    Py_VISIT( Py_TYPE( self ) );
+    return 0;
+}
+
+
+void
+AtomNumList_dealloc( AtomNumList* self )
+{
+    PyObject_GC_UnTrack( self );
+    cppy::clear( &self->member );
+    delete self->pointer;
+    self->pointer = 0;
+    PyMem_Free( self->data );
+    self->data = 0;
+    PyTypeObject* type = Py_TYPE( self );
+    type->tp_free( pyobject_cast( self ) );
+    Py_DECREF( type );
+}
+
+
+Py_ssize_t
+AtomNumList_length( AtomNumList* self )
+{
+    return self->size;
+}
+
+
+PyObject*
+AtomNumList_item( AtomNumList* self, Py_ssize_t index )
+{
+    if( index < 0 || index >= self->size )
+    {
+        PyErr_SetString( PyExc_IndexError, "atomnumlist index out of range" );
+        return 0;
+    }
+    return box( self, index );
+}
+
+
+PyObject*
+AtomNumList_subscript( AtomNumList* self, PyObject* key )
+{
+    if( PyIndex_Check( key ) )
+    {
+        Py_ssize_t index = PyNumber_AsSsize_t( key, PyExc_IndexError );
+        if( index == -1 && PyErr_Occurred() )
+            return 0;
+        if( index < 0 )
+            index += self->size;
+        return AtomNumList_item( self, index );
+    }
+    if( !PySlice_Check( key ) )
+        return PyErr_Format(
+            PyExc_TypeError,
+            "atomnumlist indices must be integers or slices, not %s",
+            Py_TYPE( key )->tp_name
+        );
+    Py_ssize_t start, stop, step;
+    if( PySlice_Unpack( key, &start, &stop, &step ) < 0 )
+        return 0;
+    Py_ssize_t count = PySlice_AdjustIndices( self->size, &start, &stop, step );
+    cppy::ptr res( AtomNumList::New( self->kind, 0, 0 ) );
+    if( !res )
+        return 0;  // LCOV_EXCL_LINE
+    AtomNumList* slice = atomnumlist_cast( res.get() );
+    if( !resize( slice, count ) )
+        return 0;  // LCOV_EXCL_LINE
+    Py_ssize_t isize = itemsize( self->kind );
+    if( step == 1 )
+    {
+        if( count > 0 )
+            memcpy( slice->data, item_ptr( self, start ), count * isize );
+    }
+    else
+    {
+        for( Py_ssize_t i = 0, cur = start; i < count; ++i, cur += step )
+            memcpy( item_ptr( slice, i ), item_ptr( self, cur ), isize );
+    }
+    return res.release();
+}
+
+
+int
+set_index( AtomNumList* self, Py_ssize_t index, PyObject* value )
+{
+    if( index < 0 )
+        index += self->size;
+    if( index < 0 || index >= self->size )
+    {
+        PyErr_SetString( PyExc_IndexError, "atomnumlist assignment index out of range" );
+        return -1;
+    }
+    CAtom* atom;
+    bool obs = observed( self, atom );
+    cppy::ptr olditem;
+    if( obs && !( olditem = box( self, index ) ) )
+        return -1;  // LCOV_EXCL_LINE
+    if( value )
+    {
+        char native[ 8 ];
+        if( !convert_item( self, value, native ) )
+            return -1;
+        self->touch();
+        memcpy( item_ptr( self, index ), native, itemsize( self->kind ) );
+    }
+    else if( !replace_items( self, index, index + 1, 0, 0 ) )
+        return -1;
+    if( !obs )
+        return 0;
+    cppy::ptr pyindex( PyLong_FromSsize_t( index ) );
+    if( !pyindex )
+        return -1;  // LCOV_EXCL_LINE
+    if( !value )
+        return post_change(
+            self, atom, ContainerOp::DelItem, "index", pyindex.get(), "item", olditem.get()
+        ) ? 0 : -1;
+    cppy::ptr newitem( box( self, index ) );
+    if( !newitem )
+        return -1;  // LCOV_EXCL_LINE
+    return post_change(
+        self, atom, ContainerOp::SetItem,
+        "index", pyindex.get(), "olditem", olditem.get(), "newitem", newitem.get()
+    ) ? 0 : -1;
+}
+
+
+// Delete the items of an extended slice by compacting the storage.
+bool
+delete_extended_slice( AtomNumList* self, Py_ssize_t start, Py_ssize_t step, Py_ssize_t count )
+{
+    if( !check_resizable( self ) )
+        return false;
+    if( step < 0 )
+    {
+        start += step * ( count - 1 );
+        step = -step;
+    }
+    Py_ssize_t isize = itemsize( self->kind );
+    Py_ssize_t dest = start;
+    Py_ssize_t next = start;
+    Py_ssize_t removed = 0;
+    for( Py_ssize_t cur = start; cur < self->size; ++cur )
+    {
+        if( removed < count && cur == next )
+        {
+            ++removed;
+            next += step;
+            continue;
+        }
+        memcpy( item_ptr( self, dest++ ), item_ptr( self, cur ), isize );
+    }
+    self->touch();
+    return resize( self, self->size - count );
+}
+
+
+int
+set_slice( AtomNumList* self, PyObject* key, PyObject* value )
+{
+    Py_ssize_t start, stop, step;
+    if( PySlice_Unpack( key, &start, &stop, &step ) < 0 )
+        return -1;
+    Py_ssize_t count = PySlice_AdjustIndices( self->size, &start, &stop, step );
+    std::vector<char> items;
+    if( value && !collect_items( self, value, items ) )
+        return -1;
+    Py_ssize_t isize = itemsize( self->kind );
+    Py_ssize_t newcount = items.size() / isize;
+    if( value && step != 1 && newcount != count )
+    {
+        PyErr_Format(
+            PyExc_ValueError,
+            "attempt to assign sequence of size %zd to extended slice of size %zd",
+            newcount,
+            count
+        );
+        return -1;
+    }
+    CAtom* atom;
+    bool obs = observed( self, atom );
+    cppy::ptr olditems;
+    if( obs && !( olditems = box_items( self, start, count, step ) ) )
+        return -1;  // LCOV_EXCL_LINE
+    if( step == 1 )
+    {
+        if( !replace_items( self, start, start + count, items.data(), newcount ) )
+            return -1;
+    }
+    else if( value )
+    {
+        self->touch();
+        for( Py_ssize_t i = 0, cur = start; i < count; ++i, cur += step )
+            memcpy( item_ptr( self, cur ), &items[ i * isize ], isize );
+    }
+    else if( count > 0 && !delete_extended_slice( self, start, step, count ) )
+        return -1;
+    if( !obs )
+        return 0;
+    if( !value )
+        return post_change(
+            self, atom, ContainerOp::DelItem, "index", key, "item", olditems.get()
+        ) ? 0 : -1;
+    cppy::ptr newitems( step == 1 ?
+        box_items( self, start, newcount ) : box_items( self, start, count, step ) );
+    if( !newitems )
+        return -1;  // LCOV_EXCL_LINE
+    return post_change(
+        self, atom, ContainerOp::SetItem,
+        "index", key, "olditem", olditems.get(), "newitem", newitems.get()
+    ) ? 0 : -1;
+}
+
+
+int
+AtomNumList_ass_item( AtomNumList* self, Py_ssize_t index, PyObject* value )
+{
+    return set_index( self, index, value );
+}
+
+
+int
+AtomNumList_ass_subscript( AtomNumList* self, PyObject* key, PyObject* value )
+{
+    if( PyIndex_Check( key ) )
+    {
+        Py_ssize_t index = PyNumber_AsSsize_t( key, PyExc_IndexError );
+        if( index == -1 && PyErr_Occurred() )
+            return -1;
+        return set_index( self, index, value );
+    }
+    if( PySlice_Check( key ) )
+        return set_slice( self, key, value );
+    PyErr_Format(
+        PyExc_TypeError,
+        "atomnumlist indices must be integers or slices, not %s",
+        Py_TYPE( key )->tp_name
+    );
+    return -1;
+}
+
+
+int
+AtomNumList_contains( AtomNumList* self, PyObject* value )
+{
+    Py_ssize_t index = find_item( self, value, 0, self->size );
+    return index == -2 ? -1 : index >= 0;
+}
+
+
+// Add items at the end of the list and notify them under operation.
+bool
+extend_items( AtomNumList* self, PyObject* value, ContainerOp::Op operation )
+{
+    std::vector<char> items;
+    if( !collect_items( self, value, items ) )
+        return false;
+    Py_ssize_t start = self->size;
+    Py_ssize_t count = items.size() / itemsize( self->kind );
+    if( !replace_items( self, start, start, items.data(), count ) )
+        return false;
+    CAtom* atom;
+    if( observed( self, atom ) )
+    {
+        cppy::ptr added( box_items( self, start, count ) );
+        if( !added || !post_change( self, atom, operation, "items", added.get() ) )
+            return false;
+    }
+    return true;
+}
+
+
+PyObject*
+AtomNumList_inplace_concat( AtomNumList* self, PyObject* value )
+{
+    if( !extend_items( self, value, ContainerOp::Iadd ) )
+        return 0;
+    return cppy::incref( pyobject_cast( self ) );
+}
+
+
+PyObject*
+AtomNumList_inplace_repeat( AtomNumList* self, Py_ssize_t count )
+{
+    Py_ssize_t size = self->size;
+    if( count < 1 )
+        count = 0;
+    if( size > 0 && count > PY_SSIZE_T_MAX / size )
+        return PyErr_NoMemory();
+    self->touch();
+    if( !resize( self, size * count ) )
+        return 0;
+    Py_ssize_t nbytes = size * itemsize( self->kind );
+    for( Py_ssize_t i = 1; i < count; ++i )
+        memcpy( self->data + i * nbytes, self->data, nbytes );
+    CAtom* atom;
+    if( observed( self, atom ) )
+    {
+        cppy::ptr pycount( PyLong_FromSsize_t( count ) );
+        if( !pycount || !post_change( self, atom, ContainerOp::Imul, "count", pycount.get() ) )
+            return 0;
+    }
+    return cppy::incref( pyobject_cast( self ) );
+}
+
+
+PyObject*
+AtomNumList_richcompare( AtomNumList* self, PyObject* other, int op )
+{
+    if( ( op != Py_EQ && op != Py_NE ) ||
+        !( AtomNumList::TypeCheck( other ) || PyList_Check( other ) || PyTuple_Check( other ) ) )
+        return cppy::incref( Py_NotImplemented );
+    Py_ssize_t size = PySequence_Size( other );
+    if( size < 0 )
+        return 0;  // LCOV_EXCL_LINE
+    bool equal = size == self->size;
+    AtomNumList* list = AtomNumList::TypeCheck( other ) ? atomnumlist_cast( other ) : 0;
+    if( equal && list && list->kind == self->kind && self->kind != NumericKind::Float )
+        equal = size == 0 || memcmp( self->data, list->data, size * itemsize( self->kind ) ) == 0;
+    else if( equal && list && list->kind == self->kind )
+    {
+        const double* first = reinterpret_cast<const double*>( self->data );
+        const double* second = reinterpret_cast<const double*>( list->data );
+        equal = std::equal( first, first + size, second );
+    }
+    else
+    {
+        for( Py_ssize_t i = 0; equal && i < std::min( size, self->size ); ++i )
+        {
+            cppy::ptr item( box( self, i ) );
+            cppy::ptr otheritem( PySequence_GetItem( other, i ) );
+            if( !item || !otheritem )
+                return 0;
+            int res = PyObject_RichCompareBool( item.get(), otheritem.get(), Py_EQ );
+            if( res < 0 )
+                return 0;
+            equal = res == 1;
+        }
+    }
+    return cppy::incref( ( op == Py_EQ ) == equal ? Py_True : Py_False );
+}
+
+
+PyObject*
+AtomNumList_tolist( AtomNumList* self )
+{
+    return box_items( self, 0, self->size );
+}
+
+
+PyObject*
+AtomNumList_repr( AtomNumList* self )
+{
+    cppy::ptr items( AtomNumList_tolist( self ) );
+    if( !items )
+        return 0;  // LCOV_EXCL_LINE
+    return PyObject_Repr( items.get() );
+}
+
+
+PyObject*
+AtomNumList_append( AtomNumList* self, PyObject* value )
+{
+    char native[ 8 ];
+    if( !convert_item( self, value, native ) )
+        return 0;
+    if( !replace_items( self, self->size, self->size, native, 1 ) )
+        return 0;
+    CAtom* atom;
+    if( observed( self, atom ) )
+    {
+        cppy::ptr item( box( self, self->size - 1 ) );
+        if( !item || !post_change( self, atom, ContainerOp::Append, "item", item.get() ) )
+            return 0;
+    }
+    return cppy::incref( Py_None );
+}
+
+
+PyObject*
+AtomNumList_insert( AtomNumList* self, PyObject*const *args, Py_ssize_t nargsf )
+{
+    if( PyVectorcall_NARGS( nargsf ) != 2 || !PyIndex_Check( args[ 0 ] ) )
+        return cppy::type_error( "signature is insert(index: int, value: Any)" );
+    Py_ssize_t index = PyNumber_AsSsize_t( args[ 0 ], PyExc_OverflowError );
+    if( index == -1 && PyErr_Occurred() )
+        return 0;
+    char native[ 8 ];
+    if( !convert_item( self, args[ 1 ], native ) )
+        return 0;
+    if( index < 0 )
+        index = std::max<Py_ssize_t>( index + self->size, 0 );
+    index = std::min( index, self->size );
+    if( !replace_items( self, index, index, native, 1 ) )
+        return 0;
+    CAtom* atom;
+    if( observed( self, atom ) )
+    {
+        cppy::ptr pyindex( PyLong_FromSsize_t( index ) );
+        cppy::ptr item( box( self, index ) );
+        if( !pyindex || !item ||
+            !post_change( self, atom, ContainerOp::Insert, "index", pyindex.get(), "item", item.get() ) )
+            return 0;
+    }
+    return cppy::incref( Py_None );
+}
+
+
+PyObject*
+AtomNumList_extend( AtomNumList* self, PyObject* value )
+{
+    if( !extend_items( self, value, ContainerOp::Extend ) )
+        return 0;
+    return cppy::incref( Py_None );
+}
+
+
+PyObject*
+AtomNumList_pop( AtomNumList* self, PyObject*const *args, Py_ssize_t nargsf )
+{
+    Py_ssize_t nargs = PyVectorcall_NARGS( nargsf );
+    if( nargs > 1 )
+        return cppy::type_error( "signature is pop(index: int = -1)" );
+    Py_ssize_t index = -1;
+    if( nargs == 1 )
+    {
+        index = PyNumber_AsSsize_t( args[ 0 ], PyExc_IndexError );
+        if( index == -1 && PyErr_Occurred() )
+            return 0;
+    }
+    if( self->size == 0 )
+    {
+        PyErr_SetString( PyExc_IndexError, "pop from empty atomnumlist" );
+        return 0;
+    }
+    if( index < 0 )
+        index += self->size;
+    if( index < 0 || index >= self->size )
+    {
+        PyErr_SetString( PyExc_IndexError, "pop index out of range" );
+        return 0;
+    }
+    cppy::ptr item( box( self, index ) );
+    if( !item || !replace_items( self, index, index + 1, 0, 0 ) )
+        return 0;
+    CAtom* atom;
+    if( observed( self, atom ) )
+    {
+        cppy::ptr pyindex( PyLong_FromSsize_t( index ) );
+        if( !pyindex ||
+            !post_change( self, atom, ContainerOp::Pop, "index", pyindex.get(), "item", item.get() ) )
+            return 0;
+    }
+    return item.release();
+}
+
+
+PyObject*
+AtomNumList_remove( AtomNumList* self, PyObject* value )
+{
+    Py_ssize_t index = find_item( self, value, 0, self->size );
+    if( index == -2 )
+        return 0;
+    if( index == -1 )
+    {
+        PyErr_SetString( PyExc_ValueError, "atomnumlist.remove(x): x not in list" );
+        return 0;
+    }
+    cppy::ptr item( box( self, index ) );
+    if( !item || !replace_items( self, index, index + 1, 0, 0 ) )
+        return 0;
+    CAtom* atom;
+    if( observed( self, atom ) && !post_change( self, atom, ContainerOp::Remove, "item", item.get() ) )
+        return 0;
+    return cppy::incref( Py_None );
+}
+
+
+PyObject*
+AtomNumList_clear_items( AtomNumList* self )
+{
+    CAtom* atom;
+    bool obs = observed( self, atom );
+    cppy::ptr items;
+    if( obs && !( items = AtomNumList_tolist( self ) ) )
+        return 0;  // LCOV_EXCL_LINE
+    if( !replace_items( self, 0, self->size, 0, 0 ) )
+        return 0;
+    if( obs && !post_change( self, atom, ContainerOp::Clear, "items", items.get() ) )
+        return 0;
+    return cppy::incref( Py_None );
+}
+
+
+PyObject*
+AtomNumList_reverse( AtomNumList* self )
+{
+    self->touch();
+    switch( self->kind )
+    {
+        case NumericKind::Int:
+        case NumericKind::Float:
+        {
+            int64_t* data = reinterpret_cast<int64_t*>( self->data );
+            std::reverse( data, data + self->size );
+            break;
+        }
+        default:
+            std::reverse( self->data, self->data + self->size );
+            break;
+    }
+    CAtom* atom;
+    if( observed( self, atom ) && !post_change( self, atom, ContainerOp::Reverse ) )
+        return 0;
+    return cppy::incref( Py_None );
+}
+
+
+PyObject*
+AtomNumList_sort( AtomNumList* self, PyObject* args, PyObject* kwargs )
+{
+    static char* kwlist[] = { "reverse", 0 };
+    int reverse = 0;
+    if( !PyArg_ParseTupleAndKeywords( args, kwargs, "|$p:sort", kwlist, &reverse ) )
+        return 0;
+    self->touch();
+    switch( self->kind )
+    {
+        case NumericKind::Int:
+        {
+            int64_t* data = reinterpret_cast<int64_t*>( self->data );
+            if( reverse )
+                std::sort( data, data + self->size, std::greater<int64_t>() );
+            else
+                std::sort( data, data + self->size );
+            break;
+        }
+        case NumericKind::Float:
+        {
+            // NaNs are moved to the end so that the ordering is strict weak.
+            double* data = reinterpret_cast<double*>( self->data );
+            double* end = std::stable_partition(
+                data, data + self->size, []( double v ) { return !std::isnan( v ); }
+            );
+            if( reverse )
+                std::stable_sort( data, end, std::greater<double>() );
+            else
+                std::stable_sort( data, end );
+            break;
+        }
+        default:
+        {
+            Py_ssize_t trues = std::count( self->data, self->data + self->size, 1 );
+            Py_ssize_t falses = self->size - trues;
+            memset( self->data, reverse ? 1 : 0, reverse ? trues : falses );
+            memset( self->data + ( reverse ? trues : falses ), reverse ? 0 : 1, reverse ? falses : trues );
+            break;
+        }
+    }
+    CAtom* atom;
+    if( observed( self, atom ) &&
+        !post_change( self, atom, ContainerOp::Sort, "key", Py_None, "reverse", reverse ? Py_True : Py_False ) )
+        return 0;
+    return cppy::incref( Py_None );
+}
+
+
+PyObject*
+AtomNumList_index( AtomNumList* self, PyObject* args )
+{
+    PyObject* value;
+    Py_ssize_t start = 0;
+    Py_ssize_t stop = PY_SSIZE_T_MAX;
+    if( !PyArg_ParseTuple( args, "O|nn:index", &value, &start, &stop ) )
+        return 0;
+    if( start < 0 )
+        start = std::max<Py_ssize_t>( start + self->size, 0 );
+    if( stop < 0 )
+        stop = std::max<Py_ssize_t>( stop + self->size, 0 );
+    Py_ssize_t index = find_item( self, value, start, stop );
+    if( index == -2 )
+        return 0;
+    if( index == -1 )
+    {
+        PyErr_SetString( PyExc_ValueError, "atomnumlist.index(x): x not in list" );
+        return 0;
+    }
+    return PyLong_FromSsize_t( index );
+}
+
+
+PyObject*
+AtomNumList_count( AtomNumList* self, PyObject* value )
+{
+    Py_ssize_t count = 0;
+    Py_ssize_t index = find_item( self, value, 0, self->size );
+    while( index >= 0 )
+    {
+        ++count;
+        index = find_item( self, value, index + 1, self->size );
+    }
+    if( index == -2 )
+        return 0;
+    return PyLong_FromSsize_t( count );
+}
+
+
+PyObject*
+AtomNumList_copy( AtomNumList* self )
+{
+    cppy::ptr res( AtomNumList::New( self->kind, 0, 0 ) );
+    if( !res || AtomNumList::Assign( atomnumlist_cast( res.get() ), pyobject_cast( self ) ) < 0 )
+        return 0;  // LCOV_EXCL_LINE
+    return res.release();
+}
+
+
+PyObject*
+AtomNumList_from_buffer( PyObject* type, PyObject* args )
+{
+    PyObject* pykind;
+    PyObject* buffer;
+    if( !PyArg_ParseTuple( args, "OO:from_buffer", &pykind, &buffer ) )
+        return 0;
+    NumericKind::Kind kind;
+    if( !AtomNumList::KindFromType( pykind, kind ) )
+        return cppy::type_error( pykind, "int, float or bool" );
+    Py_buffer view;
+    if( PyObject_GetBuffer( buffer, &view, PyBUF_SIMPLE ) < 0 )
+        return 0;
+    cppy::ptr res( AtomNumList::New( kind, 0, 0 ) );
+    AtomNumList* list = res ? atomnumlist_cast( res.get() ) : 0;
+    bool ok = list != 0;
+    if( ok && view.len % itemsize( kind ) != 0 )
+    {
+        PyErr_SetString( PyExc_ValueError, "buffer size is not a multiple of the item size" );
+        ok = false;
+    }
+    if( ok )
+        ok = replace_items(
+            list, 0, 0, reinterpret_cast<const char*>( view.buf ), view.len / itemsize( kind )
+        );
+    PyBuffer_Release( &view );
+    if( ok && kind == NumericKind::Bool )
+        normalize_bools( list->data, list->size );
+    return ok ? res.release() : 0;
+}
+
+
+PyObject*
+AtomNumList_reduce_ex( AtomNumList* self, PyObject* protocol )
+{
+    long proto = PyLong_AsLong( protocol );
+    if( proto == -1 && PyErr_Occurred() )
+        return 0;
+    cppy::ptr factory( PyObject_GetAttrString( pyobject_cast( AtomNumList::TypeObject ), "from_buffer" ) );
+    if( !factory )
+        return 0;  // LCOV_EXCL_LINE
+    // Protocol 5 lets the pickler transfer the storage out-of-band.
+    cppy::ptr buffer( proto >= 5 ?
+        PyPickleBuffer_FromObject( pyobject_cast( self ) ) :
+        PyBytes_FromStringAndSize( self->data, self->size * itemsize( self->kind ) ) );
+    if( !buffer )
+        return 0;  // LCOV_EXCL_LINE
+    return Py_BuildValue( "(O(OO))", factory.get(), kind_type( self->kind ), buffer.get() );
+}
+
+
+PyObject*
+AtomNumList_sizeof( AtomNumList* self )
+{
+    Py_ssize_t size = Py_TYPE( self )->tp_basicsize + self->allocated * itemsize( self->kind );
+    return PyLong_FromSsize_t( size );
+}
+
+
+int
+AtomNumList_getbuffer( AtomNumList* self, Py_buffer* view, int flags )
+{
+    if( flags & PyBUF_WRITABLE )
+    {
+        // Writes through a buffer would bypass validation and notifications.
+        PyErr_SetString( PyExc_BufferError, "atomnumlist buffers are read-only" );
+        view->obj = 0;
+        return -1;
+    }
+    view->obj = cppy::incref( pyobject_cast( self ) );
+    view->buf = self->data ? self->data : empty_storage;
+    view->itemsize = itemsize( self->kind );
+    view->len = self->size * view->itemsize;
+    view->readonly = 1;
+    view->ndim = 1;
+    view->format = ( flags & PyBUF_FORMAT ) ? const_cast<char*>( kind_formats[ self->kind ] ) : 0;
+    // The size cannot change while the buffer is exported.
+    view->shape = ( flags & PyBUF_ND ) ? &self->size : 0;
+    view->strides = ( flags & PyBUF_STRIDES ) ? &view->itemsize : 0;
+    view->suboffsets = 0;
+    view->internal = 0;
+    ++self->exports;
+    return 0;
+}
+
+
+void
+AtomNumList_releasebuffer( AtomNumList* self, Py_buffer* view )
+{
+    --self->exports;
+}
+
+
+PyObject*
+AtomNumList_get_kind( AtomNumList* self, void* context )
+{
+    return cppy::incref( kind_type( self->kind ) );
+}
+
+
+PyObject*
+AtomNumList_get_itemsize( AtomNumList* self, void* context )
+{
+    return PyLong_FromSsize_t( itemsize( self->kind ) );
+}
+
+
+PyObject*
+AtomNumList_get_version( AtomNumList* self, void* context )
+{
+    return PyLong_FromUnsignedLongLong( self->version );
+}
+
+
+PyDoc_STRVAR(append_doc,
+"L.append(number) -- append number to end");
+PyDoc_STRVAR(insert_doc,
+"L.insert(index, number) -- insert number before index");
+PyDoc_STRVAR(extend_doc,
+"L.extend(sequence) -- extend list by appending the numbers of the sequence");
+PyDoc_STRVAR(pop_doc,
+"L.pop([index]) -> number -- remove and return item at index (default last).\n"
+"Raises IndexError if list is empty or index is out of range.");
+PyDoc_STRVAR(remove_doc,
+"L.remove(value) -- remove first occurrence of value.\n"
+"Raises ValueError if the value is not present.");
+PyDoc_STRVAR(clear_doc,
+"L.clear() -- remove all items");
+PyDoc_STRVAR(reverse_doc,
+"L.reverse() -- reverse *IN PLACE*");
+PyDoc_STRVAR(sort_doc,
+"L.sort(*, reverse=False) -- sort *IN PLACE*, NaNs are moved to the end");
+PyDoc_STRVAR(index_doc,
+"L.index(value, [start, [stop]]) -> integer -- return first index of value.\n"
+"Raises ValueError if the value is not present.");
+PyDoc_STRVAR(count_doc,
+"L.count(value) -> integer -- return number of occurrences of value");
+PyDoc_STRVAR(tolist_doc,
+"L.tolist() -> list -- return the items as a list");
+PyDoc_STRVAR(copy_doc,
+"L.copy() -> atomnumlist -- return a copy not bound to any atom");
+PyDoc_STRVAR(from_buffer_doc,
+"atomnumlist.from_buffer(kind, buffer) -> atomnumlist -- create a list from\n"
+"the raw native items held by a buffer");
+
+
+static PyMethodDef
+AtomNumList_methods[] = {
+    { "append", ( PyCFunction )AtomNumList_append, METH_O, append_doc },
+    { "insert", ( PyCFunction )AtomNumList_insert, METH_FASTCALL, insert_doc },
+    { "extend", ( PyCFunction )AtomNumList_extend, METH_O, extend_doc },
+    { "pop", ( PyCFunction )AtomNumList_pop, METH_FASTCALL, pop_doc },
+    { "remove", ( PyCFunction )AtomNumList_remove, METH_O, remove_doc },
+    { "clear", ( PyCFunction )AtomNumList_clear_items, METH_NOARGS, clear_doc },
+    { "reverse", ( PyCFunction )AtomNumList_reverse, METH_NOARGS, reverse_doc },
+    { "sort", ( PyCFunction )AtomNumList_sort, METH_VARARGS | METH_KEYWORDS, sort_doc },
+    { "index", ( PyCFunction )AtomNumList_index, METH_VARARGS, index_doc },
+    { "count", ( PyCFunction )AtomNumList_count, METH_O, count_doc },
+    { "tolist", ( PyCFunction )AtomNumList_tolist, METH_NOARGS, tolist_doc },
+    { "copy", ( PyCFunction )AtomNumList_copy, METH_NOARGS, copy_doc },
+    { "from_buffer", ( PyCFunction )AtomNumList_from_buffer, METH_VARARGS | METH_CLASS, from_buffer_doc },
+    { "__reduce_ex__", ( PyCFunction )AtomNumList_reduce_ex, METH_O, "" },
+    { "__sizeof__", ( PyCFunction )AtomNumList_sizeof, METH_NOARGS, "" },
+    { 0 }  /* sentinel */
+};
+
+
+static PyGetSetDef
+AtomNumList_getset[] = {
+    { "kind", ( getter )AtomNumList_get_kind, 0,
+      "The type of the items: int, float or bool." },
+    { "itemsize", ( getter )AtomNumList_get_itemsize, 0,
+      "The size in bytes of an item in the storage." },
+    { "version", ( getter )AtomNumList_get_version, 0,
+      "A number drawn anew each time the list is modified." },
+    { 0 }  // sentinel
+};
+
+
+static PyType_Slot AtomNumList_Type_slots[] = {
+    { Py_tp_new, void_cast( AtomNumList_new ) },                        /* tp_new */
+    { Py_tp_dealloc, void_cast( AtomNumList_dealloc ) },                /* tp_dealloc */
+    { Py_tp_traverse, void_cast( AtomNumList_traverse ) },              /* tp_traverse */
+    { Py_tp_clear, void_cast( AtomNumList_clear ) },                    /* tp_clear */
+    { Py_tp_repr, void_cast( AtomNumList_repr ) },                      /* tp_repr */
+    { Py_tp_hash, void_cast( PyObject_HashNotImplemented ) },           /* tp_hash */
+    { Py_tp_richcompare, void_cast( AtomNumList_richcompare ) },        /* tp_richcompare */
+    { Py_tp_methods, void_cast( AtomNumList_methods ) },                /* tp_methods */
+    { Py_tp_getset, void_cast( AtomNumList_getset ) },                  /* tp_getset */
+    { Py_sq_length, void_cast( AtomNumList_length ) },                  /* sq_length */
+    { Py_sq_item, void_cast( AtomNumList_item ) },                      /* sq_item */
+    { Py_sq_ass_item, void_cast( AtomNumList_ass_item ) },              /* sq_ass_item */
+    { Py_sq_contains, void_cast( AtomNumList_contains ) },              /* sq_contains */
+    { Py_sq_inplace_concat, void_cast( AtomNumList_inplace_concat ) },  /* sq_inplace_concat */
+    { Py_sq_inplace_repeat, void_cast( AtomNumList_inplace_repeat ) },  /* sq_inplace_repeat */
+    { Py_mp_length, void_cast( AtomNumList_length ) },                  /* mp_length */
+    { Py_mp_subscript, void_cast( AtomNumList_subscript ) },            /* mp_subscript */
+    { Py_mp_ass_subscript, void_cast( AtomNumList_ass_subscript ) },    /* mp_ass_subscript */
+    { Py_bf_getbuffer, void_cast( AtomNumList_getbuffer ) },            /* bf_getbuffer */
+    { Py_bf_releasebuffer, void_cast( AtomNumList_releasebuffer ) },    /* bf_releasebuffer */
+    { 0, 0 },
+};
+
+
+}  // namespace
+
+
+PyTypeObject* AtomNumList::TypeObject = NULL;
+
+
+PyType_Spec AtomNumList::TypeObject_Spec = {
+    PACKAGE_TYPENAME( "atomnumlist" ),          /* tp_name */
+    sizeof( AtomNumList ),                      /* tp_basicsize */
+    0,                                          /* tp_itemsize */
+    Py_TPFLAGS_DEFAULT
+    |Py_TPFLAGS_BASETYPE
+    |Py_TPFLAGS_HAVE_GC,                        /* tp_flags */
+    AtomNumList_Type_slots                      /* slots */
+};
+
+
+PyObject*
+AtomNumList::New( NumericKind::Kind kind, CAtom* atom, Member* member )
+{
+    cppy::ptr ptr( PyType_GenericAlloc( AtomNumList::TypeObject, 0 ) );
+    if( !ptr )
+        return 0;  // LCOV_EXCL_LINE (failed instance creation)
+    AtomNumList* list = atomnumlist_cast( ptr.get() );
+    list->kind = kind;
+    list->pointer = new CAtomPointer( atom );
+    list->member = reinterpret_cast<Member*>( cppy::xincref( pyobject_cast( member ) ) );
+    list->touch();
+    return ptr.release();
+}
+
+
+int
+AtomNumList::Assign( AtomNumList* list, PyObject* value )
+{
+    std::vector<char> items;
+    if( !collect_items( list, value, items ) )
+        return -1;
+    Py_ssize_t count = items.size() / itemsize( list->kind );
+    if( !replace_items( list, 0, list->size, items.data(), count ) )
+        return -1;
+    // A verbatim copy holds the same items as its source.
+    if( AtomNumList::TypeCheck( value ) && atomnumlist_cast( value )->kind == list->kind )
+        list->version = atomnumlist_cast( value )->version;
+    return 0;
+}
+
+
+bool
+AtomNumList::KindFromType( PyObject* type, NumericKind::Kind& kind )
+{
+    if( type == pyobject_cast( &PyLong_Type ) )
+        kind = NumericKind::Int;
+    else if( type == pyobject_cast( &PyFloat_Type ) )
+        kind = NumericKind::Float;
+    else if( type == pyobject_cast( &PyBool_Type ) )
+        kind = NumericKind::Bool;
+    else
+        return false;
+    return true;
+}
+
+
+bool
+AtomNumList::Ready()
+{
+    // The reference will be handled by the module to which we will add the type
+    TypeObject = pytype_cast( PyType_FromSpec( &TypeObject_Spec ) );
+    if( !TypeObject )
+    {
+        return false;  // LCOV_EXCL_LINE (failed type creation)
+    }
+    return true;
+}
+
+
+}  // namespace atom
@@ -0,0 +1,78 @@
+/*-----------------------------------------------------------------------------
+| Copyright (c) 2025, Nucleic Development Team.
+|
+| Distributed under the terms of the Modified BSD License.
+|
+| The full license is in the file LICENSE, distributed with this software.
+|----------------------------------------------------------------------------*/
+#pragma once
+#include <cppy/cppy.h>
+#include "catom.h"
+#include "catompointer.h"
+#include "containerversion.h"
+#include "member.h"
+
+
+#define atomnumlist_cast( o ) ( reinterpret_cast<atom::AtomNumList*>( o ) )
+
+namespace atom
+{
+
+
+namespace NumericKind
+{
+
+enum Kind: uint8_t
+{
+    Int,  // int64
+    Float,  // float64
+    Bool,
+};
+
+}  // namespace NumericKind
+
+
+// POD struct - all member fields are considered private
+struct AtomNumList
+{
+    PyObject_HEAD
+    char* data;
+    Py_ssize_t size;
+    Py_ssize_t allocated;
+    Py_ssize_t exports;  // live buffer exports, the storage cannot be resized
+    CAtomPointer* pointer;
+    Member* member;  // member notified of the changes, null if standalone
+    uint64_t version;  // drawn anew on each modification
+    NumericKind::Kind kind;
+
+    static PyType_Spec TypeObject_Spec;
+
+    static PyTypeObject* TypeObject;
+
+    static bool Ready();
+
+    // Create an empty list whose changes are notified by the given member.
+    static PyObject* New( NumericKind::Kind kind, CAtom* atom, Member* member );
+
+    // Replace the content of an empty list by the items of a list, a tuple,
+    // another numeric list or an object exporting a buffer. Items are copied
+    // without conversion when the source stores the same native type.
+    static int Assign( AtomNumList* list, PyObject* value );
+
+    // Map int, float and bool to the kind storing them.
+    static bool KindFromType( PyObject* type, NumericKind::Kind& kind );
+
+    void touch()
+    {
+        version = next_container_version();
+    }
+
+    static bool TypeCheck( PyObject* ob )
+    {
+        return PyObject_TypeCheck( ob, TypeObject ) != 0;
+    }
+
+};
+
+
+}  // namespace atom
@@ -7,6 +7,7 @@
 |----------------------------------------------------------------------------*/
 #include <cppy/cppy.h>
 #include "atomset.h"
+#include "memberchange.h"
 #include "packagenaming.h"
 
 namespace atom
@@ -18,6 +19,10 @@ typedef _PyCFunctionFast pycfunc_f;
 namespace SetMethods
 {
     static PyObject* update;
+    static PyObject* discard;
+    static PyObject* remove;
+    static PyObject* pop;
+    static PyObject* clear;
 
 bool
 init_methods()
@@ -29,9 +34,13 @@ init_methods()
     }
 
     update = PyObject_GetAttrString( pyobject_cast( &PySet_Type ),  "update" );
-    if( !update )
+    discard = PyObject_GetAttrString( pyobject_cast( &PySet_Type ),  "discard" );
+    remove = PyObject_GetAttrString( pyobject_cast( &PySet_Type ),  "remove" );
+    pop = PyObject_GetAttrString( pyobject_cast( &PySet_Type ),  "pop" );
+    clear = PyObject_GetAttrString( pyobject_cast( &PySet_Type ),  "clear" );
+    if( !update || !discard || !remove || !pop || !clear )
     {
-        return false;  // LCOV_EXCL_LINE (failed to load set 'update' method, impossible)
+        return false;  // LCOV_EXCL_LINE (failed to load set methods, impossible)
     }
     return true;
 }
@@ -268,6 +277,144 @@ PyObject* AtomSet_update( AtomSet* self, PyObject* value )
 }
 
 
+// Read access to a set whose validation was deferred validates it first.
+inline bool ensure_validated( AtomSet* self )
+{
+	return !self->unvalidated || AtomSet::ValidateAll( self ) == 0;
+}
+
+
+int AtomSet_contains( AtomSet* self, PyObject* value )
+{
+	if( !ensure_validated( self ) )
+	{
+		return -1;
+	}
+	return PySet_Type.tp_as_sequence->sq_contains( pyobject_cast( self ), value );
+}
+
+
+PyObject* AtomSet_iter( AtomSet* self )
+{
+	if( !ensure_validated( self ) )
+	{
+		return 0;
+	}
+	return PySet_Type.tp_iter( pyobject_cast( self ) );
+}
+
+
+PyObject* AtomSet_repr( AtomSet* self )
+{
+	if( !ensure_validated( self ) )
+	{
+		return 0;
+	}
+	return PySet_Type.tp_repr( pyobject_cast( self ) );
+}
+
+
+PyObject* AtomSet_richcompare( AtomSet* self, PyObject* other, int op )
+{
+	if( !ensure_validated( self ) )
+	{
+		return 0;
+	}
+	if( AtomSet::TypeCheck( other ) && !ensure_validated( atomset_cast( other ) ) )
+	{
+		return 0;
+	}
+	return PySet_Type.tp_richcompare( pyobject_cast( self ), other, op );
+}
+
+
+// Run a binary operator of the base set once both operands are validated.
+PyObject* set_binary_op( binaryfunc op, PyObject* left, PyObject* right )
+{
+	if( AtomSet::TypeCheck( left ) && !ensure_validated( atomset_cast( left ) ) )
+	{
+		return 0;
+	}
+	if( AtomSet::TypeCheck( right ) && !ensure_validated( atomset_cast( right ) ) )
+	{
+		return 0;
+	}
+	return op( left, right );
+}
+
+
+PyObject* AtomSet_or( PyObject* left, PyObject* right )
+{
+	return set_binary_op( PySet_Type.tp_as_number->nb_or, left, right );
+}
+
+
+PyObject* AtomSet_and( PyObject* left, PyObject* right )
+{
+	return set_binary_op( PySet_Type.tp_as_number->nb_and, left, right );
+}
+
+
+PyObject* AtomSet_sub( PyObject* left, PyObject* right )
+{
+	return set_binary_op( PySet_Type.tp_as_number->nb_subtract, left, right );
+}
+
+
+PyObject* AtomSet_xor( PyObject* left, PyObject* right )
+{
+	return set_binary_op( PySet_Type.tp_as_number->nb_xor, left, right );
+}
+
+
+// The attributes which do not read the items of the set. Accessing any
+// other attribute, such as the inherited copy, union or issubset methods,
+// validates the deferred items first.
+bool is_lazy_set_attribute( PyObject* name )
+{
+	static const char* names[] = {
+		"validated", "validate_all", "add", "update", "clear", 0
+	};
+	for( const char** it = names; *it; ++it )
+	{
+		if( PyUnicode_CompareWithASCIIString( name, *it ) == 0 )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+PyObject* AtomSet_getattro( AtomSet* self, PyObject* name )
+{
+	if( self->unvalidated && PyUnicode_Check( name ) && !is_lazy_set_attribute( name ) )
+	{
+		if( AtomSet::ValidateAll( self ) < 0 )
+		{
+			return 0;
+		}
+	}
+	return PyObject_GenericGetAttr( pyobject_cast( self ), name );
+}
+
+
+PyObject* AtomSet_validate_all( AtomSet* self )
+{
+	if( !ensure_validated( self ) )
+	{
+		return 0;
+	}
+	return cppy::incref( Py_None );
+}
+
+
+PyObject* AtomSet_get_validated( AtomSet* self, void* ctxt )
+{
+	return cppy::incref( self->unvalidated ? Py_False : Py_True );
+}
+
+
 static PyMethodDef AtomSet_methods[] = {
 	{ "add",
 	  ( PyCFunction )AtomSet_add,
@@ -289,6 +436,20 @@ static PyMethodDef AtomSet_methods[] = {
 	  ( PyCFunction )AtomSet_update,
 	  METH_O,
 	  "Update a set with the union of itself and another." },
+	{ "validate_all",
+	  ( PyCFunction )AtomSet_validate_all,
+	  METH_NOARGS,
+	  "Validate the items whose validation was deferred." },
+	{ 0 } // sentinel
+};
+
+
+static PyGetSetDef AtomSet_getset[] = {
+	{ "validated",
+	  ( getter )AtomSet_get_validated,
+	  0,
+	  "Whether all the items of the set have been validated. A set outliving "
+	  "its atom stays unvalidated." },
 	{ 0 } // sentinel
 };
 
@@ -298,12 +459,391 @@ static PyType_Slot AtomSet_Type_slots[] = {
     { Py_tp_traverse, void_cast( AtomSet_traverse ) },       /* tp_traverse */
     { Py_tp_clear, void_cast( AtomSet_clear ) },             /* tp_clear */
     { Py_tp_methods, void_cast( AtomSet_methods ) },         /* tp_methods */
+    { Py_tp_getset, void_cast( AtomSet_getset ) },           /* tp_getset */
+    { Py_tp_iter, void_cast( AtomSet_iter ) },               /* tp_iter */
+    { Py_sq_contains, void_cast( AtomSet_contains ) },       /* sq_contains */
     { Py_tp_base, void_cast( &PySet_Type ) },                /* tp_base */
     { Py_tp_new, void_cast( AtomSet_new ) },                 /* tp_new */
     { Py_nb_inplace_subtract, void_cast( AtomSet_isub ) },   /* nb_inplace_substract */
     { Py_nb_inplace_and, void_cast( AtomSet_iand ) },        /* nb_inplace_substract */
     { Py_nb_inplace_xor, void_cast( AtomSet_ixor ) },        /* nb_inplace_substract */
     { Py_nb_inplace_or, void_cast( AtomSet_ior ) },          /* nb_inplace_substract */
+    { Py_nb_or, void_cast( AtomSet_or ) },                   /* nb_or */
+    { Py_nb_and, void_cast( AtomSet_and ) },                 /* nb_and */
+    { Py_nb_subtract, void_cast( AtomSet_sub ) },            /* nb_subtract */
+    { Py_nb_xor, void_cast( AtomSet_xor ) },                 /* nb_xor */
+    { Py_tp_getattro, void_cast( AtomSet_getattro ) },       /* tp_getattro */
+    { Py_tp_repr, void_cast( AtomSet_repr ) },               /* tp_repr */
+    { Py_tp_richcompare, void_cast( AtomSet_richcompare ) }, /* tp_richcompare */
+    { Py_tp_hash, void_cast( PyObject_HashNotImplemented ) }, /* tp_hash */
+    { 0, 0 },
+};
+
+
+// AtomCSet
+
+int AtomCSet_clear( AtomCSet* self )
+{
+	Py_CLEAR( self->member );
+	return AtomSet_clear( atomset_cast( self ) );
+}
+
+
+int AtomCSet_traverse( AtomCSet* self, visitproc visit, void* arg )
+{
+	Py_VISIT( self->member );
+	return AtomSet_traverse( atomset_cast( self ), visit, arg );
+}
+
+
+void AtomCSet_dealloc( AtomCSet* self )
+{
+	cppy::clear( &self->member );
+	AtomSet_dealloc( atomset_cast( self ) );
+}
+
+
+// Whether the changes of the set are observed. The atom is returned in atom.
+bool observed( AtomCSet* self, CAtom*& atom )
+{
+	atom = self->set.pointer->data();
+	return self->member && atom && MemberChange::container_observed( atom, self->member );
+}
+
+
+// Notify a change of the set carrying up to two payload entries.
+bool post_change(
+	AtomCSet* self,
+	CAtom* atom,
+	ContainerOp::Op operation,
+	const char* key,
+	PyObject* value,
+	const char* key2 = 0,
+	PyObject* value2 = 0 )
+{
+	cppy::ptr change( MemberChange::container( atom, self->member, pyobject_cast( self ), operation ) );
+	if( !change )
+	{
+		return false;
+	}
+	if( key && PyDict_SetItemString( change.get(), key, value ) != 0 )
+	{
+		return false;
+	}
+	if( key2 && PyDict_SetItemString( change.get(), key2, value2 ) != 0 )
+	{
+		return false;
+	}
+	return MemberChange::notify_container( atom, self->member, change.get() );
+}
+
+
+PyObject* call_set_method( AtomCSet* self, PyObject* method, PyObject* arg )
+{
+	PyObject* args[] = { pyobject_cast( self ), arg };
+	return PyObject_Vectorcall( method, args, arg ? 2 : 1, 0 );
+}
+
+
+PyObject* AtomCSet_add( AtomCSet* self, PyObject* value )
+{
+	cppy::ptr item( validate_value( atomset_cast( self ), value ) );
+	if( !item )
+	{
+		return 0;
+	}
+	CAtom* atom;
+	bool obs = observed( self, atom );
+	int present = obs ? PySet_Contains( pyobject_cast( self ), item.get() ) : 0;
+	if( present < 0 || PySet_Add( pyobject_cast( self ), item.get() ) < 0 )
+	{
+		return 0;
+	}
+	if( obs && !present && !post_change( self, atom, ContainerOp::Add, "item", item.get() ) )
+	{
+		return 0;
+	}
+	return cppy::incref( Py_None );
+}
+
+
+// Run a set method removing at most one item and notify the removal.
+PyObject* remove_one( AtomCSet* self, PyObject* method, PyObject* value, ContainerOp::Op operation )
+{
+	Py_ssize_t size = PySet_GET_SIZE( pyobject_cast( self ) );
+	cppy::ptr res( call_set_method( self, method, value ) );
+	if( !res )
+	{
+		return 0;
+	}
+	if( PySet_GET_SIZE( pyobject_cast( self ) ) == size )
+	{
+		return res.release();
+	}
+	CAtom* atom;
+	if( !observed( self, atom ) )
+	{
+		return res.release();
+	}
+	// The set does not expose the removed key, report the argument in the
+	// form the validator stores it, or as is if it does not validate.
+	cppy::ptr item( value ? validate_value( atomset_cast( self ), value ) : cppy::incref( res.get() ) );
+	if( !item )
+	{
+		PyErr_Clear();
+		item = cppy::incref( value );
+	}
+	if( !post_change( self, atom, operation, "item", item.get() ) )
+	{
+		return 0;
+	}
+	return res.release();
+}
+
+
+PyObject* AtomCSet_discard( AtomCSet* self, PyObject* value )
+{
+	return remove_one( self, SetMethods::discard, value, ContainerOp::Discard );
+}
+
+
+PyObject* AtomCSet_remove( AtomCSet* self, PyObject* value )
+{
+	return remove_one( self, SetMethods::remove, value, ContainerOp::Remove );
+}
+
+
+PyObject* AtomCSet_pop( AtomCSet* self )
+{
+	return remove_one( self, SetMethods::pop, 0, ContainerOp::Pop );
+}
+
+
+PyObject* AtomCSet_clear_items( AtomCSet* self )
+{
+	CAtom* atom;
+	cppy::ptr items;
+	if( PySet_GET_SIZE( pyobject_cast( self ) ) > 0 && observed( self, atom ) )
+	{
+		// A set argument is merged without iterating over the atomset.
+		items = PySet_New( pyobject_cast( self ) );
+		if( !items )
+		{
+			return 0;
+		}
+	}
+	if( PySet_Clear( pyobject_cast( self ) ) < 0 )
+	{
+		return 0;  // LCOV_EXCL_LINE (clearing a set cannot fail)
+	}
+	if( items && !post_change( self, atom, ContainerOp::Clear, "items", items.get() ) )
+	{
+		return 0;
+	}
+	return cppy::incref( Py_None );
+}
+
+
+enum class InplaceOp { Or, And, Sub, Xor };
+
+
+// Apply an in-place operation with a set after validating its items and
+// notify the items which were added and removed by the operation.
+PyObject* inplace_op( AtomCSet* self, PyObject* other, InplaceOp op, ContainerOp::Op operation )
+{
+	if( !PyAnySet_Check( other ) )
+	{
+		return cppy::incref( Py_NotImplemented );
+	}
+	cppy::ptr temp( cppy::incref( other ) );
+	if( should_validate( atomset_cast( self ) ) )
+	{
+		temp = validate_set( atomset_cast( self ), other );
+		if( !temp )
+		{
+			return 0;
+		}
+	}
+	PyObject* s = pyobject_cast( self );
+	CAtom* atom;
+	bool obs = observed( self, atom );
+	cppy::ptr added;
+	cppy::ptr removed;
+	if( obs )
+	{
+		if( op == InplaceOp::Or || op == InplaceOp::Xor )
+		{
+			added = PyNumber_Subtract( temp.get(), s );
+			if( !added )
+			{
+				return 0;
+			}
+		}
+		if( op == InplaceOp::And )
+		{
+			removed = PyNumber_Subtract( s, temp.get() );
+		}
+		else if( op == InplaceOp::Sub || op == InplaceOp::Xor )
+		{
+			removed = PyNumber_And( temp.get(), s );
+		}
+		if( op != InplaceOp::Or && !removed )
+		{
+			return 0;
+		}
+	}
+	PyNumberMethods* base = PySet_Type.tp_as_number;
+	binaryfunc func = op == InplaceOp::Or ? base->nb_inplace_or :
+					  op == InplaceOp::And ? base->nb_inplace_and :
+					  op == InplaceOp::Sub ? base->nb_inplace_subtract :
+					  base->nb_inplace_xor;
+	cppy::ptr res( func( s, temp.get() ) );
+	if( !res )
+	{
+		return 0;
+	}
+	bool changed = ( added && PySet_GET_SIZE( added.get() ) > 0 ) ||
+				   ( removed && PySet_GET_SIZE( removed.get() ) > 0 );
+	if( obs && changed )
+	{
+		bool ok;
+		if( added && removed )
+		{
+			ok = post_change( self, atom, operation, "added", added.get(), "removed", removed.get() );
+		}
+		else if( added )
+		{
+			ok = post_change( self, atom, operation, "added", added.get() );
+		}
+		else
+		{
+			ok = post_change( self, atom, operation, "removed", removed.get() );
+		}
+		if( !ok )
+		{
+			return 0;
+		}
+	}
+	return res.release();
+}
+
+
+PyObject* AtomCSet_ior( AtomCSet* self, PyObject* other )
+{
+	return inplace_op( self, other, InplaceOp::Or, ContainerOp::Ior );
+}
+
+
+PyObject* AtomCSet_iand( AtomCSet* self, PyObject* other )
+{
+	return inplace_op( self, other, InplaceOp::And, ContainerOp::Iand );
+}
+
+
+PyObject* AtomCSet_isub( AtomCSet* self, PyObject* other )
+{
+	return inplace_op( self, other, InplaceOp::Sub, ContainerOp::Isub );
+}
+
+
+PyObject* AtomCSet_ixor( AtomCSet* self, PyObject* other )
+{
+	return inplace_op( self, other, InplaceOp::Xor, ContainerOp::Ixor );
+}
+
+
+// Method form of the in-place operations accepting any iterable.
+PyObject* update_op( AtomCSet* self, PyObject* value, InplaceOp op, ContainerOp::Op operation )
+{
+	cppy::ptr temp( cppy::incref( value ) );
+	if( !PyAnySet_Check( value ) && !( temp = PySet_New( value ) ) )
+	{
+		return 0;
+	}
+	cppy::ptr ignored( inplace_op( self, temp.get(), op, operation ) );
+	if( !ignored )
+	{
+		return 0;
+	}
+	return cppy::incref( Py_None );
+}
+
+
+PyObject* AtomCSet_update( AtomCSet* self, PyObject* value )
+{
+	return update_op( self, value, InplaceOp::Or, ContainerOp::Update );
+}
+
+
+PyObject* AtomCSet_difference_update( AtomCSet* self, PyObject* value )
+{
+	return update_op( self, value, InplaceOp::Sub, ContainerOp::DifferenceUpdate );
+}
+
+
+PyObject* AtomCSet_intersection_update( AtomCSet* self, PyObject* value )
+{
+	return update_op( self, value, InplaceOp::And, ContainerOp::IntersectionUpdate );
+}
+
+
+PyObject* AtomCSet_symmetric_difference_update( AtomCSet* self, PyObject* value )
+{
+	return update_op( self, value, InplaceOp::Xor, ContainerOp::SymmetricDifferenceUpdate );
+}
+
+
+static PyMethodDef AtomCSet_methods[] = {
+	{ "add",
+	  ( PyCFunction )AtomCSet_add,
+	  METH_O,
+	  "Add an element to a set." },
+	{ "discard",
+	  ( PyCFunction )AtomCSet_discard,
+	  METH_O,
+	  "Remove an element from a set if it is a member." },
+	{ "remove",
+	  ( PyCFunction )AtomCSet_remove,
+	  METH_O,
+	  "Remove an element from a set; it must be a member." },
+	{ "pop",
+	  ( PyCFunction )AtomCSet_pop,
+	  METH_NOARGS,
+	  "Remove and return an arbitrary set element." },
+	{ "clear",
+	  ( PyCFunction )AtomCSet_clear_items,
+	  METH_NOARGS,
+	  "Remove all elements from this set." },
+	{ "difference_update",
+	  ( PyCFunction )AtomCSet_difference_update,
+	  METH_O,
+	  "Update a set with the difference of itself and another." },
+	{ "intersection_update",
+	  ( PyCFunction )AtomCSet_intersection_update,
+	  METH_O,
+	  "Update a set with the intersection of itself and another." },
+	{ "symmetric_difference_update",
+	  ( PyCFunction )AtomCSet_symmetric_difference_update,
+	  METH_O,
+	  "Update a set with the symmetric difference of itself and another." },
+	{ "update",
+	  ( PyCFunction )AtomCSet_update,
+	  METH_O,
+	  "Update a set with the union of itself and another." },
+	{ 0 } // sentinel
+};
+
+
+static PyType_Slot AtomCSet_Type_slots[] = {
+    { Py_tp_base, NULL },  // Set once the base type is created  /* tp_base */
+    { Py_tp_dealloc, void_cast( AtomCSet_dealloc ) },            /* tp_dealloc */
+    { Py_tp_traverse, void_cast( AtomCSet_traverse ) },          /* tp_traverse */
+    { Py_tp_clear, void_cast( AtomCSet_clear ) },                /* tp_clear */
+    { Py_tp_methods, void_cast( AtomCSet_methods ) },            /* tp_methods */
+    { Py_nb_inplace_subtract, void_cast( AtomCSet_isub ) },      /* nb_inplace_substract */
+    { Py_nb_inplace_and, void_cast( AtomCSet_iand ) },           /* nb_inplace_and */
+    { Py_nb_inplace_xor, void_cast( AtomCSet_ixor ) },           /* nb_inplace_xor */
+    { Py_nb_inplace_or, void_cast( AtomCSet_ior ) },             /* nb_inplace_or */
     { 0, 0 },
 };
 
@@ -368,6 +908,76 @@ int AtomSet::Update( AtomSet* set, PyObject* value )
 }
 
 
+int AtomSet::UpdateUnvalidated( AtomSet* set, PyObject* value )
+{
+	PyObject* args[] = { pyobject_cast( set ), value };
+	cppy::ptr r_temp( PyObject_Vectorcall( SetMethods::update, args, 2 | PY_VECTORCALL_ARGUMENTS_OFFSET, 0 ) );
+	if( !r_temp )
+	{
+		return -1;
+	}
+	set->unvalidated = PySet_GET_SIZE( pyobject_cast( set ) ) > 0;
+	return 0;
+}
+
+
+int AtomSet::ValidateAll( AtomSet* set )
+{
+	// Reads made by the validator see the items as they stand.
+	if( set->validating )
+	{
+		return 0;
+	}
+	if( !should_validate( set ) )
+	{
+		set->unvalidated = false;
+		return 0;
+	}
+	// The items of a set outliving its atom cannot be validated.
+	if( !set->pointer->data() )
+	{
+		return 0;
+	}
+	// Set before listing the items since iterating the set is a read.
+	set->validating = true;
+	cppy::ptr items( PySequence_List( pyobject_cast( set ) ) );
+	if( !items )
+	{
+		set->validating = false;  // LCOV_EXCL_LINE (failed list creation)
+		return -1;  // LCOV_EXCL_LINE
+	}
+	bool changed = false;
+	Py_ssize_t size = PyList_GET_SIZE( items.get() );
+	for( Py_ssize_t i = 0; i < size; ++i )
+	{
+		PyObject* item = PyList_GET_ITEM( items.get(), i );
+		PyObject* valid_item = validate_value( set, item );
+		if( !valid_item )
+		{
+			set->validating = false;
+			return -1;
+		}
+		changed |= valid_item != item;
+		// Replace the borrowed item once a reference to the validated one is owned.
+		PyList_SET_ITEM( items.get(), i, valid_item );
+		Py_DECREF( item );
+	}
+	set->validating = false;
+	set->unvalidated = false;
+	if( !changed )
+	{
+		return 0;
+	}
+	if( PySet_Clear( pyobject_cast( set ) ) < 0 )
+	{
+		return -1;  // LCOV_EXCL_LINE (clearing a set cannot fail)
+	}
+	PyObject* args[] = { pyobject_cast( set ), items.get() };
+	cppy::ptr r_temp( PyObject_Vectorcall( SetMethods::update, args, 2 | PY_VECTORCALL_ARGUMENTS_OFFSET, 0 ) );
+	return !r_temp ? -1 : 0;
+}
+
+
 bool AtomSet::Ready()
 {
 	if( !SetMethods::init_methods() ) {
@@ -382,4 +992,53 @@ bool AtomSet::Ready()
     return true;
 }
 
+
+
+PyTypeObject* AtomCSet::TypeObject = NULL;
+
+
+PyType_Spec AtomCSet::TypeObject_Spec = {
+	PACKAGE_TYPENAME( "atomcset" ),            /* tp_name */
+	sizeof( AtomCSet ),                        /* tp_basicsize */
+	0,                                         /* tp_itemsize */
+	Py_TPFLAGS_DEFAULT
+	| Py_TPFLAGS_BASETYPE
+	| Py_TPFLAGS_HAVE_GC,                       /* tp_flags */
+    AtomCSet_Type_slots                         /* slots */
+};
+
+
+PyObject* AtomCSet::New( CAtom* atom, Member* validator, Member* member )
+{
+    cppy::ptr self( PySet_Type.tp_new( AtomCSet::TypeObject, 0, 0 ) );
+	if( !self )
+	{
+		return 0;  // LCOV_EXCL_LINE (failed instance creation)
+	}
+    cppy::xincref( pyobject_cast( validator ) );
+    atomset_cast( self.get() )->m_value_validator = validator;
+    atomset_cast( self.get() )->pointer = new CAtomPointer( atom );
+    cppy::xincref( pyobject_cast( member ) );
+    atomcset_cast( self.get() )->member = member;
+    return self.release();
+}
+
+
+bool AtomCSet::Ready()
+{
+	// Ensure the parent type was created
+	if( !AtomSet::TypeObject )
+	{
+		return false;  // LCOV_EXCL_LINE (parent type not created, impossible)
+	}
+	AtomCSet_Type_slots[0].pfunc = void_cast( AtomSet::TypeObject );
+    // The reference will be handled by the module to which we will add the type
+	TypeObject = pytype_cast( PyType_FromSpec( &TypeObject_Spec ) );
+    if( !TypeObject )
+    {
+        return false;  // LCOV_EXCL_LINE (failed type creation)
+    }
+    return true;
+}
+
 }  // namespace atom
@@ -13,6 +13,7 @@
 
 
 #define atomset_cast( o ) ( reinterpret_cast<atom::AtomSet*>( o ) )
+#define atomcset_cast( o ) ( reinterpret_cast<atom::AtomCSet*>( o ) )
 
 
 namespace atom
@@ -24,6 +25,8 @@ struct AtomSet
     PySetObject set;
 	Member* m_value_validator;
     CAtomPointer* pointer;
+    bool unvalidated;
+    bool validating;  // a deferred validation is running
 
 	static PyType_Spec TypeObject_Spec;
 
@@ -35,6 +38,34 @@ struct AtomSet
 
     static int Update( AtomSet* set, PyObject* value );
 
+    // Update the set without validating the items, which are validated on
+    // first access or when calling ValidateAll.
+    static int UpdateUnvalidated( AtomSet* set, PyObject* value );
+
+    static int ValidateAll( AtomSet* set );
+
+    static bool TypeCheck( PyObject* ob )
+	{
+		return PyObject_TypeCheck( ob, TypeObject ) != 0;
+	}
+
+};
+
+
+// POD struct - all member fields are considered private
+struct AtomCSet
+{
+    AtomSet set;
+    Member* member;
+
+	static PyType_Spec TypeObject_Spec;
+
+    static PyTypeObject* TypeObject;
+
+	static bool Ready();
+
+    static PyObject* New( CAtom* atom, Member* validator, Member* member );
+
     static bool TypeCheck( PyObject* ob )
 	{
 		return PyObject_TypeCheck( ob, TypeObject ) != 0;
@@ -0,0 +1,628 @@
+/*-----------------------------------------------------------------------------
+| Copyright (c) 2025, Nucleic Development Team.
+|
+| Distributed under the terms of the Modified BSD License.
+|
+| The full license is in the file LICENSE, distributed with this software.
+|----------------------------------------------------------------------------*/
+#include <cppy/cppy.h>
+#include "atomsortedmap.h"
+#include "memberchange.h"
+#include "packagenaming.h"
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wdeprecated-writable-strings"
+#endif
+
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#endif
+
+namespace atom
+{
+
+
+namespace
+{
+
+
+// The sortedmap type of atom.datastructures, which implements the storage.
+PyTypeObject* SortedMap_Type = 0;
+
+
+namespace SortedMapMethods
+{
+    static PyObject* missing;  // default of get telling missing keys apart
+    static PyObject* get;
+    static PyObject* pop;
+    static PyObject* clear;
+    static PyObject* update;
+    static PyObject* snapshot;
+    static PyObject* items;
+    static PyObject* bisect_left;
+
+bool
+init_methods()
+{
+    PyObject* type = pyobject_cast( SortedMap_Type );
+    missing = PyObject_CallNoArgs( pyobject_cast( &PyBaseObject_Type ) );
+    get = PyObject_GetAttrString( type, "get" );
+    pop = PyObject_GetAttrString( type, "pop" );
+    clear = PyObject_GetAttrString( type, "clear" );
+    update = PyObject_GetAttrString( type, "update" );
+    snapshot = PyObject_GetAttrString( type, "snapshot" );
+    items = PyObject_GetAttrString( type, "items" );
+    bisect_left = PyObject_GetAttrString( type, "bisect_left" );
+    if( !missing || !get || !pop || !clear || !update || !snapshot || !items || !bisect_left )
+    {
+        return false;  // LCOV_EXCL_LINE (failed to load sortedmap methods, impossible)
+    }
+    return true;
+}
+
+}  // namespace SortedMapMethods
+
+
+// Call an unbound sortedmap method with the map and up to one argument.
+PyObject*
+call_method( PyObject* method, PyObject* self, PyObject* arg = 0 )
+{
+    PyObject* args[2] = { self, arg };
+    return PyObject_Vectorcall( method, args, arg ? 2 : 1, 0 );
+}
+
+
+// Create a plain sortedmap holding the items of a mapping or of an iterable
+// of pairs.
+PyObject*
+new_map( PyObject* source = 0 )
+{
+    PyObject* args[1] = { source };
+    return PyObject_Vectorcall( pyobject_cast( SortedMap_Type ), args, source ? 1 : 0, 0 );
+}
+
+
+// Add the items of source to a map through the sortedmap implementation.
+bool
+update_map( PyObject* self, PyObject* source )
+{
+    cppy::ptr res( call_method( SortedMapMethods::update, self, source ) );
+    return res.get() != 0;
+}
+
+
+Py_ssize_t
+map_length( PyObject* self )
+{
+    return SortedMap_Type->tp_as_mapping->mp_length( self );
+}
+
+
+// The value stored under key, or null without an error if there is none.
+// Looking the key up through get avoids raising a KeyError for new keys.
+PyObject*
+lookup( PyObject* self, PyObject* key )
+{
+    PyObject* args[3] = { self, key, SortedMapMethods::missing };
+    cppy::ptr value( PyObject_Vectorcall( SortedMapMethods::get, args, 3, 0 ) );
+    if( value.get() == SortedMapMethods::missing )
+        return 0;
+    return value.release();
+}
+
+
+// Whether the items assigned to the map must be validated, which is only
+// the case once the map is bound to an atom.
+bool
+should_validate( AtomSortedMap* map )
+{
+    return map->pointer->data() && ( map->m_key_validator || map->m_value_validator );
+}
+
+
+PyObject*
+validate_item( AtomSortedMap* map, Member* validator, PyObject* item )
+{
+    CAtom* atom = map->pointer->data();
+    if( !validator || !atom )
+        return cppy::incref( item );
+    return validator->full_validate( atom, Py_None, item );
+}
+
+
+// A validator missing on both sides is equivalent.
+bool
+equivalent_validators( Member* first, Member* second )
+{
+    if( !first || !second )
+        return first == second;
+    return Member::equivalent_validators( first, second );
+}
+
+
+// Whether the items of value can be used as is by the map.
+bool
+prevalidated( AtomSortedMap* map, PyObject* value )
+{
+    if( !AtomSortedMap::TypeCheck( value ) )
+        return false;
+    AtomSortedMap* source = atomsortedmap_cast( value );
+    return equivalent_validators( source->m_key_validator, map->m_key_validator ) &&
+        equivalent_validators( source->m_value_validator, map->m_value_validator );
+}
+
+
+// Build a new plain map holding the validated keys and values of a map.
+PyObject*
+validate_map( AtomSortedMap* map, PyObject* source )
+{
+    cppy::ptr pairs( PyList_New( 0 ) );
+    if( !pairs )
+        return 0;  // LCOV_EXCL_LINE
+    cppy::ptr view( call_method( SortedMapMethods::items, source ) );
+    if( !view )
+        return 0;  // LCOV_EXCL_LINE
+    cppy::ptr iter( PyObject_GetIter( view.get() ) );
+    if( !iter )
+        return 0;  // LCOV_EXCL_LINE
+    cppy::ptr item;
+    while( ( item = PyIter_Next( iter.get() ) ) )
+    {
+        cppy::ptr key( validate_item( map, map->m_key_validator, PyTuple_GET_ITEM( item.get(), 0 ) ) );
+        if( !key )
+            return 0;
+        cppy::ptr value( validate_item( map, map->m_value_validator, PyTuple_GET_ITEM( item.get(), 1 ) ) );
+        if( !value )
+            return 0;
+        cppy::ptr pair( PyTuple_Pack( 2, key.get(), value.get() ) );
+        if( !pair || PyList_Append( pairs.get(), pair.get() ) != 0 )
+            return 0;  // LCOV_EXCL_LINE
+    }
+    if( PyErr_Occurred() )
+        return 0;  // LCOV_EXCL_LINE
+    return new_map( pairs.get() );
+}
+
+
+// Whether the changes of the map are observed. The atom is returned in atom.
+bool
+observed( AtomSortedMap* map, CAtom*& atom )
+{
+    atom = map->pointer->data();
+    return map->member && atom && MemberChange::container_observed( atom, map->member );
+}
+
+
+// Notify a change of the map carrying up to three payload entries.
+bool
+post_change(
+    AtomSortedMap* map,
+    CAtom* atom,
+    ContainerOp::Op operation,
+    const char* key,
+    PyObject* value,
+    const char* key2 = 0,
+    PyObject* value2 = 0,
+    const char* key3 = 0,
+    PyObject* value3 = 0 )
+{
+    cppy::ptr change( MemberChange::container( atom, map->member, map->object(), operation ) );
+    if( !change )
+        return false;
+    if( key && PyDict_SetItemString( change.get(), key, value ) != 0 )
+        return false;
+    if( key2 && PyDict_SetItemString( change.get(), key2, value2 ) != 0 )
+        return false;
+    if( key3 && PyDict_SetItemString( change.get(), key3, value3 ) != 0 )
+        return false;
+    return MemberChange::notify_container( atom, map->member, change.get() );
+}
+
+
+// The rank of the first key which is not less than bound, none_rank for None.
+bool
+slice_rank( PyObject* self, PyObject* bound, Py_ssize_t none_rank, Py_ssize_t& rank )
+{
+    if( bound == Py_None )
+    {
+        rank = none_rank;
+        return true;
+    }
+    cppy::ptr pyrank( call_method( SortedMapMethods::bisect_left, self, bound ) );
+    if( !pyrank )
+        return false;
+    rank = PyLong_AsSsize_t( pyrank.get() );
+    return !PyErr_Occurred();
+}
+
+
+// The items whose keys fall in the bounds of a slice as a plain map.
+PyObject*
+slice_items( PyObject* self, PyObject* slice )
+{
+    PySliceObject* bounds = reinterpret_cast<PySliceObject*>( slice );
+    Py_ssize_t first;
+    Py_ssize_t last;
+    if( !slice_rank( self, bounds->start, 0, first ) ||
+        !slice_rank( self, bounds->stop, map_length( self ), last ) )
+        return 0;
+    cppy::ptr view( call_method( SortedMapMethods::items, self ) );
+    if( !view )
+        return 0;  // LCOV_EXCL_LINE
+    cppy::ptr pairs( PySequence_GetSlice( view.get(), first, last < first ? first : last ) );
+    if( !pairs )
+        return 0;  // LCOV_EXCL_LINE
+    return new_map( pairs.get() );
+}
+
+
+int
+del_subscript( AtomSortedMap* map, CAtom* atom, PyObject* key )
+{
+    PyObject* self = map->object();
+    objobjargproc ass_subscript = SortedMap_Type->tp_as_mapping->mp_ass_subscript;
+    if( PySlice_Check( key ) )
+    {
+        cppy::ptr items( slice_items( self, key ) );
+        if( !items )
+            return -1;
+        if( ass_subscript( self, key, 0 ) < 0 )
+            return -1;
+        if( map_length( items.get() ) == 0 )
+            return 0;
+        return post_change( map, atom, ContainerOp::DelItem, "items", items.get() ) ? 0 : -1;
+    }
+    cppy::ptr olditem( SortedMap_Type->tp_as_mapping->mp_subscript( self, key ) );
+    if( !olditem )
+        return -1;
+    if( ass_subscript( self, key, 0 ) < 0 )
+        return -1;
+    return post_change( map, atom, ContainerOp::DelItem, "key", key, "item", olditem.get() ) ? 0 : -1;
+}
+
+
+PyObject*
+AtomSortedMap_new( PyTypeObject* type, PyObject* args, PyObject* kwargs )
+{
+    cppy::ptr self( SortedMap_Type->tp_new( type, args, kwargs ) );
+    if( !self )
+        return 0;
+    AtomSortedMap* map = atomsortedmap_cast( self.get() );
+    map->pointer = new CAtomPointer();
+    map->touch();
+    return self.release();
+}
+
+
+int
+AtomSortedMap_clear( PyObject* self )
+{
+    AtomSortedMap* map = atomsortedmap_cast( self );
+    Py_CLEAR( map->member );
+    Py_CLEAR( map->m_key_validator );
+    Py_CLEAR( map->m_value_validator );
+    return SortedMap_Type->tp_clear( self );
+}
+
+
+int
+AtomSortedMap_traverse( PyObject* self, visitproc visit, void* arg )
+{
+    AtomSortedMap* map = atomsortedmap_cast( self );
+    Py_VISIT( map->member );
+    Py_VISIT( map->m_key_validator );
+    Py_VISIT( map->m_value_validator );
+    return SortedMap_Type->tp_traverse( self, visit, arg );
+}
+
+
+void
+AtomSortedMap_dealloc( PyObject* self )
+{
+    PyObject_GC_UnTrack( self );
+    AtomSortedMap* map = atomsortedmap_cast( self );
+    cppy::clear( &map->member );
+    cppy::clear( &map->m_key_validator );
+    cppy::clear( &map->m_value_validator );
+    delete map->pointer;
+    map->pointer = 0;
+    SortedMap_Type->tp_dealloc( self );
+}
+
+
+int
+AtomSortedMap_ass_subscript( PyObject* self, PyObject* key, PyObject* value )
+{
+    AtomSortedMap* map = atomsortedmap_cast( self );
+    map->touch();
+    objobjargproc ass_subscript = SortedMap_Type->tp_as_mapping->mp_ass_subscript;
+    CAtom* atom;
+    if( !value )
+    {
+        if( !observed( map, atom ) )
+            return ass_subscript( self, key, 0 );
+        return del_subscript( map, atom, key );
+    }
+    cppy::ptr keyptr( validate_item( map, map->m_key_validator, key ) );
+    if( !keyptr )
+        return -1;
+    cppy::ptr valueptr( validate_item( map, map->m_value_validator, value ) );
+    if( !valueptr )
+        return -1;
+    if( !observed( map, atom ) )
+        return ass_subscript( self, keyptr.get(), valueptr.get() );
+    cppy::ptr olditem( lookup( self, keyptr.get() ) );
+    if( !olditem && PyErr_Occurred() )
+        return -1;
+    if( ass_subscript( self, keyptr.get(), valueptr.get() ) < 0 )
+        return -1;
+    if( olditem == valueptr )
+        return 0;
+    bool ok = olditem ?
+        post_change( map, atom, ContainerOp::SetItem, "key", keyptr.get(), "olditem", olditem.get(), "newitem", valueptr.get() ) :
+        post_change( map, atom, ContainerOp::SetItem, "key", keyptr.get(), "newitem", valueptr.get() );
+    return ok ? 0 : -1;
+}
+
+
+PyObject*
+AtomSortedMap_pop( PyObject* self, PyObject*const *args, Py_ssize_t nargs )
+{
+    AtomSortedMap* map = atomsortedmap_cast( self );
+    map->touch();
+    Py_ssize_t size = map_length( self );
+    PyObject* fargs[3] = { self, nargs > 0 ? args[0] : 0, nargs > 1 ? args[1] : 0 };
+    cppy::ptr res( PyObject_Vectorcall( SortedMapMethods::pop, fargs, nargs + 1, 0 ) );
+    if( !res )
+        return 0;
+    CAtom* atom;
+    if( map_length( self ) != size && observed( map, atom ) )
+    {
+        if( !post_change( map, atom, ContainerOp::Pop, "key", args[0], "item", res.get() ) )
+            return 0;
+    }
+    return res.release();
+}
+
+
+PyObject*
+AtomSortedMap_clear_items( PyObject* self )
+{
+    AtomSortedMap* map = atomsortedmap_cast( self );
+    map->touch();
+    CAtom* atom;
+    cppy::ptr items;
+    // A snapshot shares the nodes of the map and costs no copy.
+    if( map_length( self ) > 0 && observed( map, atom ) )
+    {
+        items = call_method( SortedMapMethods::snapshot, self );
+        if( !items )
+            return 0;  // LCOV_EXCL_LINE
+    }
+    cppy::ptr res( call_method( SortedMapMethods::clear, self ) );
+    if( !res )
+        return 0;  // LCOV_EXCL_LINE
+    if( items && !post_change( map, atom, ContainerOp::Clear, "items", items.get() ) )
+        return 0;
+    return res.release();
+}
+
+
+// Merge validated items and notify them along with the values they replaced.
+bool
+update_items( AtomSortedMap* map, PyObject* source, PyObject* kwargs )
+{
+    PyObject* self = map->object();
+    bool has_kwargs = kwargs && PyDict_GET_SIZE( kwargs ) > 0;
+    CAtom* atom;
+    bool obs = observed( map, atom );
+    if( !obs && !should_validate( map ) )
+    {
+        if( source && !update_map( self, source ) )
+            return false;
+        return !has_kwargs || update_map( self, kwargs );
+    }
+    cppy::ptr items( new_map( source ) );
+    if( !items )
+        return false;
+    if( has_kwargs && !update_map( items.get(), kwargs ) )
+        return false;
+    if( should_validate( map ) && ( has_kwargs || !source || !prevalidated( map, source ) ) )
+    {
+        items = validate_map( map, items.get() );
+        if( !items )
+            return false;
+    }
+    if( map_length( items.get() ) == 0 )
+        return true;
+    if( !obs )
+        return update_map( self, items.get() );
+    cppy::ptr olditems( PyList_New( 0 ) );
+    if( !olditems )
+        return false;  // LCOV_EXCL_LINE
+    cppy::ptr iter( PyObject_GetIter( items.get() ) );
+    if( !iter )
+        return false;  // LCOV_EXCL_LINE
+    cppy::ptr key;
+    while( ( key = PyIter_Next( iter.get() ) ) )
+    {
+        cppy::ptr olditem( lookup( self, key.get() ) );
+        if( !olditem && PyErr_Occurred() )
+            return false;
+        if( !olditem )
+            continue;
+        cppy::ptr pair( PyTuple_Pack( 2, key.get(), olditem.get() ) );
+        if( !pair || PyList_Append( olditems.get(), pair.get() ) != 0 )
+            return false;  // LCOV_EXCL_LINE
+    }
+    if( PyErr_Occurred() )
+        return false;  // LCOV_EXCL_LINE
+    olditems = new_map( olditems.get() );
+    if( !olditems )
+        return false;  // LCOV_EXCL_LINE
+    if( !update_map( self, items.get() ) )
+        return false;
+    return post_change( map, atom, ContainerOp::Update, "items", items.get(), "olditems", olditems.get() );
+}
+
+
+PyObject*
+AtomSortedMap_update( PyObject* self, PyObject* args, PyObject* kwargs )
+{
+    PyObject* source = 0;
+    if( !PyArg_UnpackTuple( args, "update", 0, 1, &source ) )
+        return 0;
+    AtomSortedMap* map = atomsortedmap_cast( self );
+    map->touch();
+    if( !update_items( map, source, kwargs ) )
+        return 0;
+    Py_RETURN_NONE;
+}
+
+
+PyObject*
+AtomSortedMap_get_version( PyObject* self, void* context )
+{
+    return PyLong_FromUnsignedLongLong( atomsortedmap_cast( self )->version );
+}
+
+
+static PyMethodDef
+AtomSortedMap_methods[] = {
+    { "pop",
+      ( PyCFunction )AtomSortedMap_pop,
+      METH_FASTCALL,
+      "Remove a key and return its value, or the default if it is missing." },
+    { "clear",
+      ( PyCFunction )AtomSortedMap_clear_items,
+      METH_NOARGS,
+      "Remove all the items of the map." },
+    { "update",
+      ( PyCFunction )AtomSortedMap_update,
+      METH_VARARGS | METH_KEYWORDS,
+      "Add the items of a mapping or an iterable of pairs and of the keywords." },
+    { 0 } // sentinel
+};
+
+
+static PyGetSetDef
+AtomSortedMap_getset[] = {
+    { "version", ( getter )AtomSortedMap_get_version, 0,
+      "A number drawn anew each time the map is modified." },
+    { 0 }  // sentinel
+};
+
+
+static PyType_Slot AtomSortedMap_Type_slots[] = {
+    { Py_tp_new, void_cast( AtomSortedMap_new ) },                      /* tp_new */
+    { Py_tp_dealloc, void_cast( AtomSortedMap_dealloc ) },              /* tp_dealloc */
+    { Py_tp_traverse, void_cast( AtomSortedMap_traverse ) },            /* tp_traverse */
+    { Py_tp_clear, void_cast( AtomSortedMap_clear ) },                  /* tp_clear */
+    { Py_tp_methods, void_cast( AtomSortedMap_methods ) },              /* tp_methods */
+    { Py_tp_getset, void_cast( AtomSortedMap_getset ) },                /* tp_getset */
+    { Py_mp_ass_subscript, void_cast( AtomSortedMap_ass_subscript ) },  /* mp_ass_subscript */
+    /* tp_base cannot be set at this stage */
+    { 0, 0 },
+};
+
+
+}  // namespace
+
+
+// Initialize static variables (otherwise the compiler eliminates them)
+PyTypeObject* AtomSortedMap::TypeObject = NULL;
+
+
+Py_ssize_t AtomSortedMap::Offset = 0;
+
+
+// The basic size is set once the size of the base type is known.
+PyType_Spec AtomSortedMap::TypeObject_Spec = {
+    PACKAGE_TYPENAME( "atomsortedmap" ),        /* tp_name */
+    0,                                          /* tp_basicsize */
+    0,                                          /* tp_itemsize */
+    Py_TPFLAGS_DEFAULT
+    |Py_TPFLAGS_BASETYPE
+    |Py_TPFLAGS_HAVE_GC,                        /* tp_flags */
+    AtomSortedMap_Type_slots                    /* slots */
+};
+
+
+PyObject*
+AtomSortedMap::New( CAtom* atom, Member* member, Member* key_validator, Member* value_validator )
+{
+    cppy::ptr args( PyTuple_New( 0 ) );
+    if( !args )
+        return 0;  // LCOV_EXCL_LINE
+    cppy::ptr self( SortedMap_Type->tp_new( TypeObject, args.get(), 0 ) );
+    if( !self )
+        return 0;  // LCOV_EXCL_LINE (failed instance creation)
+    AtomSortedMap* map = atomsortedmap_cast( self.get() );
+    map->pointer = new CAtomPointer( atom );
+    map->member = reinterpret_cast<Member*>( cppy::xincref( pyobject_cast( member ) ) );
+    map->m_key_validator = reinterpret_cast<Member*>( cppy::xincref( pyobject_cast( key_validator ) ) );
+    map->m_value_validator = reinterpret_cast<Member*>( cppy::xincref( pyobject_cast( value_validator ) ) );
+    map->touch();
+    return self.release();
+}
+
+
+int
+AtomSortedMap::Assign( PyObject* self, PyObject* value )
+{
+    AtomSortedMap* map = atomsortedmap_cast( self );
+    map->touch();
+    cppy::ptr items( cppy::incref( value ) );
+    bool verbatim = !should_validate( map ) || prevalidated( map, value );
+    if( !verbatim )
+    {
+        items = new_map( value );
+        if( !items )
+            return -1;
+        items = validate_map( map, items.get() );
+        if( !items )
+            return -1;
+    }
+    // Updating an empty map from another sortedmap shares its nodes.
+    if( !update_map( self, items.get() ) )
+        return -1;
+    // A verbatim copy holds the same items as its source.
+    if( verbatim && AtomSortedMap::TypeCheck( value ) && atomsortedmap_cast( value )->version )
+        map->version = atomsortedmap_cast( value )->version;
+    return 0;
+}
+
+
+bool
+AtomSortedMap::SortedMapCheck( PyObject* ob )
+{
+    return PyObject_TypeCheck( ob, SortedMap_Type ) != 0;
+}
+
+
+bool
+AtomSortedMap::Ready()
+{
+    cppy::ptr mod( PyImport_ImportModule( "atom.datastructures.sortedmap" ) );
+    if( !mod )
+        return false;  // LCOV_EXCL_LINE (failed to import the sortedmap module)
+    cppy::ptr type( PyObject_GetAttrString( mod.get(), "sortedmap" ) );
+    if( !type )
+        return false;  // LCOV_EXCL_LINE (failed to load the sortedmap type)
+    SortedMap_Type = pytype_cast( type.release() );
+    if( !SortedMapMethods::init_methods() )
+        return false;  // LCOV_EXCL_LINE (failed method lookup, impossible)
+    Offset = SortedMap_Type->tp_basicsize;
+    TypeObject_Spec.basicsize = static_cast<int>( Offset + sizeof( AtomSortedMap ) );
+    cppy::ptr bases( PyTuple_Pack( 1, pyobject_cast( SortedMap_Type ) ) );
+    if( !bases )
+        return false;  // LCOV_EXCL_LINE (failed tuple creation)
+    // The reference will be handled by the module to which we will add the type
+    TypeObject = pytype_cast( PyType_FromSpecWithBases( &TypeObject_Spec, bases.get() ) );
+    if( !TypeObject )
+        return false;  // LCOV_EXCL_LINE (failed type creation)
+    return true;
+}
+
+
+}  // namespace atom
@@ -0,0 +1,79 @@
+/*-----------------------------------------------------------------------------
+| Copyright (c) 2025, Nucleic Development Team.
+|
+| Distributed under the terms of the Modified BSD License.
+|
+| The full license is in the file LICENSE, distributed with this software.
+|----------------------------------------------------------------------------*/
+#pragma once
+#include <cppy/cppy.h>
+#include "catom.h"
+#include "catompointer.h"
+#include "containerversion.h"
+#include "member.h"
+
+
+#define atomsortedmap_cast( o ) ( atom::AtomSortedMap::Fields( o ) )
+
+namespace atom
+{
+
+
+// POD struct - all member fields are considered private
+//
+// The type derives from the sortedmap of atom.datastructures whose layout is
+// private to its module, so those fields follow the fields of the sortedmap
+// at an offset only known once the base type has been imported.
+struct AtomSortedMap
+{
+    CAtomPointer* pointer;  // null for a map created from Python
+    Member* member;  // member notified of the changes, null if standalone
+    Member* m_key_validator;
+    Member* m_value_validator;
+    uint64_t version;  // drawn anew on each modification
+
+    static PyType_Spec TypeObject_Spec;
+
+    static PyTypeObject* TypeObject;
+
+    static Py_ssize_t Offset;
+
+    static bool Ready();
+
+    // Create an empty map whose changes are notified by the given member.
+    static PyObject* New(
+        CAtom* atom, Member* member, Member* key_validator, Member* value_validator
+    );
+
+    // Replace the content of a new map by the validated items of a mapping,
+    // without notification. The items of another atom sorted map validated
+    // in the same way are copied as is.
+    static int Assign( PyObject* map, PyObject* value );
+
+    static AtomSortedMap* Fields( PyObject* ob )
+    {
+        return reinterpret_cast<AtomSortedMap*>( reinterpret_cast<char*>( ob ) + Offset );
+    }
+
+    PyObject* object()
+    {
+        return reinterpret_cast<PyObject*>( reinterpret_cast<char*>( this ) - Offset );
+    }
+
+    void touch()
+    {
+        version = next_container_version();
+    }
+
+    static bool TypeCheck( PyObject* ob )
+    {
+        return PyObject_TypeCheck( ob, TypeObject ) != 0;
+    }
+
+    // Whether an object is a sortedmap of atom.datastructures.
+    static bool SortedMapCheck( PyObject* ob );
+
+};
+
+
+}  // namespace atom
@@ -136,8 +136,14 @@ enum Mode: uint8_t
     List,
     ContainerList,
     Set,
+    ContainerSet,
     Dict,
+    ContainerDict,
     DefaultDict,
+    NumericList,
+    IntSet,
+    SortedMap,
+    Deque,
     OptionalInstance,
     Instance,
     OptionalTyped,
@@ -209,4 +215,17 @@ enum Mode: uint8_t
 
 }  // namespace GetState
 
+
+namespace ChangeDetection
+{
+
+enum Mode: uint8_t
+{
+    Equality,  // We want equality to be the default behavior
+    Identity,
+    Comparator,
+};
+
+}  // namespace ChangeDetection
+
 }  // namespace atom
@@ -358,6 +358,102 @@ CAtom_freeze( CAtom* self )
 }
 
 
+// Capture the pending exception as a (name, exception) failure. Exceptions
+// which are not subclasses of Exception are left pending and false returned.
+bool
+record_failure( PyObject* failures, PyObject* name )
+{
+    if( !PyErr_ExceptionMatches( PyExc_Exception ) )
+        return false;
+#if PY_VERSION_HEX >= 0x030C0000
+    cppy::ptr valueptr( PyErr_GetRaisedException() );
+#else
+    PyObject* type;
+    PyObject* value;
+    PyObject* traceback;
+    PyErr_Fetch( &type, &value, &traceback );
+    PyErr_NormalizeException( &type, &value, &traceback );
+    cppy::ptr typeptr( type );
+    cppy::ptr valueptr( value );
+    cppy::ptr tracebackptr( traceback );
+    if( traceback )
+        PyException_SetTraceback( value, traceback );
+#endif
+    cppy::ptr failure( PyTuple_Pack( 2, name, valueptr.get() ) );
+    if( !failure )
+        return false;
+    return PyList_Append( failures, failure.get() ) == 0;
+}
+
+
+PyObject*
+CAtom_validate_record( PyTypeObject* type, PyObject* record )
+{
+    if( !PyMapping_Check( record ) )
+        return cppy::type_error( record, "mapping" );
+    cppy::ptr items( PyMapping_Items( record ) );
+    if( !items )
+        return 0;
+    cppy::ptr membersptr( PyObject_GetAttr( pyobject_cast( type ), atom_members ) );
+    if( !membersptr )
+        return 0;
+    if( !PyDict_CheckExact( membersptr.get() ) )
+        return cppy::system_error( "atom members" );
+    // Validators are given a bare instance, which is never initialized nor
+    // notifies, in place of the atom the values would be assigned to.
+    cppy::ptr emptyargs( PyTuple_New( 0 ) );
+    if( !emptyargs )
+        return 0;
+    cppy::ptr stub( CAtom_new( type, emptyargs.get(), 0 ) );
+    if( !stub )
+        return 0;
+    catom_cast( stub.get() )->set_notifications_enabled( false );
+    cppy::ptr validated( PyDict_New() );
+    if( !validated )
+        return 0;
+    cppy::ptr failures( PyList_New( 0 ) );
+    if( !failures )
+        return 0;
+    Py_ssize_t size = PyList_GET_SIZE( items.get() );
+    for( Py_ssize_t i = 0; i < size; ++i )
+    {
+        PyObject* item = PyList_GET_ITEM( items.get(), i );
+        if( !PyTuple_Check( item ) || PyTuple_GET_SIZE( item ) != 2 )
+            return cppy::type_error( "mapping items must be 2-tuples" );
+        PyObject* name = PyTuple_GET_ITEM( item, 0 );
+        PyObject* value = PyTuple_GET_ITEM( item, 1 );
+        cppy::ptr member( cppy::xincref( PyDict_GetItemWithError( membersptr.get(), name ) ) );
+        if( !member )
+        {
+            if( !PyErr_Occurred() )
+            {
+                PyErr_Format(
+                    PyExc_AttributeError,
+                    "'%s' has no member named '%S'",
+                    type->tp_name,
+                    name
+                );
+            }
+            if( !record_failure( failures.get(), name ) )
+                return 0;
+            continue;
+        }
+        cppy::ptr valid( member_cast( member.get() )->full_validate(
+            catom_cast( stub.get() ), Py_None, value
+        ) );
+        if( !valid )
+        {
+            if( !record_failure( failures.get(), name ) )
+                return 0;
+            continue;
+        }
+        if( PyDict_SetItem( validated.get(), name, valid.get() ) != 0 )
+            return 0;
+    }
+    return PyTuple_Pack( 2, validated.get(), failures.get() );
+}
+
+
 PyObject*
 CAtom_sizeof( CAtom* self, PyObject* args )
 {
@@ -504,6 +600,10 @@ CAtom_methods[] = {
       "Call the registered observers for a given topic with positional and keyword arguments." },
     { "freeze", ( PyCFunction )CAtom_freeze, METH_NOARGS,
       "Freeze the atom to prevent further modifications to its attributes." },
+    { "validate_record", ( PyCFunction )CAtom_validate_record, METH_O | METH_CLASS,
+      "Validate a mapping of member names to values without creating an atom.\n\n"
+      "Return a dict of the validated values and a list of (name, exception)\n"
+      "for the values which failed validation." },
     { "__sizeof__", ( PyCFunction )CAtom_sizeof, METH_NOARGS,
       "__sizeof__() -> size of object in memory, in bytes" },
     { "__getstate__", ( PyCFunction )CAtom_getstate, METH_NOARGS,
@@ -16,6 +16,10 @@
 #include "atomlist.h"
 #include "atomset.h"
 #include "atomdict.h"
+#include "atomnumlist.h"
+#include "atomintset.h"
+#include "atomsortedmap.h"
+#include "atomdeque.h"
 #include "enumtypes.h"
 #include "propertyhelper.h"
 
@@ -43,10 +47,34 @@ bool ready_types()
     {
         return false;  // LCOV_EXCL_LINE (failed type init)
     }
+    if( !AtomCDict::Ready() )  // LCOV_EXCL_BR_LINE
+    {
+        return false;  // LCOV_EXCL_LINE (failed type init)
+    }
     if( !AtomSet::Ready() )  // LCOV_EXCL_BR_LINE
     {
         return false;  // LCOV_EXCL_LINE (failed type init)
     }
+    if( !AtomCSet::Ready() )  // LCOV_EXCL_BR_LINE
+    {
+        return false;  // LCOV_EXCL_LINE (failed type init)
+    }
+    if( !AtomNumList::Ready() )  // LCOV_EXCL_BR_LINE
+    {
+        return false;  // LCOV_EXCL_LINE (failed type init)
+    }
+    if( !AtomIntSet::Ready() )  // LCOV_EXCL_BR_LINE
+    {
+        return false;  // LCOV_EXCL_LINE (failed type init)
+    }
+    if( !AtomSortedMap::Ready() )  // LCOV_EXCL_BR_LINE
+    {
+        return false;  // LCOV_EXCL_LINE (failed type init)
+    }
+    if( !AtomDeque::Ready() )  // LCOV_EXCL_BR_LINE
+    {
+        return false;  // LCOV_EXCL_LINE (failed type init)
+    }
     if( !AtomRef::Ready() )  // LCOV_EXCL_BR_LINE
     {
         return false;  // LCOV_EXCL_LINE (failed type init)
@@ -114,6 +142,54 @@ bool add_objects( PyObject* mod )
 	}
     atom_set.release();
 
+    // atomcset
+    cppy::ptr atom_cset( pyobject_cast( AtomCSet::TypeObject ) );
+	if( PyModule_AddObject( mod, "atomcset", atom_cset.get() ) < 0 )  // LCOV_EXCL_BR_LINE
+	{
+		return false;  // LCOV_EXCL_LINE (failed type addition to module)
+	}
+    atom_cset.release();
+
+    // atomcdict
+    cppy::ptr atom_cdict( pyobject_cast( AtomCDict::TypeObject ) );
+	if( PyModule_AddObject( mod, "atomcdict", atom_cdict.get() ) < 0 )  // LCOV_EXCL_BR_LINE
+	{
+		return false;  // LCOV_EXCL_LINE (failed type addition to module)
+	}
+    atom_cdict.release();
+
+    // atomnumlist
+    cppy::ptr atom_numlist( pyobject_cast( AtomNumList::TypeObject ) );
+	if( PyModule_AddObject( mod, "atomnumlist", atom_numlist.get() ) < 0 )  // LCOV_EXCL_BR_LINE
+	{
+		return false;  // LCOV_EXCL_LINE (failed type addition to module)
+	}
+    atom_numlist.release();
+
+    // atomintset
+    cppy::ptr atom_intset( pyobject_cast( AtomIntSet::TypeObject ) );
+	if( PyModule_AddObject( mod, "atomintset", atom_intset.get() ) < 0 )  // LCOV_EXCL_BR_LINE
+	{
+		return false;  // LCOV_EXCL_LINE (failed type addition to module)
+	}
+    atom_intset.release();
+
+    // atomsortedmap
+    cppy::ptr atom_sortedmap( pyobject_cast( AtomSortedMap::TypeObject ) );
+	if( PyModule_AddObject( mod, "atomsortedmap", atom_sortedmap.get() ) < 0 )  // LCOV_EXCL_BR_LINE
+	{
+		return false;  // LCOV_EXCL_LINE (failed type addition to module)
+	}
+    atom_sortedmap.release();
+
+    // atomdeque
+    cppy::ptr atom_deque( pyobject_cast( AtomDeque::TypeObject ) );
+	if( PyModule_AddObject( mod, "atomdeque", atom_deque.get() ) < 0 )  // LCOV_EXCL_BR_LINE
+	{
+		return false;  // LCOV_EXCL_LINE (failed type addition to module)
+	}
+    atom_deque.release();
+
     // atomref
     cppy::ptr atom_ref( pyobject_cast( AtomRef::TypeObject ) );
 	if( PyModule_AddObject( mod, "atomref", atom_ref.get() ) < 0 )  // LCOV_EXCL_BR_LINE
@@ -147,6 +223,7 @@ bool add_objects( PyObject* mod )
     cppy::incref( PyValidate );
     cppy::incref( PyPostValidate );
     cppy::incref( PyGetState );
+    cppy::incref( PyChangeDetection );
     cppy::incref( PyChangeType );
     PyModule_AddObject( mod, "GetAttr", PyGetAttr );
     PyModule_AddObject( mod, "SetAttr", PySetAttr );
@@ -157,6 +234,7 @@ bool add_objects( PyObject* mod )
     PyModule_AddObject( mod, "Validate", PyValidate );
     PyModule_AddObject( mod, "PostValidate", PyPostValidate );
     PyModule_AddObject( mod, "GetState", PyGetState );
+    PyModule_AddObject( mod, "ChangeDetection", PyChangeDetection );
     PyModule_AddObject( mod, "ChangeType", PyChangeType );
 
 	return true;
@@ -0,0 +1,118 @@
+/*-----------------------------------------------------------------------------
+| Copyright (c) 2025, Nucleic Development Team.
+|
+| Distributed under the terms of the Modified BSD License.
+|
+| The full license is in the file LICENSE, distributed with this software.
+|----------------------------------------------------------------------------*/
+#include <cppy/cppy.h>
+#include "atomdeque.h"
+#include "atomintset.h"
+#include "atomnumlist.h"
+#include "atomsortedmap.h"
+#include "member.h"
+#include "utils.h"
+
+
+namespace atom
+{
+
+
+bool
+Member::check_context( ChangeDetection::Mode mode, PyObject* context )
+{
+    switch( mode )
+    {
+        case ChangeDetection::Comparator:
+            if( !PyCallable_Check( context ) )
+            {
+                cppy::type_error( context, "callable" );
+                return false;
+            }
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+
+namespace
+{
+
+
+// The version of an atom container or 0 for any other object. The lists,
+// sets and dicts of atom can be modified through the methods of their
+// builtin base class (e.g. list.__init__), which do not draw a new version,
+// so only the containers whose storage is private are considered.
+uint64_t
+container_version( PyObject* value )
+{
+    if( AtomNumList::TypeCheck( value ) )
+        return atomnumlist_cast( value )->version;
+    if( AtomIntSet::TypeCheck( value ) )
+        return atomintset_cast( value )->version;
+    if( AtomSortedMap::TypeCheck( value ) )
+        return atomsortedmap_cast( value )->version;
+    if( AtomDeque::TypeCheck( value ) )
+        return atomdeque_cast( value )->version;
+    return 0;
+}
+
+
+int
+equality_handler( Member* member, PyObject* oldvalue, PyObject* newvalue )
+{
+    // Containers sharing a version hold the same items.
+    uint64_t version = container_version( oldvalue );
+    if( version != 0 && version == container_version( newvalue ) )
+        return 1;
+    return utils::safe_richcompare( oldvalue, newvalue, Py_EQ ) ? 1 : 0;
+}
+
+
+int
+identity_handler( Member* member, PyObject* oldvalue, PyObject* newvalue )
+{
+    return oldvalue == newvalue ? 1 : 0;
+}
+
+
+int
+comparator_handler( Member* member, PyObject* oldvalue, PyObject* newvalue )
+{
+    cppy::ptr args( PyTuple_Pack( 2, oldvalue, newvalue ) );
+    if( !args )
+        return -1;
+    cppy::ptr res( PyObject_Call( member->change_detection_context, args.get(), 0 ) );
+    if( !res )
+        return -1;
+    return PyObject_IsTrue( res.get() );
+}
+
+
+typedef int
+( *handler )( Member* member, PyObject* oldvalue, PyObject* newvalue );
+
+
+static handler
+handlers[] = {
+    equality_handler,
+    identity_handler,
+    comparator_handler
+};
+
+
+}  // namespace
+
+
+int
+Member::unchanged( PyObject* oldvalue, PyObject* newvalue )
+{
+    if( get_change_detection_mode() >= sizeof( handlers ) )
+        return equality_handler( this, oldvalue, newvalue );  // LCOV_EXCL_LINE
+    return handlers[ get_change_detection_mode() ]( this, oldvalue, newvalue );
+}
+
+
+}  // namespace atom
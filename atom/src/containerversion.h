@@ -0,0 +1,27 @@
+/*-----------------------------------------------------------------------------
+| Copyright (c) 2025, Nucleic Development Team.
+|
+| Distributed under the terms of the Modified BSD License.
+|
+| The full license is in the file LICENSE, distributed with this software.
+|----------------------------------------------------------------------------*/
+#pragma once
+#include <cstdint>
+
+
+namespace atom
+{
+
+// Draw a new version for an atom container which was created or modified.
+//
+// All containers draw their versions from a single counter, so that two
+// containers share a version only when one is an unmodified copy of the
+// other and hence holds the same items. Zero is never drawn.
+inline uint64_t
+next_container_version()
+{
+    static uint64_t counter = 0;
+    return ++counter;
+}
+
+}  // namespace atom
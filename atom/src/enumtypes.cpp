@@ -25,6 +25,7 @@ PyObject* PyDefaultValue = 0;
 PyObject* PyValidate = 0;
 PyObject* PyPostValidate = 0;
 PyObject* PyGetState = 0;
+PyObject* PyChangeDetection = 0;
 PyObject* PyChangeType = 0;
 
 
@@ -271,8 +272,14 @@ bool init_enumtypes()
         add_long( dict_ptr, expand_enum( List ) );
         add_long( dict_ptr, expand_enum( ContainerList ) );
         add_long( dict_ptr, expand_enum( Set ) );
+        add_long( dict_ptr, expand_enum( ContainerSet ) );
         add_long( dict_ptr, expand_enum( Dict ) );
+        add_long( dict_ptr, expand_enum( ContainerDict ) );
         add_long( dict_ptr, expand_enum( DefaultDict ) );
+        add_long( dict_ptr, expand_enum( NumericList ) );
+        add_long( dict_ptr, expand_enum( IntSet ) );
+        add_long( dict_ptr, expand_enum( SortedMap ) );
+        add_long( dict_ptr, expand_enum( Deque ) );
         add_long( dict_ptr, expand_enum( OptionalInstance ) );
         add_long( dict_ptr, expand_enum( Instance ) );
         add_long( dict_ptr, expand_enum( OptionalTyped ) );
@@ -355,6 +362,23 @@ bool init_enumtypes()
         }
     }
 
+    {
+        using namespace ChangeDetection;
+        cppy::ptr dict_ptr( PyDict_New() );
+        if( !dict_ptr )
+        {
+            return false;  // LCOV_EXCL_LINE
+        }
+        add_long( dict_ptr, expand_enum( Equality ) );
+        add_long( dict_ptr, expand_enum( Identity ) );
+        add_long( dict_ptr, expand_enum( Comparator ) );
+        PyChangeDetection = make_enum( enum_cls, "ChangeDetection", dict_ptr );
+        if( !PyChangeDetection )
+        {
+            return false;  // LCOV_EXCL_LINE (enum creation failed, impossible)
+        }
+    }
+
     return true;
 }
 
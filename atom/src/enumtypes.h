@@ -22,6 +22,7 @@ extern PyObject* PyDefaultValue;
 extern PyObject* PyValidate;
 extern PyObject* PyPostValidate;
 extern PyObject* PyGetState;
+extern PyObject* PyChangeDetection;
 
 
 bool init_enumtypes();
@@ -112,6 +113,12 @@ from_py_enum( PyObject* value, GetState::Mode& out )
     return _from_py_enum( value, PyGetState, out );
 }
 
+template<> inline bool
+from_py_enum( PyObject* value, ChangeDetection::Mode& out )
+{
+    return _from_py_enum( value, PyChangeDetection, out );
+}
+
 
 template<typename T> inline PyObject*
 _to_py_enum( T value, PyObject* py_enum_class )
@@ -193,6 +200,13 @@ to_py_enum( GetState::Mode value )
     return _to_py_enum( value, PyGetState );
 }
 
+
+template<> inline PyObject*
+to_py_enum( ChangeDetection::Mode value )
+{
+    return _to_py_enum( value, PyChangeDetection );
+}
+
 }  // namespace EnumTypes
 
 }  // namespace atom
@@ -0,0 +1,1254 @@
+/*-----------------------------------------------------------------------------
+| Copyright (c) 2025, Nucleic Development Team.
+|
+| Distributed under the terms of the Modified BSD License.
+|
+| The full license is in the file LICENSE, distributed with this software.
+|----------------------------------------------------------------------------*/
+#include <cppy/cppy.h>
+#include <algorithm>
+#include <vector>
+#include <sstream>
+#include "packagenaming.h"
+#include "sortedtree.h"
+#include "utils.h"
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wdeprecated-writable-strings"
+#endif
+
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#endif
+
+
+namespace
+{
+
+using namespace atom::sortedtree;
+
+
+// Draw the priority of a node of a treap from a xorshift generator.
+uint32_t
+next_priority()
+{
+    static uint32_t state = 2463534242u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+
+// Half-open interval [start, end) mapped to a value. The bounds are ordered
+// like the keys of a sortedmap, ints and floats being compared through their
+// native copies.
+struct IntervalNode
+{
+    IntervalNode( const SortKey& start_key, const SortKey& end_key, PyObject* item ) :
+        start( cppy::incref( start_key.order ) ), end( cppy::incref( end_key.order ) ),
+        value( cppy::incref( item ) ), nstart( start_key.native ), nend( end_key.native ),
+        left( 0 ), right( 0 ), max_end( this ), size( 1 ),
+        priority( next_priority() ) {}
+
+    SortKey start_key() const
+    {
+        SortKey key = { start.get(), nstart };
+        return key;
+    }
+
+    SortKey end_key() const
+    {
+        SortKey key = { end.get(), nend };
+        return key;
+    }
+
+    cppy::ptr start;
+    cppy::ptr end;
+    cppy::ptr value;
+    NativeKey nstart;
+    NativeKey nend;
+    IntervalNode* left;
+    IntervalNode* right;
+    IntervalNode* max_end;  // node of the subtree whose interval ends last
+    size_t size;  // number of nodes of the subtree
+    uint32_t priority;  // larger than the priorities of the children
+};
+
+
+// Treap of intervals ordered by start then by end, each node tracking the
+// largest end of its subtree. Queries skip the subtrees whose intervals all
+// end before the queried range, so that they only walk the paths leading to
+// the reported intervals.
+class IntervalTree
+{
+
+public:
+
+    typedef IntervalNode Node;
+
+    IntervalTree() : m_root( 0 ) {}
+
+    IntervalTree( const IntervalTree& other ) : m_root( clone( other.m_root ) ) {}
+
+    ~IntervalTree()
+    {
+        release( m_root );
+    }
+
+    size_t size() const
+    {
+        return m_root ? m_root->size : 0;
+    }
+
+    void swap( IntervalTree& other )
+    {
+        std::swap( m_root, other.m_root );
+    }
+
+    // The node of the interval [start, end) or null if there is none.
+    Node* find( const SortKey& start, const SortKey& end, const KeyOrder& order ) const
+    {
+        Node* node = m_root;
+        while( node )
+        {
+            int res = compare( start, end, node, order );
+            if( res == 0 )
+                return node;
+            node = res < 0 ? node->left : node->right;
+        }
+        return 0;
+    }
+
+    // The node of the given rank, which must be valid.
+    Node* at( size_t rank ) const
+    {
+        Node* node = m_root;
+        for( ;; )
+        {
+            size_t left = node->left ? node->left->size : 0;
+            if( rank == left )
+                return node;
+            if( rank < left )
+                node = node->left;
+            else
+            {
+                rank -= left + 1;
+                node = node->right;
+            }
+        }
+    }
+
+    // Insert a node whose interval is not in the tree yet.
+    void insert( Node* node, const KeyOrder& order )
+    {
+        insert( m_root, node, order );
+    }
+
+    // Detach the node of the interval [start, end), if any, and return it so
+    // that the caller can free it once the tree is consistent.
+    Node* erase( const SortKey& start, const SortKey& end, const KeyOrder& order )
+    {
+        return erase( m_root, start, end, order );
+    }
+
+    // Fill an empty tree with nodes sorted by strictly increasing intervals
+    // in O(n), by building the cartesian tree of their priorities.
+    void load_sorted( std::vector<Node*>& nodes, const KeyOrder& order )
+    {
+        std::vector<Node*> spine;
+        for( Node* node : nodes )
+        {
+            Node* last = 0;
+            while( !spine.empty() && spine.back()->priority < node->priority )
+            {
+                last = spine.back();
+                spine.pop_back();
+            }
+            node->left = last;
+            if( !spine.empty() )
+                spine.back()->right = node;
+            spine.push_back( node );
+        }
+        if( spine.empty() )
+            return;
+        m_root = spine.front();
+        refresh_all( m_root, order );
+    }
+
+    // Call visitor with the nodes, in order, of the intervals which end after
+    // lo and start before hi, or at hi if closed is true.
+    template<typename Visitor>
+    void overlapping( const SortKey& lo, const SortKey& hi, bool closed, const KeyOrder& order, Visitor& visitor ) const
+    {
+        overlapping( m_root, lo, hi, closed, order, visitor );
+    }
+
+    template<typename Visitor>
+    int visit( Visitor& visitor ) const
+    {
+        return visit( m_root, visitor );
+    }
+
+    size_t memory() const
+    {
+        return sizeof( IntervalTree ) + sizeof( Node ) * size();
+    }
+
+    // Three way comparison of the interval [start, end) with that of a node.
+    static int compare( const SortKey& start, const SortKey& end, Node* node, const KeyOrder& order )
+    {
+        SortKey other = node->start_key();
+        if( order.less( start, other ) )
+            return -1;
+        if( order.less( other, start ) )
+            return 1;
+        other = node->end_key();
+        if( order.less( end, other ) )
+            return -1;
+        return order.less( other, end ) ? 1 : 0;
+    }
+
+private:
+
+    // Restore the size and the largest end of a node from its children.
+    static void refresh( Node* node, const KeyOrder& order )
+    {
+        node->size = 1;
+        node->max_end = node;
+        Node* children[ 2 ] = { node->left, node->right };
+        for( Node* child : children )
+        {
+            if( !child )
+                continue;
+            node->size += child->size;
+            if( order.less( node->max_end->end_key(), child->max_end->end_key() ) )
+                node->max_end = child->max_end;
+        }
+    }
+
+    static void refresh_all( Node* node, const KeyOrder& order )
+    {
+        if( node->left )
+            refresh_all( node->left, order );
+        if( node->right )
+            refresh_all( node->right, order );
+        refresh( node, order );
+    }
+
+    // Split a subtree into the intervals less and greater than that of node.
+    static void split( Node* root, Node* node, const KeyOrder& order, Node*& less, Node*& greater )
+    {
+        if( !root )
+        {
+            less = greater = 0;
+            return;
+        }
+        if( compare( node->start_key(), node->end_key(), root, order ) < 0 )
+        {
+            split( root->left, node, order, less, root->left );
+            greater = root;
+        }
+        else
+        {
+            split( root->right, node, order, root->right, greater );
+            less = root;
+        }
+        refresh( root, order );
+    }
+
+    // Join two subtrees, all the intervals of first preceding those of second.
+    static Node* join( Node* first, Node* second, const KeyOrder& order )
+    {
+        if( !first )
+            return second;
+        if( !second )
+            return first;
+        if( first->priority > second->priority )
+        {
+            first->right = join( first->right, second, order );
+            refresh( first, order );
+            return first;
+        }
+        second->left = join( first, second->left, order );
+        refresh( second, order );
+        return second;
+    }
+
+    static void insert( Node*& root, Node* node, const KeyOrder& order )
+    {
+        if( !root )
+        {
+            root = node;
+            return;
+        }
+        if( node->priority > root->priority )
+        {
+            split( root, node, order, node->left, node->right );
+            refresh( node, order );
+            root = node;
+            return;
+        }
+        if( compare( node->start_key(), node->end_key(), root, order ) < 0 )
+            insert( root->left, node, order );
+        else
+            insert( root->right, node, order );
+        refresh( root, order );
+    }
+
+    static Node* erase( Node*& root, const SortKey& start, const SortKey& end, const KeyOrder& order )
+    {
+        if( !root )
+            return 0;
+        int res = compare( start, end, root, order );
+        if( res == 0 )
+        {
+            Node* node = root;
+            root = join( node->left, node->right, order );
+            node->left = node->right = 0;
+            return node;
+        }
+        Node* node = erase( res < 0 ? root->left : root->right, start, end, order );
+        if( node )
+            refresh( root, order );
+        return node;
+    }
+
+    template<typename Visitor>
+    static void overlapping( Node* node, const SortKey& lo, const SortKey& hi, bool closed, const KeyOrder& order, Visitor& visitor )
+    {
+        while( node && order.less( lo, node->max_end->end_key() ) )
+        {
+            overlapping( node->left, lo, hi, closed, order, visitor );
+            SortKey start = node->start_key();
+            if( closed ? order.less( hi, start ) : !order.less( start, hi ) )
+                return;
+            if( order.less( lo, node->end_key() ) )
+                visitor( node );
+            node = node->right;
+        }
+    }
+
+    static void release( Node* node )
+    {
+        if( !node )
+            return;
+        release( node->left );
+        release( node->right );
+        delete node;
+    }
+
+    static Node* clone( Node* node )
+    {
+        if( !node )
+            return 0;
+        Node* copy = new Node( *node );
+        copy->left = clone( node->left );
+        copy->right = clone( node->right );
+        if( node->max_end == node )
+            copy->max_end = copy;
+        else if( node->left && node->max_end == node->left->max_end )
+            copy->max_end = copy->left->max_end;
+        else
+            copy->max_end = copy->right->max_end;
+        return copy;
+    }
+
+    template<typename Visitor>
+    static int visit( Node* node, Visitor& visitor )
+    {
+        if( !node )
+            return 0;
+        if( int res = visitor( node->start.get() ) )
+            return res;
+        if( int res = visitor( node->end.get() ) )
+            return res;
+        if( int res = visitor( node->value.get() ) )
+            return res;
+        if( int res = visit( node->left, visitor ) )
+            return res;
+        return visit( node->right, visitor );
+    }
+
+    Node* m_root;
+};
+
+
+// Sort keys of the bounds of an interval given as a (start, end) tuple.
+class IntervalProbe
+{
+
+public:
+
+    // Returns false if key is not a pair.
+    bool init( PyObject* key )
+    {
+        if( !PyTuple_Check( key ) || PyTuple_GET_SIZE( key ) != 2 )
+        {
+            cppy::type_error( key, "(start, end) tuple" );
+            return false;
+        }
+        m_start.order = PyTuple_GET_ITEM( key, 0 );
+        m_end.order = PyTuple_GET_ITEM( key, 1 );
+        m_kind = KeyKind::join(
+            classify_key( m_start.order, m_start.native ),
+            classify_key( m_end.order, m_end.native )
+        );
+        return true;
+    }
+
+    // Returns false if the interval is empty.
+    bool check() const
+    {
+        if( KeyOrder( m_kind ).less( m_start, m_end ) )
+            return true;
+        cppy::ptr pair( PyTuple_Pack( 2, m_start.order, m_end.order ) );
+        if( !pair )
+            return false;  // LCOV_EXCL_LINE
+        cppy::ptr repr( PyObject_Repr( pair.get() ) );
+        if( repr )
+            PyErr_Format( PyExc_ValueError, "interval %U does not end after its start", repr.get() );
+        return false;
+    }
+
+    const SortKey& start() const
+    {
+        return m_start;
+    }
+
+    const SortKey& end() const
+    {
+        return m_end;
+    }
+
+    KeyKind::Kind kind() const
+    {
+        return m_kind;
+    }
+
+private:
+
+    SortKey m_start;
+    SortKey m_end;
+    KeyKind::Kind m_kind;
+};
+
+
+struct IntervalMap
+{
+    PyObject_HEAD
+    IntervalTree* m_items;
+    uint64_t m_version;  // bumped when intervals are added or removed
+    KeyKind::Kind m_kind;  // kind of all the bounds stored so far
+
+    static PyType_Spec TypeObject_Spec;
+
+    static PyTypeObject* TypeObject;
+
+    static bool Ready();
+
+    // The comparisons used to look bounds of a kind up. Bounds of another kind
+    // than those of the map are compared through rich comparisons.
+    KeyOrder order_for( KeyKind::Kind kind ) const
+    {
+        return KeyOrder( kind == m_kind ? m_kind : KeyKind::Object );
+    }
+
+    // The node of an interval. Returns false if key is not an interval.
+    bool find( PyObject* key, IntervalNode*& node )
+    {
+        IntervalProbe probe;
+        if( !probe.init( key ) )
+            return false;
+        node = m_items->find( probe.start(), probe.end(), order_for( probe.kind() ) );
+        return true;
+    }
+
+    PyObject* getitem( PyObject* key, PyObject* default_value = 0 )
+    {
+        IntervalNode* node;
+        if( !find( key, node ) )
+            return 0;
+        if( node )
+            return cppy::incref( node->value.get() );
+        if( default_value )
+            return cppy::incref( default_value );
+        return lookup_fail( key );
+    }
+
+    int setitem( PyObject* key, PyObject* value )
+    {
+        IntervalProbe probe;
+        if( !probe.init( key ) || !probe.check() )
+            return -1;
+        KeyKind::Kind kind = m_items->size() == 0 ? probe.kind() : KeyKind::join( m_kind, probe.kind() );
+        KeyOrder order( kind );
+        IntervalNode* node = m_items->find( probe.start(), probe.end(), order );
+        if( node )
+        {
+            // The replaced value is released once the map is consistent
+            // since its destruction may run arbitrary code.
+            cppy::ptr old( node->value.release() );
+            node->value = cppy::incref( value );
+            return 0;
+        }
+        m_kind = kind;
+        m_items->insert( new IntervalNode( probe.start(), probe.end(), value ), order );
+        ++m_version;
+        return 0;
+    }
+
+    // Detach the node of an interval into removed. Returns 1 if there was
+    // such an interval, 0 if there was none and -1 on error.
+    int erase( PyObject* key, IntervalNode*& removed )
+    {
+        IntervalProbe probe;
+        if( !probe.init( key ) )
+            return -1;
+        removed = m_items->erase( probe.start(), probe.end(), order_for( probe.kind() ) );
+        if( !removed )
+            return 0;
+        ++m_version;
+        return 1;
+    }
+
+    PyObject* pop( PyObject* key, PyObject* default_value = 0 )
+    {
+        IntervalNode* removed;
+        int res = erase( key, removed );
+        if( res < 0 )
+            return 0;
+        if( res > 0 )
+        {
+            PyObject* value = cppy::incref( removed->value.get() );
+            delete removed;
+            return value;
+        }
+        if( default_value )
+            return cppy::incref( default_value );
+        return lookup_fail( key );
+    }
+
+    static PyObject* lookup_fail( PyObject* key )
+    {
+        cppy::ptr pytuple( PyTuple_Pack( 1, key ) );
+        if( !pytuple )
+            return 0;  // LCOV_EXCL_LINE
+        PyErr_SetObject( PyExc_KeyError, pytuple.get() );
+        return 0;
+    }
+};
+
+
+namespace ViewKind
+{
+
+enum Kind: uint8_t
+{
+    Keys,
+    Values,
+    Items,
+};
+
+}  // namespace ViewKind
+
+
+// The object produced for a node by the iterators of a kind.
+PyObject*
+node_object( IntervalNode* node, ViewKind::Kind kind )
+{
+    if( kind == ViewKind::Values )
+        return cppy::incref( node->value.get() );
+    cppy::ptr key( PyTuple_Pack( 2, node->start.get(), node->end.get() ) );
+    if( !key || kind == ViewKind::Keys )
+        return key.release();
+    return PyTuple_Pack( 2, key.get(), node->value.get() );
+}
+
+
+// Iterator over an intervalmap, locating each node by rank.
+struct IntervalMapIterator
+{
+    PyObject_HEAD
+    IntervalMap* map;
+    size_t rank;  // rank of the next node
+    uint64_t version;
+    ViewKind::Kind kind;
+
+    static PyType_Spec TypeObject_Spec;
+
+    static PyTypeObject* TypeObject;
+
+    static PyObject* New( IntervalMap* map, ViewKind::Kind kind )
+    {
+        PyObject* pyiter = PyType_GenericAlloc( TypeObject, 0 );
+        if( !pyiter )
+            return 0;  // LCOV_EXCL_LINE
+        IntervalMapIterator* iter = reinterpret_cast<IntervalMapIterator*>( pyiter );
+        iter->map = reinterpret_cast<IntervalMap*>( cppy::incref( pyobject_cast( map ) ) );
+        iter->version = map->m_version;
+        iter->kind = kind;
+        return pyiter;
+    }
+};
+
+
+int
+IntervalMapIterator_traverse( IntervalMapIterator* self, visitproc visit, void* arg )
+{
+    Py_VISIT( pyobject_cast( self->map ) );
+    Py_VISIT( Py_TYPE( self ) );
+    return 0;
+}
+
+
+int
+IntervalMapIterator_clear( IntervalMapIterator* self )
+{
+    Py_CLEAR( self->map );
+    return 0;
+}
+
+
+void
+IntervalMapIterator_dealloc( IntervalMapIterator* self )
+{
+    PyObject_GC_UnTrack( self );
+    IntervalMapIterator_clear( self );
+    PyTypeObject* type = Py_TYPE( self );
+    type->tp_free( pyobject_cast( self ) );
+    Py_DECREF( type );
+}
+
+
+PyObject*
+IntervalMapIterator_next( IntervalMapIterator* self )
+{
+    if( !self->map )
+        return 0;
+    if( self->map->m_version != self->version )
+    {
+        Py_CLEAR( self->map );
+        PyErr_SetString( PyExc_RuntimeError, "intervalmap changed size during iteration" );
+        return 0;
+    }
+    if( self->rank >= self->map->m_items->size() )
+    {
+        Py_CLEAR( self->map );
+        return 0;
+    }
+    return node_object( self->map->m_items->at( self->rank++ ), self->kind );
+}
+
+
+PyObject*
+IntervalMapIterator_length_hint( IntervalMapIterator* self )
+{
+    return PyLong_FromSize_t( self->map ? self->map->m_items->size() - self->rank : 0 );
+}
+
+
+static PyMethodDef
+IntervalMapIterator_methods[] = {
+    { "__length_hint__", ( PyCFunction )IntervalMapIterator_length_hint, METH_NOARGS,
+      "" },
+    { 0 } // sentinel
+};
+
+
+static PyType_Slot IntervalMapIterator_Type_slots[] = {
+    { Py_tp_dealloc, void_cast( IntervalMapIterator_dealloc ) },      /* tp_dealloc */
+    { Py_tp_traverse, void_cast( IntervalMapIterator_traverse ) },    /* tp_traverse */
+    { Py_tp_clear, void_cast( IntervalMapIterator_clear ) },          /* tp_clear */
+    { Py_tp_iter, void_cast( PyObject_SelfIter ) },                   /* tp_iter */
+    { Py_tp_iternext, void_cast( IntervalMapIterator_next ) },        /* tp_iternext */
+    { Py_tp_methods, void_cast( IntervalMapIterator_methods ) },      /* tp_methods */
+    { 0, 0 },
+};
+
+
+PyTypeObject* IntervalMapIterator::TypeObject = NULL;
+
+
+PyType_Spec IntervalMapIterator::TypeObject_Spec = {
+	PACKAGE_TYPENAME( "intervalmap.intervalmap_iterator" ),  /* tp_name */
+	sizeof( IntervalMapIterator ),                           /* tp_basicsize */
+	0,                                                       /* tp_itemsize */
+	Py_TPFLAGS_DEFAULT|
+    Py_TPFLAGS_HAVE_GC,                                      /* tp_flags */
+    IntervalMapIterator_Type_slots                           /* slots */
+};
+
+
+// Owns the nodes built from a source until they are handed to a tree.
+struct NodeBatch
+{
+    ~NodeBatch()
+    {
+        for( IntervalNode* node : nodes )
+            delete node;
+    }
+
+    std::vector<IntervalNode*> nodes;
+};
+
+
+// Append a node for an interval and a value and join the kind of its bounds
+// to kind. Returns false if the interval is invalid.
+bool
+append_node( PyObject* key, PyObject* value, NodeBatch& batch, KeyKind::Kind& kind )
+{
+    IntervalProbe probe;
+    if( !probe.init( key ) || !probe.check() )
+        return false;
+    batch.nodes.push_back( new IntervalNode( probe.start(), probe.end(), value ) );
+    kind = KeyKind::join( kind, probe.kind() );
+    return true;
+}
+
+
+// Collect the intervals of a mapping or of an iterable of pairs.
+bool
+collect_nodes( PyObject* source, NodeBatch& batch, KeyKind::Kind& kind )
+{
+    if( PyDict_Check( source ) )
+    {
+        batch.nodes.reserve( batch.nodes.size() + PyDict_Size( source ) );
+        Py_ssize_t pos = 0;
+        PyObject* key;
+        PyObject* value;
+        while( PyDict_Next( source, &pos, &key, &value ) )
+        {
+            if( !append_node( key, value, batch, kind ) )
+                return false;
+        }
+        return true;
+    }
+    cppy::ptr pairs;
+    if( PyObject_TypeCheck( source, IntervalMap::TypeObject ) )
+    {
+        pairs = IntervalMapIterator::New( reinterpret_cast<IntervalMap*>( source ), ViewKind::Items );
+    }
+    else
+        pairs = cppy::incref( source );
+    if( !pairs )
+        return false;  // LCOV_EXCL_LINE
+    cppy::ptr seq( PyObject_GetIter( pairs.get() ) );
+    if( !seq )
+        return false;
+    cppy::ptr item;
+    while( ( item = PyIter_Next( seq.get() ) ) )
+    {
+        if( PySequence_Length( item.get() ) != 2 )
+        {
+            PyErr_Clear();
+            cppy::type_error( item.get(), "pairs of objects" );
+            return false;
+        }
+        cppy::ptr key( PySequence_GetItem( item.get(), 0 ) );
+        cppy::ptr value( PySequence_GetItem( item.get(), 1 ) );
+        if( !key || !value )
+            return false;
+        if( !append_node( key.get(), value.get(), batch, kind ) )
+            return false;
+    }
+    return !PyErr_Occurred();
+}
+
+
+// Sort nodes by interval and keep a single node per interval, holding the
+// last value like a dict.
+void
+sort_unique( std::vector<IntervalNode*>& nodes, const KeyOrder& order )
+{
+    auto less = [&]( IntervalNode* first, IntervalNode* second ) -> bool
+    {
+        return IntervalTree::compare( first->start_key(), first->end_key(), second, order ) < 0;
+    };
+    std::stable_sort( nodes.begin(), nodes.end(), less );
+    size_t last = 0;
+    for( size_t i = 1; i < nodes.size(); ++i )
+    {
+        if( !less( nodes[ last ], nodes[ i ] ) )
+        {
+            std::swap( nodes[ last ]->value, nodes[ i ]->value );
+            delete nodes[ i ];
+        }
+        else
+            nodes[ ++last ] = nodes[ i ];
+    }
+    if( !nodes.empty() )
+        nodes.resize( last + 1 );
+}
+
+
+// Add the intervals of a source, building the tree in one pass if the map is
+// empty and inserting them one by one else.
+bool
+update_from( IntervalMap* self, PyObject* source )
+{
+    NodeBatch batch;
+    KeyKind::Kind kind = KeyKind::Empty;
+    if( !collect_nodes( source, batch, kind ) )
+        return false;
+    if( batch.nodes.empty() )
+        return true;
+    IntervalTree* tree = self->m_items;
+    if( tree->size() == 0 )
+    {
+        KeyOrder order( kind );
+        sort_unique( batch.nodes, order );
+        tree->load_sorted( batch.nodes, order );
+        batch.nodes.clear();
+        self->m_kind = kind;
+        ++self->m_version;
+        return true;
+    }
+    KeyOrder order( KeyKind::join( self->m_kind, kind ) );
+    self->m_kind = order.kind;
+    for( size_t i = 0; i < batch.nodes.size(); ++i )
+    {
+        IntervalNode* node = batch.nodes[ i ];
+        IntervalNode* existing = tree->find( node->start_key(), node->end_key(), order );
+        if( existing )
+            std::swap( existing->value, node->value );
+        else
+        {
+            tree->insert( node, order );
+            batch.nodes[ i ] = 0;
+            ++self->m_version;
+        }
+    }
+    return true;
+}
+
+
+PyObject*
+IntervalMap_new( PyTypeObject* type, PyObject* args, PyObject* kwargs )
+{
+    PyObject* map = 0;
+    static char* kwlist[] = { "map", 0 };
+    if( !PyArg_ParseTupleAndKeywords( args, kwargs, "|O:__new__", kwlist, &map ) )
+        return 0;
+    cppy::ptr self( type->tp_alloc( type, 0 ) );
+    if( !self ) {
+        return 0;  // LCOV_EXCL_LINE (allocation failed, very unlikely)
+    }
+    IntervalMap* cself = reinterpret_cast<IntervalMap*>( self.get() );
+    cself->m_items = new IntervalTree();
+    cself->m_kind = KeyKind::Empty;
+    if( map && !update_from( cself, map ) )
+        return 0;
+    return self.release();
+}
+
+
+// Clearing the tree may cause arbitrary side effects on item
+// decref, including calls into methods which mutate the tree.
+// To avoid segfaults, first make the tree empty, then let the
+// destructors run for the old items.
+int
+IntervalMap_clear( IntervalMap* self )
+{
+    IntervalTree empty;
+    self->m_items->swap( empty );
+    ++self->m_version;
+    return 0;
+}
+
+
+int
+IntervalMap_traverse( IntervalMap* self, visitproc visit, void* arg )
+{
+    auto visitor = [&]( PyObject* ob ) -> int
+    {
+        Py_VISIT( ob );
+        return 0;
+    };
+    if( int res = self->m_items->visit( visitor ) )
+        return res;
+    Py_VISIT( Py_TYPE( self ) );
+    return 0;
+}
+
+
+void
+IntervalMap_dealloc( IntervalMap* self )
+{
+    PyObject_GC_UnTrack( self );
+    IntervalMap_clear( self );
+    delete self->m_items;
+    self->m_items = 0;
+    PyTypeObject* type = Py_TYPE( self );
+    type->tp_free( reinterpret_cast<PyObject*>( self ) );
+    Py_DECREF( type );
+}
+
+
+Py_ssize_t
+IntervalMap_length( IntervalMap* self )
+{
+    return static_cast<Py_ssize_t>( self->m_items->size() );
+}
+
+
+PyObject*
+IntervalMap_subscript( IntervalMap* self, PyObject* key )
+{
+    return self->getitem( key );
+}
+
+
+int
+IntervalMap_ass_subscript( IntervalMap* self, PyObject* key, PyObject* value )
+{
+    if( value )
+        return self->setitem( key, value );
+    IntervalNode* removed;
+    int res = self->erase( key, removed );
+    if( res == 0 )
+        IntervalMap::lookup_fail( key );
+    if( res <= 0 )
+        return -1;
+    delete removed;
+    return 0;
+}
+
+
+int
+IntervalMap_contains( IntervalMap* self, PyObject* key )
+{
+    IntervalNode* node;
+    if( !self->find( key, node ) )
+        return -1;
+    return node != 0;
+}
+
+
+PyObject*
+IntervalMap_contains_bool( IntervalMap* self, PyObject* key )
+{
+    int res = IntervalMap_contains( self, key );
+    if( res < 0 )
+        return 0;
+    return cppy::incref( res ? Py_True : Py_False );
+}
+
+
+PyObject*
+IntervalMap_get( IntervalMap* self, PyObject*const *args, Py_ssize_t nargs )
+{
+    if( nargs == 1 )
+        return self->getitem( args[0], Py_None );
+    if( nargs == 2 )
+        return self->getitem( args[0], args[1] );
+    std::ostringstream ostr;
+    if( nargs > 2 )
+        ostr << "get() expected at most 2 arguments, got " << nargs;
+    else
+        ostr << "get() expected at least 1 argument, got " << nargs;
+    return cppy::type_error( ostr.str().c_str() );
+}
+
+
+PyObject*
+IntervalMap_pop( IntervalMap* self, PyObject*const *args, Py_ssize_t nargs )
+{
+    if( nargs == 1 )
+        return self->pop( args[0] );
+    if( nargs == 2 )
+        return self->pop( args[0], args[1] );
+    std::ostringstream ostr;
+    if( nargs > 2 )
+        ostr << "pop() expected at most 2 arguments, got " << nargs;
+    else
+        ostr << "pop() expected at least 1 argument, got " << nargs;
+    return cppy::type_error( ostr.str().c_str() );
+}
+
+
+PyObject*
+IntervalMap_clearmethod( IntervalMap* self )
+{
+    IntervalMap_clear( self );
+    Py_RETURN_NONE;
+}
+
+
+PyObject*
+IntervalMap_iter( IntervalMap* self )
+{
+    return IntervalMapIterator::New( self, ViewKind::Keys );
+}
+
+
+PyObject*
+IntervalMap_values( IntervalMap* self )
+{
+    return IntervalMapIterator::New( self, ViewKind::Values );
+}
+
+
+PyObject*
+IntervalMap_items( IntervalMap* self )
+{
+    return IntervalMapIterator::New( self, ViewKind::Items );
+}
+
+
+// Like the copies of a dict subclass, the copies of a subclass are plain maps.
+PyObject*
+IntervalMap_copy( IntervalMap* self )
+{
+    PyTypeObject* type = IntervalMap::TypeObject;
+    PyObject* copy = type->tp_alloc( type, 0 );
+    if( !copy )
+        return 0;  // LCOV_EXCL_LINE
+    IntervalMap* ccopy = reinterpret_cast<IntervalMap*>( copy );
+    ccopy->m_items = new IntervalTree( *self->m_items );
+    ccopy->m_kind = self->m_kind;
+    return copy;
+}
+
+
+PyObject*
+IntervalMap_update( IntervalMap* self, PyObject* args )
+{
+    PyObject* other = 0;
+    if( !PyArg_ParseTuple( args, "|O:update", &other ) )
+        return 0;
+    if( other && !update_from( self, other ) )
+        return 0;
+    Py_RETURN_NONE;
+}
+
+
+// Return the ((start, end), value) pairs of the intervals which end after lo
+// and start before hi, or at hi if closed is true.
+PyObject*
+overlapping( IntervalMap* self, const KeyProbe& lo, const KeyProbe& hi, bool closed )
+{
+    KeyKind::Kind kind = KeyKind::join( lo.kind(), hi.kind() );
+    // References to the reported intervals are taken before building the
+    // pairs, since the allocations may run code modifying the map.
+    std::vector<cppy::ptr> found;
+    auto collect = [&]( IntervalNode* node )
+    {
+        found.push_back( node->start );
+        found.push_back( node->end );
+        found.push_back( node->value );
+    };
+    self->m_items->overlapping( lo.sort_key(), hi.sort_key(), closed, self->order_for( kind ), collect );
+    cppy::ptr pylist( PyList_New( found.size() / 3 ) );
+    if( !pylist )
+        return 0;  // LCOV_EXCL_LINE
+    for( size_t i = 0; i < found.size(); i += 3 )
+    {
+        cppy::ptr key( PyTuple_Pack( 2, found[ i ].get(), found[ i + 1 ].get() ) );
+        if( !key )
+            return 0;  // LCOV_EXCL_LINE
+        PyObject* pair = PyTuple_Pack( 2, key.get(), found[ i + 2 ].get() );
+        if( !pair )
+            return 0;  // LCOV_EXCL_LINE
+        PyList_SET_ITEM( pylist.get(), i / 3, pair );
+    }
+    return pylist.release();
+}
+
+
+PyObject*
+IntervalMap_at( IntervalMap* self, PyObject* point )
+{
+    KeyProbe probe;
+    probe.init( point, 0 );
+    return overlapping( self, probe, probe, true );
+}
+
+
+PyObject*
+IntervalMap_overlap( IntervalMap* self, PyObject*const *args, Py_ssize_t nargs )
+{
+    if( nargs != 2 )
+    {
+        std::ostringstream ostr;
+        ostr << "overlap() expected 2 arguments, got " << nargs;
+        return cppy::type_error( ostr.str().c_str() );
+    }
+    KeyProbe lo;
+    KeyProbe hi;
+    lo.init( args[0], 0 );
+    hi.init( args[1], 0 );
+    return overlapping( self, lo, hi, false );
+}
+
+
+PyObject*
+IntervalMap_repr( IntervalMap* self )
+{
+    std::ostringstream ostr;
+    ostr << "intervalmap([";
+    // The reprs may run code modifying the map.
+    IntervalTree copy( *self->m_items );
+    for( size_t i = 0; i < copy.size(); ++i )
+    {
+        IntervalNode* node = copy.at( i );
+        cppy::ptr startstr( PyObject_Repr( node->start.get() ) );
+        if( !startstr )
+            return 0;
+        cppy::ptr endstr( PyObject_Repr( node->end.get() ) );
+        if( !endstr )
+            return 0;
+        cppy::ptr valstr( PyObject_Repr( node->value.get() ) );
+        if( !valstr )
+            return 0;
+        ostr << "((" << PyUnicode_AsUTF8( startstr.get() ) << ", ";
+        ostr << PyUnicode_AsUTF8( endstr.get() ) << "), ";
+        ostr << PyUnicode_AsUTF8( valstr.get() ) << "), ";
+    }
+    if( copy.size() > 0 )
+        ostr.seekp( -2, std::ios_base::cur );
+    ostr << "])";
+    return PyUnicode_FromString( ostr.str().c_str() );
+}
+
+
+PyObject*
+IntervalMap_sizeof( IntervalMap* self, PyObject* args )
+{
+    Py_ssize_t size = Py_TYPE(self)->tp_basicsize;
+    size += self->m_items->memory();
+    return PyLong_FromSsize_t( size );
+}
+
+
+static PyMethodDef
+IntervalMap_methods[] = {
+    { "get", ( PyCFunction )IntervalMap_get, METH_FASTCALL,
+      "" },
+    { "pop", ( PyCFunction )IntervalMap_pop, METH_FASTCALL,
+      "" },
+    { "clear", ( PyCFunction )IntervalMap_clearmethod, METH_NOARGS,
+      "" },
+    { "values", ( PyCFunction )IntervalMap_values, METH_NOARGS,
+      "Iterate over the values in the order of their intervals." },
+    { "items", ( PyCFunction )IntervalMap_items, METH_NOARGS,
+      "Iterate over the ((start, end), value) pairs." },
+    { "copy", ( PyCFunction )IntervalMap_copy, METH_NOARGS,
+      "" },
+    { "update", ( PyCFunction )IntervalMap_update, METH_VARARGS,
+      "Add the items of a mapping or an iterable of pairs." },
+    { "at", ( PyCFunction )IntervalMap_at, METH_O,
+      "Return the ((start, end), value) pairs of the intervals containing point." },
+    { "overlap", ( PyCFunction )IntervalMap_overlap, METH_FASTCALL,
+      "Return the ((start, end), value) pairs of the intervals overlapping [start, end)." },
+    { "__contains__", ( PyCFunction )IntervalMap_contains_bool, METH_O | METH_COEXIST,
+      "" },
+    { "__getitem__", ( PyCFunction )IntervalMap_subscript, METH_O | METH_COEXIST,
+      "" },
+    { "__sizeof__", ( PyCFunction )IntervalMap_sizeof, METH_NOARGS,
+      "__sizeof__() -> size of object in memory, in bytes" },
+    { 0 } // sentinel
+};
+
+
+static PyType_Slot IntervalMap_Type_slots[] = {
+    { Py_tp_dealloc, void_cast( IntervalMap_dealloc ) },              /* tp_dealloc */
+    { Py_tp_traverse, void_cast( IntervalMap_traverse ) },            /* tp_traverse */
+    { Py_tp_clear, void_cast( IntervalMap_clear ) },                  /* tp_clear */
+    { Py_tp_methods, void_cast( IntervalMap_methods ) },              /* tp_methods */
+    { Py_tp_repr, void_cast( IntervalMap_repr ) },                    /* tp_repr */
+    { Py_tp_new, void_cast( IntervalMap_new ) },                      /* tp_new */
+    { Py_tp_iter, void_cast( IntervalMap_iter ) },                    /* tp_iter */
+    { Py_tp_alloc, void_cast( PyType_GenericAlloc ) },                /* tp_alloc */
+    { Py_mp_length, void_cast( IntervalMap_length ) },                /* mp_length */
+    { Py_mp_subscript, void_cast( IntervalMap_subscript ) },          /* mp_subscript */
+    { Py_mp_ass_subscript, void_cast( IntervalMap_ass_subscript ) },  /* mp_ass_subscript */
+    { Py_sq_contains, void_cast( IntervalMap_contains ) },            /* sq_contains */
+    { 0, 0 },
+};
+
+
+// Initialize static variables (otherwise the compiler eliminates them)
+PyTypeObject* IntervalMap::TypeObject = NULL;
+
+
+PyType_Spec IntervalMap::TypeObject_Spec = {
+	PACKAGE_TYPENAME( "intervalmap.intervalmap" ),   /* tp_name */
+	sizeof( IntervalMap ),                           /* tp_basicsize */
+	0,                                               /* tp_itemsize */
+	Py_TPFLAGS_DEFAULT|
+    Py_TPFLAGS_BASETYPE|
+    Py_TPFLAGS_HAVE_GC,                              /* tp_flags */
+    IntervalMap_Type_slots                           /* slots */
+};
+
+
+bool IntervalMap::Ready()
+{
+    // The reference will be handled by the module to which we will add the type
+	TypeObject = pytype_cast( PyType_FromSpec( &TypeObject_Spec ) );
+    if( !TypeObject )
+    {
+        return false;  // LCOV_EXCL_LINE (failed to create type, very unlikely)
+    }
+    IntervalMapIterator::TypeObject = pytype_cast( PyType_FromSpec( &IntervalMapIterator::TypeObject_Spec ) );
+    if( !IntervalMapIterator::TypeObject )
+    {
+        return false;  // LCOV_EXCL_LINE (failed to create type, very unlikely)
+    }
+    return true;
+}
+
+
+// Module creation
+
+static PyMethodDef
+intervalmap_methods[] = {
+    { 0 } // Sentinel
+};
+
+int
+intervalmap_modexec( PyObject *mod )
+{
+    if( !IntervalMap::Ready() )
+    {
+        return -1;  // LCOV_EXCL_LINE (failed to init type, very unlikely)
+    }
+
+    cppy::ptr intervalmap( pyobject_cast( IntervalMap::TypeObject ) );
+	if( PyModule_AddObject( mod, "intervalmap", intervalmap.get() ) < 0 )
+	{
+		return -1;  // LCOV_EXCL_LINE (failed to add type to module, very unlikely)
+	}
+    intervalmap.release();
+
+    return 0;
+}
+
+
+PyModuleDef_Slot intervalmap_slots[] = {
+    {Py_mod_exec, reinterpret_cast<void*>( intervalmap_modexec ) },
+    {0, NULL}
+};
+
+
+static struct PyModuleDef moduledef = {
+        PyModuleDef_HEAD_INIT,
+        "intervalmap",
+        "intervalmap extension module",
+        0,
+        intervalmap_methods,
+        intervalmap_slots,
+        NULL,
+        NULL,
+        NULL
+};
+
+
+}  // namespace
+
+
+PyMODINIT_FUNC PyInit_intervalmap( void )
+{
+    return PyModuleDef_Init( &moduledef );
+}
@@ -24,6 +24,9 @@ namespace atom
 {
 
 
+thread_local QuietValidation* QuietValidation::s_current = 0;
+
+
 namespace
 {
 
@@ -60,8 +63,13 @@ Member_clear( Member* self )
     Py_CLEAR( self->default_value_context );
     Py_CLEAR( self->post_validate_context );
     Py_CLEAR( self->getstate_context );
+    Py_CLEAR( self->change_detection_context );
     if( self->static_observers )
         self->static_observers->clear();
+    ValidateCache* cache = self->validate_cache;
+    self->validate_cache = 0;
+    if( cache )
+        cache->decref();
 }
 
 
@@ -79,6 +87,7 @@ Member_traverse( Member* self, visitproc visit, void* arg )
     Py_VISIT( self->default_value_context );
     Py_VISIT( self->post_validate_context );
     Py_VISIT( self->getstate_context );
+    Py_VISIT( self->change_detection_context );
     if( self->static_observers )
     {
         std::vector<Observer>::iterator it;
@@ -86,6 +95,12 @@ Member_traverse( Member* self, visitproc visit, void* arg )
         for( it = self->static_observers->begin(); it != end; ++it )
             Py_VISIT( it->m_observer.get() );
     }
+    if( self->validate_cache )
+    {
+        int res = self->validate_cache->traverse( visit, arg );
+        if( res )
+            return res;
+    }
 #if PY_VERSION_HEX >= 0x03090000
     // This was not needed before Python 3.9 (Python issue 35810 and 40217)
     Py_VISIT(Py_TYPE(self));
@@ -282,6 +297,91 @@ Member_do_setattr( Member* self, PyObject*const *args, Py_ssize_t n )
 }
 
 
+PyObject*
+Member_try_set( Member* self, PyObject*const *args, Py_ssize_t n )
+{
+    if( n != 2 )
+        return cppy::type_error( "try_set() takes exactly 2 arguments" );
+    PyObject* object = args[0];
+    PyObject* value = args[1];
+    if( !CAtom::TypeCheck( object ) )
+        return cppy::type_error( object, "CAtom" );
+    int res = self->try_setattr( catom_cast( object ), value );
+    if( res < 0 )
+        return 0;
+    return cppy::incref( res ? Py_True : Py_False );
+}
+
+
+PyObject*
+Member_try_set_many( Member* self, PyObject*const *args, Py_ssize_t n )
+{
+    if( n != 2 )
+        return cppy::type_error( "try_set_many() takes exactly 2 arguments" );
+    cppy::ptr objects( PySequence_Fast( args[0], "atoms must be a sequence" ) );
+    if( !objects )
+        return 0;
+    cppy::ptr values( PySequence_Fast( args[1], "values must be a sequence" ) );
+    if( !values )
+        return 0;
+    Py_ssize_t count = PySequence_Fast_GET_SIZE( objects.get() );
+    if( PySequence_Fast_GET_SIZE( values.get() ) != count )
+        return cppy::value_error( "atoms and values must have the same length" );
+    cppy::ptr failed( PyList_New( 0 ) );
+    if( !failed )
+        return 0;
+    for( Py_ssize_t i = 0; i < count; ++i )
+    {
+        PyObject* object = PySequence_Fast_GET_ITEM( objects.get(), i );
+        if( !CAtom::TypeCheck( object ) )
+            return cppy::type_error( object, "CAtom" );
+        int res = self->try_setattr(
+            catom_cast( object ), PySequence_Fast_GET_ITEM( values.get(), i )
+        );
+        if( res < 0 )
+            return 0;
+        if( res == 0 )
+        {
+            cppy::ptr index( PyLong_FromSsize_t( i ) );
+            if( !index || PyList_Append( failed.get(), index.get() ) != 0 )
+                return 0;
+        }
+    }
+    return failed.release();
+}
+
+
+PyObject*
+Member_validation_error( Member* self, PyObject*const *args, Py_ssize_t n )
+{
+    if( n != 2 )
+        return cppy::type_error( "validation_error() takes exactly 2 arguments" );
+    PyObject* object = args[0];
+    PyObject* value = args[1];
+    if( !CAtom::TypeCheck( object ) )
+        return cppy::type_error( object, "CAtom" );
+    cppy::ptr valid( self->full_validate( catom_cast( object ), Py_None, value ) );
+    if( valid )
+        Py_RETURN_NONE;
+    if( !PyErr_ExceptionMatches( PyExc_TypeError ) && !PyErr_ExceptionMatches( PyExc_ValueError ) )
+        return 0;
+#if PY_VERSION_HEX >= 0x030C0000
+    return PyErr_GetRaisedException();
+#else
+    PyObject* type;
+    PyObject* exc;
+    PyObject* traceback;
+    PyErr_Fetch( &type, &exc, &traceback );
+    PyErr_NormalizeException( &type, &exc, &traceback );
+    cppy::ptr typeptr( type );
+    cppy::ptr tracebackptr( traceback );
+    if( traceback )
+        PyException_SetTraceback( exc, traceback );
+    return exc;
+#endif
+}
+
+
 PyObject*
 Member_do_delattr( Member* self, PyObject* object )
 {
@@ -382,14 +482,32 @@ Member_do_should_getstate( Member* self, PyObject* object )
 }
 
 
+PyObject*
+Member_validate_cache_info( Member* self )
+{
+    if( !self->validate_cache )
+        Py_RETURN_NONE;
+    return self->validate_cache->info();
+}
+
+
+PyObject*
+Member_clear_validate_cache( Member* self )
+{
+    if( self->validate_cache )
+        self->validate_cache->clear();
+    Py_RETURN_NONE;
+}
+
+
 PyObject*
 Member_clone( Member* self )
 {
     // reimplement in a subclass to clone additional Python state
-    PyObject* pyclone = PyType_GenericNew( Py_TYPE(self), 0, 0 );
+    cppy::ptr pyclone( PyType_GenericNew( Py_TYPE(self), 0, 0 ) );
     if( !pyclone )
         return 0;
-    Member* clone = member_cast( pyclone );
+    Member* clone = member_cast( pyclone.get() );
     clone->modes = self->modes;
     clone->index = self->index;
     clone->name = cppy::incref( self->name );
@@ -404,12 +522,15 @@ Member_clone( Member* self )
     clone->default_value_context = cppy::xincref( self->default_value_context );
     clone->post_validate_context = cppy::xincref( self->post_validate_context );
     clone->getstate_context = cppy::xincref( self->getstate_context );
+    clone->change_detection_context = cppy::xincref( self->change_detection_context );
     if( self->static_observers )
     {
         clone->static_observers = new std::vector<Observer>();
         *clone->static_observers = *self->static_observers;
     }
-    return pyclone;
+    if( !clone->update_validate_cache() )
+        return 0;
+    return pyclone.release();
 }
 
 
@@ -671,6 +792,8 @@ Member_set_validate_mode( Member* self, PyObject*const *args, Py_ssize_t n )
         return 0;
     self->set_validate_mode( mode );
     cppy::replace( &self->validate_context, context );
+    if( !self->update_validate_cache() )
+        return 0;
     Py_RETURN_NONE;
 }
 
@@ -733,6 +856,35 @@ Member_set_getstate_mode( Member* self, PyObject*const *args, Py_ssize_t n )
 }
 
 
+PyObject*
+Member_get_change_detection_mode( Member* self, void* ctxt )
+{
+    cppy::ptr tuple( PyTuple_New( 2 ) );
+    if( !tuple )
+        return 0;
+    cppy::ptr py_enum( EnumTypes::to_py_enum( self->get_change_detection_mode() ) );
+    if( !py_enum )
+        return 0;
+    PyTuple_SET_ITEM( tuple.get(), 0, py_enum.release() );
+    PyObject* context = self->change_detection_context;
+    PyTuple_SET_ITEM( tuple.get(), 1, cppy::incref( context ? context : Py_None ) );
+    return tuple.release();
+}
+
+
+PyObject*
+Member_set_change_detection_mode( Member* self, PyObject*const *args, Py_ssize_t n )
+{
+    ChangeDetection::Mode mode;
+    PyObject* context;
+    if( !parse_mode_and_context( args, n, &context, mode ) )
+        return 0;
+    self->set_change_detection_mode( mode );
+    cppy::replace( &self->change_detection_context, context );
+    Py_RETURN_NONE;
+}
+
+
 PyObject*
 Member_notify( Member* self, PyObject* args, PyObject* kwargs )
 {
@@ -797,6 +949,29 @@ Member_set_metadata( Member* self, PyObject* value, void* ctxt )
 }
 
 
+PyObject*
+Member_get_lazy_validation( Member* self, void* ctxt )
+{
+    return cppy::incref( self->get_lazy_validation() ? Py_True : Py_False );
+}
+
+
+int
+Member_set_lazy_validation( Member* self, PyObject* value, void* ctxt )
+{
+    if( !value )
+    {
+        cppy::type_error( "can't delete lazy_validation" );
+        return -1;
+    }
+    int lazy = PyObject_IsTrue( value );
+    if( lazy < 0 )
+        return -1;
+    self->set_lazy_validation( lazy == 1 );
+    return 0;
+}
+
+
 PyObject*
 Member__get__( Member* self, PyObject* object, PyObject* type )
 {
@@ -840,6 +1015,8 @@ Member_getset[] = {
       "Get the default value mode for the member." },
     { "validate_mode", ( getter )Member_get_validate_mode, 0,
       "Get the validate mode for the member." },
+    { "lazy_validation", ( getter )Member_get_lazy_validation, ( setter )Member_set_lazy_validation,
+      "Get and set whether the items of container values are validated lazily." },
     { "post_getattr_mode", ( getter )Member_get_post_getattr_mode, 0,
       "Get the post getattr mode for the member." },
     { "post_setattr_mode", ( getter )Member_get_post_setattr_mode, 0,
@@ -848,6 +1025,8 @@ Member_getset[] = {
       "Get the post validate mode for the member." },
     { "getstate_mode", ( getter )Member_get_getstate_mode, 0,
       "Get the getstate mode for the member"},
+    { "change_detection_mode", ( getter )Member_get_change_detection_mode, 0,
+      "Get the change detection mode for the member." },
     { 0 } // sentinel
 };
 
@@ -878,10 +1057,20 @@ Member_methods[] = {
       "Remove the name of a method to call on all atoms when the member changes." },
     { "clone", ( PyCFunction )Member_clone, METH_NOARGS,
       "Create a clone of this member." },
+    { "validate_cache_info", ( PyCFunction )Member_validate_cache_info, METH_NOARGS,
+      "Get the statistics of the validation cache of the member, if any." },
+    { "clear_validate_cache", ( PyCFunction )Member_clear_validate_cache, METH_NOARGS,
+      "Clear the entries and statistics of the validation cache of the member." },
     { "do_getattr", ( PyCFunction )Member_do_getattr, METH_O,
       "Run the getattr handler for the member." },
     { "do_setattr", ( PyCFunction )Member_do_setattr, METH_FASTCALL,
       "Run the setattr handler for the member." },
+    { "try_set", ( PyCFunction )Member_try_set, METH_FASTCALL,
+      "Set the value on the atom, returning False instead of raising if it fails validation." },
+    { "try_set_many", ( PyCFunction )Member_try_set_many, METH_FASTCALL,
+      "Set values on atoms pairwise and return the indices which failed validation." },
+    { "validation_error", ( PyCFunction )Member_validation_error, METH_FASTCALL,
+      "Get the error raised when validating the value for the atom, or None." },
     { "do_delattr", ( PyCFunction )Member_do_delattr, METH_O,
       "Run the delattr handler for the member." },
     { "do_default_value", ( PyCFunction )Member_do_default_value, METH_O,
@@ -916,6 +1105,8 @@ Member_methods[] = {
       "Set the post validate mode for the member." },
     { "set_getstate_mode", ( PyCFunction )Member_set_getstate_mode, METH_FASTCALL,
       "Set the getstate mode for the member." },
+    { "set_change_detection_mode", ( PyCFunction )Member_set_change_detection_mode, METH_FASTCALL,
+      "Set the change detection mode for the member." },
     { "notify", ( PyCFunction )Member_notify, METH_VARARGS | METH_KEYWORDS,
       "Notify the static observers for the given member and atom." },
     { "tag", ( PyCFunction )Member_tag, METH_VARARGS | METH_KEYWORDS,
@@ -14,6 +14,7 @@
 #include "catom.h"
 #include "modifyguard.h"
 #include "observer.h"
+#include "validatecache.h"
 
 #ifndef UINT64_C
 #define UINT64_C( c ) ( c ## ULL )
@@ -32,10 +33,12 @@ PACK(struct MemberModes
     SetAttr::Mode setattr: 4;
     PostSetAttr::Mode post_setattr: 3;
     DefaultValue::Mode default_value: 4;
-    Validate::Mode validate: 5;
+    Validate::Mode validate: 6;
     PostValidate::Mode post_validate: 3;
     DelAttr::Mode delattr: 3;
     GetState::Mode getstate: 3;
+    ChangeDetection::Mode change_detection: 2;
+    bool lazy_validation: 1;
 });
 
 struct Member
@@ -52,8 +55,10 @@ struct Member
     PyObject* default_value_context;
     PyObject* post_validate_context;
     PyObject* getstate_context;
+    PyObject* change_detection_context;
     ModifyGuard<Member>* modify_guard;
     std::vector<Observer>* static_observers;
+    ValidateCache* validate_cache;
     MemberModes modes;
     uint32_t index;
 
@@ -127,6 +132,18 @@ struct Member
         modes.validate = mode;
     }
 
+    // Whether the items of a container value are validated on first access
+    // rather than when the container is assigned.
+    bool get_lazy_validation()
+    {
+        return modes.lazy_validation;
+    }
+
+    void set_lazy_validation( bool lazy )
+    {
+        modes.lazy_validation = lazy;
+    }
+
     PostValidate::Mode get_post_validate_mode()
     {
         return modes.post_validate;
@@ -157,10 +174,24 @@ struct Member
         modes.getstate = mode;
     }
 
+    ChangeDetection::Mode get_change_detection_mode()
+    {
+        return modes.change_detection;
+    }
+
+    void set_change_detection_mode( ChangeDetection::Mode mode )
+    {
+        modes.change_detection = mode;
+    }
+
     PyObject* getattr( CAtom* atom );
 
     int setattr( CAtom* atom, PyObject* value );
 
+    // Returns 1 on success, 0 if the value failed validation and -1 on any
+    // other error. A validation failure leaves no exception set.
+    int try_setattr( CAtom* atom, PyObject* value );
+
     int delattr( CAtom* atom );
 
     PyObject* post_getattr( CAtom* atom, PyObject* value );
@@ -175,8 +206,18 @@ struct Member
 
     PyObject* full_validate( CAtom* atom, PyObject* oldvalue, PyObject* newvalue );
 
+    bool update_validate_cache();
+
+    // Whether two item validators accept and produce the same values, so that
+    // items validated by one need not be validated by the other.
+    static bool equivalent_validators( Member* first, Member* second );
+
     PyObject* should_getstate( CAtom* atom );
 
+    // Returns 1 if the new value is considered unchanged from the old one
+    // according to the change detection mode, 0 if not and -1 on error.
+    int unchanged( PyObject* oldvalue, PyObject* newvalue );
+
     bool has_observers()
     {
         return static_observers && static_observers->size() > 0;
@@ -225,10 +266,125 @@ struct Member
 
     static bool check_context( GetState::Mode mode, PyObject* context );
 
+    static bool check_context( ChangeDetection::Mode mode, PyObject* context );
+
     static int TypeCheck( PyObject* object )
     {
         return PyObject_TypeCheck( object, TypeObject );
     }
 };
 
+
+
+// While a quiet scope is active, the validation handlers of the member it was
+// opened for signal a failure through QuietValidation::fail, which raises a
+// bare exception type instead of formatting a message and records that the
+// validation itself failed. Errors raised by user code, such as a coercer or
+// a post validate method, are not recorded. A scope is carried into the
+// members validating the parts of the value, such as the items of a
+// container, and is paused once the value is validated. The scopes are
+// tracked per thread and any other validation, such as a nested assignment
+// made by a coercer, reports its failures in full.
+class QuietValidation
+{
+
+public:
+
+    QuietValidation( Member* member, CAtom* atom ) :
+        m_member( member ), m_other( 0 ), m_atom( atom ), m_outer( s_current ),
+        m_root( this ), m_failed( false )
+    {
+        s_current = this;
+    }
+
+    // Extend the innermost scope, if it covers the owner, to the members
+    // validating the parts of its value.
+    QuietValidation( Member* owner, CAtom* atom, Member* member, Member* other = 0 ) :
+        m_member( member ), m_other( other ), m_atom( atom ), m_outer( s_current ),
+        m_root( 0 ), m_failed( false )
+    {
+        if( active( owner, atom ) )
+        {
+            m_root = m_outer->m_root;
+            s_current = this;
+        }
+    }
+
+    ~QuietValidation()
+    {
+        if( m_root )
+            s_current = m_outer;
+    }
+
+    bool failed() const
+    {
+        return m_failed;
+    }
+
+    static bool active( Member* member, CAtom* atom )
+    {
+        return s_current && member && s_current->m_atom == atom &&
+            ( s_current->m_member == member || s_current->m_other == member );
+    }
+
+    // Raise a bare exception of the given type and record the failure if a
+    // scope covers the member, otherwise leave it to the caller to report.
+    static bool fail( Member* member, CAtom* atom, PyObject* type )
+    {
+        if( !active( member, atom ) )
+            return false;
+        PyErr_SetNone( type );
+        s_current->m_root->m_failed = true;
+        return true;
+    }
+
+    // Record the TypeError or ValueError raised by a validator defined in
+    // Python as a validation failure.
+    static void record( Member* member, CAtom* atom )
+    {
+        if( active( member, atom ) && (
+                PyErr_ExceptionMatches( PyExc_TypeError ) ||
+                PyErr_ExceptionMatches( PyExc_ValueError ) ) )
+            s_current->m_root->m_failed = true;
+    }
+
+    // Suspend the scopes while the validated value is stored and notified.
+    class Pause
+    {
+
+    public:
+
+        Pause() : m_outer( s_current )
+        {
+            s_current = 0;
+        }
+
+        ~Pause()
+        {
+            s_current = m_outer;
+        }
+
+    private:
+
+        Pause( const Pause& );
+        Pause& operator=( const Pause& );
+
+        QuietValidation* m_outer;
+    };
+
+private:
+
+    QuietValidation( const QuietValidation& );
+    QuietValidation& operator=( const QuietValidation& );
+
+    Member* m_member;
+    Member* m_other;
+    CAtom* m_atom;
+    QuietValidation* m_outer;
+    QuietValidation* m_root;  // the scope opened for the assignment, 0 if not pushed
+    bool m_failed;
+
+    static thread_local QuietValidation* s_current;
+};
+
 }  // namespace atom
@@ -25,6 +25,37 @@ static PyObject* objectstr;
 static PyObject* namestr;
 static PyObject* valuestr;
 static PyObject* oldvaluestr;
+static PyObject* containerstr;
+static PyObject* operationstr;
+static PyObject* operationstrs[ ContainerOp::Count ];
+
+static const char* operationnames[ ContainerOp::Count ] = {
+    "__delitem__",
+    "__iadd__",
+    "__iand__",
+    "__imul__",
+    "__ior__",
+    "__isub__",
+    "__ixor__",
+    "__setitem__",
+    "add",
+    "append",
+    "appendleft",
+    "clear",
+    "difference_update",
+    "discard",
+    "extend",
+    "insert",
+    "intersection_update",
+    "pop",
+    "popitem",
+    "popleft",
+    "remove",
+    "reverse",
+    "sort",
+    "symmetric_difference_update",
+    "update",
+};
 
 
 PyObject*
@@ -174,6 +205,76 @@ property( CAtom* atom, Member* member, PyObject* oldvalue, PyObject* newvalue )
     return dict.release();
 }
 
+
+
+PyObject*
+container( CAtom* atom, Member* member, PyObject* value, ContainerOp::Op operation )
+{
+    cppy::ptr dict( PyDict_New() );
+    if( !dict )
+    {
+        return 0;
+    }
+    if( PyDict_SetItem( dict.get(),  typestr, containerstr ) != 0)
+    {
+        return 0;
+    }
+    if( PyDict_SetItem( dict.get(),  namestr, member->name ) != 0 )
+    {
+        return 0;
+    }
+    if( PyDict_SetItem( dict.get(),  objectstr, pyobject_cast( atom ) ) != 0 )
+    {
+        return 0;
+    }
+    if( PyDict_SetItem( dict.get(),  oldvaluestr, value ) != 0 )
+    {
+        return 0;
+    }
+    if( PyDict_SetItem( dict.get(),  valuestr, value ) != 0 )
+    {
+        return 0;
+    }
+    if( PyDict_SetItem( dict.get(),  operationstr, operationstrs[ operation ] ) != 0 )
+    {
+        return 0;
+    }
+    return dict.release();
+}
+
+
+bool
+container_observed( CAtom* atom, Member* member )
+{
+    return member->has_observers( ChangeType::Container ) || atom->has_observers( member->name );
+}
+
+
+bool
+notify_container( CAtom* atom, Member* member, PyObject* change )
+{
+    cppy::ptr args( PyTuple_Pack( 1, change ) );
+    if( !args )
+    {
+        return false;
+    }
+    if( member->has_observers( ChangeType::Container ) )
+    {
+        if( !member->notify( atom, args.get(), 0, ChangeType::Container ) )
+        {
+            return false;
+        }
+    }
+    if( atom->has_observers( member->name ) )
+    {
+        if( !atom->notify( member->name, args.get(), 0, ChangeType::Container ) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace MemberChange
 
 
@@ -235,6 +336,24 @@ init_memberchange()
     {
         return false;
     }
+    MemberChange::containerstr = PyUnicode_InternFromString( "container" );
+    if( !MemberChange::containerstr )
+    {
+        return false;
+    }
+    MemberChange::operationstr = PyUnicode_InternFromString( "operation" );
+    if( !MemberChange::operationstr )
+    {
+        return false;
+    }
+    for( int i = 0; i < ContainerOp::Count; ++i )
+    {
+        MemberChange::operationstrs[ i ] = PyUnicode_InternFromString( MemberChange::operationnames[ i ] );
+        if( !MemberChange::operationstrs[ i ] )
+        {
+            return false;
+        }
+    }
     alloced = true;
     return true;
 }
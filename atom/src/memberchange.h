@@ -13,6 +13,42 @@
 namespace atom
 {
 
+namespace ContainerOp
+{
+
+// The operations reported by the container changes.
+enum Op {
+    DelItem,
+    Iadd,
+    Iand,
+    Imul,
+    Ior,
+    Isub,
+    Ixor,
+    SetItem,
+    Add,
+    Append,
+    AppendLeft,
+    Clear,
+    DifferenceUpdate,
+    Discard,
+    Extend,
+    Insert,
+    IntersectionUpdate,
+    Pop,
+    PopItem,
+    PopLeft,
+    Remove,
+    Reverse,
+    Sort,
+    SymmetricDifferenceUpdate,
+    Update,
+    Count
+};
+
+} // end ContainerOp
+
+
 namespace MemberChange
 {
 
@@ -35,6 +71,23 @@ event( CAtom* atom, Member* member, PyObject* value );
 PyObject*
 property( CAtom* atom, Member* member, PyObject* oldvalue, PyObject* newvalue );
 
+
+// Create the common part of the change emitted by an operation on the
+// container value of a member. The container is both the value and the old
+// value of the change. The caller adds the operation payload.
+PyObject*
+container( CAtom* atom, Member* member, PyObject* value, ContainerOp::Op operation );
+
+
+// Whether the member or the atom have observers of container changes.
+bool
+container_observed( CAtom* atom, Member* member );
+
+
+// Deliver a container change to the observers of the member and the atom.
+bool
+notify_container( CAtom* atom, Member* member, PyObject* change );
+
 } // namespace MemberChange
 
 
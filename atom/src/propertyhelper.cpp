@@ -80,8 +80,16 @@ reset_property( PyObject* mod, PyObject* args )
         {
             return 0;
         }
-        bool cached = member->get_getattr_mode() == GetAttr::CachedProperty;
-        if( !cached || !utils::safe_richcompare( oldptr, newptr, Py_EQ ) )
+        int same = 0;
+        if( member->get_getattr_mode() == GetAttr::CachedProperty )
+        {
+            same = member->unchanged( oldptr.get(), newptr.get() );
+            if( same < 0 )
+            {
+                return 0;
+            }
+        }
+        if( !same )
         {
             cppy::ptr argsptr( property_args( atom, member, oldptr.get(), newptr.get() ) );
             if( !argsptr )
@@ -120,6 +120,7 @@ slot_handler( Member* member, CAtom* atom, PyObject* value )
     newptr = member->full_validate( atom, oldptr.get(), newptr.get() );
     if( !newptr )
         return -1;
+    QuietValidation::Pause pause;
     atom->set_slot( member->index, newptr.get() );
     if( member->get_post_setattr_mode() )
     {
@@ -131,11 +132,13 @@ slot_handler( Member* member, CAtom* atom, PyObject* value )
         cppy::ptr argsptr;
         if( member->has_observers(ChangeType::Update | ChangeType::Create) )
         {
-
-            if( valid_old && utils::safe_richcompare( oldptr, newptr, Py_EQ ) )
-                return 0;
             if( valid_old )
+            {
+                int same = member->unchanged( oldptr.get(), newptr.get() );
+                if( same != 0 )
+                    return same < 0 ? -1 : 0;
                 argsptr = updated_args( atom, member, oldptr.get(), newptr.get() );
+            }
             else
                 argsptr = created_args( atom, member, newptr.get() );
             if( !argsptr )
@@ -149,10 +152,11 @@ slot_handler( Member* member, CAtom* atom, PyObject* value )
             ChangeType::Type change_type = ChangeType::Any;
             if( !argsptr )
             {
-                if( valid_old && utils::safe_richcompare( oldptr, newptr, Py_EQ ) )
-                    return 0;
                 if( valid_old )
                 {
+                    int same = member->unchanged( oldptr.get(), newptr.get() );
+                    if( same != 0 )
+                        return same < 0 ? -1 : 0;
                     change_type = ChangeType::Update;
                     argsptr = updated_args( atom, member, oldptr.get(), newptr.get() );
                 }
@@ -218,6 +222,7 @@ event_handler( Member* member, CAtom* atom, PyObject* value )
     cppy::ptr valueptr( member->full_validate( atom, Py_None, value ) );
     if( !valueptr )
         return -1;
+    QuietValidation::Pause pause;
     if( atom->get_notifications_enabled() )
     {
         cppy::ptr argsptr;
@@ -257,6 +262,7 @@ int
 delegate_handler( Member* member, CAtom* atom, PyObject* value )
 {
     Member* delegate = member_cast( member->setattr_context );
+    QuietValidation quiet( member, atom, delegate );
     return delegate->setattr( atom, value );
 }
 
@@ -296,6 +302,7 @@ call_object_object_value_handler( Member* member, CAtom* atom, PyObject* value )
     cppy::ptr valueptr( member->full_validate( atom, Py_None, value ) );
     if( !valueptr )
         return -1;
+    QuietValidation::Pause pause;
     PyObject* args[] = { pyobject_cast( atom ), valueptr.get() };
     cppy::ptr ok( PyObject_Vectorcall( member->setattr_context, args, 2, 0 ) );
     if( !ok )
@@ -310,6 +317,7 @@ call_object_object_name_value_handler( Member* member, CAtom* atom, PyObject* va
     cppy::ptr valueptr( member->full_validate( atom, Py_None, value ) );
     if( !valueptr )
         return -1;
+    QuietValidation::Pause pause;
     PyObject* args[] = { pyobject_cast( atom ), member->name, valueptr.get() };
     cppy::ptr ok( PyObject_Vectorcall( member->setattr_context, args, 3, 0 ) );
     if( !ok )
@@ -324,6 +332,7 @@ object_method_value_handler( Member* member, CAtom* atom, PyObject* value )
     cppy::ptr valueptr( member->full_validate( atom, Py_None, value ) );
     if( !valueptr )
         return -1;
+    QuietValidation::Pause pause;
     cppy::ptr ok( PyObject_CallMethodOneArg( pyobject_cast( atom ), member->setattr_context, valueptr.get() ) );
     if ( !ok )
         return -1;
@@ -337,6 +346,7 @@ object_method_name_value_handler( Member* member, CAtom* atom, PyObject* value )
     cppy::ptr valueptr( member->full_validate( atom, Py_None, value ) );
     if( !valueptr )
         return -1;
+    QuietValidation::Pause pause;
     PyObject* args[] = { pyobject_cast( atom ), member->name, valueptr.get() };
     cppy::ptr ok( PyObject_VectorcallMethod( member->setattr_context, args, 3 | PY_VECTORCALL_ARGUMENTS_OFFSET, 0 ) );
     if( !ok )
@@ -351,6 +361,7 @@ member_method_object_value_handler( Member* member, CAtom* atom, PyObject* value
     cppy::ptr valueptr( member->full_validate( atom, Py_None, value ) );
     if( !valueptr )
         return -1;
+    QuietValidation::Pause pause;
     PyObject* args[] = { pyobject_cast( member ), pyobject_cast( atom ), valueptr.get() };
     cppy::ptr ok( PyObject_VectorcallMethod( member->setattr_context, args, 3 | PY_VECTORCALL_ARGUMENTS_OFFSET, 0 ) );
     if( !ok )
@@ -393,4 +404,23 @@ Member::setattr( CAtom* atom, PyObject* value )
 }
 
 
+// Assign the value through the setattr handler in a quiet scope. A failure
+// of the validation is cleared and reported as 0.
+int
+Member::try_setattr( CAtom* atom, PyObject* value )
+{
+    QuietValidation quiet( this, atom );
+    if( setattr( atom, value ) == 0 )
+        return 1;
+    if( quiet.failed() && (
+            PyErr_ExceptionMatches( PyExc_TypeError ) ||
+            PyErr_ExceptionMatches( PyExc_ValueError ) ) )
+    {
+        PyErr_Clear();
+        return 0;
+    }
+    return -1;
+}
+
+
 }  // namespace atom
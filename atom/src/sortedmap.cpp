@@ -7,10 +7,13 @@
 |----------------------------------------------------------------------------*/
 #include <cppy/cppy.h>
 #include <algorithm>
+#include <cstring>
+#include <iterator>
 #include <vector>
 #include <iostream>
 #include <sstream>
 #include "packagenaming.h"
+#include "sortedtree.h"
 #include "utils.h"
 
 #ifdef __clang__
@@ -25,320 +28,853 @@
 namespace
 {
 
-class MapItem
+using namespace atom::sortedtree;
+
+
+struct SortedMap
 {
+    typedef MapTree Items;
 
-public:
+    PyObject_HEAD
+    Items* m_items;
+    PyObject* m_keyfunc;  // null if the keys are ordered by themselves
+    uint64_t m_version;  // bumped when items are added or removed
+    KeyKind::Kind m_kind;  // kind of all the keys stored so far
 
-    MapItem() {}
+    static PyType_Spec TypeObject_Spec;
 
-    MapItem( PyObject* key, PyObject* value ) :
-        m_key( cppy::incref( key ) ), m_value( cppy::incref( value ) ) { }
+    static PyTypeObject* TypeObject;
 
-    MapItem( cppy::ptr& key, cppy::ptr& value ) :
-        m_key( key ), m_value( value ) { }
+	static bool Ready();
 
-    MapItem( cppy::ptr& key, PyObject* value ) :
-        m_key( key ), m_value( cppy::incref( value ) ) { }
+    // The comparisons used to look a probe up. A probe of another kind than
+    // the keys of the map is compared through rich comparisons.
+    KeyOrder order_for( const KeyProbe& probe ) const
+    {
+        return KeyOrder( probe.kind() == m_kind ? m_kind : KeyKind::Object );
+    }
 
-    MapItem( PyObject* key, cppy::ptr& value ) :
-        m_key( cppy::incref( key ) ), m_value( value ) { }
+    // The item stored under the key of a probe. Returns false if the key
+    // function raised.
+    bool find( PyObject* key, MapItem*& item )
+    {
+        KeyProbe probe;
+        if( !probe.init( key, m_keyfunc ) )
+            return false;
+        item = m_items->find( probe.sort_key(), order_for( probe ) );
+        return true;
+    }
 
-    ~MapItem() { }
+    // The rank at which key would be inserted. Returns false if the key
+    // function raised.
+    bool bisect( PyObject* key, bool right, size_t& rank )
+    {
+        KeyProbe probe;
+        if( !probe.init( key, m_keyfunc ) )
+            return false;
+        rank = m_items->bisect( probe.sort_key(), right, order_for( probe ) );
+        return true;
+    }
 
-    PyObject* key()
+    // Insert an item of the given kind, switching the map to rich comparisons
+    // if its keys are of another kind.
+    void insert( MapItem& item, KeyKind::Kind kind, cppy::ptr& old )
     {
-        return m_key.get();
+        m_kind = m_items->size() == 0 ? kind : KeyKind::join( m_kind, kind );
+        if( m_items->insert( item, KeyOrder( m_kind ), old ) )
+            ++m_version;
     }
 
-    PyObject* value()
+    PyObject* getitem( PyObject* key, PyObject* default_value = 0 )
     {
-        return m_value.get();
+        MapItem* item;
+        if( !find( key, item ) )
+            return 0;
+        if( item )
+            return cppy::incref( item->value() );
+        if( default_value )
+            return cppy::incref( default_value );
+        return lookup_fail( key );
     }
 
-    void update( PyObject* value )
+    int setitem( PyObject* key, PyObject* value )
     {
-        m_value = cppy::incref( value );
+        KeyProbe probe;
+        if( !probe.init( key, m_keyfunc ) )
+            return -1;
+        MapItem item( key, value, probe.sort_key() );
+        // The replaced value is released once the tree is consistent since
+        // its destruction may run arbitrary code.
+        cppy::ptr old;
+        insert( item, probe.kind(), old );
+        return 0;
     }
 
-    struct CmpLess
+    // Remove the item stored under key into removed. Returns 1 if there was
+    // such an item, 0 if there was none and -1 on error.
+    int erase( PyObject* key, MapItem& removed )
     {
-        // All three operators are needed in order to keep the
-        // MSVC debug version of std::lower_bound happy.
-        bool operator()( MapItem& first, MapItem& second )
-        {
-            if( first.m_key == second.m_key )
-                return false;
-            return atom::utils::safe_richcompare( first.m_key.get(), second.m_key.get(), Py_LT );
-        }
+        KeyProbe probe;
+        if( !probe.init( key, m_keyfunc ) )
+            return -1;
+        if( !m_items->erase( probe.sort_key(), order_for( probe ), removed ) )
+            return 0;
+        ++m_version;
+        return 1;
+    }
 
-        bool operator()( MapItem& first, PyObject* second )
-        {
-            if( first.m_key == second )
-                return false;
-            return atom::utils::safe_richcompare( first.m_key.get(), second, Py_LT );
-        }
+    int delitem( PyObject* key )
+    {
+        MapItem removed;
+        int res = erase( key, removed );
+        if( res == 0 )
+            lookup_fail( key );
+        return res > 0 ? 0 : -1;
+    }
 
-        bool operator()( PyObject* first, MapItem& second )
-        {
-            if( first == second.m_key )
-                return false;
-            return atom::utils::safe_richcompare( first, second.m_key.get(), Py_LT );
-        }
-    };
+    int contains( PyObject* key )
+    {
+        MapItem* item;
+        if( !find( key, item ) )
+            return -1;
+        return item != 0;
+    }
 
-    struct CmpEq
+    PyObject* pop( PyObject* key, PyObject* default_value=0 )
     {
-        bool operator()( MapItem& first, MapItem& second )
-        {
-            if( first.m_key == second.m_key )
-                return true;
-            return atom::utils::safe_richcompare( first.m_key.get(), second.m_key.get(), Py_EQ );
-        }
+        MapItem removed;
+        int res = erase( key, removed );
+        if( res < 0 )
+            return 0;
+        if( res > 0 )
+            return cppy::incref( removed.value() );
+        if( default_value )
+            return cppy::incref( default_value );
+        return lookup_fail( key );
+    }
 
-        bool operator()( MapItem& first, PyObject* second )
+    // Remove the items whose keys fall in the bounds of a slice, the stop
+    // bound being excluded.
+    int delslice( PyObject* slice )
+    {
+        cppy::ptr start( PyObject_GetAttrString( slice, "start" ) );
+        cppy::ptr stop( PyObject_GetAttrString( slice, "stop" ) );
+        cppy::ptr step( PyObject_GetAttrString( slice, "step" ) );
+        if( !start || !stop || !step )
+            return -1;  // LCOV_EXCL_LINE
+        if( step.get() != Py_None )
         {
-            if( first.m_key == second )
-                return true;
-            return atom::utils::safe_richcompare( first.m_key.get(),  second, Py_EQ );
+            PyErr_SetString( PyExc_ValueError, "sortedmap slices do not support a step" );
+            return -1;
         }
+        size_t first = 0;
+        size_t last = m_items->size();
+        if( start.get() != Py_None && !bisect( start.get(), false, first ) )
+            return -1;
+        if( stop.get() != Py_None && !bisect( stop.get(), false, last ) )
+            return -1;
+        if( last <= first )
+            return 0;
+        std::vector<MapItem> removed;
+        m_items->erase_range( first, last - first, removed );
+        ++m_version;
+        return 0;
+    }
+
+    static PyObject* lookup_fail( PyObject* key )
+    {
+        cppy::ptr pystr( PyObject_Str( key ) );
+        if( !pystr )
+            return 0;
+        cppy::ptr pytuple( PyTuple_Pack( 1, key ) );
+        if (!pytuple)
+            return 0;
+        PyErr_SetObject(PyExc_KeyError, pytuple.get());
+        return 0;
+    }
+};
+
+
+// Convert an index to a rank, negative indices counting from the end.
+bool
+rank_from_index( SortedMap* self, PyObject* index, size_t& rank )
+{
+    Py_ssize_t i = PyNumber_AsSsize_t( index, PyExc_IndexError );
+    if( i == -1 && PyErr_Occurred() )
+        return false;
+    Py_ssize_t size = static_cast<Py_ssize_t>( self->m_items->size() );
+    if( i < 0 )
+        i += size;
+    if( i < 0 || i >= size )
+    {
+        PyErr_SetString( PyExc_IndexError, "sortedmap index out of range" );
+        return false;
+    }
+    rank = static_cast<size_t>( i );
+    return true;
+}
 
-        bool operator()( PyObject* first, MapItem& second )
-        {
-            if( first == second.m_key )
-                return true;
-            return atom::utils::safe_richcompare( first, second.m_key.get(), Py_EQ );
-        }
-    };
 
-private:
+namespace ViewKind
+{
 
-    cppy::ptr m_key;
-    cppy::ptr m_value;
+enum Kind: uint8_t
+{
+    Keys,
+    Values,
+    Items,
 };
 
+}  // namespace ViewKind
 
-struct SortedMap
+
+// The object produced for an item by the views and iterators of a kind.
+PyObject*
+view_object( MapItem& item, ViewKind::Kind kind )
 {
-    typedef std::vector<MapItem> Items;
+    switch( kind )
+    {
+        case ViewKind::Keys:
+            return cppy::incref( item.key() );
+        case ViewKind::Values:
+            return cppy::incref( item.value() );
+        default:
+            return PyTuple_Pack( 2, item.key(), item.value() );
+    }
+}
+
 
+PyObject*
+size_changed_fail()
+{
+    PyErr_SetString( PyExc_RuntimeError, "sortedmap changed size during iteration" );
+    return 0;
+}
+
+
+// Iterator over a range of ranks of a sortedmap. The position in the current
+// leaf is cached until the layout of the tree changes.
+struct SortedMapIterator
+{
     PyObject_HEAD
-    Items* m_items;
+    SortedMap* map;
+    MapTree::Leaf* leaf;
+    size_t index;
+    size_t rank;  // rank of the next item
+    size_t remaining;
+    uint64_t version;
+    uint64_t generation;  // generation of the tree when leaf was located
+    bool reverse;
+    ViewKind::Kind kind;
 
     static PyType_Spec TypeObject_Spec;
 
     static PyTypeObject* TypeObject;
 
-	static bool Ready();
+    // Iterate over the items whose ranks are in [start, stop).
+    static PyObject* New( SortedMap* map, size_t start, size_t stop, bool reverse, ViewKind::Kind kind = ViewKind::Keys )
+    {
+        PyObject* pyiter = PyType_GenericAlloc( TypeObject, 0 );
+        if( !pyiter )
+            return 0;  // LCOV_EXCL_LINE
+        SortedMapIterator* iter = reinterpret_cast<SortedMapIterator*>( pyiter );
+        iter->map = reinterpret_cast<SortedMap*>( cppy::incref( pyobject_cast( map ) ) );
+        iter->version = map->m_version;
+        iter->reverse = reverse;
+        iter->kind = kind;
+        iter->remaining = stop > start ? stop - start : 0;
+        iter->rank = reverse ? stop - 1 : start;
+        if( iter->remaining )
+            iter->locate();
+        return pyiter;
+    }
 
-    PyObject* getitem( PyObject* key, PyObject* default_value = 0 )
+    void locate()
     {
-        Items::iterator it = std::lower_bound(
-            m_items->begin(), m_items->end(), key, MapItem::CmpLess()
-        );
-        if( it == m_items->end() )
+        MapTree::Position position = map->m_items->at( rank );
+        leaf = position.leaf;
+        index = position.index;
+        generation = map->m_items->generation();
+    }
+};
+
+
+int
+SortedMapIterator_traverse( SortedMapIterator* self, visitproc visit, void* arg )
+{
+    Py_VISIT( pyobject_cast( self->map ) );
+    Py_VISIT( Py_TYPE( self ) );
+    return 0;
+}
+
+
+int
+SortedMapIterator_clear( SortedMapIterator* self )
+{
+    Py_CLEAR( self->map );
+    return 0;
+}
+
+
+void
+SortedMapIterator_dealloc( SortedMapIterator* self )
+{
+    PyObject_GC_UnTrack( self );
+    SortedMapIterator_clear( self );
+    PyTypeObject* type = Py_TYPE( self );
+    type->tp_free( pyobject_cast( self ) );
+    Py_DECREF( type );
+}
+
+
+PyObject*
+SortedMapIterator_next( SortedMapIterator* self )
+{
+    if( !self->map )
+        return 0;
+    if( self->map->m_version != self->version )
+    {
+        Py_CLEAR( self->map );
+        return size_changed_fail();
+    }
+    if( self->remaining == 0 )
+    {
+        Py_CLEAR( self->map );
+        return 0;
+    }
+    if( self->map->m_items->generation() != self->generation )
+        self->locate();
+    PyObject* res = view_object( self->leaf->items[ self->index ], self->kind );
+    if( !res )
+        return 0;  // LCOV_EXCL_LINE
+    if( --self->remaining > 0 )
+    {
+        // Crossing to another leaf locates it from the root.
+        if( !self->reverse )
         {
-            if( default_value )
-                return cppy::incref( default_value );
-            return lookup_fail( key );
+            ++self->rank;
+            if( ++self->index == self->leaf->items.size() )
+                self->locate();
+        }
+        else
+        {
+            --self->rank;
+            if( self->index-- == 0 )
+                self->locate();
         }
-        if( MapItem::CmpEq()( *it, key ) )
-            return cppy::incref( it->value() );
-        if( default_value )
-            return cppy::incref( default_value );
-        return lookup_fail( key );
     }
+    return res;
+}
 
-    int setitem( PyObject* key, PyObject* value )
+
+PyObject*
+SortedMapIterator_length_hint( SortedMapIterator* self )
+{
+    return PyLong_FromSize_t( self->map ? self->remaining : 0 );
+}
+
+
+static PyMethodDef
+SortedMapIterator_methods[] = {
+    { "__length_hint__", ( PyCFunction )SortedMapIterator_length_hint, METH_NOARGS,
+      "" },
+    { 0 } // sentinel
+};
+
+
+static PyType_Slot SortedMapIterator_Type_slots[] = {
+    { Py_tp_dealloc, void_cast( SortedMapIterator_dealloc ) },      /* tp_dealloc */
+    { Py_tp_traverse, void_cast( SortedMapIterator_traverse ) },    /* tp_traverse */
+    { Py_tp_clear, void_cast( SortedMapIterator_clear ) },          /* tp_clear */
+    { Py_tp_iter, void_cast( PyObject_SelfIter ) },                 /* tp_iter */
+    { Py_tp_iternext, void_cast( SortedMapIterator_next ) },        /* tp_iternext */
+    { Py_tp_methods, void_cast( SortedMapIterator_methods ) },      /* tp_methods */
+    { 0, 0 },
+};
+
+
+PyTypeObject* SortedMapIterator::TypeObject = NULL;
+
+
+PyType_Spec SortedMapIterator::TypeObject_Spec = {
+	PACKAGE_TYPENAME( "sortedmap.sortedmap_iterator" ),  /* tp_name */
+	sizeof( SortedMapIterator ),                         /* tp_basicsize */
+	0,                                                   /* tp_itemsize */
+	Py_TPFLAGS_DEFAULT|
+    Py_TPFLAGS_HAVE_GC,                                  /* tp_flags */
+    SortedMapIterator_Type_slots                         /* slots */
+};
+
+
+// Live view over the keys, values or items of a sortedmap.
+struct SortedMapView
+{
+    PyObject_HEAD
+    SortedMap* map;
+    ViewKind::Kind kind;
+
+    static PyType_Spec KeysType_Spec;
+
+    static PyType_Spec ValuesType_Spec;
+
+    static PyType_Spec ItemsType_Spec;
+
+    static PyTypeObject* TypeObjects[ 3 ];  // indexed by kind
+
+    static PyObject* New( SortedMap* map, ViewKind::Kind kind )
+    {
+        PyObject* pyview = PyType_GenericAlloc( TypeObjects[ kind ], 0 );
+        if( !pyview )
+            return 0;  // LCOV_EXCL_LINE
+        SortedMapView* view = reinterpret_cast<SortedMapView*>( pyview );
+        view->map = reinterpret_cast<SortedMap*>( cppy::incref( pyobject_cast( map ) ) );
+        view->kind = kind;
+        return pyview;
+    }
+
+    static bool TypeCheck( PyObject* ob )
+    {
+        PyTypeObject* type = Py_TYPE( ob );
+        return type == TypeObjects[ 0 ] || type == TypeObjects[ 1 ] || type == TypeObjects[ 2 ];
+    }
+};
+
+
+int
+SortedMapView_traverse( SortedMapView* self, visitproc visit, void* arg )
+{
+    Py_VISIT( pyobject_cast( self->map ) );
+    Py_VISIT( Py_TYPE( self ) );
+    return 0;
+}
+
+
+int
+SortedMapView_clear( SortedMapView* self )
+{
+    Py_CLEAR( self->map );
+    return 0;
+}
+
+
+void
+SortedMapView_dealloc( SortedMapView* self )
+{
+    PyObject_GC_UnTrack( self );
+    SortedMapView_clear( self );
+    PyTypeObject* type = Py_TYPE( self );
+    type->tp_free( pyobject_cast( self ) );
+    Py_DECREF( type );
+}
+
+
+Py_ssize_t
+SortedMapView_length( SortedMapView* self )
+{
+    return static_cast<Py_ssize_t>( self->map->m_items->size() );
+}
+
+
+PyObject*
+SortedMapView_iter( SortedMapView* self )
+{
+    return SortedMapIterator::New( self->map, 0, self->map->m_items->size(), false, self->kind );
+}
+
+
+PyObject*
+SortedMapView_reversed( SortedMapView* self )
+{
+    return SortedMapIterator::New( self->map, 0, self->map->m_items->size(), true, self->kind );
+}
+
+
+int
+SortedMapView_contains( SortedMapView* self, PyObject* value )
+{
+    SortedMap* map = self->map;
+    if( self->kind == ViewKind::Keys )
+        return map->contains( value );
+    if( self->kind == ViewKind::Items )
+    {
+        if( !PyTuple_Check( value ) || PyTuple_GET_SIZE( value ) != 2 )
+            return 0;
+        MapItem* item;
+        if( !map->find( PyTuple_GET_ITEM( value, 0 ), item ) )
+            return -1;
+        if( !item )
+            return 0;
+        cppy::ptr stored( cppy::incref( item->value() ) );
+        return PyObject_RichCompareBool( stored.get(), PyTuple_GET_ITEM( value, 1 ), Py_EQ );
+    }
+    // Values are not ordered and must be scanned. Comparisons may run code
+    // modifying the map, so that a snapshot of the map is scanned instead.
+    uint64_t version = map->m_version;
+    MapTree snapshot;
+    snapshot.share( *map->m_items );
+    int res = 0;
+    auto scan = [&]( std::vector<MapItem>& items ) -> bool
     {
-        Items::iterator it = std::lower_bound(
-            m_items->begin(), m_items->end(), key, MapItem::CmpLess()
+        for( MapItem& item : items )
+        {
+            res = PyObject_RichCompareBool( item.value(), value, Py_EQ );
+            if( res == 0 && map->m_version != version )
+            {
+                size_changed_fail();
+                res = -1;
+            }
+            if( res != 0 )
+                return false;
+        }
+        return true;
+    };
+    snapshot.each_leaf( scan );
+    return res;
+}
+
+
+PyObject*
+SortedMapView_subscript( SortedMapView* self, PyObject* index )
+{
+    MapTree* items = self->map->m_items;
+    if( PySlice_Check( index ) )
+    {
+        Py_ssize_t start, stop, step;
+        if( PySlice_Unpack( index, &start, &stop, &step ) < 0 )
+            return 0;
+        Py_ssize_t count = PySlice_AdjustIndices(
+            static_cast<Py_ssize_t>( items->size() ), &start, &stop, step
         );
-        if( it == m_items->end() )
-            m_items->push_back( MapItem( key, value ) );
-        else if( MapItem::CmpEq()( *it, key ) )
-            it->update( value );
-        else
-            m_items->insert( it, MapItem( key, value ) );
+        cppy::ptr pylist( PyList_New( count ) );
+        if( !pylist )
+            return 0;  // LCOV_EXCL_LINE
+        for( Py_ssize_t i = 0; i < count; ++i )
+        {
+            PyObject* ob = view_object( items->at( start + i * step ).item(), self->kind );
+            if( !ob )
+                return 0;  // LCOV_EXCL_LINE
+            PyList_SET_ITEM( pylist.get(), i, ob );
+        }
+        return pylist.release();
+    }
+    size_t rank;
+    if( !rank_from_index( self->map, index, rank ) )
         return 0;
+    return view_object( items->at( rank ).item(), self->kind );
+}
+
+
+// Views compare equal to the sequences and views holding the same objects in
+// the same order.
+PyObject*
+SortedMapView_richcompare( SortedMapView* self, PyObject* other, int op )
+{
+    if( ( op != Py_EQ && op != Py_NE ) ||
+        !( PyList_Check( other ) || PyTuple_Check( other ) || SortedMapView::TypeCheck( other ) ) )
+        return cppy::incref( Py_NotImplemented );
+    Py_ssize_t length = PyObject_Length( other );
+    if( length < 0 )
+        return 0;  // LCOV_EXCL_LINE
+    bool equal = static_cast<size_t>( length ) == self->map->m_items->size();
+    if( equal )
+    {
+        cppy::ptr mine( SortedMapView_iter( self ) );
+        cppy::ptr theirs( PyObject_GetIter( other ) );
+        if( !mine || !theirs )
+            return 0;  // LCOV_EXCL_LINE
+        cppy::ptr first;
+        while( equal && ( first = PyIter_Next( mine.get() ) ) )
+        {
+            cppy::ptr second( PyIter_Next( theirs.get() ) );
+            if( !second )
+            {
+                if( PyErr_Occurred() )
+                    return 0;
+                equal = false;
+                break;
+            }
+            int res = PyObject_RichCompareBool( first.get(), second.get(), Py_EQ );
+            if( res < 0 )
+                return 0;
+            equal = res == 1;
+        }
+        if( PyErr_Occurred() )
+            return 0;
     }
+    return cppy::incref( equal == ( op == Py_EQ ) ? Py_True : Py_False );
+}
+
+
+PyObject*
+SortedMapView_repr( SortedMapView* self )
+{
+    static const char* names[] = { "sortedmap_keys", "sortedmap_values", "sortedmap_items" };
+    cppy::ptr pylist( PySequence_List( pyobject_cast( self ) ) );
+    if( !pylist )
+        return 0;
+    return PyUnicode_FromFormat( "%s(%R)", names[ self->kind ], pylist.get() );
+}
+
+
+static PyMethodDef
+SortedMapView_methods[] = {
+    { "__reversed__", ( PyCFunction )SortedMapView_reversed, METH_NOARGS,
+      "" },
+    { 0 } // sentinel
+};
+
+
+static PyType_Slot SortedMapView_Type_slots[] = {
+    { Py_tp_dealloc, void_cast( SortedMapView_dealloc ) },          /* tp_dealloc */
+    { Py_tp_traverse, void_cast( SortedMapView_traverse ) },        /* tp_traverse */
+    { Py_tp_clear, void_cast( SortedMapView_clear ) },              /* tp_clear */
+    { Py_tp_iter, void_cast( SortedMapView_iter ) },                /* tp_iter */
+    { Py_tp_repr, void_cast( SortedMapView_repr ) },                /* tp_repr */
+    { Py_tp_richcompare, void_cast( SortedMapView_richcompare ) },  /* tp_richcompare */
+    { Py_tp_hash, void_cast( PyObject_HashNotImplemented ) },       /* tp_hash */
+    { Py_tp_methods, void_cast( SortedMapView_methods ) },          /* tp_methods */
+    { Py_sq_length, void_cast( SortedMapView_length ) },            /* sq_length */
+    { Py_sq_contains, void_cast( SortedMapView_contains ) },        /* sq_contains */
+    { Py_mp_length, void_cast( SortedMapView_length ) },            /* mp_length */
+    { Py_mp_subscript, void_cast( SortedMapView_subscript ) },      /* mp_subscript */
+    { 0, 0 },
+};
+
+
+PyTypeObject* SortedMapView::TypeObjects[ 3 ] = { NULL, NULL, NULL };
+
+
+PyType_Spec SortedMapView::KeysType_Spec = {
+	PACKAGE_TYPENAME( "sortedmap.sortedmap_keys" ),  /* tp_name */
+	sizeof( SortedMapView ),                         /* tp_basicsize */
+	0,                                               /* tp_itemsize */
+	Py_TPFLAGS_DEFAULT|
+    Py_TPFLAGS_HAVE_GC,                              /* tp_flags */
+    SortedMapView_Type_slots                         /* slots */
+};
+
+
+PyType_Spec SortedMapView::ValuesType_Spec = {
+	PACKAGE_TYPENAME( "sortedmap.sortedmap_values" ),  /* tp_name */
+	sizeof( SortedMapView ),                           /* tp_basicsize */
+	0,                                                 /* tp_itemsize */
+	Py_TPFLAGS_DEFAULT|
+    Py_TPFLAGS_HAVE_GC,                                /* tp_flags */
+    SortedMapView_Type_slots                           /* slots */
+};
+
+
+PyType_Spec SortedMapView::ItemsType_Spec = {
+	PACKAGE_TYPENAME( "sortedmap.sortedmap_items" ),  /* tp_name */
+	sizeof( SortedMapView ),                          /* tp_basicsize */
+	0,                                                /* tp_itemsize */
+	Py_TPFLAGS_DEFAULT|
+    Py_TPFLAGS_HAVE_GC,                               /* tp_flags */
+    SortedMapView_Type_slots                          /* slots */
+};
+
+
+// Append the item of a key and a value ordered by the key function of map and
+// join its kind to kind. Returns false if the key function raised.
+bool
+append_item( SortedMap* map, PyObject* key, PyObject* value, std::vector<MapItem>& items, KeyKind::Kind& kind )
+{
+    KeyProbe probe;
+    if( !probe.init( key, map->m_keyfunc ) )
+        return false;
+    items.push_back( MapItem( key, value, probe.sort_key() ) );
+    kind = KeyKind::join( kind, probe.kind() );
+    return true;
+}
 
-    int delitem( PyObject* key )
+
+// Append the items of a sortedmap, a dict or an iterable of pairs, ordered by
+// the key function of map, and join their kind to kind.
+bool
+collect_items( SortedMap* map, PyObject* source, std::vector<MapItem>& items, KeyKind::Kind& kind )
+{
+    if( PyObject_TypeCheck( source, SortedMap::TypeObject ) )
     {
-        Items::iterator it = std::lower_bound(
-            m_items->begin(), m_items->end(), key, MapItem::CmpLess()
-        );
-        if( it == m_items->end() )
+        SortedMap* other = reinterpret_cast<SortedMap*>( source );
+        std::vector<MapItem> copies;
+        std::vector<MapItem>& target = other->m_keyfunc == map->m_keyfunc ? items : copies;
+        target.reserve( target.size() + other->m_items->size() );
+        auto copy = [&]( std::vector<MapItem>& leaf_items ) -> bool
         {
-            lookup_fail( key );
-            return -1;
+            target.insert( target.end(), leaf_items.begin(), leaf_items.end() );
+            return true;
+        };
+        other->m_items->each_leaf( copy );
+        if( other->m_keyfunc == map->m_keyfunc )
+        {
+            if( other->m_items->size() > 0 )
+                kind = KeyKind::join( kind, other->m_kind );
+            return true;
         }
-        if( MapItem::CmpEq()( *it, key ) )
+        // Items ordered by another key function are copied first since the
+        // key function may modify the other map.
+        for( MapItem& item : copies )
         {
-            m_items->erase( it );
-            return 0;
+            if( !append_item( map, item.key(), item.value(), items, kind ) )
+                return false;
         }
-        lookup_fail( key );
-        return -1;
+        return true;
     }
-
-    bool contains( PyObject* key )
+    if( PyDict_Check( source ) && !map->m_keyfunc )
     {
-        Items::iterator it = std::lower_bound(
-            m_items->begin(), m_items->end(), key, MapItem::CmpLess()
-        );
-        if( it == m_items->end() )
-            return false;
-        return MapItem::CmpEq()( *it, key );
+        items.reserve( items.size() + PyDict_Size( source ) );
+        Py_ssize_t pos = 0;
+        PyObject* key;
+        PyObject* value;
+        while( PyDict_Next( source, &pos, &key, &value ) )
+            append_item( map, key, value, items, kind );
+        return true;
     }
-
-    PyObject* pop( PyObject* key, PyObject* default_value=0 )
+    cppy::ptr pairs( PyDict_Check( source ) ? PyDict_Items( source ) : cppy::incref( source ) );
+    if( !pairs )
+        return false;  // LCOV_EXCL_LINE
+    cppy::ptr seq( PyObject_GetIter( pairs.get() ) );
+    if( !seq )
+        return false;
+    cppy::ptr item;
+    while( ( item = PyIter_Next( seq.get() ) ) )
     {
-        Items::iterator it = std::lower_bound(
-            m_items->begin(), m_items->end(), key, MapItem::CmpLess()
-        );
-        if( it == m_items->end() )
-        {
-            if( default_value )
-                return cppy::incref( default_value );
-            return lookup_fail( key );
-        }
-        if( MapItem::CmpEq()( *it, key ) )
+        if( PySequence_Length( item.get() ) != 2 )
         {
-            PyObject* res = cppy::incref( it->value() );
-            m_items->erase( it );
-            return res;
+            PyErr_Clear();
+            cppy::type_error( item.get(), "pairs of objects" );
+            return false;
         }
-        if( default_value )
-            return cppy::incref( default_value );
-        return lookup_fail( key );
+        cppy::ptr key( PySequence_GetItem( item.get(), 0 ) );
+        cppy::ptr value( PySequence_GetItem( item.get(), 1 ) );
+        if( !key || !value )
+            return false;
+        if( !append_item( map, key.get(), value.get(), items, kind ) )
+            return false;
     }
+    return !PyErr_Occurred();
+}
 
-    PyObject* keys()
-    {
-        PyObject* pylist = PyList_New( m_items->size() );
-        if( !pylist )
-            return 0;
-        Py_ssize_t listidx = 0;
-        Items::iterator it;
-        Items::iterator end_it = m_items->end();
-        for( it = m_items->begin(); it != end_it; ++it )
-        {
-            PyList_SET_ITEM( pylist, listidx, cppy::incref( it->key() ) );
-            ++listidx;
-        }
-        return pylist;
-    }
 
-    PyObject* values()
+// Sort items by key unless they are already sorted and keep a single item
+// per key, holding the first key object and the last value like a dict.
+void
+sort_unique( std::vector<MapItem>& items, const KeyOrder& order )
+{
+    size_t count = items.size();
+    size_t i = 1;
+    while( i < count && order( items[ i - 1 ], items[ i ] ) )
+        ++i;
+    if( i >= count )
+        return;
+    std::stable_sort( items.begin(), items.end(), order );
+    size_t last = 0;
+    for( i = 1; i < count; ++i )
     {
-        PyObject* pylist = PyList_New( m_items->size() );
-        if( !pylist )
-            return 0;
-        Py_ssize_t listidx = 0;
-        Items::iterator it;
-        Items::iterator end_it = m_items->end();
-        for( it = m_items->begin(); it != end_it; ++it )
+        if( !order( items[ last ], items[ i ] ) )
         {
-            PyList_SET_ITEM( pylist, listidx, cppy::incref( it->value() ) );
-            ++listidx;
+            cppy::ptr old( items[ last ].update( items[ i ].value() ) );
         }
-        return pylist;
+        else if( ++last != i )
+            items[ last ] = std::move( items[ i ] );
     }
+    items.resize( last + 1 );
+}
+
 
-    PyObject* items()
+// Merge the items of a tree with sorted unique items, the values of the
+// latter winning for equal keys. A snapshot of the tree is walked since the
+// comparisons may run code modifying it.
+void
+merge_sorted( MapTree* tree, std::vector<MapItem>& items, std::vector<MapItem>& merged, const KeyOrder& order )
+{
+    MapTree snapshot;
+    snapshot.share( *tree );
+    merged.reserve( snapshot.size() + items.size() );
+    std::vector<MapItem>::iterator it = items.begin();
+    auto merge = [&]( std::vector<MapItem>& leaf_items ) -> bool
     {
-        PyObject* pylist = PyList_New( m_items->size() );
-        if( !pylist )
-            return 0;
-        Py_ssize_t listidx = 0;
-        Items::iterator it;
-        Items::iterator end_it = m_items->end();
-        for( it = m_items->begin(); it != end_it; ++it )
+        for( MapItem& item : leaf_items )
         {
-            PyObject* pytuple = PyTuple_New( 2 );
-            if( !pytuple )
-                return 0;
-            PyTuple_SET_ITEM( pytuple, 0, cppy::incref( it->key() ) );
-            PyTuple_SET_ITEM( pytuple, 1, cppy::incref( it->value() ) );
-            PyList_SET_ITEM( pylist, listidx, pytuple );
-            ++listidx;
+            while( it != items.end() && order( *it, item ) )
+                merged.push_back( std::move( *it++ ) );
+            if( it != items.end() && !order( item, *it ) )
+            {
+                merged.push_back( item );
+                cppy::ptr old( merged.back().update( it->value() ) );
+                ++it;
+            }
+            else
+                merged.push_back( item );
         }
-        return pylist;
-    }
+        return true;
+    };
+    snapshot.each_leaf( merge );
+    merged.insert( merged.end(), std::make_move_iterator( it ), std::make_move_iterator( items.end() ) );
+}
 
-    static PyObject* lookup_fail( PyObject* key )
-    {
-        cppy::ptr pystr( PyObject_Str( key ) );
-        if( !pystr )
-            return 0;
-        cppy::ptr pytuple( PyTuple_Pack( 1, key ) );
-        if (!pytuple)
-            return 0;
-        PyErr_SetObject(PyExc_KeyError, pytuple.get());
-        return 0;
+
+// Allocate an empty map of a type ordering its keys by keyfunc.
+PyObject*
+new_map( PyTypeObject* type, PyObject* keyfunc )
+{
+    PyObject* self = type->tp_alloc( type, 0 );
+    if( !self ) {
+        return 0;  // LCOV_EXCL_LINE (allocation failed, very unlikely)
     }
-};
+    SortedMap* cself = reinterpret_cast<SortedMap*>( self );
+    cself->m_items = new SortedMap::Items();
+    cself->m_keyfunc = cppy::xincref( keyfunc );
+    cself->m_kind = KeyKind::Empty;
+    return self;
+}
 
 
 PyObject*
 SortedMap_new( PyTypeObject* type, PyObject* args, PyObject* kwargs )
 {
     PyObject* map = 0;
-    static char* kwlist[] = { "map", 0 };
-    if( !PyArg_ParseTupleAndKeywords( args, kwargs, "|O:__new__", kwlist, &map ) )
+    PyObject* keyfunc = Py_None;
+    static char* kwlist[] = { "map", "key", 0 };
+    if( !PyArg_ParseTupleAndKeywords( args, kwargs, "|O$O:__new__", kwlist, &map, &keyfunc ) )
         return 0;
+    if( keyfunc != Py_None && !PyCallable_Check( keyfunc ) )
+        return cppy::type_error( keyfunc, "callable or None" );
 
-    PyObject* self = PyType_GenericNew( type, 0, 0 );
+    cppy::ptr self( new_map( type, keyfunc != Py_None ? keyfunc : 0 ) );
     if( !self ) {
         return 0;  // LCOV_EXCL_LINE (allocation failed, very unlikely)
     }
-    SortedMap* cself = reinterpret_cast<SortedMap*>( self );
-    cself->m_items = new SortedMap::Items();
+    SortedMap* cself = reinterpret_cast<SortedMap*>( self.get() );
 
-    cppy::ptr seq;
+    // Sorting the input once and loading the leaves in order is much faster
+    // than inserting the items one by one.
     if( map )
     {
-        if( PyDict_Check( map ) )
-        {
-            seq = PyObject_GetIter( PyDict_Items( map ) );
-            if( !seq ) {
-                return 0;  // LCOV_EXCL_LINE (dict items failed, very unlikely)
-            }
-        }
-        else
-        {
-            seq = PyObject_GetIter( map );
-            if( !seq )
-                return 0;
-        }
-    }
-
-    if( seq )
-    {
-        cppy::ptr item;
-        while( (item = PyIter_Next( seq.get() )) )
-        {
-            if( PySequence_Length( item.get() ) != 2)
-                return cppy::type_error( item.get(), "pairs of objects" );
-
-            cself->setitem( PySequence_GetItem( item.get(), 0 ),
-                            PySequence_GetItem( item.get(), 1 ) );
-        }
+        std::vector<MapItem> items;
+        KeyKind::Kind kind = KeyKind::Empty;
+        if( !collect_items( cself, map, items, kind ) )
+            return 0;
+        sort_unique( items, KeyOrder( kind ) );
+        cself->m_items->load_sorted( items );
+        cself->m_kind = kind;
     }
 
-    return self;
+    return self.release();
 }
 
-// Clearing the vector may cause arbitrary side effects on item
-// decref, including calls into methods which mutate the vector.
-// To avoid segfaults, first make the vector empty, then let the
+
+// Clearing the tree may cause arbitrary side effects on item
+// decref, including calls into methods which mutate the tree.
+// To avoid segfaults, first make the tree empty, then let the
 // destructors run for the old items.
 int
 SortedMap_clear( SortedMap* self )
 {
     SortedMap::Items empty;
     self->m_items->swap( empty );
+    ++self->m_version;
+    Py_CLEAR( self->m_keyfunc );
     return 0;
 }
 
@@ -346,13 +882,14 @@ SortedMap_clear( SortedMap* self )
 int
 SortedMap_traverse( SortedMap* self, visitproc visit, void* arg )
 {
-    SortedMap::Items::iterator it;
-    SortedMap::Items::iterator end_it = self->m_items->end();
-    for( it = self->m_items->begin(); it != end_it; ++it )
+    auto visitor = [&]( PyObject* ob ) -> int
     {
-        Py_VISIT( it->key() );
-        Py_VISIT( it->value() );
-    }
+        Py_VISIT( ob );
+        return 0;
+    };
+    if( int res = self->m_items->visit( visitor ) )
+        return res;
+    Py_VISIT( self->m_keyfunc );
 #if PY_VERSION_HEX >= 0x03090000
     // This was not needed before Python 3.9 (Python issue 35810 and 40217)
     Py_VISIT(Py_TYPE(self));
@@ -368,7 +905,9 @@ SortedMap_dealloc( SortedMap* self )
     SortedMap_clear( self );
     delete self->m_items;
     self->m_items = 0;
-    Py_TYPE(self)->tp_free( reinterpret_cast<PyObject*>( self ) );
+    PyTypeObject* type = Py_TYPE( self );
+    type->tp_free( reinterpret_cast<PyObject*>( self ) );
+    Py_DECREF( type );
 }
 
 
@@ -389,6 +928,13 @@ SortedMap_subscript( SortedMap* self, PyObject* key )
 int
 SortedMap_ass_subscript( SortedMap* self, PyObject* key, PyObject* value )
 {
+    if( PySlice_Check( key ) )
+    {
+        if( !value )
+            return self->delslice( key );
+        cppy::type_error( "sortedmap slices only support deletion" );
+        return -1;
+    }
     if( !value )
         return self->delitem( key );
     return self->setitem( key, value );
@@ -424,7 +970,7 @@ SortedMap_pop( SortedMap* self, PyObject*const *args, Py_ssize_t nargs )
     if( nargs == 1 )
         return self->pop( args[0] );
     if( nargs == 2 )
-        return self->getitem( args[0], args[1] );
+        return self->pop( args[0], args[1] );
     std::ostringstream ostr;
     if( nargs > 2 )
         ostr << "pop() expected at most 2 arguments, got " << nargs;
@@ -437,12 +983,13 @@ SortedMap_pop( SortedMap* self, PyObject*const *args, Py_ssize_t nargs )
 PyObject*
 SortedMap_clearmethod( SortedMap* self )
 {
-    // Clearing the vector may cause arbitrary side effects on item
-    // decref, including calls into methods which mutate the vector.
-    // To avoid segfaults, first make the vector empty, then let the
+    // Clearing the tree may cause arbitrary side effects on item
+    // decref, including calls into methods which mutate the tree.
+    // To avoid segfaults, first make the tree empty, then let the
     // destructors run for the old items.
     SortedMap::Items empty;
     self->m_items->swap( empty );
+    ++self->m_version;
     Py_RETURN_NONE;
 }
 
@@ -450,68 +997,317 @@ SortedMap_clearmethod( SortedMap* self )
 PyObject*
 SortedMap_keys( SortedMap* self )
 {
-    return self->keys();
+    return SortedMapView::New( self, ViewKind::Keys );
 }
 
 
 PyObject*
 SortedMap_values( SortedMap* self )
 {
-    return self->values();
+    return SortedMapView::New( self, ViewKind::Values );
 }
 
 
 PyObject*
 SortedMap_items( SortedMap* self )
 {
-    return self->items();
+    return SortedMapView::New( self, ViewKind::Items );
 }
 
 
 PyObject*
 SortedMap_iter( SortedMap* self )
 {
-    cppy::ptr keys( self->keys() );
-    if( !keys )
-        return 0;
-    return PyObject_GetIter( keys.get() );
+    return SortedMapIterator::New( self, 0, self->m_items->size(), false );
+}
+
+
+PyObject*
+SortedMap_reversed( SortedMap* self )
+{
+    return SortedMapIterator::New( self, 0, self->m_items->size(), true );
 }
 
 
 
+// Like the copies of a dict subclass, the copies of a subclass are plain maps.
 PyObject*
 SortedMap_copy( SortedMap* self )
 {
-    PyTypeObject* type = pytype_cast( Py_TYPE(self) );
+    PyTypeObject* type = SortedMap::TypeObject;
     PyObject* copy = type->tp_alloc( type, 0 );
     if( !copy )
         return 0;
     SortedMap* ccopy = reinterpret_cast<SortedMap*>( copy );
-    ccopy->m_items = new SortedMap::Items();
-    *ccopy->m_items = *self->m_items;
+    ccopy->m_items = new SortedMap::Items( *self->m_items );
+    ccopy->m_keyfunc = cppy::xincref( self->m_keyfunc );
+    ccopy->m_kind = self->m_kind;
     return copy;
 }
 
 
+// Return a copy sharing the nodes of the map, which are copied by the first
+// mutation of either map touching them.
+PyObject*
+SortedMap_snapshot( SortedMap* self )
+{
+    PyObject* res = new_map( SortedMap::TypeObject, self->m_keyfunc );
+    if( !res )
+        return 0;  // LCOV_EXCL_LINE
+    SortedMap* map = reinterpret_cast<SortedMap*>( res );
+    map->m_items->share( *self->m_items );
+    map->m_kind = self->m_kind;
+    return res;
+}
+
+
+// Add the items of a source to the map, inserting them one by one if they are
+// few compared to the map and merging them with the items of the map else.
+bool
+update_from( SortedMap* self, PyObject* source )
+{
+    // An empty map shares the nodes of a map ordered in the same way.
+    if( self->m_items->size() == 0 && PyObject_TypeCheck( source, SortedMap::TypeObject ) &&
+        reinterpret_cast<SortedMap*>( source )->m_keyfunc == self->m_keyfunc )
+    {
+        SortedMap* other = reinterpret_cast<SortedMap*>( source );
+        if( other->m_items->size() == 0 || other == self )
+            return true;
+        self->m_items->share( *other->m_items );
+        self->m_kind = other->m_kind;
+        ++self->m_version;
+        return true;
+    }
+    std::vector<MapItem> items;
+    KeyKind::Kind kind = KeyKind::Empty;
+    if( !collect_items( self, source, items, kind ) )
+        return false;
+    if( items.empty() )
+        return true;
+    sort_unique( items, KeyOrder( kind ) );
+    MapTree* tree = self->m_items;
+    if( items.size() * 16 < tree->size() )
+    {
+        for( MapItem& item : items )
+        {
+            cppy::ptr old;
+            self->insert( item, kind, old );
+        }
+        return true;
+    }
+    KeyKind::Kind joined = tree->size() == 0 ? kind : KeyKind::join( self->m_kind, kind );
+    std::vector<MapItem> merged;
+    merge_sorted( tree, items, merged, KeyOrder( joined ) );
+    if( merged.size() != tree->size() )
+        ++self->m_version;
+    // The old items are released once the new tree is in place.
+    MapTree old;
+    old.swap( *tree );
+    tree->load_sorted( merged );
+    self->m_kind = joined;
+    return true;
+}
+
+
+PyObject*
+SortedMap_update( SortedMap* self, PyObject* args, PyObject* kwargs )
+{
+    PyObject* other = 0;
+    if( !PyArg_ParseTuple( args, "|O:update", &other ) )
+        return 0;
+    if( other && !update_from( self, other ) )
+        return 0;
+    if( kwargs && !update_from( self, kwargs ) )
+        return 0;
+    Py_RETURN_NONE;
+}
+
+
+PyObject*
+SortedMap_merge( SortedMap* self, PyObject* other )
+{
+    std::vector<MapItem> items;
+    KeyKind::Kind kind = KeyKind::Empty;
+    if( !collect_items( self, other, items, kind ) )
+        return 0;
+    sort_unique( items, KeyOrder( kind ) );
+    KeyKind::Kind joined = self->m_items->size() == 0 ? kind : KeyKind::join( self->m_kind, kind );
+    std::vector<MapItem> merged;
+    merge_sorted( self->m_items, items, merged, KeyOrder( joined ) );
+    cppy::ptr res( new_map( SortedMap::TypeObject, self->m_keyfunc ) );
+    if( !res )
+        return 0;  // LCOV_EXCL_LINE
+    SortedMap* map = reinterpret_cast<SortedMap*>( res.get() );
+    map->m_items->load_sorted( merged );
+    map->m_kind = joined;
+    return res.release();
+}
+
+
+// Walk two arrays of sorted unique items in step, calling visit with the
+// items of both arrays stored under the same key, null standing for a key
+// missing from one of the arrays. Stops and returns false if visit does.
+template<typename Visitor>
+bool
+merge_walk( std::vector<MapItem>& first, std::vector<MapItem>& second, const KeyOrder& order, Visitor visit )
+{
+    std::vector<MapItem>::iterator it = first.begin();
+    std::vector<MapItem>::iterator other = second.begin();
+    while( it != first.end() || other != second.end() )
+    {
+        bool ok;
+        if( other == second.end() || ( it != first.end() && order( *it, *other ) ) )
+            ok = visit( &*it++, static_cast<MapItem*>( 0 ) );
+        else if( it == first.end() || order( *other, *it ) )
+            ok = visit( static_cast<MapItem*>( 0 ), &*other++ );
+        else
+            ok = visit( &*it++, &*other++ );
+        if( !ok )
+            return false;
+    }
+    return true;
+}
+
+
+// Copy the items of a map and those of another mapping, ordered by the key
+// function of the map, so that walking them cannot be disturbed by code run
+// by the comparisons. Returns the comparisons to use for both arrays.
+bool
+snapshot_pair( SortedMap* self, PyObject* other, std::vector<MapItem>& mine, std::vector<MapItem>& theirs, KeyKind::Kind& kind )
+{
+    KeyKind::Kind my_kind = KeyKind::Empty;
+    KeyKind::Kind their_kind = KeyKind::Empty;
+    if( !collect_items( self, pyobject_cast( self ), mine, my_kind ) )
+        return false;  // LCOV_EXCL_LINE
+    if( !collect_items( self, other, theirs, their_kind ) )
+        return false;
+    sort_unique( theirs, KeyOrder( their_kind ) );
+    kind = KeyKind::join( my_kind, their_kind );
+    return true;
+}
+
+
+// Build a map ordered like self from sorted unique items.
+PyObject*
+map_from_sorted( SortedMap* self, std::vector<MapItem>& items, KeyKind::Kind kind )
+{
+    PyObject* res = new_map( SortedMap::TypeObject, self->m_keyfunc );
+    if( !res )
+        return 0;  // LCOV_EXCL_LINE
+    SortedMap* map = reinterpret_cast<SortedMap*>( res );
+    map->m_items->load_sorted( items );
+    map->m_kind = items.empty() ? KeyKind::Empty : kind;
+    return res;
+}
+
+
+PyObject*
+SortedMap_intersection( SortedMap* self, PyObject* other )
+{
+    std::vector<MapItem> mine;
+    std::vector<MapItem> theirs;
+    KeyKind::Kind kind;
+    if( !snapshot_pair( self, other, mine, theirs, kind ) )
+        return 0;
+    std::vector<MapItem> common;
+    merge_walk( mine, theirs, KeyOrder( kind ), [&]( MapItem* item, MapItem* their ) {
+        if( item && their )
+            common.push_back( std::move( *item ) );
+        return true;
+    } );
+    return map_from_sorted( self, common, kind );
+}
+
+
+PyObject*
+SortedMap_difference( SortedMap* self, PyObject* other )
+{
+    std::vector<MapItem> mine;
+    std::vector<MapItem> theirs;
+    KeyKind::Kind kind;
+    if( !snapshot_pair( self, other, mine, theirs, kind ) )
+        return 0;
+    std::vector<MapItem> remaining;
+    merge_walk( mine, theirs, KeyOrder( kind ), [&]( MapItem* item, MapItem* their ) {
+        if( item && !their )
+            remaining.push_back( std::move( *item ) );
+        return true;
+    } );
+    return map_from_sorted( self, remaining, kind );
+}
+
+
+// Return the maps of the added, removed and changed items from self to other,
+// the changed keys being mapped to (old value, new value) pairs.
+PyObject*
+SortedMap_diff( SortedMap* self, PyObject* other )
+{
+    std::vector<MapItem> mine;
+    std::vector<MapItem> theirs;
+    KeyKind::Kind kind;
+    if( !snapshot_pair( self, other, mine, theirs, kind ) )
+        return 0;
+    std::vector<MapItem> added;
+    std::vector<MapItem> removed;
+    std::vector<MapItem> changed;
+    bool ok = merge_walk( mine, theirs, KeyOrder( kind ), [&]( MapItem* item, MapItem* their ) {
+        if( !item )
+            added.push_back( std::move( *their ) );
+        else if( !their )
+            removed.push_back( std::move( *item ) );
+        else
+        {
+            int equal = PyObject_RichCompareBool( item->value(), their->value(), Py_EQ );
+            if( equal < 0 )
+                return false;
+            if( !equal )
+            {
+                cppy::ptr pair( PyTuple_Pack( 2, item->value(), their->value() ) );
+                if( !pair )
+                    return false;  // LCOV_EXCL_LINE
+                changed.push_back( std::move( *item ) );
+                cppy::ptr old( changed.back().update( pair.get() ) );
+            }
+        }
+        return true;
+    } );
+    if( !ok )
+        return 0;
+    cppy::ptr pyadded( map_from_sorted( self, added, kind ) );
+    cppy::ptr pyremoved( map_from_sorted( self, removed, kind ) );
+    cppy::ptr pychanged( map_from_sorted( self, changed, kind ) );
+    if( !pyadded || !pyremoved || !pychanged )
+        return 0;  // LCOV_EXCL_LINE
+    return PyTuple_Pack( 3, pyadded.get(), pyremoved.get(), pychanged.get() );
+}
+
+
 PyObject*
 SortedMap_repr( SortedMap* self )
 {
     std::ostringstream ostr;
     ostr << "sortedmap([";
-    SortedMap::Items::iterator it;
-    SortedMap::Items::iterator end_it = self->m_items->end();
-    for( it = self->m_items->begin(); it != end_it; ++it )
+    // The reprs may run code modifying the map.
+    MapTree snapshot;
+    snapshot.share( *self->m_items );
+    auto write = [&]( std::vector<MapItem>& items ) -> bool
     {
-        cppy::ptr keystr( PyObject_Repr( it->key() ) );
-        if( !keystr )
-            return 0;
-        cppy::ptr valstr( PyObject_Repr( it->value() ) );
-        if( !valstr )
-            return 0;
-        ostr << "(" << PyUnicode_AsUTF8( keystr.get() ) << ", ";
-        ostr << PyUnicode_AsUTF8( valstr.get() ) << "), ";
-    }
-    if( self->m_items->size() > 0 )
+        for( MapItem& item : items )
+        {
+            cppy::ptr keystr( PyObject_Repr( item.key() ) );
+            if( !keystr )
+                return false;
+            cppy::ptr valstr( PyObject_Repr( item.value() ) );
+            if( !valstr )
+                return false;
+            ostr << "(" << PyUnicode_AsUTF8( keystr.get() ) << ", ";
+            ostr << PyUnicode_AsUTF8( valstr.get() ) << "), ";
+        }
+        return true;
+    };
+    if( !snapshot.each_leaf( write ) )
+        return 0;
+    if( snapshot.size() > 0 )
         ostr.seekp( -2, std::ios_base::cur );
     ostr << "])";
     return PyUnicode_FromString( ostr.str().c_str() );
@@ -521,11 +1317,129 @@ SortedMap_repr( SortedMap* self )
 PyObject*
 SortedMap_contains_bool( SortedMap* self, PyObject* key )
 {
-    if( self->contains( key ) )
+    int res = self->contains( key );
+    if( res < 0 )
+        return 0;
+    return cppy::incref( res ? Py_True : Py_False );
+}
+
+
+PyObject*
+SortedMap_bisect_left( SortedMap* self, PyObject* key )
+{
+    size_t rank;
+    if( !self->bisect( key, false, rank ) )
+        return 0;
+    return PyLong_FromSize_t( rank );
+}
+
+
+PyObject*
+SortedMap_bisect_right( SortedMap* self, PyObject* key )
+{
+    size_t rank;
+    if( !self->bisect( key, true, rank ) )
+        return 0;
+    return PyLong_FromSize_t( rank );
+}
+
+
+// Return the key of the given rank, or the default (which raises a KeyError
+// on the requested key when missing) if the rank is out of the map.
+PyObject*
+key_or_default( SortedMap* self, size_t rank, bool valid, PyObject*const *args, Py_ssize_t nargs, const char* name )
+{
+    if( nargs < 1 || nargs > 2 )
+    {
+        std::ostringstream ostr;
+        ostr << name << "() expected 1 or 2 arguments, got " << nargs;
+        return cppy::type_error( ostr.str().c_str() );
+    }
+    if( valid )
+        return cppy::incref( self->m_items->at( rank ).item().key() );
+    if( nargs == 2 )
+        return cppy::incref( args[1] );
+    return SortedMap::lookup_fail( args[0] );
+}
+
+
+PyObject*
+SortedMap_floor_key( SortedMap* self, PyObject*const *args, Py_ssize_t nargs )
+{
+    size_t rank = 0;
+    if( nargs >= 1 && !self->bisect( args[0], true, rank ) )
+        return 0;
+    return key_or_default( self, rank - 1, rank > 0, args, nargs, "floor_key" );
+}
+
+
+PyObject*
+SortedMap_ceiling_key( SortedMap* self, PyObject*const *args, Py_ssize_t nargs )
+{
+    size_t rank = 0;
+    if( nargs >= 1 && !self->bisect( args[0], false, rank ) )
+        return 0;
+    return key_or_default( self, rank, rank < self->m_items->size(), args, nargs, "ceiling_key" );
+}
+
+
+PyObject*
+SortedMap_peekitem( SortedMap* self, PyObject*const *args, Py_ssize_t nargs )
+{
+    if( nargs > 1 )
     {
-        Py_RETURN_TRUE;
+        std::ostringstream ostr;
+        ostr << "peekitem() expected at most 1 argument, got " << nargs;
+        return cppy::type_error( ostr.str().c_str() );
     }
-    Py_RETURN_FALSE;
+    size_t rank;
+    cppy::ptr last( PyLong_FromLong( -1 ) );
+    if( !rank_from_index( self, nargs == 1 ? args[0] : last.get(), rank ) )
+        return 0;
+    MapItem& item = self->m_items->at( rank ).item();
+    return PyTuple_Pack( 2, item.key(), item.value() );
+}
+
+
+PyObject*
+SortedMap_index( SortedMap* self, PyObject* key )
+{
+    KeyProbe probe;
+    if( !probe.init( key, self->m_keyfunc ) )
+        return 0;
+    KeyOrder order = self->order_for( probe );
+    size_t rank = self->m_items->bisect( probe.sort_key(), false, order );
+    if( rank < self->m_items->size() &&
+        order.equal( self->m_items->at( rank ).item().sort_key(), probe.sort_key() ) )
+        return PyLong_FromSize_t( rank );
+    cppy::ptr repr( PyObject_Repr( key ) );
+    if( !repr )
+        return 0;
+    PyErr_Format( PyExc_ValueError, "%U is not in sortedmap", repr.get() );
+    return 0;
+}
+
+
+PyObject*
+SortedMap_irange( SortedMap* self, PyObject* args, PyObject* kwargs )
+{
+    PyObject* minimum = Py_None;
+    PyObject* maximum = Py_None;
+    int include_min = 1;
+    int include_max = 1;
+    int reverse = 0;
+    static char* kwlist[] = { "minimum", "maximum", "inclusive", "reverse", 0 };
+    if( !PyArg_ParseTupleAndKeywords(
+            args, kwargs, "|OO(pp)p:irange", kwlist,
+            &minimum, &maximum, &include_min, &include_max, &reverse ) )
+        return 0;
+    size_t start = 0;
+    size_t stop = self->m_items->size();
+    if( minimum != Py_None && !self->bisect( minimum, !include_min, start ) )
+        return 0;
+    if( maximum != Py_None && !self->bisect( maximum, include_max, stop ) )
+        return 0;
+    return SortedMapIterator::New( self, start, stop, reverse );
 }
 
 
@@ -533,8 +1447,7 @@ PyObject*
 SortedMap_sizeof( SortedMap* self, PyObject* args )
 {
     Py_ssize_t size = Py_TYPE(self)->tp_basicsize;
-    size += sizeof( SortedMap::Items );
-    size += sizeof( MapItem ) * self->m_items->capacity();
+    size += self->m_items->memory();
     return PyLong_FromSsize_t( size );
 }
 
@@ -555,6 +1468,36 @@ SortedMap_methods[] = {
       "" },
     { "copy", ( PyCFunction )SortedMap_copy, METH_NOARGS,
       "" },
+    { "snapshot", ( PyCFunction )SortedMap_snapshot, METH_NOARGS,
+      "Return a copy of the map sharing its storage until either map is modified." },
+    { "update", ( PyCFunction )SortedMap_update, METH_VARARGS | METH_KEYWORDS,
+      "Add the items of a mapping or an iterable of pairs and of the keywords." },
+    { "merge", ( PyCFunction )SortedMap_merge, METH_O,
+      "Return a new map holding the items of the map and of another mapping." },
+    { "union", ( PyCFunction )SortedMap_merge, METH_O,
+      "Return a new map holding the keys of both maps, other's values winning." },
+    { "intersection", ( PyCFunction )SortedMap_intersection, METH_O,
+      "Return a new map holding the items whose keys are also in other." },
+    { "difference", ( PyCFunction )SortedMap_difference, METH_O,
+      "Return a new map holding the items whose keys are not in other." },
+    { "diff", ( PyCFunction )SortedMap_diff, METH_O,
+      "Return the (added, removed, changed) maps turning the map into other." },
+    { "__reversed__", ( PyCFunction )SortedMap_reversed, METH_NOARGS,
+      "" },
+    { "bisect_left", ( PyCFunction )SortedMap_bisect_left, METH_O,
+      "Return the index at which key would be inserted before equal keys." },
+    { "bisect_right", ( PyCFunction )SortedMap_bisect_right, METH_O,
+      "Return the index at which key would be inserted after equal keys." },
+    { "floor_key", ( PyCFunction )SortedMap_floor_key, METH_FASTCALL,
+      "Return the largest key less than or equal to key." },
+    { "ceiling_key", ( PyCFunction )SortedMap_ceiling_key, METH_FASTCALL,
+      "Return the smallest key greater than or equal to key." },
+    { "peekitem", ( PyCFunction )SortedMap_peekitem, METH_FASTCALL,
+      "Return the (key, value) pair at the given index, the last by default." },
+    { "index", ( PyCFunction )SortedMap_index, METH_O,
+      "Return the index of key in the map." },
+    { "irange", ( PyCFunction )SortedMap_irange, METH_VARARGS | METH_KEYWORDS,
+      "Iterate over the keys between minimum and maximum." },
     { "__contains__", ( PyCFunction )SortedMap_contains_bool, METH_O | METH_COEXIST,
       "" },
     { "__getitem__", ( PyCFunction )SortedMap_subscript, METH_O | METH_COEXIST,
@@ -565,11 +1508,27 @@ SortedMap_methods[] = {
 };
 
 
+PyObject*
+SortedMap_get_key( SortedMap* self, void* context )
+{
+    return cppy::incref( self->m_keyfunc ? self->m_keyfunc : Py_None );
+}
+
+
+static PyGetSetDef
+SortedMap_getset[] = {
+    { "key", ( getter )SortedMap_get_key, 0,
+      "The function computing the object ordering each key, or None." },
+    { 0 } // sentinel
+};
+
+
 static PyType_Slot SortedMap_Type_slots[] = {
     { Py_tp_dealloc, void_cast( SortedMap_dealloc ) },              /* tp_dealloc */
     { Py_tp_traverse, void_cast( SortedMap_traverse ) },            /* tp_traverse */
     { Py_tp_clear, void_cast( SortedMap_clear ) },                  /* tp_clear */
     { Py_tp_methods, void_cast( SortedMap_methods ) },              /* tp_methods */
+    { Py_tp_getset, void_cast( SortedMap_getset ) },                /* tp_getset */
     { Py_tp_repr, void_cast( SortedMap_repr ) },                    /* tp_repr */
     { Py_tp_new, void_cast( SortedMap_new ) },                      /* tp_new */
     { Py_tp_iter, void_cast( SortedMap_iter ) },                    /* tp_iter */
@@ -591,6 +1550,7 @@ PyType_Spec SortedMap::TypeObject_Spec = {
 	sizeof( SortedMap ),                         /* tp_basicsize */
 	0,                                           /* tp_itemsize */
 	Py_TPFLAGS_DEFAULT|
+    Py_TPFLAGS_BASETYPE|
     Py_TPFLAGS_HAVE_GC,                          /* tp_flags */
     SortedMap_Type_slots                         /* slots */
 };
@@ -604,6 +1564,24 @@ bool SortedMap::Ready()
     {
         return false;  // LCOV_EXCL_LINE (failed to create type, very unlikely)
     }
+    SortedMapIterator::TypeObject = pytype_cast( PyType_FromSpec( &SortedMapIterator::TypeObject_Spec ) );
+    if( !SortedMapIterator::TypeObject )
+    {
+        return false;  // LCOV_EXCL_LINE (failed to create type, very unlikely)
+    }
+    PyType_Spec* view_specs[] = {
+        &SortedMapView::KeysType_Spec,
+        &SortedMapView::ValuesType_Spec,
+        &SortedMapView::ItemsType_Spec,
+    };
+    for( size_t i = 0; i < 3; ++i )
+    {
+        SortedMapView::TypeObjects[ i ] = pytype_cast( PyType_FromSpec( view_specs[ i ] ) );
+        if( !SortedMapView::TypeObjects[ i ] )
+        {
+            return false;  // LCOV_EXCL_LINE (failed to create type, very unlikely)
+        }
+    }
     return true;
 }
 
@@ -0,0 +1,1278 @@
+/*-----------------------------------------------------------------------------
+| Copyright (c) 2025, Nucleic Development Team.
+|
+| Distributed under the terms of the Modified BSD License.
+|
+| The full license is in the file LICENSE, distributed with this software.
+|----------------------------------------------------------------------------*/
+#include <cppy/cppy.h>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <sstream>
+#include "packagenaming.h"
+#include "sortedtree.h"
+#include "utils.h"
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wdeprecated-writable-strings"
+#endif
+
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#endif
+
+
+namespace
+{
+
+using namespace atom::sortedtree;
+
+
+// Sorted set of values, stored as the keys of the items of a MapTree whose
+// values are all None. A sortedmultiset shares the layout and the methods of
+// the sortedset but keeps the values comparing equal, in insertion order.
+struct SortedSet
+{
+    PyObject_HEAD
+    MapTree* m_items;
+    PyObject* m_keyfunc;  // null if the values are ordered by themselves
+    uint64_t m_version;  // bumped when values are added or removed
+    KeyKind::Kind m_kind;  // kind of all the values stored so far
+    bool m_multi;  // true for a sortedmultiset
+
+    static PyType_Spec TypeObject_Spec;
+
+    static PyType_Spec MultiTypeObject_Spec;
+
+    static PyTypeObject* TypeObject;
+
+    static PyTypeObject* MultiTypeObject;
+
+    static bool Ready();
+
+    static bool TypeCheck( PyObject* ob )
+    {
+        return PyObject_TypeCheck( ob, TypeObject ) || PyObject_TypeCheck( ob, MultiTypeObject );
+    }
+
+    const char* name() const
+    {
+        return m_multi ? "sortedmultiset" : "sortedset";
+    }
+
+    // The comparisons used to look a probe up. A probe of another kind than
+    // the values of the set is compared through rich comparisons.
+    KeyOrder order_for( const KeyProbe& probe ) const
+    {
+        return KeyOrder( probe.kind() == m_kind ? m_kind : KeyKind::Object );
+    }
+
+    // The first item stored under the sort key of a value. Returns false if
+    // the key function raised.
+    bool find( PyObject* value, MapItem*& item )
+    {
+        KeyProbe probe;
+        if( !probe.init( value, m_keyfunc ) )
+            return false;
+        item = m_items->find( probe.sort_key(), order_for( probe ) );
+        return true;
+    }
+
+    // The rank at which value would be inserted. Returns false if the key
+    // function raised.
+    bool bisect( PyObject* value, bool right, size_t& rank )
+    {
+        KeyProbe probe;
+        if( !probe.init( value, m_keyfunc ) )
+            return false;
+        rank = m_items->bisect( probe.sort_key(), right, order_for( probe ) );
+        return true;
+    }
+
+    // Add a value of the given kind, switching the set to rich comparisons
+    // if its values are of another kind. A sortedset keeps the value already
+    // stored under an equal sort key.
+    void insert( MapItem& item, KeyKind::Kind kind )
+    {
+        m_kind = m_items->size() == 0 ? kind : KeyKind::join( m_kind, kind );
+        KeyOrder order( m_kind );
+        if( m_multi )
+        {
+            m_items->insert_equal( item, order );
+            ++m_version;
+            return;
+        }
+        cppy::ptr old;
+        if( m_items->insert( item, order, old ) )
+            ++m_version;
+    }
+
+    int add( PyObject* value )
+    {
+        KeyProbe probe;
+        if( !probe.init( value, m_keyfunc ) )
+            return -1;
+        MapItem item( value, Py_None, probe.sort_key() );
+        insert( item, probe.kind() );
+        return 0;
+    }
+
+    // Remove one value equal to value into removed. Returns 1 if there was
+    // such a value, 0 if there was none and -1 on error.
+    int erase( PyObject* value, MapItem& removed )
+    {
+        KeyProbe probe;
+        if( !probe.init( value, m_keyfunc ) )
+            return -1;
+        if( !m_items->erase( probe.sort_key(), order_for( probe ), removed ) )
+            return 0;
+        ++m_version;
+        return 1;
+    }
+
+    int contains( PyObject* value )
+    {
+        MapItem* item;
+        if( !find( value, item ) )
+            return -1;
+        return item != 0;
+    }
+
+    static PyObject* lookup_fail( PyObject* value )
+    {
+        cppy::ptr pytuple( PyTuple_Pack( 1, value ) );
+        if( !pytuple )
+            return 0;  // LCOV_EXCL_LINE
+        PyErr_SetObject( PyExc_KeyError, pytuple.get() );
+        return 0;
+    }
+};
+
+
+// Convert an index to a rank, negative indices counting from the end.
+bool
+rank_from_index( SortedSet* self, PyObject* index, size_t& rank )
+{
+    Py_ssize_t i = PyNumber_AsSsize_t( index, PyExc_IndexError );
+    if( i == -1 && PyErr_Occurred() )
+        return false;
+    Py_ssize_t size = static_cast<Py_ssize_t>( self->m_items->size() );
+    if( i < 0 )
+        i += size;
+    if( i < 0 || i >= size )
+    {
+        PyErr_Format( PyExc_IndexError, "%s index out of range", self->name() );
+        return false;
+    }
+    rank = static_cast<size_t>( i );
+    return true;
+}
+
+
+// Iterator over a range of ranks of a set. The position in the current leaf
+// is cached until the layout of the tree changes.
+struct SortedSetIterator
+{
+    PyObject_HEAD
+    SortedSet* set;
+    MapTree::Leaf* leaf;
+    size_t index;
+    size_t rank;  // rank of the next value
+    size_t remaining;
+    uint64_t version;
+    uint64_t generation;  // generation of the tree when leaf was located
+    bool reverse;
+
+    static PyType_Spec TypeObject_Spec;
+
+    static PyTypeObject* TypeObject;
+
+    // Iterate over the values whose ranks are in [start, stop).
+    static PyObject* New( SortedSet* set, size_t start, size_t stop, bool reverse )
+    {
+        PyObject* pyiter = PyType_GenericAlloc( TypeObject, 0 );
+        if( !pyiter )
+            return 0;  // LCOV_EXCL_LINE
+        SortedSetIterator* iter = reinterpret_cast<SortedSetIterator*>( pyiter );
+        iter->set = reinterpret_cast<SortedSet*>( cppy::incref( pyobject_cast( set ) ) );
+        iter->version = set->m_version;
+        iter->reverse = reverse;
+        iter->remaining = stop > start ? stop - start : 0;
+        iter->rank = reverse ? stop - 1 : start;
+        if( iter->remaining )
+            iter->locate();
+        return pyiter;
+    }
+
+    void locate()
+    {
+        MapTree::Position position = set->m_items->at( rank );
+        leaf = position.leaf;
+        index = position.index;
+        generation = set->m_items->generation();
+    }
+};
+
+
+int
+SortedSetIterator_traverse( SortedSetIterator* self, visitproc visit, void* arg )
+{
+    Py_VISIT( pyobject_cast( self->set ) );
+    Py_VISIT( Py_TYPE( self ) );
+    return 0;
+}
+
+
+int
+SortedSetIterator_clear( SortedSetIterator* self )
+{
+    Py_CLEAR( self->set );
+    return 0;
+}
+
+
+void
+SortedSetIterator_dealloc( SortedSetIterator* self )
+{
+    PyObject_GC_UnTrack( self );
+    SortedSetIterator_clear( self );
+    PyTypeObject* type = Py_TYPE( self );
+    type->tp_free( pyobject_cast( self ) );
+    Py_DECREF( type );
+}
+
+
+PyObject*
+SortedSetIterator_next( SortedSetIterator* self )
+{
+    if( !self->set )
+        return 0;
+    if( self->set->m_version != self->version )
+    {
+        PyErr_Format( PyExc_RuntimeError, "%s changed size during iteration", self->set->name() );
+        Py_CLEAR( self->set );
+        return 0;
+    }
+    if( self->remaining == 0 )
+    {
+        Py_CLEAR( self->set );
+        return 0;
+    }
+    if( self->set->m_items->generation() != self->generation )
+        self->locate();
+    PyObject* res = cppy::incref( self->leaf->items[ self->index ].key() );
+    if( --self->remaining > 0 )
+    {
+        // Crossing to another leaf locates it from the root.
+        if( !self->reverse )
+        {
+            ++self->rank;
+            if( ++self->index == self->leaf->items.size() )
+                self->locate();
+        }
+        else
+        {
+            --self->rank;
+            if( self->index-- == 0 )
+                self->locate();
+        }
+    }
+    return res;
+}
+
+
+PyObject*
+SortedSetIterator_length_hint( SortedSetIterator* self )
+{
+    return PyLong_FromSize_t( self->set ? self->remaining : 0 );
+}
+
+
+static PyMethodDef
+SortedSetIterator_methods[] = {
+    { "__length_hint__", ( PyCFunction )SortedSetIterator_length_hint, METH_NOARGS,
+      "" },
+    { 0 } // sentinel
+};
+
+
+static PyType_Slot SortedSetIterator_Type_slots[] = {
+    { Py_tp_dealloc, void_cast( SortedSetIterator_dealloc ) },      /* tp_dealloc */
+    { Py_tp_traverse, void_cast( SortedSetIterator_traverse ) },    /* tp_traverse */
+    { Py_tp_clear, void_cast( SortedSetIterator_clear ) },          /* tp_clear */
+    { Py_tp_iter, void_cast( PyObject_SelfIter ) },                 /* tp_iter */
+    { Py_tp_iternext, void_cast( SortedSetIterator_next ) },        /* tp_iternext */
+    { Py_tp_methods, void_cast( SortedSetIterator_methods ) },      /* tp_methods */
+    { 0, 0 },
+};
+
+
+PyTypeObject* SortedSetIterator::TypeObject = NULL;
+
+
+PyType_Spec SortedSetIterator::TypeObject_Spec = {
+	PACKAGE_TYPENAME( "sortedset.sortedset_iterator" ),  /* tp_name */
+	sizeof( SortedSetIterator ),                         /* tp_basicsize */
+	0,                                                   /* tp_itemsize */
+	Py_TPFLAGS_DEFAULT|
+    Py_TPFLAGS_HAVE_GC,                                  /* tp_flags */
+    SortedSetIterator_Type_slots                         /* slots */
+};
+
+
+// Append the values of an iterable, ordered by the key function of set, and
+// join their kind to kind.
+bool
+collect_values( SortedSet* set, PyObject* source, std::vector<MapItem>& items, KeyKind::Kind& kind )
+{
+    if( SortedSet::TypeCheck( source ) &&
+        reinterpret_cast<SortedSet*>( source )->m_keyfunc == set->m_keyfunc )
+    {
+        SortedSet* other = reinterpret_cast<SortedSet*>( source );
+        items.reserve( items.size() + other->m_items->size() );
+        auto copy = [&]( std::vector<MapItem>& leaf_items ) -> bool
+        {
+            items.insert( items.end(), leaf_items.begin(), leaf_items.end() );
+            return true;
+        };
+        other->m_items->each_leaf( copy );
+        if( other->m_items->size() > 0 )
+            kind = KeyKind::join( kind, other->m_kind );
+        return true;
+    }
+    cppy::ptr iter( PyObject_GetIter( source ) );
+    if( !iter )
+        return false;
+    Py_ssize_t hint = PyObject_LengthHint( source, 0 );
+    if( hint < 0 )
+        return false;
+    items.reserve( items.size() + static_cast<size_t>( hint ) );
+    cppy::ptr value;
+    while( ( value = PyIter_Next( iter.get() ) ) )
+    {
+        KeyProbe probe;
+        if( !probe.init( value.get(), set->m_keyfunc ) )
+            return false;
+        items.push_back( MapItem( value.get(), Py_None, probe.sort_key() ) );
+        kind = KeyKind::join( kind, probe.kind() );
+    }
+    return !PyErr_Occurred();
+}
+
+
+// Sort values unless they are already sorted, keeping the equal values in
+// order. Only the first of the equal values is kept if unique is true.
+void
+sort_values( std::vector<MapItem>& items, const KeyOrder& order, bool unique )
+{
+    size_t count = items.size();
+    size_t i = 1;
+    while( i < count && ( unique ? order( items[ i - 1 ], items[ i ] ) : !order( items[ i ], items[ i - 1 ] ) ) )
+        ++i;
+    if( i >= count )
+        return;
+    std::stable_sort( items.begin(), items.end(), order );
+    if( !unique )
+        return;
+    size_t last = 0;
+    for( i = 1; i < count; ++i )
+    {
+        if( order( items[ last ], items[ i ] ) && ++last != i )
+            items[ last ] = std::move( items[ i ] );
+    }
+    items.resize( last + 1 );
+}
+
+
+// Merge the values of a tree with sorted values, the values of the tree
+// coming first among equal values. The values of items equal to a value of
+// the tree are dropped if unique is true. A snapshot of the tree is walked
+// since the comparisons may run code modifying it.
+void
+merge_sorted( MapTree* tree, std::vector<MapItem>& items, std::vector<MapItem>& merged, const KeyOrder& order, bool unique )
+{
+    MapTree snapshot;
+    snapshot.share( *tree );
+    merged.reserve( snapshot.size() + items.size() );
+    std::vector<MapItem>::iterator it = items.begin();
+    auto merge = [&]( std::vector<MapItem>& leaf_items ) -> bool
+    {
+        for( MapItem& item : leaf_items )
+        {
+            while( it != items.end() && order( *it, item ) )
+                merged.push_back( std::move( *it++ ) );
+            if( unique && it != items.end() && !order( item, *it ) )
+                ++it;
+            merged.push_back( item );
+        }
+        return true;
+    };
+    snapshot.each_leaf( merge );
+    merged.insert( merged.end(), std::make_move_iterator( it ), std::make_move_iterator( items.end() ) );
+}
+
+
+// Allocate an empty set of a type ordering its values by keyfunc.
+PyObject*
+new_set( PyTypeObject* type, PyObject* keyfunc, bool multi )
+{
+    PyObject* self = type->tp_alloc( type, 0 );
+    if( !self ) {
+        return 0;  // LCOV_EXCL_LINE (allocation failed, very unlikely)
+    }
+    SortedSet* cself = reinterpret_cast<SortedSet*>( self );
+    cself->m_items = new MapTree();
+    cself->m_keyfunc = cppy::xincref( keyfunc );
+    cself->m_kind = KeyKind::Empty;
+    cself->m_multi = multi;
+    return self;
+}
+
+
+// Build a set ordered like self from sorted values.
+PyObject*
+set_from_sorted( SortedSet* self, std::vector<MapItem>& items, KeyKind::Kind kind )
+{
+    PyObject* res = new_set(
+        self->m_multi ? SortedSet::MultiTypeObject : SortedSet::TypeObject,
+        self->m_keyfunc,
+        self->m_multi
+    );
+    if( !res )
+        return 0;  // LCOV_EXCL_LINE
+    SortedSet* set = reinterpret_cast<SortedSet*>( res );
+    set->m_items->load_sorted( items );
+    set->m_kind = items.empty() ? KeyKind::Empty : kind;
+    return res;
+}
+
+
+PyObject*
+sorted_set_new( PyTypeObject* type, PyObject* args, PyObject* kwargs, bool multi )
+{
+    PyObject* iterable = 0;
+    PyObject* keyfunc = Py_None;
+    static char* kwlist[] = { "iterable", "key", 0 };
+    if( !PyArg_ParseTupleAndKeywords( args, kwargs, "|O$O:__new__", kwlist, &iterable, &keyfunc ) )
+        return 0;
+    if( keyfunc != Py_None && !PyCallable_Check( keyfunc ) )
+        return cppy::type_error( keyfunc, "callable or None" );
+
+    cppy::ptr self( new_set( type, keyfunc != Py_None ? keyfunc : 0, multi ) );
+    if( !self ) {
+        return 0;  // LCOV_EXCL_LINE (allocation failed, very unlikely)
+    }
+    SortedSet* cself = reinterpret_cast<SortedSet*>( self.get() );
+
+    // Sorting the input once and loading the leaves in order is much faster
+    // than inserting the values one by one.
+    if( iterable )
+    {
+        std::vector<MapItem> items;
+        KeyKind::Kind kind = KeyKind::Empty;
+        if( !collect_values( cself, iterable, items, kind ) )
+            return 0;
+        sort_values( items, KeyOrder( kind ), !multi );
+        cself->m_items->load_sorted( items );
+        cself->m_kind = kind;
+    }
+
+    return self.release();
+}
+
+
+PyObject*
+SortedSet_new( PyTypeObject* type, PyObject* args, PyObject* kwargs )
+{
+    return sorted_set_new( type, args, kwargs, false );
+}
+
+
+PyObject*
+SortedMultiSet_new( PyTypeObject* type, PyObject* args, PyObject* kwargs )
+{
+    return sorted_set_new( type, args, kwargs, true );
+}
+
+
+// Clearing the tree may cause arbitrary side effects on item
+// decref, including calls into methods which mutate the tree.
+// To avoid segfaults, first make the tree empty, then let the
+// destructors run for the old items.
+int
+SortedSet_clear( SortedSet* self )
+{
+    MapTree empty;
+    self->m_items->swap( empty );
+    ++self->m_version;
+    Py_CLEAR( self->m_keyfunc );
+    return 0;
+}
+
+
+int
+SortedSet_traverse( SortedSet* self, visitproc visit, void* arg )
+{
+    auto visitor = [&]( PyObject* ob ) -> int
+    {
+        Py_VISIT( ob );
+        return 0;
+    };
+    if( int res = self->m_items->visit( visitor ) )
+        return res;
+    Py_VISIT( self->m_keyfunc );
+    Py_VISIT( Py_TYPE( self ) );
+    return 0;
+}
+
+
+void
+SortedSet_dealloc( SortedSet* self )
+{
+    PyObject_GC_UnTrack( self );
+    SortedSet_clear( self );
+    delete self->m_items;
+    self->m_items = 0;
+    PyTypeObject* type = Py_TYPE( self );
+    type->tp_free( reinterpret_cast<PyObject*>( self ) );
+    Py_DECREF( type );
+}
+
+
+Py_ssize_t
+SortedSet_length( SortedSet* self )
+{
+    return static_cast<Py_ssize_t>( self->m_items->size() );
+}
+
+
+int
+SortedSet_contains( SortedSet* self, PyObject* value )
+{
+    return self->contains( value );
+}
+
+
+// Indexing and slicing address the values by rank.
+PyObject*
+SortedSet_subscript( SortedSet* self, PyObject* index )
+{
+    MapTree* items = self->m_items;
+    if( PySlice_Check( index ) )
+    {
+        Py_ssize_t start, stop, step;
+        if( PySlice_Unpack( index, &start, &stop, &step ) < 0 )
+            return 0;
+        Py_ssize_t count = PySlice_AdjustIndices(
+            static_cast<Py_ssize_t>( items->size() ), &start, &stop, step
+        );
+        cppy::ptr pylist( PyList_New( count ) );
+        if( !pylist )
+            return 0;  // LCOV_EXCL_LINE
+        for( Py_ssize_t i = 0; i < count; ++i )
+        {
+            PyObject* value = items->at( start + i * step ).item().key();
+            PyList_SET_ITEM( pylist.get(), i, cppy::incref( value ) );
+        }
+        return pylist.release();
+    }
+    size_t rank;
+    if( !rank_from_index( self, index, rank ) )
+        return 0;
+    return cppy::incref( items->at( rank ).item().key() );
+}
+
+
+int
+SortedSet_ass_subscript( SortedSet* self, PyObject* index, PyObject* value )
+{
+    if( value )
+    {
+        PyErr_Format( PyExc_TypeError, "%s does not support item assignment", self->name() );
+        return -1;
+    }
+    // The removed values are released once the tree is consistent.
+    std::vector<MapItem> removed;
+    if( PySlice_Check( index ) )
+    {
+        Py_ssize_t start, stop, step;
+        if( PySlice_Unpack( index, &start, &stop, &step ) < 0 )
+            return -1;
+        Py_ssize_t count = PySlice_AdjustIndices(
+            static_cast<Py_ssize_t>( self->m_items->size() ), &start, &stop, step
+        );
+        if( count == 0 )
+            return 0;
+        if( step == 1 || step == -1 )
+        {
+            size_t first = static_cast<size_t>( step == 1 ? start : stop + 1 );
+            self->m_items->erase_range( first, static_cast<size_t>( count ), removed );
+        }
+        else
+        {
+            // Erasing the largest rank first keeps the other ranks valid.
+            Py_ssize_t last = start + ( count - 1 ) * step;
+            Py_ssize_t rank = step > 0 ? last : start;
+            Py_ssize_t stride = step > 0 ? step : -step;
+            for( Py_ssize_t i = 0; i < count; ++i, rank -= stride )
+                self->m_items->erase_range( static_cast<size_t>( rank ), 1, removed );
+        }
+        ++self->m_version;
+        return 0;
+    }
+    size_t rank;
+    if( !rank_from_index( self, index, rank ) )
+        return -1;
+    self->m_items->erase_range( rank, 1, removed );
+    ++self->m_version;
+    return 0;
+}
+
+
+PyObject*
+SortedSet_iter( SortedSet* self )
+{
+    return SortedSetIterator::New( self, 0, self->m_items->size(), false );
+}
+
+
+PyObject*
+SortedSet_reversed( SortedSet* self )
+{
+    return SortedSetIterator::New( self, 0, self->m_items->size(), true );
+}
+
+
+PyObject*
+SortedSet_add( SortedSet* self, PyObject* value )
+{
+    if( self->add( value ) < 0 )
+        return 0;
+    Py_RETURN_NONE;
+}
+
+
+PyObject*
+SortedSet_discard( SortedSet* self, PyObject* value )
+{
+    MapItem removed;
+    if( self->erase( value, removed ) < 0 )
+        return 0;
+    Py_RETURN_NONE;
+}
+
+
+PyObject*
+SortedSet_remove( SortedSet* self, PyObject* value )
+{
+    MapItem removed;
+    int res = self->erase( value, removed );
+    if( res < 0 )
+        return 0;
+    if( res == 0 )
+        return SortedSet::lookup_fail( value );
+    Py_RETURN_NONE;
+}
+
+
+PyObject*
+SortedSet_pop( SortedSet* self, PyObject*const *args, Py_ssize_t nargs )
+{
+    if( nargs > 1 )
+    {
+        std::ostringstream ostr;
+        ostr << "pop() expected at most 1 argument, got " << nargs;
+        return cppy::type_error( ostr.str().c_str() );
+    }
+    if( self->m_items->size() == 0 )
+    {
+        PyErr_Format( PyExc_IndexError, "pop from an empty %s", self->name() );
+        return 0;
+    }
+    size_t rank;
+    cppy::ptr last( PyLong_FromLong( -1 ) );
+    if( !rank_from_index( self, nargs == 1 ? args[0] : last.get(), rank ) )
+        return 0;
+    std::vector<MapItem> removed;
+    self->m_items->erase_range( rank, 1, removed );
+    ++self->m_version;
+    return cppy::incref( removed.front().key() );
+}
+
+
+PyObject*
+SortedSet_clearmethod( SortedSet* self )
+{
+    MapTree empty;
+    self->m_items->swap( empty );
+    ++self->m_version;
+    Py_RETURN_NONE;
+}
+
+
+// Like the copies of a set subclass, the copies of a subclass are plain sets.
+PyObject*
+SortedSet_copy( SortedSet* self )
+{
+    PyTypeObject* type = self->m_multi ? SortedSet::MultiTypeObject : SortedSet::TypeObject;
+    PyObject* copy = type->tp_alloc( type, 0 );
+    if( !copy )
+        return 0;  // LCOV_EXCL_LINE
+    SortedSet* ccopy = reinterpret_cast<SortedSet*>( copy );
+    ccopy->m_items = new MapTree( *self->m_items );
+    ccopy->m_keyfunc = cppy::xincref( self->m_keyfunc );
+    ccopy->m_kind = self->m_kind;
+    ccopy->m_multi = self->m_multi;
+    return copy;
+}
+
+
+// Return a copy sharing the nodes of the set, which are copied by the first
+// mutation of either set touching them.
+PyObject*
+SortedSet_snapshot( SortedSet* self )
+{
+    std::vector<MapItem> none;
+    PyObject* res = set_from_sorted( self, none, KeyKind::Empty );
+    if( !res )
+        return 0;  // LCOV_EXCL_LINE
+    SortedSet* set = reinterpret_cast<SortedSet*>( res );
+    set->m_items->share( *self->m_items );
+    set->m_kind = self->m_kind;
+    return res;
+}
+
+
+// Add the values of an iterable to the set, inserting them one by one if they
+// are few compared to the set and merging them with the values of the set
+// else.
+PyObject*
+SortedSet_update( SortedSet* self, PyObject* source )
+{
+    std::vector<MapItem> items;
+    KeyKind::Kind kind = KeyKind::Empty;
+    if( !collect_values( self, source, items, kind ) )
+        return 0;
+    if( items.empty() )
+        Py_RETURN_NONE;
+    sort_values( items, KeyOrder( kind ), !self->m_multi );
+    MapTree* tree = self->m_items;
+    if( items.size() * 16 < tree->size() )
+    {
+        for( MapItem& item : items )
+            self->insert( item, kind );
+        Py_RETURN_NONE;
+    }
+    KeyKind::Kind joined = tree->size() == 0 ? kind : KeyKind::join( self->m_kind, kind );
+    std::vector<MapItem> merged;
+    merge_sorted( tree, items, merged, KeyOrder( joined ), !self->m_multi );
+    if( merged.size() != tree->size() )
+        ++self->m_version;
+    // The old values are released once the new tree is in place.
+    MapTree old;
+    old.swap( *tree );
+    tree->load_sorted( merged );
+    self->m_kind = joined;
+    Py_RETURN_NONE;
+}
+
+
+// Walk two arrays of sorted unique values in step, calling visit with the
+// values of both arrays comparing equal, null standing for a value missing
+// from one of the arrays.
+template<typename Visitor>
+void
+merge_walk( std::vector<MapItem>& first, std::vector<MapItem>& second, const KeyOrder& order, Visitor visit )
+{
+    std::vector<MapItem>::iterator it = first.begin();
+    std::vector<MapItem>::iterator other = second.begin();
+    while( it != first.end() || other != second.end() )
+    {
+        if( other == second.end() || ( it != first.end() && order( *it, *other ) ) )
+            visit( &*it++, static_cast<MapItem*>( 0 ) );
+        else if( it == first.end() || order( *other, *it ) )
+            visit( static_cast<MapItem*>( 0 ), &*other++ );
+        else
+            visit( &*it++, &*other++ );
+    }
+}
+
+
+// Copy the values of a set and those of an iterable, ordered by the key
+// function of the set, so that walking them cannot be disturbed by code run
+// by the comparisons. Returns the comparisons to use for both arrays.
+bool
+snapshot_pair( SortedSet* self, PyObject* other, std::vector<MapItem>& mine, std::vector<MapItem>& theirs, KeyKind::Kind& kind )
+{
+    KeyKind::Kind my_kind = KeyKind::Empty;
+    KeyKind::Kind their_kind = KeyKind::Empty;
+    if( !collect_values( self, pyobject_cast( self ), mine, my_kind ) )
+        return false;  // LCOV_EXCL_LINE
+    if( !collect_values( self, other, theirs, their_kind ) )
+        return false;
+    sort_values( theirs, KeyOrder( their_kind ), true );
+    kind = KeyKind::join( my_kind, their_kind );
+    return true;
+}
+
+
+// Set operations walking the values of the set and of another iterable. The
+// values of the set win over the equal values of other.
+template<bool keep_mine, bool keep_common, bool keep_theirs>
+PyObject*
+set_operation( SortedSet* self, PyObject* other )
+{
+    std::vector<MapItem> mine;
+    std::vector<MapItem> theirs;
+    KeyKind::Kind kind;
+    if( !snapshot_pair( self, other, mine, theirs, kind ) )
+        return 0;
+    std::vector<MapItem> res;
+    merge_walk( mine, theirs, KeyOrder( kind ), [&]( MapItem* item, MapItem* their ) {
+        if( item && their )
+        {
+            if( keep_common )
+                res.push_back( std::move( *item ) );
+        }
+        else if( item ? keep_mine : keep_theirs )
+            res.push_back( std::move( item ? *item : *their ) );
+    } );
+    return set_from_sorted( self, res, kind );
+}
+
+
+PyObject*
+SortedSet_union( SortedSet* self, PyObject* other )
+{
+    return set_operation<true, true, true>( self, other );
+}
+
+
+PyObject*
+SortedSet_intersection( SortedSet* self, PyObject* other )
+{
+    return set_operation<false, true, false>( self, other );
+}
+
+
+PyObject*
+SortedSet_difference( SortedSet* self, PyObject* other )
+{
+    return set_operation<true, false, false>( self, other );
+}
+
+
+PyObject*
+SortedSet_symmetric_difference( SortedSet* self, PyObject* other )
+{
+    return set_operation<true, false, true>( self, other );
+}
+
+
+PyObject*
+SortedSet_contains_bool( SortedSet* self, PyObject* value )
+{
+    int res = self->contains( value );
+    if( res < 0 )
+        return 0;
+    return cppy::incref( res ? Py_True : Py_False );
+}
+
+
+PyObject*
+SortedSet_bisect_left( SortedSet* self, PyObject* value )
+{
+    size_t rank;
+    if( !self->bisect( value, false, rank ) )
+        return 0;
+    return PyLong_FromSize_t( rank );
+}
+
+
+PyObject*
+SortedSet_bisect_right( SortedSet* self, PyObject* value )
+{
+    size_t rank;
+    if( !self->bisect( value, true, rank ) )
+        return 0;
+    return PyLong_FromSize_t( rank );
+}
+
+
+PyObject*
+SortedSet_count( SortedSet* self, PyObject* value )
+{
+    KeyProbe probe;
+    if( !probe.init( value, self->m_keyfunc ) )
+        return 0;
+    KeyOrder order = self->order_for( probe );
+    size_t first = self->m_items->bisect( probe.sort_key(), false, order );
+    size_t last = self->m_items->bisect( probe.sort_key(), true, order );
+    return PyLong_FromSize_t( last - first );
+}
+
+
+PyObject*
+SortedSet_index( SortedSet* self, PyObject* value )
+{
+    KeyProbe probe;
+    if( !probe.init( value, self->m_keyfunc ) )
+        return 0;
+    KeyOrder order = self->order_for( probe );
+    size_t rank = self->m_items->bisect( probe.sort_key(), false, order );
+    if( rank < self->m_items->size() &&
+        order.equal( self->m_items->at( rank ).item().sort_key(), probe.sort_key() ) )
+        return PyLong_FromSize_t( rank );
+    cppy::ptr repr( PyObject_Repr( value ) );
+    if( !repr )
+        return 0;
+    PyErr_Format( PyExc_ValueError, "%U is not in %s", repr.get(), self->name() );
+    return 0;
+}
+
+
+PyObject*
+SortedSet_irange( SortedSet* self, PyObject* args, PyObject* kwargs )
+{
+    PyObject* minimum = Py_None;
+    PyObject* maximum = Py_None;
+    int include_min = 1;
+    int include_max = 1;
+    int reverse = 0;
+    static char* kwlist[] = { "minimum", "maximum", "inclusive", "reverse", 0 };
+    if( !PyArg_ParseTupleAndKeywords(
+            args, kwargs, "|OO(pp)p:irange", kwlist,
+            &minimum, &maximum, &include_min, &include_max, &reverse ) )
+        return 0;
+    size_t start = 0;
+    size_t stop = self->m_items->size();
+    if( minimum != Py_None && !self->bisect( minimum, !include_min, start ) )
+        return 0;
+    if( maximum != Py_None && !self->bisect( maximum, include_max, stop ) )
+        return 0;
+    return SortedSetIterator::New( self, start, stop, reverse );
+}
+
+
+// Sets of the same type compare equal when they hold equal values in the
+// same order.
+PyObject*
+SortedSet_richcompare( SortedSet* self, PyObject* other, int op )
+{
+    if( ( op != Py_EQ && op != Py_NE ) || !SortedSet::TypeCheck( other ) ||
+        reinterpret_cast<SortedSet*>( other )->m_multi != self->m_multi )
+        Py_RETURN_NOTIMPLEMENTED;
+    SortedSet* cother = reinterpret_cast<SortedSet*>( other );
+    bool equal = self->m_items->size() == cother->m_items->size();
+    if( equal && self != cother )
+    {
+        // The comparisons may run code modifying the sets.
+        std::vector<MapItem> mine;
+        std::vector<MapItem> theirs;
+        KeyKind::Kind kind = KeyKind::Empty;
+        collect_values( self, pyobject_cast( self ), mine, kind );
+        collect_values( cother, other, theirs, kind );
+        for( size_t i = 0; equal && i < mine.size(); ++i )
+        {
+            int res = PyObject_RichCompareBool( mine[ i ].key(), theirs[ i ].key(), Py_EQ );
+            if( res < 0 )
+                return 0;
+            equal = res == 1;
+        }
+    }
+    return cppy::incref( equal == ( op == Py_EQ ) ? Py_True : Py_False );
+}
+
+
+PyObject*
+SortedSet_repr( SortedSet* self )
+{
+    std::ostringstream ostr;
+    ostr << self->name() << "([";
+    // The reprs may run code modifying the set.
+    MapTree snapshot;
+    snapshot.share( *self->m_items );
+    auto write = [&]( std::vector<MapItem>& items ) -> bool
+    {
+        for( MapItem& item : items )
+        {
+            cppy::ptr valstr( PyObject_Repr( item.key() ) );
+            if( !valstr )
+                return false;
+            ostr << PyUnicode_AsUTF8( valstr.get() ) << ", ";
+        }
+        return true;
+    };
+    if( !snapshot.each_leaf( write ) )
+        return 0;
+    if( snapshot.size() > 0 )
+        ostr.seekp( -2, std::ios_base::cur );
+    ostr << "])";
+    return PyUnicode_FromString( ostr.str().c_str() );
+}
+
+
+PyObject*
+SortedSet_sizeof( SortedSet* self, PyObject* args )
+{
+    Py_ssize_t size = Py_TYPE(self)->tp_basicsize;
+    size += self->m_items->memory();
+    return PyLong_FromSsize_t( size );
+}
+
+
+PyObject*
+SortedSet_get_key( SortedSet* self, void* context )
+{
+    return cppy::incref( self->m_keyfunc ? self->m_keyfunc : Py_None );
+}
+
+
+static PyMethodDef
+SortedSet_methods[] = {
+    { "add", ( PyCFunction )SortedSet_add, METH_O,
+      "Add a value unless an equal value is already in the set." },
+    { "discard", ( PyCFunction )SortedSet_discard, METH_O,
+      "Remove a value if it is in the set." },
+    { "remove", ( PyCFunction )SortedSet_remove, METH_O,
+      "Remove a value, raising a KeyError if it is not in the set." },
+    { "pop", ( PyCFunction )SortedSet_pop, METH_FASTCALL,
+      "Remove and return the value at the given index, the last by default." },
+    { "clear", ( PyCFunction )SortedSet_clearmethod, METH_NOARGS,
+      "" },
+    { "copy", ( PyCFunction )SortedSet_copy, METH_NOARGS,
+      "" },
+    { "snapshot", ( PyCFunction )SortedSet_snapshot, METH_NOARGS,
+      "Return a copy of the set sharing its storage until either set is modified." },
+    { "update", ( PyCFunction )SortedSet_update, METH_O,
+      "Add the values of an iterable." },
+    { "union", ( PyCFunction )SortedSet_union, METH_O,
+      "Return a new set holding the values of the set and of other." },
+    { "intersection", ( PyCFunction )SortedSet_intersection, METH_O,
+      "Return a new set holding the values of the set also in other." },
+    { "difference", ( PyCFunction )SortedSet_difference, METH_O,
+      "Return a new set holding the values of the set not in other." },
+    { "symmetric_difference", ( PyCFunction )SortedSet_symmetric_difference, METH_O,
+      "Return a new set holding the values in either the set or other but not both." },
+    { "__reversed__", ( PyCFunction )SortedSet_reversed, METH_NOARGS,
+      "" },
+    { "bisect_left", ( PyCFunction )SortedSet_bisect_left, METH_O,
+      "Return the index at which value would be inserted before equal values." },
+    { "bisect_right", ( PyCFunction )SortedSet_bisect_right, METH_O,
+      "Return the index at which value would be inserted after equal values." },
+    { "count", ( PyCFunction )SortedSet_count, METH_O,
+      "Return the number of values equal to value." },
+    { "index", ( PyCFunction )SortedSet_index, METH_O,
+      "Return the index of the first value equal to value." },
+    { "irange", ( PyCFunction )SortedSet_irange, METH_VARARGS | METH_KEYWORDS,
+      "Iterate over the values between minimum and maximum." },
+    { "__contains__", ( PyCFunction )SortedSet_contains_bool, METH_O | METH_COEXIST,
+      "" },
+    { "__getitem__", ( PyCFunction )SortedSet_subscript, METH_O | METH_COEXIST,
+      "" },
+    { "__sizeof__", ( PyCFunction )SortedSet_sizeof, METH_NOARGS,
+      "__sizeof__() -> size of object in memory, in bytes" },
+    { 0 } // sentinel
+};
+
+
+// The set operations are not defined for multisets.
+static PyMethodDef
+SortedMultiSet_methods[] = {
+    { "add", ( PyCFunction )SortedSet_add, METH_O,
+      "Add a value after the equal values already in the multiset." },
+    { "discard", ( PyCFunction )SortedSet_discard, METH_O,
+      "Remove one value equal to value if there is any." },
+    { "remove", ( PyCFunction )SortedSet_remove, METH_O,
+      "Remove one value equal to value, raising a KeyError if there is none." },
+    { "pop", ( PyCFunction )SortedSet_pop, METH_FASTCALL,
+      "Remove and return the value at the given index, the last by default." },
+    { "clear", ( PyCFunction )SortedSet_clearmethod, METH_NOARGS,
+      "" },
+    { "copy", ( PyCFunction )SortedSet_copy, METH_NOARGS,
+      "" },
+    { "snapshot", ( PyCFunction )SortedSet_snapshot, METH_NOARGS,
+      "Return a copy of the multiset sharing its storage until either is modified." },
+    { "update", ( PyCFunction )SortedSet_update, METH_O,
+      "Add the values of an iterable." },
+    { "__reversed__", ( PyCFunction )SortedSet_reversed, METH_NOARGS,
+      "" },
+    { "bisect_left", ( PyCFunction )SortedSet_bisect_left, METH_O,
+      "Return the index at which value would be inserted before equal values." },
+    { "bisect_right", ( PyCFunction )SortedSet_bisect_right, METH_O,
+      "Return the index at which value would be inserted after equal values." },
+    { "count", ( PyCFunction )SortedSet_count, METH_O,
+      "Return the number of values equal to value." },
+    { "index", ( PyCFunction )SortedSet_index, METH_O,
+      "Return the index of the first value equal to value." },
+    { "irange", ( PyCFunction )SortedSet_irange, METH_VARARGS | METH_KEYWORDS,
+      "Iterate over the values between minimum and maximum." },
+    { "__contains__", ( PyCFunction )SortedSet_contains_bool, METH_O | METH_COEXIST,
+      "" },
+    { "__getitem__", ( PyCFunction )SortedSet_subscript, METH_O | METH_COEXIST,
+      "" },
+    { "__sizeof__", ( PyCFunction )SortedSet_sizeof, METH_NOARGS,
+      "__sizeof__() -> size of object in memory, in bytes" },
+    { 0 } // sentinel
+};
+
+
+static PyGetSetDef
+SortedSet_getset[] = {
+    { "key", ( getter )SortedSet_get_key, 0,
+      "The function computing the object ordering each value, or None." },
+    { 0 } // sentinel
+};
+
+
+static PyType_Slot SortedSet_Type_slots[] = {
+    { Py_tp_dealloc, void_cast( SortedSet_dealloc ) },              /* tp_dealloc */
+    { Py_tp_traverse, void_cast( SortedSet_traverse ) },            /* tp_traverse */
+    { Py_tp_clear, void_cast( SortedSet_clear ) },                  /* tp_clear */
+    { Py_tp_methods, void_cast( SortedSet_methods ) },              /* tp_methods */
+    { Py_tp_getset, void_cast( SortedSet_getset ) },                /* tp_getset */
+    { Py_tp_repr, void_cast( SortedSet_repr ) },                    /* tp_repr */
+    { Py_tp_richcompare, void_cast( SortedSet_richcompare ) },      /* tp_richcompare */
+    { Py_tp_hash, void_cast( PyObject_HashNotImplemented ) },       /* tp_hash */
+    { Py_tp_new, void_cast( SortedSet_new ) },                      /* tp_new */
+    { Py_tp_iter, void_cast( SortedSet_iter ) },                    /* tp_iter */
+    { Py_tp_alloc, void_cast( PyType_GenericAlloc ) },              /* tp_alloc */
+    { Py_mp_length, void_cast( SortedSet_length ) },                /* mp_length */
+    { Py_mp_subscript, void_cast( SortedSet_subscript ) },          /* mp_subscript */
+    { Py_mp_ass_subscript, void_cast( SortedSet_ass_subscript ) },  /* mp_ass_subscript */
+    { Py_sq_contains, void_cast( SortedSet_contains ) },            /* sq_contains */
+    { 0, 0 },
+};
+
+
+static PyType_Slot SortedMultiSet_Type_slots[] = {
+    { Py_tp_dealloc, void_cast( SortedSet_dealloc ) },              /* tp_dealloc */
+    { Py_tp_traverse, void_cast( SortedSet_traverse ) },            /* tp_traverse */
+    { Py_tp_clear, void_cast( SortedSet_clear ) },                  /* tp_clear */
+    { Py_tp_methods, void_cast( SortedMultiSet_methods ) },         /* tp_methods */
+    { Py_tp_getset, void_cast( SortedSet_getset ) },                /* tp_getset */
+    { Py_tp_repr, void_cast( SortedSet_repr ) },                    /* tp_repr */
+    { Py_tp_richcompare, void_cast( SortedSet_richcompare ) },      /* tp_richcompare */
+    { Py_tp_hash, void_cast( PyObject_HashNotImplemented ) },       /* tp_hash */
+    { Py_tp_new, void_cast( SortedMultiSet_new ) },                 /* tp_new */
+    { Py_tp_iter, void_cast( SortedSet_iter ) },                    /* tp_iter */
+    { Py_tp_alloc, void_cast( PyType_GenericAlloc ) },              /* tp_alloc */
+    { Py_mp_length, void_cast( SortedSet_length ) },                /* mp_length */
+    { Py_mp_subscript, void_cast( SortedSet_subscript ) },          /* mp_subscript */
+    { Py_mp_ass_subscript, void_cast( SortedSet_ass_subscript ) },  /* mp_ass_subscript */
+    { Py_sq_contains, void_cast( SortedSet_contains ) },            /* sq_contains */
+    { 0, 0 },
+};
+
+
+// Initialize static variables (otherwise the compiler eliminates them)
+PyTypeObject* SortedSet::TypeObject = NULL;
+
+
+PyTypeObject* SortedSet::MultiTypeObject = NULL;
+
+
+PyType_Spec SortedSet::TypeObject_Spec = {
+	PACKAGE_TYPENAME( "sortedset.sortedset" ),   /* tp_name */
+	sizeof( SortedSet ),                         /* tp_basicsize */
+	0,                                           /* tp_itemsize */
+	Py_TPFLAGS_DEFAULT|
+    Py_TPFLAGS_BASETYPE|
+    Py_TPFLAGS_HAVE_GC,                          /* tp_flags */
+    SortedSet_Type_slots                         /* slots */
+};
+
+
+PyType_Spec SortedSet::MultiTypeObject_Spec = {
+	PACKAGE_TYPENAME( "sortedset.sortedmultiset" ),  /* tp_name */
+	sizeof( SortedSet ),                             /* tp_basicsize */
+	0,                                               /* tp_itemsize */
+	Py_TPFLAGS_DEFAULT|
+    Py_TPFLAGS_BASETYPE|
+    Py_TPFLAGS_HAVE_GC,                              /* tp_flags */
+    SortedMultiSet_Type_slots                        /* slots */
+};
+
+
+bool SortedSet::Ready()
+{
+    // The references will be handled by the module to which we will add the types
+	TypeObject = pytype_cast( PyType_FromSpec( &TypeObject_Spec ) );
+    if( !TypeObject )
+    {
+        return false;  // LCOV_EXCL_LINE (failed to create type, very unlikely)
+    }
+	MultiTypeObject = pytype_cast( PyType_FromSpec( &MultiTypeObject_Spec ) );
+    if( !MultiTypeObject )
+    {
+        return false;  // LCOV_EXCL_LINE (failed to create type, very unlikely)
+    }
+    SortedSetIterator::TypeObject = pytype_cast( PyType_FromSpec( &SortedSetIterator::TypeObject_Spec ) );
+    if( !SortedSetIterator::TypeObject )
+    {
+        return false;  // LCOV_EXCL_LINE (failed to create type, very unlikely)
+    }
+    return true;
+}
+
+
+// Module creation
+
+static PyMethodDef
+sortedset_methods[] = {
+    { 0 } // Sentinel
+};
+
+int
+sortedset_modexec( PyObject *mod )
+{
+    if( !SortedSet::Ready() )
+    {
+        return -1;  // LCOV_EXCL_LINE (failed to init type, very unlikely)
+    }
+
+    cppy::ptr sortedset( pyobject_cast( SortedSet::TypeObject ) );
+	if( PyModule_AddObject( mod, "sortedset", sortedset.get() ) < 0 )
+	{
+		return -1;  // LCOV_EXCL_LINE (failed to add type to module, very unlikely)
+	}
+    sortedset.release();
+
+    cppy::ptr sortedmultiset( pyobject_cast( SortedSet::MultiTypeObject ) );
+	if( PyModule_AddObject( mod, "sortedmultiset", sortedmultiset.get() ) < 0 )
+	{
+		return -1;  // LCOV_EXCL_LINE (failed to add type to module, very unlikely)
+	}
+    sortedmultiset.release();
+
+    return 0;
+}
+
+
+PyModuleDef_Slot sortedset_slots[] = {
+    {Py_mod_exec, reinterpret_cast<void*>( sortedset_modexec ) },
+    {0, NULL}
+};
+
+
+static struct PyModuleDef moduledef = {
+        PyModuleDef_HEAD_INIT,
+        "sortedset",
+        "sortedset extension module",
+        0,
+        sortedset_methods,
+        sortedset_slots,
+        NULL,
+        NULL,
+        NULL
+};
+
+
+}  // namespace
+
+
+PyMODINIT_FUNC PyInit_sortedset( void )
+{
+    return PyModuleDef_Init( &moduledef );
+}
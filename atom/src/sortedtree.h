@@ -0,0 +1,1148 @@
+/*-----------------------------------------------------------------------------
+| Copyright (c) 2013-2025, Nucleic Development Team.
+|
+| Distributed under the terms of the Modified BSD License.
+|
+| The full license is in the file LICENSE, distributed with this software.
+|----------------------------------------------------------------------------*/
+#pragma once
+#include <cppy/cppy.h>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <vector>
+#include "utils.h"
+
+
+// Sorted storage shared by the extension types of atom.datastructures: the
+// comparison of native keys and the copy-on-write B+tree holding the items.
+
+namespace atom
+{
+
+namespace sortedtree
+{
+
+namespace KeyKind
+{
+
+// Kind shared by all the keys of a map, which selects how they are compared.
+enum Kind: uint8_t
+{
+    Empty,  // no key inserted yet
+    Int,  // exact ints fitting in a long long
+    Float,  // exact floats
+    Str,  // exact strs
+    Bytes,  // exact bytes
+    Object,  // any other mix of keys, compared through rich comparisons
+};
+
+// The kind of a map holding keys of both kinds.
+inline Kind join( Kind first, Kind second )
+{
+    if( first == Empty || first == second )
+        return second;
+    return second == Empty ? first : Object;
+}
+
+}  // namespace KeyKind
+
+
+// Native copy of a key of an int or float map.
+union NativeKey
+{
+    long long i;
+    double d;
+};
+
+
+// Classify the object ordering a key and store its native copy.
+inline KeyKind::Kind
+classify_key( PyObject* order, NativeKey& native )
+{
+    native.i = 0;
+    if( PyLong_CheckExact( order ) )
+    {
+        int overflow;
+        native.i = PyLong_AsLongLongAndOverflow( order, &overflow );
+        return overflow ? KeyKind::Object : KeyKind::Int;
+    }
+    if( PyFloat_CheckExact( order ) )
+    {
+        native.d = PyFloat_AS_DOUBLE( order );
+        return KeyKind::Float;
+    }
+    if( PyUnicode_CheckExact( order ) )
+        return KeyKind::Str;
+    if( PyBytes_CheckExact( order ) )
+        return KeyKind::Bytes;
+    return KeyKind::Object;
+}
+
+
+// Borrowed view of the object ordering a key, which is the key itself or the
+// result of the key function of the map, and of its native copy.
+struct SortKey
+{
+    PyObject* order;
+    NativeKey native;
+};
+
+
+class MapItem
+{
+
+public:
+
+    MapItem() { m_native.i = 0; }
+
+    MapItem( PyObject* key, PyObject* value ) :
+        m_key( cppy::incref( key ) ), m_value( cppy::incref( value ) )
+    {
+        m_native.i = 0;
+    }
+
+    // Build an item ordered by a sort key. The order object is only held if
+    // it differs from the key, that is if it was computed by a key function.
+    MapItem( PyObject* key, PyObject* value, const SortKey& sort ) :
+        m_key( cppy::incref( key ) ), m_value( cppy::incref( value ) ),
+        m_order( sort.order != key ? cppy::incref( sort.order ) : 0 ),
+        m_native( sort.native ) { }
+
+    MapItem( const MapItem& other ) = default;
+
+    // Moving an item steals its references so that shifting the items of a
+    // node does not touch the reference counts.
+    MapItem( MapItem&& other ) noexcept :
+        m_key( other.m_key.release() ), m_value( other.m_value.release() ),
+        m_order( other.m_order.release() ), m_native( other.m_native ) { }
+
+    MapItem& operator=( const MapItem& other ) = default;
+
+    MapItem& operator=( MapItem&& other ) noexcept
+    {
+        if( this != &other )
+        {
+            m_key = other.m_key.release();
+            m_value = other.m_value.release();
+            m_order = other.m_order.release();
+            m_native = other.m_native;
+        }
+        return *this;
+    }
+
+    ~MapItem() { }
+
+    PyObject* key()
+    {
+        return m_key.get();
+    }
+
+    PyObject* value()
+    {
+        return m_value.get();
+    }
+
+    // The result of the key function of the map for the key, if any.
+    PyObject* order()
+    {
+        return m_order.get();
+    }
+
+    SortKey sort_key() const
+    {
+        SortKey sort = { m_order ? m_order.get() : m_key.get(), m_native };
+        return sort;
+    }
+
+    const NativeKey& native() const
+    {
+        return m_native;
+    }
+
+    // Replace the value and hand back the old one, so that the caller can
+    // release it once the map is in a consistent state.
+    PyObject* update( PyObject* value )
+    {
+        PyObject* old = m_value.release();
+        m_value = cppy::incref( value );
+        return old;
+    }
+
+private:
+
+    cppy::ptr m_key;
+    cppy::ptr m_value;
+    cppy::ptr m_order;
+    NativeKey m_native;
+};
+
+
+// Owned copy of the sort key of an item, used to separate the children of
+// the inner nodes of a tree.
+class Separator
+{
+
+public:
+
+    Separator() { m_sort.order = 0; m_sort.native.i = 0; }
+
+    explicit Separator( const MapItem& item ) : m_sort( item.sort_key() )
+    {
+        Py_INCREF( m_sort.order );
+    }
+
+    Separator( const Separator& other ) : m_sort( other.m_sort )
+    {
+        Py_XINCREF( m_sort.order );
+    }
+
+    Separator( Separator&& other ) noexcept : m_sort( other.m_sort )
+    {
+        other.m_sort.order = 0;
+    }
+
+    Separator& operator=( const Separator& other )
+    {
+        PyObject* old = m_sort.order;
+        m_sort = other.m_sort;
+        Py_XINCREF( m_sort.order );
+        Py_XDECREF( old );
+        return *this;
+    }
+
+    Separator& operator=( Separator&& other ) noexcept
+    {
+        if( this != &other )
+        {
+            PyObject* old = m_sort.order;
+            m_sort = other.m_sort;
+            other.m_sort.order = 0;
+            Py_XDECREF( old );
+        }
+        return *this;
+    }
+
+    ~Separator()
+    {
+        Py_XDECREF( m_sort.order );
+    }
+
+    const SortKey& sort_key() const
+    {
+        return m_sort;
+    }
+
+    const NativeKey& native() const
+    {
+        return m_sort.native;
+    }
+
+private:
+
+    SortKey m_sort;
+};
+
+
+inline int
+bytes_compare( PyObject* first, PyObject* second )
+{
+    Py_ssize_t first_size = PyBytes_GET_SIZE( first );
+    Py_ssize_t second_size = PyBytes_GET_SIZE( second );
+    int res = memcmp(
+        PyBytes_AS_STRING( first ), PyBytes_AS_STRING( second ),
+        static_cast<size_t>( std::min( first_size, second_size ) )
+    );
+    if( res != 0 )
+        return res;
+    return first_size < second_size ? -1 : ( first_size > second_size ? 1 : 0 );
+}
+
+
+// Comparison of the sort keys of a map. Keys of a native kind are compared
+// without calling into Python, which gives the same order as the rich
+// comparisons used for the other keys.
+struct KeyOrder
+{
+    explicit KeyOrder( KeyKind::Kind k ) : kind( k ) {}
+
+    bool less( const SortKey& first, const SortKey& second ) const
+    {
+        switch( kind )
+        {
+            case KeyKind::Int:
+                return first.native.i < second.native.i;
+            case KeyKind::Float:
+                return first.native.d < second.native.d;
+            case KeyKind::Str:
+                return first.order != second.order && PyUnicode_Compare( first.order, second.order ) < 0;
+            case KeyKind::Bytes:
+                return bytes_compare( first.order, second.order ) < 0;
+            default:
+                if( first.order == second.order )
+                    return false;
+                return atom::utils::safe_richcompare( first.order, second.order, Py_LT );
+        }
+    }
+
+    bool equal( const SortKey& first, const SortKey& second ) const
+    {
+        if( first.order == second.order )
+            return true;
+        switch( kind )
+        {
+            case KeyKind::Int:
+                return first.native.i == second.native.i;
+            case KeyKind::Float:
+                return first.native.d == second.native.d;
+            case KeyKind::Str:
+                return PyUnicode_Compare( first.order, second.order ) == 0;
+            case KeyKind::Bytes:
+                return bytes_compare( first.order, second.order ) == 0;
+            default:
+                return atom::utils::safe_richcompare( first.order, second.order, Py_EQ );
+        }
+    }
+
+    // All the operators are needed in order to keep the MSVC debug version
+    // of std::lower_bound happy.
+    bool operator()( const MapItem& first, const MapItem& second ) const
+    {
+        return less( first.sort_key(), second.sort_key() );
+    }
+
+    bool operator()( const MapItem& first, const SortKey& second ) const
+    {
+        return less( first.sort_key(), second );
+    }
+
+    bool operator()( const SortKey& first, const MapItem& second ) const
+    {
+        return less( first, second.sort_key() );
+    }
+
+    // Comparison of a key with the separators of an inner node.
+    bool operator()( const SortKey& first, const Separator& second ) const
+    {
+        return less( first, second.sort_key() );
+    }
+
+    bool operator()( const Separator& first, const SortKey& second ) const
+    {
+        return less( first.sort_key(), second );
+    }
+
+    KeyKind::Kind kind;
+};
+
+
+// Number of leading elements of a sorted array for which pred holds. The
+// search is branchless since mispredicted branches cost more than the cheap
+// comparisons of native keys.
+template<typename T, typename Pred>
+size_t
+partition_point( const T* first, size_t length, Pred pred )
+{
+    const T* base = first;
+    while( length > 1 )
+    {
+        size_t half = length / 2;
+        base = pred( base[ half ] ) ? base + half : base;
+        length -= half;
+    }
+    return ( base - first ) + ( length == 1 && pred( *base ) );
+}
+
+
+// Index of the first item or separator of a sorted array whose sort key is
+// not less than key, or greater than key if right is true.
+template<typename T>
+size_t
+sorted_bound( const std::vector<T>& array, const SortKey& key, const KeyOrder& order, bool right )
+{
+    const T* first = array.data();
+    size_t length = array.size();
+    switch( order.kind )
+    {
+        case KeyKind::Int:
+        {
+            long long value = key.native.i;
+            if( right )
+                return partition_point( first, length, [value]( const T& e ) { return !( value < e.native().i ); } );
+            return partition_point( first, length, [value]( const T& e ) { return e.native().i < value; } );
+        }
+        case KeyKind::Float:
+        {
+            double value = key.native.d;
+            if( right )
+                return partition_point( first, length, [value]( const T& e ) { return !( value < e.native().d ); } );
+            return partition_point( first, length, [value]( const T& e ) { return e.native().d < value; } );
+        }
+        default:
+            if( right )
+                return std::upper_bound( array.begin(), array.end(), key, order ) - array.begin();
+            return std::lower_bound( array.begin(), array.end(), key, order ) - array.begin();
+    }
+}
+
+
+// Draw a number never returned before, identifying a layout of a tree.
+inline uint64_t
+next_generation()
+{
+    static uint64_t generation = 0;
+    return ++generation;
+}
+
+
+// B+tree storing the items in sorted arrays held by leaves. A map fitting in
+// a single leaf is a plain sorted array, larger maps pay a few separator
+// comparisons to reach the leaf but insert and erase in O(log n) instead of
+// shifting all the following items. Inner nodes count the items under each
+// child so that items can also be reached by rank in O(log n).
+//
+// Nodes are reference counted so that snapshots share them with the tree
+// they were taken from. A mutation copies the shared nodes on the path to the
+// modified leaves, leaving the nodes seen by the other trees untouched.
+class MapTree
+{
+
+public:
+
+    static const size_t LeafMax = 64;
+
+    static const size_t InnerMax = 64;
+
+    struct Node
+    {
+        explicit Node( bool is_leaf ) : leaf( is_leaf ), refs( 1 ) {}
+
+        // A copy is owned by a single parent.
+        Node( const Node& other ) : leaf( other.leaf ), refs( 1 ) {}
+
+        bool leaf;
+        size_t refs;  // number of parents and trees holding the node
+    };
+
+    struct Leaf : Node
+    {
+        Leaf() : Node( true ) {}
+
+        std::vector<MapItem> items;
+    };
+
+    struct Inner : Node
+    {
+        Inner() : Node( false ) {}
+
+        // The children are shared with the copied node.
+        Inner( const Inner& other ) :
+            Node( other ), keys( other.keys ), children( other.children ),
+            counts( other.counts )
+        {
+            for( Node* child : children )
+                ++child->refs;
+        }
+
+        // keys[ i ] is the smallest key stored under children[ i + 1 ] and
+        // counts[ i ] the number of items stored under children[ i ].
+        std::vector<Separator> keys;
+        std::vector<Node*> children;
+        std::vector<size_t> counts;
+    };
+
+    // Location of an item in a leaf.
+    struct Position
+    {
+        Leaf* leaf;
+        size_t index;
+
+        MapItem& item() const
+        {
+            return leaf->items[ index ];
+        }
+    };
+
+    MapTree() : m_root( new Leaf() ), m_size( 0 ), m_generation( next_generation() ) {}
+
+    // Deep copy of a tree, sharing no node with it.
+    MapTree( const MapTree& other ) :
+        m_root( clone( other.m_root ) ), m_size( other.m_size ),
+        m_generation( next_generation() ) {}
+
+    ~MapTree()
+    {
+        release( m_root );
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    // Changes whenever nodes may have been modified, copied or freed, so
+    // that positions in the leaves can be cached until it changes.
+    uint64_t generation() const
+    {
+        return m_generation;
+    }
+
+    void swap( MapTree& other )
+    {
+        std::swap( m_root, other.m_root );
+        std::swap( m_size, other.m_size );
+        m_generation = next_generation();
+        other.m_generation = next_generation();
+    }
+
+    // Replace the content of the tree by that of another tree, sharing all
+    // its nodes in O(1).
+    void share( const MapTree& other )
+    {
+        ++other.m_root->refs;
+        release( m_root );
+        m_root = other.m_root;
+        m_size = other.m_size;
+        m_generation = next_generation();
+    }
+
+    // Call visitor with the items of each leaf in key order, stopping when
+    // it returns false.
+    template<typename Visitor>
+    bool each_leaf( Visitor& visitor ) const
+    {
+        return each_leaf( m_root, visitor );
+    }
+
+    // The item stored under key or null if there is none.
+    MapItem* find( const SortKey& key, const KeyOrder& order )
+    {
+        Node* node = m_root;
+        while( !node->leaf )
+        {
+            Inner* inner = static_cast<Inner*>( node );
+            node = inner->children[ child_index( inner, key, order ) ];
+        }
+        std::vector<MapItem>& items = static_cast<Leaf*>( node )->items;
+        size_t index = sorted_bound( items, key, order, false );
+        if( index == items.size() || !order.equal( items[ index ].sort_key(), key ) )
+            return 0;
+        return &items[ index ];
+    }
+
+    // The rank of the first item whose key is not less than key, or greater
+    // than key if right is true.
+    size_t bisect( const SortKey& key, bool right, const KeyOrder& order ) const
+    {
+        size_t rank = 0;
+        Node* node = m_root;
+        while( !node->leaf )
+        {
+            Inner* inner = static_cast<Inner*>( node );
+            // Equal keys may straddle a separator in a multiset, so the
+            // child is chosen with the same bound as the items.
+            size_t index = sorted_bound( inner->keys, key, order, right );
+            for( size_t i = 0; i < index; ++i )
+                rank += inner->counts[ i ];
+            node = inner->children[ index ];
+        }
+        return rank + sorted_bound( static_cast<Leaf*>( node )->items, key, order, right );
+    }
+
+    // The position of the item of the given rank, which must be valid.
+    Position at( size_t rank ) const
+    {
+        Node* node = m_root;
+        while( !node->leaf )
+        {
+            Inner* inner = static_cast<Inner*>( node );
+            size_t index = 0;
+            while( rank >= inner->counts[ index ] )
+                rank -= inner->counts[ index++ ];
+            node = inner->children[ index ];
+        }
+        Position position = { static_cast<Leaf*>( node ), rank };
+        return position;
+    }
+
+    // Insert an item or update the value of the item stored under its key.
+    // The replaced value, if any, is stored in old. Returns true if the item
+    // was inserted.
+    bool insert( MapItem& item, const KeyOrder& order, cppy::ptr& old )
+    {
+        return insert( item, order, old, true );
+    }
+
+    // Insert an item after the items stored under an equal key, if any.
+    void insert_equal( MapItem& item, const KeyOrder& order )
+    {
+        cppy::ptr old;
+        insert( item, order, old, false );
+    }
+
+    // Remove the item stored under key into removed, returns false if there
+    // is no such item. In a multiset, the first item found under key is
+    // removed.
+    bool erase( const SortKey& key, const KeyOrder& order, MapItem& removed )
+    {
+        bool min_changed = false;
+        m_generation = next_generation();
+        if( !erase( unshare( m_root ), key, order, removed, min_changed ) )
+            return false;
+        --m_size;
+        collapse_root();
+        return true;
+    }
+
+    // Fill an empty tree with items sorted by increasing keys, the
+    // items being moved out of the vector. Leaves and inner nodes are filled
+    // evenly so that they all hold at least half of their capacity.
+    void load_sorted( std::vector<MapItem>& items )
+    {
+        size_t total = items.size();
+        if( total == 0 )
+            return;
+        std::vector<Node*> level;
+        std::vector<MapItem*> mins;  // smallest item under each node
+        std::vector<size_t> counts;
+        size_t leaves = ( total + LeafMax - 1 ) / LeafMax;
+        std::vector<MapItem>::iterator it = items.begin();
+        for( size_t i = 0; i < leaves; ++i )
+        {
+            size_t take = total / leaves + ( i < total % leaves ? 1 : 0 );
+            Leaf* leaf = new Leaf();
+            leaf->items.assign( std::make_move_iterator( it ), std::make_move_iterator( it + take ) );
+            it += take;
+            level.push_back( leaf );
+            mins.push_back( &leaf->items.front() );
+            counts.push_back( take );
+        }
+        while( level.size() > 1 )
+        {
+            size_t size = level.size();
+            size_t groups = ( size + InnerMax ) / ( InnerMax + 1 );
+            std::vector<Node*> parents;
+            std::vector<MapItem*> parent_mins;
+            std::vector<size_t> parent_counts;
+            size_t index = 0;
+            for( size_t g = 0; g < groups; ++g )
+            {
+                size_t take = size / groups + ( g < size % groups ? 1 : 0 );
+                Inner* inner = new Inner();
+                size_t count = 0;
+                for( size_t j = index; j < index + take; ++j )
+                {
+                    if( j > index )
+                        inner->keys.push_back( Separator( *mins[ j ] ) );
+                    inner->children.push_back( level[ j ] );
+                    inner->counts.push_back( counts[ j ] );
+                    count += counts[ j ];
+                }
+                parents.push_back( inner );
+                parent_mins.push_back( mins[ index ] );
+                parent_counts.push_back( count );
+                index += take;
+            }
+            level.swap( parents );
+            mins.swap( parent_mins );
+            counts.swap( parent_counts );
+        }
+        release( m_root );
+        m_root = level.front();
+        m_size = total;
+        m_generation = next_generation();
+    }
+
+    // Move count items starting at the given rank into removed.
+    void erase_range( size_t rank, size_t count, std::vector<MapItem>& removed )
+    {
+        removed.reserve( removed.size() + count );
+        m_generation = next_generation();
+        while( count > 0 )
+        {
+            bool min_changed = false;
+            size_t done = erase_at( unshare( m_root ), rank, count, removed, min_changed );
+            m_size -= done;
+            count -= done;
+            collapse_root();
+        }
+    }
+
+    template<typename Visitor>
+    int visit( Visitor& visitor ) const
+    {
+        return visit( m_root, visitor );
+    }
+
+    size_t memory() const
+    {
+        return sizeof( MapTree ) + memory( m_root );
+    }
+
+private:
+
+    struct Split
+    {
+        Split() : right( 0 ), count( 0 ) {}
+
+        Separator key;
+        Node* right;
+        size_t count;  // number of items moved to the right node
+    };
+
+    // Insert an item, updating the item stored under an equal key if unique
+    // is true and inserting after the equal items otherwise.
+    bool insert( MapItem& item, const KeyOrder& order, cppy::ptr& old, bool unique )
+    {
+        Split split;
+        m_generation = next_generation();
+        bool inserted = insert( unshare( m_root ), item, order, split, old, unique );
+        if( inserted )
+            ++m_size;
+        if( split.right )
+        {
+            Inner* root = new Inner();
+            root->keys.push_back( split.key );
+            root->children.push_back( m_root );
+            root->children.push_back( split.right );
+            root->counts.push_back( m_size - split.count );
+            root->counts.push_back( split.count );
+            m_root = root;
+        }
+        return inserted;
+    }
+
+    static size_t child_index( Inner* inner, const SortKey& key, const KeyOrder& order )
+    {
+        return sorted_bound( inner->keys, key, order, true );
+    }
+
+    static MapItem& first_item( Node* node )
+    {
+        while( !node->leaf )
+            node = static_cast<Inner*>( node )->children.front();
+        return static_cast<Leaf*>( node )->items.front();
+    }
+
+    static size_t node_size( Node* node )
+    {
+        if( node->leaf )
+            return static_cast<Leaf*>( node )->items.size();
+        return static_cast<Inner*>( node )->children.size();
+    }
+
+    static size_t subtree_count( Node* node )
+    {
+        if( node->leaf )
+            return static_cast<Leaf*>( node )->items.size();
+        size_t count = 0;
+        for( size_t child_count : static_cast<Inner*>( node )->counts )
+            count += child_count;
+        return count;
+    }
+
+    // Return the node held by a slot, replacing it by a copy first if it is
+    // shared so that it can be modified without affecting other trees.
+    static Node* unshare( Node*& slot )
+    {
+        Node* node = slot;
+        if( node->refs == 1 )
+            return node;
+        if( node->leaf )
+            slot = new Leaf( *static_cast<Leaf*>( node ) );
+        else
+            slot = new Inner( *static_cast<Inner*>( node ) );
+        --node->refs;
+        return slot;
+    }
+
+    // Drop a reference to a node, freeing it with the nodes it holds alone
+    // once no parent or tree holds it.
+    static void release( Node* node )
+    {
+        if( --node->refs > 0 )
+            return;
+        if( node->leaf )
+        {
+            delete static_cast<Leaf*>( node );
+            return;
+        }
+        Inner* inner = static_cast<Inner*>( node );
+        for( Node* child : inner->children )
+            release( child );
+        delete inner;
+    }
+
+    template<typename Visitor>
+    static bool each_leaf( Node* node, Visitor& visitor )
+    {
+        if( node->leaf )
+            return visitor( static_cast<Leaf*>( node )->items );
+        for( Node* child : static_cast<Inner*>( node )->children )
+        {
+            if( !each_leaf( child, visitor ) )
+                return false;
+        }
+        return true;
+    }
+
+    void collapse_root()
+    {
+        if( !m_root->leaf && static_cast<Inner*>( m_root )->children.size() == 1 )
+        {
+            Inner* root = static_cast<Inner*>( m_root );
+            m_root = root->children.front();
+            root->children.clear();
+            delete root;
+        }
+    }
+
+    // Returns true if a new item was inserted, false if one was updated.
+    static bool insert( Node* node, MapItem& item, const KeyOrder& order, Split& split, cppy::ptr& old, bool unique )
+    {
+        SortKey key = item.sort_key();
+        if( node->leaf )
+        {
+            Leaf* leaf = static_cast<Leaf*>( node );
+            std::vector<MapItem>::iterator it = leaf->items.begin() +
+                sorted_bound( leaf->items, key, order, !unique );
+            if( unique && it != leaf->items.end() && order.equal( it->sort_key(), key ) )
+            {
+                old = it->update( item.value() );
+                return false;
+            }
+            // Cap the growth of the leaf to the item which triggers its split.
+            if( leaf->items.size() == leaf->items.capacity() && leaf->items.size() >= LeafMax / 2 )
+            {
+                size_t offset = it - leaf->items.begin();
+                leaf->items.reserve( LeafMax + 1 );
+                it = leaf->items.begin() + offset;
+            }
+            leaf->items.insert( it, std::move( item ) );
+            if( leaf->items.size() > LeafMax )
+                split_leaf( leaf, split );
+            return true;
+        }
+        Inner* inner = static_cast<Inner*>( node );
+        size_t index = child_index( inner, key, order );
+        Split child_split;
+        bool inserted = insert( unshare( inner->children[ index ] ), item, order, child_split, old, unique );
+        if( inserted )
+            ++inner->counts[ index ];
+        if( child_split.right )
+        {
+            inner->keys.insert( inner->keys.begin() + index, child_split.key );
+            inner->children.insert( inner->children.begin() + index + 1, child_split.right );
+            inner->counts[ index ] -= child_split.count;
+            inner->counts.insert( inner->counts.begin() + index + 1, child_split.count );
+            if( inner->keys.size() > InnerMax )
+                split_inner( inner, split );
+        }
+        return inserted;
+    }
+
+    static void split_leaf( Leaf* leaf, Split& split )
+    {
+        Leaf* right = new Leaf();
+        size_t half = leaf->items.size() / 2;
+        right->items.assign(
+            std::make_move_iterator( leaf->items.begin() + half ),
+            std::make_move_iterator( leaf->items.end() )
+        );
+        leaf->items.resize( half );
+        // Keys inserted in increasing order never reach the left leaf again,
+        // so it would keep the room of a full leaf for half of the items.
+        leaf->items.shrink_to_fit();
+        split.key = Separator( right->items.front() );
+        split.right = right;
+        split.count = right->items.size();
+    }
+
+    static void split_inner( Inner* inner, Split& split )
+    {
+        Inner* right = new Inner();
+        size_t mid = inner->keys.size() / 2;
+        split.key = inner->keys[ mid ];
+        right->keys.assign( inner->keys.begin() + mid + 1, inner->keys.end() );
+        right->children.assign( inner->children.begin() + mid + 1, inner->children.end() );
+        right->counts.assign( inner->counts.begin() + mid + 1, inner->counts.end() );
+        inner->keys.resize( mid );
+        inner->children.resize( mid + 1 );
+        inner->counts.resize( mid + 1 );
+        split.right = right;
+        split.count = subtree_count( right );
+    }
+
+    // min_changed reports that the smallest key of the subtree was removed,
+    // so that the separator referring to it can be replaced and no separator
+    // keeps a removed key alive.
+    static bool erase( Node* node, const SortKey& key, const KeyOrder& order, MapItem& removed, bool& min_changed )
+    {
+        if( node->leaf )
+        {
+            std::vector<MapItem>& items = static_cast<Leaf*>( node )->items;
+            std::vector<MapItem>::iterator it = items.begin() + sorted_bound( items, key, order, false );
+            if( it == items.end() || !order.equal( it->sort_key(), key ) )
+                return false;
+            removed = std::move( *it );
+            min_changed = it == items.begin();
+            items.erase( it );
+            return true;
+        }
+        Inner* inner = static_cast<Inner*>( node );
+        size_t index = child_index( inner, key, order );
+        if( !erase( unshare( inner->children[ index ] ), key, order, removed, min_changed ) )
+            return false;
+        --inner->counts[ index ];
+        fix_child( inner, index, min_changed );
+        return true;
+    }
+
+    // Remove up to count items from the leaf holding the item of the given
+    // rank and return the number of removed items.
+    static size_t erase_at( Node* node, size_t rank, size_t count, std::vector<MapItem>& removed, bool& min_changed )
+    {
+        if( node->leaf )
+        {
+            std::vector<MapItem>& items = static_cast<Leaf*>( node )->items;
+            size_t done = std::min( count, items.size() - rank );
+            removed.insert(
+                removed.end(),
+                std::make_move_iterator( items.begin() + rank ),
+                std::make_move_iterator( items.begin() + rank + done )
+            );
+            items.erase( items.begin() + rank, items.begin() + rank + done );
+            min_changed = rank == 0;
+            return done;
+        }
+        Inner* inner = static_cast<Inner*>( node );
+        size_t index = 0;
+        while( rank >= inner->counts[ index ] )
+            rank -= inner->counts[ index++ ];
+        size_t done = erase_at( unshare( inner->children[ index ] ), rank, count, removed, min_changed );
+        inner->counts[ index ] -= done;
+        fix_child( inner, index, min_changed );
+        return done;
+    }
+
+    // Restore the separator and the size invariants after items were removed
+    // from children[ index ].
+    static void fix_child( Inner* inner, size_t index, bool& min_changed )
+    {
+        Node* child = inner->children[ index ];
+        if( min_changed && index > 0 )
+        {
+            if( inner->counts[ index ] > 0 )
+                inner->keys[ index - 1 ] = Separator( first_item( child ) );
+            min_changed = false;
+        }
+        size_t min_size = child->leaf ? LeafMax / 2 : InnerMax / 2;
+        if( node_size( child ) < min_size && inner->children.size() > 1 )
+            rebalance( inner, index > 0 ? index - 1 : index );
+    }
+
+    // Merge or balance the siblings children[ index ] and children[ index + 1 ].
+    static void rebalance( Inner* inner, size_t index )
+    {
+        Node* first = unshare( inner->children[ index ] );
+        Node* second = unshare( inner->children[ index + 1 ] );
+        if( first->leaf )
+        {
+            Leaf* left = static_cast<Leaf*>( first );
+            Leaf* right = static_cast<Leaf*>( second );
+            size_t total = left->items.size() + right->items.size();
+            if( total <= LeafMax )
+            {
+                left->items.insert(
+                    left->items.end(),
+                    std::make_move_iterator( right->items.begin() ),
+                    std::make_move_iterator( right->items.end() )
+                );
+                remove_child( inner, index );
+                delete right;
+                return;
+            }
+            size_t target = total / 2;
+            if( left->items.size() < target )
+            {
+                size_t count = target - left->items.size();
+                left->items.insert(
+                    left->items.end(),
+                    std::make_move_iterator( right->items.begin() ),
+                    std::make_move_iterator( right->items.begin() + count )
+                );
+                right->items.erase( right->items.begin(), right->items.begin() + count );
+            }
+            else
+            {
+                size_t count = left->items.size() - target;
+                right->items.insert(
+                    right->items.begin(),
+                    std::make_move_iterator( left->items.end() - count ),
+                    std::make_move_iterator( left->items.end() )
+                );
+                left->items.resize( target );
+            }
+            inner->keys[ index ] = Separator( right->items.front() );
+            inner->counts[ index ] = left->items.size();
+            inner->counts[ index + 1 ] = right->items.size();
+            return;
+        }
+        Inner* left = static_cast<Inner*>( first );
+        Inner* right = static_cast<Inner*>( second );
+        if( left->keys.size() + right->keys.size() + 1 <= InnerMax )
+        {
+            left->keys.push_back( inner->keys[ index ] );
+            left->keys.insert( left->keys.end(), right->keys.begin(), right->keys.end() );
+            left->children.insert( left->children.end(), right->children.begin(), right->children.end() );
+            left->counts.insert( left->counts.end(), right->counts.begin(), right->counts.end() );
+            right->children.clear();
+            remove_child( inner, index );
+            delete right;
+            return;
+        }
+        // Rotate children through the separator until both sides are even.
+        while( left->children.size() + 1 < right->children.size() )
+        {
+            left->keys.push_back( inner->keys[ index ] );
+            left->children.push_back( right->children.front() );
+            left->counts.push_back( right->counts.front() );
+            inner->keys[ index ] = right->keys.front();
+            right->keys.erase( right->keys.begin() );
+            right->children.erase( right->children.begin() );
+            right->counts.erase( right->counts.begin() );
+        }
+        while( right->children.size() + 1 < left->children.size() )
+        {
+            right->keys.insert( right->keys.begin(), inner->keys[ index ] );
+            right->children.insert( right->children.begin(), left->children.back() );
+            right->counts.insert( right->counts.begin(), left->counts.back() );
+            inner->keys[ index ] = left->keys.back();
+            left->keys.pop_back();
+            left->children.pop_back();
+            left->counts.pop_back();
+        }
+        inner->counts[ index ] = subtree_count( left );
+        inner->counts[ index + 1 ] = subtree_count( right );
+    }
+
+    // Drop children[ index + 1 ] once merged into children[ index ].
+    static void remove_child( Inner* inner, size_t index )
+    {
+        inner->counts[ index ] += inner->counts[ index + 1 ];
+        inner->keys.erase( inner->keys.begin() + index );
+        inner->children.erase( inner->children.begin() + index + 1 );
+        inner->counts.erase( inner->counts.begin() + index + 1 );
+    }
+
+    static Node* clone( Node* node )
+    {
+        if( node->leaf )
+            return new Leaf( *static_cast<Leaf*>( node ) );
+        Inner* source = static_cast<Inner*>( node );
+        Inner* inner = new Inner();
+        inner->keys = source->keys;
+        inner->counts = source->counts;
+        inner->children.reserve( source->children.size() );
+        for( Node* child : source->children )
+            inner->children.push_back( clone( child ) );
+        return inner;
+    }
+
+    // The objects held by shared nodes are not visited since the garbage
+    // collector expects each reference to be reported once. Reference cycles
+    // going through them are thus only collected once the nodes are no longer
+    // shared.
+    template<typename Visitor>
+    static int visit( Node* node, Visitor& visitor )
+    {
+        if( node->refs > 1 )
+            return 0;
+        if( node->leaf )
+        {
+            for( MapItem& item : static_cast<Leaf*>( node )->items )
+            {
+                if( int res = visitor( item.key() ) )
+                    return res;
+                if( int res = visitor( item.value() ) )
+                    return res;
+                if( int res = visitor( item.order() ) )
+                    return res;
+            }
+            return 0;
+        }
+        Inner* inner = static_cast<Inner*>( node );
+        for( Separator& key : inner->keys )
+        {
+            if( int res = visitor( key.sort_key().order ) )
+                return res;
+        }
+        for( Node* child : inner->children )
+        {
+            if( int res = visit( child, visitor ) )
+                return res;
+        }
+        return 0;
+    }
+
+    static size_t memory( Node* node )
+    {
+        if( node->leaf )
+            return sizeof( Leaf ) + sizeof( MapItem ) * static_cast<Leaf*>( node )->items.capacity();
+        Inner* inner = static_cast<Inner*>( node );
+        size_t size = sizeof( Inner ) + sizeof( Separator ) * inner->keys.capacity() +
+            sizeof( Node* ) * inner->children.capacity() +
+            sizeof( size_t ) * inner->counts.capacity();
+        for( Node* child : inner->children )
+            size += memory( child );
+        return size;
+    }
+
+    Node* m_root;
+    size_t m_size;
+    uint64_t m_generation;
+};
+
+
+// Sort key of a key looked up in or added to a map, owning the result of the
+// key function of the map if any.
+class KeyProbe
+{
+
+public:
+
+    // Returns false if the key function raised.
+    bool init( PyObject* key, PyObject* keyfunc )
+    {
+        m_sort.order = key;
+        if( keyfunc )
+        {
+            m_owner = PyObject_CallOneArg( keyfunc, key );
+            if( !m_owner )
+                return false;
+            m_sort.order = m_owner.get();
+        }
+        m_kind = classify_key( m_sort.order, m_sort.native );
+        return true;
+    }
+
+    const SortKey& sort_key() const
+    {
+        return m_sort;
+    }
+
+    KeyKind::Kind kind() const
+    {
+        return m_kind;
+    }
+
+private:
+
+    cppy::ptr m_owner;
+    SortKey m_sort;
+    KeyKind::Kind m_kind;
+};
+
+}  // namespace sortedtree
+
+}  // namespace atom
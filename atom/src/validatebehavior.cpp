@@ -10,9 +10,13 @@
 #include <sstream>
 #include <cppy/cppy.h>
 #include "member.h"
+#include "atomdeque.h"
+#include "atomintset.h"
 #include "atomlist.h"
+#include "atomnumlist.h"
 #include "atomdict.h"
 #include "atomset.h"
+#include "atomsortedmap.h"
 
 
 namespace atom
@@ -61,6 +65,7 @@ Member::check_context( Validate::Mode mode, PyObject* context )
         case Validate::List:
         case Validate::ContainerList:
         case Validate::Set:
+        case Validate::ContainerSet:
             if( context != Py_None && !Member::TypeCheck( context ) )
             {
                 cppy::type_error( context, "Member or None" );
@@ -87,6 +92,8 @@ Member::check_context( Validate::Mode mode, PyObject* context )
             break;
         }
         case Validate::Dict:
+        case Validate::ContainerDict:
+        case Validate::SortedMap:
         {
             if( !PyTuple_Check( context ) )
             {
@@ -144,6 +151,40 @@ Member::check_context( Validate::Mode mode, PyObject* context )
             }
             break;
         }
+        case Validate::NumericList:
+        {
+            NumericKind::Kind kind;
+            if( !AtomNumList::KindFromType( context, kind ) )
+            {
+                cppy::type_error( context, "int, float or bool" );
+                return false;
+            }
+            break;
+        }
+        case Validate::Deque:
+        {
+            if( !PyTuple_Check( context ) || PyTuple_GET_SIZE( context ) != 2 )
+            {
+                cppy::type_error( context, "2-tuple of Member or None and int" );
+                return false;
+            }
+            PyObject* item = PyTuple_GET_ITEM( context, 0 );
+            PyObject* maxlen = PyTuple_GET_ITEM( context, 1 );
+            if( ( item != Py_None && !Member::TypeCheck( item ) ) || !PyLong_Check( maxlen ) )
+            {
+                cppy::type_error( context, "2-tuple of Member or None and int" );
+                return false;
+            }
+            Py_ssize_t size = PyLong_AsSsize_t( maxlen );
+            if( size == -1 && PyErr_Occurred() )
+                return false;
+            if( size < 1 )
+            {
+                cppy::value_error( "maxlen must be positive" );
+                return false;
+            }
+            break;
+        }
         case Validate::OptionalInstance:
         case Validate::Instance:
         case Validate::Subclass:
@@ -225,11 +266,12 @@ Member::check_context( Validate::Mode mode, PyObject* context )
                 cppy::type_error( context, "2-tuple of (type, callable)" );
                 return false;
             }
-            if( PyTuple_GET_SIZE( context ) != 2 )
+            if( PyTuple_GET_SIZE( context ) != 2 && PyTuple_GET_SIZE( context ) != 3 )
             {
                 PyErr_Format(
                     PyExc_TypeError,
-                    "Expected 2-tuple of (type, callable). Got a tuple of length %d instead.",
+                    "Expected 2-tuple of (type, callable) or 3-tuple of "
+                    "(type, callable, int). Got a tuple of length %d instead.",
                     PyTuple_GET_SIZE( context )
                 );
                 return false;
@@ -245,6 +287,23 @@ Member::check_context( Validate::Mode mode, PyObject* context )
                 cppy::type_error( context, "2-tuple of (type, callable)" );
                 return false;
             }
+            if( PyTuple_GET_SIZE( context ) == 3 )
+            {
+                PyObject* cache_size = PyTuple_GET_ITEM( context, 2 );
+                if( !PyLong_Check( cache_size ) )
+                {
+                    cppy::type_error( context, "3-tuple of (type, callable, int)" );
+                    return false;
+                }
+                Py_ssize_t size = PyLong_AsSsize_t( cache_size );
+                if( size == -1 && PyErr_Occurred() )
+                    return false;
+                if( size < 0 )
+                {
+                    cppy::value_error( "the cache size of a Coerced must be positive or 0" );
+                    return false;
+                }
+            }
             break;
         }
         case Validate::Delegate:
@@ -274,6 +333,403 @@ namespace
 {
 
 
+// Hashed membership index for the items of an Enum. Unhashable items are
+// kept aside and are checked by equality as a plain sequence scan would.
+class EnumIndex : public ValidateCache
+{
+
+public:
+
+    static bool Create( PyObject* items, ValidateCache** cache )
+    {
+        // Only immutable sequences are indexed, since the index would get
+        // out of sync with a mutable one.
+        if( !PyTuple_CheckExact( items ) )
+            return true;
+        cppy::ptr hashed( PyFrozenSet_New( 0 ) );
+        if( !hashed )
+            return false;
+        cppy::ptr unhashed( PyList_New( 0 ) );
+        if( !unhashed )
+            return false;
+        Py_ssize_t size = PyTuple_GET_SIZE( items );
+        for( Py_ssize_t i = 0; i < size; ++i )
+        {
+            PyObject* item = PyTuple_GET_ITEM( items, i );
+            if( PyObject_Hash( item ) == -1 )
+            {
+                PyErr_Clear();
+                if( PyList_Append( unhashed.get(), item ) != 0 )
+                    return false;
+            }
+            else if( PySet_Add( hashed.get(), item ) != 0 )
+                return false;
+        }
+        EnumIndex* index = new EnumIndex();
+        index->m_hashed = hashed;
+        if( PyList_GET_SIZE( unhashed.get() ) > 0 )
+            index->m_unhashed = PyList_AsTuple( unhashed.get() );
+        *cache = index;
+        return true;
+    }
+
+    int contains( PyObject* items, PyObject* value )
+    {
+        // An unhashable value can only be found by comparing it to every item.
+        if( PyObject_Hash( value ) == -1 )
+        {
+            PyErr_Clear();
+            return PySequence_Contains( items, value );
+        }
+        int res = PySet_Contains( m_hashed.get(), value );
+        if( res != 0 || !m_unhashed )
+            return res;
+        return PySequence_Contains( m_unhashed.get(), value );
+    }
+
+    int traverse( visitproc visit, void* arg )
+    {
+        Py_VISIT( m_hashed.get() );
+        Py_VISIT( m_unhashed.get() );
+        return 0;
+    }
+
+private:
+
+    cppy::ptr m_hashed;
+    cppy::ptr m_unhashed;
+};
+
+
+// Return the current version tag of a type or 0 if it has none.
+inline unsigned int
+type_version_tag( PyTypeObject* type )
+{
+#if PY_VERSION_HEX >= 0x030C0000
+    if( type->tp_version_tag == 0 )
+        PyUnstable_Type_AssignVersionTag( type );
+    return type->tp_version_tag;
+#else
+    if( !PyType_HasFeature( type, Py_TPFLAGS_VALID_VERSION_TAG ) )
+        return 0;
+    return type->tp_version_tag;
+#endif
+}
+
+
+// Small cache of the types known to pass an isinstance/issubclass check
+// against a type or tuple of types. Each entry is tagged with the version of
+// the type when it was added, which is reset by CPython whenever the type or
+// one of its bases is modified. Only positive results are cached, since the
+// registration of virtual subclasses on an ABC can turn a failure into a
+// success but never the reverse.
+class TypeCheckCache : public ValidateCache
+{
+
+public:
+
+    static bool Create( PyObject* kind, ValidateCache** cache )
+    {
+        // Caching is only safe if the checks performed by the metaclasses
+        // depend solely on the tested type.
+        cppy::ptr abc( PyImport_ImportModule( "abc" ) );
+        if( !abc )
+            return false;
+        cppy::ptr abcmeta( abc.getattr( "ABCMeta" ) );
+        if( !abcmeta )
+            return false;
+        if( PyTuple_Check( kind ) )
+        {
+            Py_ssize_t size = PyTuple_GET_SIZE( kind );
+            for( Py_ssize_t i = 0; i < size; ++i )
+            {
+                if( !is_cacheable( PyTuple_GET_ITEM( kind, i ), abcmeta.get() ) )
+                    return true;
+            }
+        }
+        else if( !is_cacheable( kind, abcmeta.get() ) )
+            return true;
+        *cache = new TypeCheckCache();
+        return true;
+    }
+
+    ~TypeCheckCache()
+    {
+        for( size_t i = 0; i < Size; ++i )
+            Py_CLEAR( m_entries[ i ].type );
+    }
+
+    bool contains( PyTypeObject* type )
+    {
+        for( size_t i = 0; i < Size; ++i )
+        {
+            Entry& entry = m_entries[ i ];
+            if( entry.type == type )
+                return entry.tag != 0 && entry.tag == type_version_tag( type );
+        }
+        return false;
+    }
+
+    // Record that a value of the given type passed an isinstance check.
+    // The type is only added if its subclass relationship accounts for the
+    // result, since isinstance also consults the __class__ of the instance.
+    // Returns -1 on error.
+    int add_instance_type( PyTypeObject* type, PyObject* kind )
+    {
+        int res = PyObject_IsSubclass( pyobject_cast( type ), kind );
+        if( res == 1 )
+            add( type );
+        return res < 0 ? -1 : 0;
+    }
+
+    void add( PyTypeObject* type )
+    {
+        unsigned int tag = type_version_tag( type );
+        if( tag == 0 )
+            return;
+        Entry& entry = m_entries[ m_next ];
+        m_next = ( m_next + 1 ) % Size;
+        PyObject* old = pyobject_cast( entry.type );
+        entry.type = pytype_cast( cppy::incref( pyobject_cast( type ) ) );
+        entry.tag = tag;
+        Py_XDECREF( old );
+    }
+
+    int traverse( visitproc visit, void* arg )
+    {
+        for( size_t i = 0; i < Size; ++i )
+            Py_VISIT( m_entries[ i ].type );
+        return 0;
+    }
+
+private:
+
+    static const size_t Size = 8;
+
+    struct Entry
+    {
+        PyTypeObject* type;
+        unsigned int tag;
+    };
+
+    TypeCheckCache() : m_next( 0 )
+    {
+        for( size_t i = 0; i < Size; ++i )
+        {
+            m_entries[ i ].type = 0;
+            m_entries[ i ].tag = 0;
+        }
+    }
+
+    static bool is_cacheable( PyObject* kind, PyObject* abcmeta )
+    {
+        PyObject* meta = pyobject_cast( Py_TYPE( kind ) );
+        return meta == pyobject_cast( &PyType_Type ) || meta == abcmeta;
+    }
+
+    Entry m_entries[ Size ];
+    size_t m_next;
+};
+
+
+// Cache used by Coerced. It combines the type check cache of the kind with
+// an optional bounded LRU cache of the coerced values, keyed by the type and
+// value of the input so that equal values of different types (1, 1.0 and
+// True) are coerced independently.
+class CoercedCache : public ValidateCache
+{
+
+public:
+
+    static bool Create( PyObject* context, ValidateCache** cache )
+    {
+        ValidateCache* types = 0;
+        if( !TypeCheckCache::Create( PyTuple_GET_ITEM( context, 0 ), &types ) )
+            return false;
+        Py_ssize_t capacity = 0;
+        if( PyTuple_GET_SIZE( context ) == 3 )
+            capacity = PyLong_AsSsize_t( PyTuple_GET_ITEM( context, 2 ) );
+        CoercedCache* coerced = new CoercedCache( static_cast<TypeCheckCache*>( types ), capacity );
+        if( capacity > 0 )
+        {
+            coerced->m_values = PyDict_New();
+            if( !coerced->m_values )
+            {
+                coerced->decref();
+                return false;
+            }
+        }
+        *cache = coerced;
+        return true;
+    }
+
+    ~CoercedCache()
+    {
+        if( m_types )
+            m_types->decref();
+    }
+
+    TypeCheckCache* types()
+    {
+        return m_types;
+    }
+
+    // Build the key under which the coerced value is stored. Returns a null
+    // pointer without an exception set if the value cannot be cached.
+    PyObject* key( PyObject* value )
+    {
+        if( !m_values )
+            return 0;
+        if( PyObject_Hash( value ) == -1 )
+        {
+            PyErr_Clear();
+            return 0;
+        }
+        return PyTuple_Pack( 2, pyobject_cast( Py_TYPE( value ) ), value );
+    }
+
+    // Lookup the coerced value stored for a key. Returns a new reference or a
+    // null pointer, with an exception set only on failure.
+    PyObject* lookup( PyObject* key )
+    {
+        cppy::ptr value( cppy::xincref( PyDict_GetItemWithError( m_values.get(), key ) ) );
+        if( !value )
+        {
+            if( !PyErr_Occurred() )
+                ++m_misses;
+            return 0;
+        }
+        ++m_hits;
+        // Move the entry to the end of the dict which is kept in LRU order.
+        if( PyDict_DelItem( m_values.get(), key ) != 0 ||
+            PyDict_SetItem( m_values.get(), key, value.get() ) != 0 )
+            return 0;
+        return value.release();
+    }
+
+    bool store( PyObject* key, PyObject* value )
+    {
+        if( PyDict_SetItem( m_values.get(), key, value ) != 0 )
+            return false;
+        while( PyDict_GET_SIZE( m_values.get() ) > m_capacity )
+        {
+            Py_ssize_t pos = 0;
+            PyObject* oldest;
+            PyObject* unused;
+            if( !PyDict_Next( m_values.get(), &pos, &oldest, &unused ) )
+                break;  // LCOV_EXCL_LINE
+            cppy::ptr oldptr( cppy::incref( oldest ) );
+            if( PyDict_DelItem( m_values.get(), oldptr.get() ) != 0 )
+                return false;
+        }
+        return true;
+    }
+
+    void clear()
+    {
+        if( m_values )
+            PyDict_Clear( m_values.get() );
+        m_hits = 0;
+        m_misses = 0;
+    }
+
+    PyObject* info()
+    {
+        return Py_BuildValue(
+            "(nnnn)",
+            m_hits,
+            m_misses,
+            m_capacity,
+            m_values ? PyDict_GET_SIZE( m_values.get() ) : Py_ssize_t( 0 )
+        );
+    }
+
+    int traverse( visitproc visit, void* arg )
+    {
+        Py_VISIT( m_values.get() );
+        return m_types ? m_types->traverse( visit, arg ) : 0;
+    }
+
+private:
+
+    CoercedCache( TypeCheckCache* types, Py_ssize_t capacity ) :
+        m_types( types ), m_capacity( capacity ), m_hits( 0 ), m_misses( 0 ) {}
+
+    TypeCheckCache* m_types;
+    cppy::ptr m_values;
+    Py_ssize_t m_capacity;
+    Py_ssize_t m_hits;
+    Py_ssize_t m_misses;
+};
+
+
+// Native copy of the bounds of a Range whose bounds are exact ints fitting
+// in a long long. Exact int values fitting in a long long are then validated
+// without going through the rich comparison machinery.
+class RangeBounds : public ValidateCache
+{
+
+public:
+
+    static bool Create( PyObject* bounds, ValidateCache** cache )
+    {
+        RangeBounds* native = new RangeBounds();
+        if( !native_bound( PyTuple_GET_ITEM( bounds, 0 ), native->m_has_low, native->m_low ) ||
+            !native_bound( PyTuple_GET_ITEM( bounds, 1 ), native->m_has_high, native->m_high ) )
+        {
+            native->decref();
+            return !PyErr_Occurred();
+        }
+        *cache = native;
+        return true;
+    }
+
+    // Compare an exact int to the bounds. Returns -1 if the value is too
+    // small, 1 if it is too large, 0 if it is in range and 2 if the value
+    // does not fit in a long long and should be compared as an object.
+    int compare( PyObject* value )
+    {
+        int overflow;
+        long long v = PyLong_AsLongLongAndOverflow( value, &overflow );
+        if( overflow != 0 )
+            return 2;
+        if( m_has_low && v < m_low )
+            return -1;
+        if( m_has_high && v > m_high )
+            return 1;
+        return 0;
+    }
+
+    int traverse( visitproc visit, void* arg )
+    {
+        return 0;
+    }
+
+private:
+
+    RangeBounds() : m_low( 0 ), m_high( 0 ), m_has_low( false ), m_has_high( false ) {}
+
+    static bool native_bound( PyObject* bound, bool& has_bound, long long& value )
+    {
+        if( bound == Py_None )
+            return true;
+        if( !PyLong_CheckExact( bound ) )
+            return false;
+        int overflow;
+        value = PyLong_AsLongLongAndOverflow( bound, &overflow );
+        if( value == -1 && PyErr_Occurred() )
+            return false;
+        has_bound = overflow == 0;
+        return has_bound;
+    }
+
+    long long m_low;
+    long long m_high;
+    bool m_has_low;
+    bool m_has_high;
+};
+
+
 std::string name_from_type_tuple_types( PyObject* type_tuple_types )
 {
     // This should never be used if the input can be something else than a type
@@ -305,6 +761,8 @@ std::string name_from_type_tuple_types( PyObject* type_tuple_types )
 PyObject*
 validate_type_fail( Member* member, CAtom* atom, PyObject* newvalue, const char* type )
 {
+    if( QuietValidation::fail( member, atom, PyExc_TypeError ) )
+        return 0;
     PyErr_Format(
         PyExc_TypeError,
         "The '%s' member on the '%s' object must be of type '%s'. "
@@ -318,6 +776,32 @@ validate_type_fail( Member* member, CAtom* atom, PyObject* newvalue, const char*
 }
 
 
+// Variant for a type or tuple of types whose name is only built when the
+// message is actually needed.
+PyObject*
+validate_type_fail( Member* member, CAtom* atom, PyObject* newvalue, PyObject* kind )
+{
+    if( QuietValidation::fail( member, atom, PyExc_TypeError ) )
+        return 0;
+    return validate_type_fail( member, atom, newvalue, name_from_type_tuple_types( kind ).c_str() );
+}
+
+
+PyObject*
+range_fail( Member* member, CAtom* atom, const char* bound )
+{
+    if( QuietValidation::fail( member, atom, PyExc_ValueError ) )
+        return 0;
+    return PyErr_Format(
+        PyExc_ValueError,
+        "range value for '%s' of '%s' too %s",
+        PyUnicode_AsUTF8( member->name ),
+        Py_TYPE( pyobject_cast( atom ) )->tp_name,
+        bound
+    );
+}
+
+
 PyObject*
 no_op_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
 {
@@ -450,60 +934,101 @@ str_promote_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject*
 }
 
 
-PyObject*
-tuple_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
+// Validate the items of a tuple using the member returned by get_member for
+// each index. An exact tuple whose items all validate to themselves is
+// returned as is, otherwise a new tuple is allocated when the first item is
+// altered (or upfront for tuple subclasses).
+template<typename GetMember> PyObject*
+validate_tuple_items( Member* member, CAtom* atom, PyObject* tuple, GetMember get_member )
 {
-    if( !PyTuple_Check( newvalue ) )
+    Py_ssize_t size = PyTuple_GET_SIZE( tuple );
+    cppy::ptr tuplecopy;
+    Py_ssize_t copied = 0;
+    if( !PyTuple_CheckExact( tuple ) )
     {
-        return validate_type_fail( member, atom, newvalue, "tuple" );
+        tuplecopy = PyTuple_New( size );
+        if( !tuplecopy )
+        {
+            return 0;
+        }
     }
-    cppy::ptr tupleptr( cppy::incref( newvalue ) );
-    if( member->validate_context != Py_None )
+    for( Py_ssize_t i = 0; i < size; ++i )
     {
-        Py_ssize_t size = PyTuple_GET_SIZE( newvalue );
-        cppy::ptr tuplecopy = PyTuple_New( size );
-        if( !tuplecopy )
+        PyObject* item = PyTuple_GET_ITEM( tuple, i );
+        Member* item_member = get_member( i );
+        cppy::ptr valid_item;
+        {
+            QuietValidation quiet( member, atom, item_member );
+            valid_item = item_member->full_validate( atom, Py_None, item );
+        }
+        if( !valid_item )
         {
             return 0;
         }
-        Member* item_member = member_cast( member->validate_context );
-        for( Py_ssize_t i = 0; i < size; ++i )
+        if( !tuplecopy && valid_item.get() == item )
         {
-            cppy::ptr item( cppy::incref( PyTuple_GET_ITEM( tupleptr.get(), i ) ) );
-            cppy::ptr valid_item( item_member->full_validate( atom, Py_None, item.get() ) );
-            if( !valid_item )
+            continue;
+        }
+        if( !tuplecopy )
+        {
+            tuplecopy = PyTuple_New( size );
+            if( !tuplecopy )
             {
                 return 0;
             }
-            PyTuple_SET_ITEM( tuplecopy.get(), i, valid_item.release() );
         }
-        tupleptr = tuplecopy;
+        // Fill in the items skipped while the tuple was left untouched.
+        for( ; copied < i; ++copied )
+        {
+            PyTuple_SET_ITEM( tuplecopy.get(), copied, cppy::incref( PyTuple_GET_ITEM( tuple, copied ) ) );
+        }
+        PyTuple_SET_ITEM( tuplecopy.get(), i, valid_item.release() );
+        copied = i + 1;
     }
-    return tupleptr.release();
+    if( !tuplecopy )
+    {
+        return cppy::incref( tuple );
+    }
+    return tuplecopy.release();
 }
 
 
 PyObject*
-fixed_tuple_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
+tuple_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
 {
     if( !PyTuple_Check( newvalue ) )
     {
         return validate_type_fail( member, atom, newvalue, "tuple" );
     }
+    if( member->validate_context == Py_None )
+    {
+        return cppy::incref( newvalue );
+    }
+    // Keep the tuple alive since validating its items may run arbitrary code.
     cppy::ptr tupleptr( cppy::incref( newvalue ) );
+    Member* item_member = member_cast( member->validate_context );
+    return validate_tuple_items(
+        member, atom, tupleptr.get(), [item_member]( Py_ssize_t ) { return item_member; }
+    );
+}
 
-    // Create a copy in which to store the validated values
-    Py_ssize_t size = PyTuple_GET_SIZE( newvalue );
-    cppy::ptr tuplecopy = PyTuple_New( size );
-    if( !tuplecopy )
+
+PyObject*
+fixed_tuple_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
+{
+    if( !PyTuple_Check( newvalue ) )
     {
-        return 0;
+        return validate_type_fail( member, atom, newvalue, "tuple" );
     }
+    cppy::ptr tupleptr( cppy::incref( newvalue ) );
 
     // Check the size match the expected size
+    Py_ssize_t size = PyTuple_GET_SIZE( newvalue );
     Py_ssize_t expected_size = PyTuple_GET_SIZE( member->validate_context );
     if( size != expected_size )
     {
+        if( QuietValidation::fail( member, atom, PyExc_TypeError ) )
+            return 0;
         PyErr_Format(
             PyExc_TypeError,
             "The '%s' member on the '%s' object must be of a '%d-tuple'. "
@@ -517,19 +1042,104 @@ fixed_tuple_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject*
     }
 
     // Validate each single item
-    for( Py_ssize_t i = 0; i < size; ++i )
+    PyObject* item_members = member->validate_context;
+    return validate_tuple_items(
+        member,
+        atom,
+        tupleptr.get(),
+        [item_members]( Py_ssize_t i ) { return member_cast( PyTuple_GET_ITEM( item_members, i ) ); }
+    );
+}
+
+
+// Validate modes whose result only depends on the value and the context and
+// which return the value itself, or an immutable object, when it is valid.
+// Container modes are excluded since they build a new container bound to the
+// atom for each value.
+bool is_pure_validate_mode( Validate::Mode mode )
+{
+    switch( mode )
     {
-        Member* item_member = member_cast( PyTuple_GET_ITEM( member->validate_context, i ) );
-        cppy::ptr item( cppy::incref( PyTuple_GET_ITEM( tupleptr.get(), i ) ) );
-        cppy::ptr valid_item( item_member->full_validate( atom, Py_None, item.get() ) );
-        if( !valid_item )
+        case Validate::List:
+        case Validate::ContainerList:
+        case Validate::Set:
+        case Validate::ContainerSet:
+        case Validate::Dict:
+        case Validate::ContainerDict:
+        case Validate::DefaultDict:
+        case Validate::NumericList:
+        case Validate::IntSet:
+        case Validate::SortedMap:
+        case Validate::Deque:
+        case Validate::Delegate:
+        case Validate::ObjectMethod_OldNew:
+        case Validate::ObjectMethod_NameOldNew:
+        case Validate::MemberMethod_ObjectOldNew:
+            return false;
+        default:
+            return true;
+    }
+}
+
+
+bool equivalent_contexts( PyObject* first, PyObject* second )
+{
+    if( Member::TypeCheck( first ) )
+        return Member::TypeCheck( second ) &&
+            Member::equivalent_validators( member_cast( first ), member_cast( second ) );
+    if( first == second )
+        return true;
+    if( Py_TYPE( first ) != Py_TYPE( second ) )
+        return false;
+    if( PyTuple_CheckExact( first ) )
+    {
+        Py_ssize_t size = PyTuple_GET_SIZE( first );
+        if( PyTuple_GET_SIZE( second ) != size )
+            return false;
+        for( Py_ssize_t i = 0; i < size; ++i )
         {
-            return 0;
+            if( !equivalent_contexts( PyTuple_GET_ITEM( first, i ), PyTuple_GET_ITEM( second, i ) ) )
+                return false;
         }
-        PyTuple_SET_ITEM( tuplecopy.get(), i, valid_item.release() );
+        return true;
+    }
+    if( PyLong_CheckExact( first ) || PyFloat_CheckExact( first ) ||
+        PyUnicode_CheckExact( first ) || PyBytes_CheckExact( first ) )
+    {
+        int res = PyObject_RichCompareBool( first, second, Py_EQ );
+        if( res < 0 )
+            PyErr_Clear();  // LCOV_EXCL_LINE
+        return res == 1;
     }
-    tupleptr = tuplecopy;
-    return tupleptr.release();
+    return false;
+}
+
+
+// Whether the items of a container validated by source_validator can be
+// used as is by a container validated by validator.
+bool prevalidated_items( Member* source_validator, bool unvalidated, Member* validator )
+{
+    if( unvalidated || !source_validator || !validator )
+        return false;
+    return Member::equivalent_validators( source_validator, validator );
+}
+
+
+// A validator missing on both sides is equivalent.
+bool prevalidated_dict( PyObject* value, Member* key_validator, Member* value_validator )
+{
+    if( !AtomDict::TypeCheck( value ) )
+        return false;
+    AtomDict* source = atomdict_cast( value );
+    if( source->unvalidated )
+        return false;
+    if( ( key_validator || source->m_key_validator ) &&
+        !prevalidated_items( source->m_key_validator, false, key_validator ) )
+        return false;
+    if( ( value_validator || source->m_value_validator ) &&
+        !prevalidated_items( source->m_value_validator, false, value_validator ) )
+        return false;
+    return true;
 }
 
 
@@ -549,13 +1159,18 @@ common_list_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject*
     {
         return 0;
     }
-    if( !validator )
+    bool prevalidated = AtomList::TypeCheck( newvalue ) && prevalidated_items(
+        atomlist_cast( newvalue )->validator, atomlist_cast( newvalue )->unvalidated, validator
+    );
+    if( !validator || prevalidated || member->get_lazy_validation() )
     {
         for( Py_ssize_t i = 0; i < size; ++i )
             PyList_SET_ITEM( listptr.get(), i, cppy::incref( PyList_GET_ITEM( newvalue, i ) ) );
+        atomlist_cast( listptr.get() )->unvalidated = validator && !prevalidated && size > 0;
     }
     else
     {
+        QuietValidation quiet( member, atom, validator );
         for( Py_ssize_t i = 0; i < size; ++i )
         {
             PyObject* item = PyList_GET_ITEM( newvalue, i );
@@ -605,8 +1220,8 @@ container_list_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObjec
 }
 
 
-PyObject*
-set_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
+template<typename SetFactory> PyObject*
+common_set_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
 {
     if( !PyAnySet_Check( newvalue ) )
         return validate_type_fail( member, atom, newvalue, "set" );
@@ -619,23 +1234,39 @@ set_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue
     }
 
     // Create a new atom set and update it.
-    cppy::ptr newset( atom::AtomSet::New( atom, validator ) );
+    cppy::ptr newset( SetFactory()( member, atom, validator ) );
     if( !newset )
     {
         return 0;
     }
 
-    if( atom::AtomSet::Update( atomset_cast( newset.get() ), newvalue) < 0 )
+    bool prevalidated = AtomSet::TypeCheck( newvalue ) && prevalidated_items(
+        atomset_cast( newvalue )->m_value_validator, atomset_cast( newvalue )->unvalidated, validator
+    );
+    if( validator && ( prevalidated || member->get_lazy_validation() ) )
     {
-        return 0;
+        if( atom::AtomSet::UpdateUnvalidated( atomset_cast( newset.get() ), newvalue ) < 0 )
+        {
+            return 0;
+        }
+        if( prevalidated )
+            atomset_cast( newset.get() )->unvalidated = false;
+    }
+    else
+    {
+        QuietValidation quiet( member, atom, validator );
+        if( atom::AtomSet::Update( atomset_cast( newset.get() ), newvalue ) < 0 )
+        {
+            return 0;
+        }
     }
 
     return newset.release();
 }
 
 
-PyObject*
-dict_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
+template<typename DictFactory> PyObject*
+common_dict_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
 {
     if( !PyDict_Check( newvalue ) )
         return validate_type_fail( member, atom, newvalue, "dict" );
@@ -657,22 +1288,174 @@ dict_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalu
     }
 
     // Create a new atom dict and update it.
-    cppy::ptr newdict( atom::AtomDict::New( atom, key_validator, value_validator ) );
+    cppy::ptr newdict( DictFactory()( member, atom, key_validator, value_validator ) );
     if( !newdict )
     {
         std::cout << "Failed to create atomdict" << std::flush;
         return 0;
     }
 
-    if( atom::AtomDict::Update( atomdict_cast( newdict.get() ), newvalue ) < 0 )
+    bool prevalidated = prevalidated_dict( newvalue, key_validator, value_validator );
+    if( ( key_validator || value_validator ) && ( prevalidated || member->get_lazy_validation() ) )
     {
-        return 0;
+        if( atom::AtomDict::UpdateUnvalidated( atomdict_cast( newdict.get() ), newvalue ) < 0 )
+        {
+            return 0;
+        }
+        if( prevalidated )
+            atomdict_cast( newdict.get() )->unvalidated = false;
+    }
+    else
+    {
+        QuietValidation quiet( member, atom, key_validator, value_validator );
+        if( atom::AtomDict::Update( atomdict_cast( newdict.get() ), newvalue ) < 0 )
+        {
+            return 0;
+        }
     }
 
     return newdict.release();
 }
 
 
+PyObject*
+numeric_list_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
+{
+    if( !AtomNumList::TypeCheck( newvalue ) && !PyList_Check( newvalue ) &&
+        !PyTuple_Check( newvalue ) && !PyObject_CheckBuffer( newvalue ) )
+        return validate_type_fail( member, atom, newvalue, "list" );
+    NumericKind::Kind kind;
+    AtomNumList::KindFromType( member->validate_context, kind );
+    cppy::ptr listptr( AtomNumList::New( kind, atom, member ) );
+    if( !listptr )
+        return 0;
+    if( AtomNumList::Assign( atomnumlist_cast( listptr.get() ), newvalue ) < 0 )
+        return 0;
+    return listptr.release();
+}
+
+
+PyObject*
+int_set_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
+{
+    if( !AtomIntSet::TypeCheck( newvalue ) && !PyAnySet_Check( newvalue ) )
+        return validate_type_fail( member, atom, newvalue, "set" );
+    cppy::ptr setptr( AtomIntSet::New( atom, member ) );
+    if( !setptr )
+        return 0;
+    if( AtomIntSet::Assign( atomintset_cast( setptr.get() ), newvalue ) < 0 )
+        return 0;
+    return setptr.release();
+}
+
+
+PyObject*
+sorted_map_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
+{
+    if( !AtomSortedMap::SortedMapCheck( newvalue ) && !PyDict_Check( newvalue ) )
+        return validate_type_fail( member, atom, newvalue, "sortedmap" );
+    PyObject* k = PyTuple_GET_ITEM( member->validate_context, 0 );
+    PyObject* v = PyTuple_GET_ITEM( member->validate_context, 1 );
+    Member* key_validator = k != Py_None ? member_cast( k ) : 0;
+    Member* value_validator = v != Py_None ? member_cast( v ) : 0;
+    cppy::ptr mapptr( AtomSortedMap::New( atom, member, key_validator, value_validator ) );
+    if( !mapptr )
+        return 0;
+    QuietValidation quiet( member, atom, key_validator, value_validator );
+    if( AtomSortedMap::Assign( mapptr.get(), newvalue ) < 0 )
+        return 0;
+    return mapptr.release();
+}
+
+
+PyObject*
+deque_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
+{
+    if( !AtomDeque::TypeCheck( newvalue ) && !PyList_Check( newvalue ) && !PyTuple_Check( newvalue ) )
+        return validate_type_fail( member, atom, newvalue, "list" );
+    PyObject* item = PyTuple_GET_ITEM( member->validate_context, 0 );
+    Member* validator = item != Py_None ? member_cast( item ) : 0;
+    Py_ssize_t maxlen = PyLong_AsSsize_t( PyTuple_GET_ITEM( member->validate_context, 1 ) );
+    cppy::ptr dequeptr( AtomDeque::New( maxlen, atom, validator, member ) );
+    if( !dequeptr )
+        return 0;
+    bool prevalidated = AtomDeque::TypeCheck( newvalue ) &&
+        prevalidated_items( atomdeque_cast( newvalue )->validator, false, validator );
+    QuietValidation quiet( member, atom, validator );
+    if( AtomDeque::Assign( atomdeque_cast( dequeptr.get() ), newvalue, !prevalidated ) < 0 )
+        return 0;
+    return dequeptr.release();
+}
+
+
+class AtomSetFactory
+{
+public:
+    PyObject* operator()( Member* member, CAtom* atom, Member* validator )
+    {
+        return atom::AtomSet::New( atom, validator );
+    }
+};
+
+
+class AtomCSetFactory
+{
+public:
+    PyObject* operator()( Member* member, CAtom* atom, Member* validator )
+    {
+        return atom::AtomCSet::New( atom, validator, member );
+    }
+};
+
+
+class AtomDictFactory
+{
+public:
+    PyObject* operator()( Member* member, CAtom* atom, Member* key_validator, Member* value_validator )
+    {
+        return atom::AtomDict::New( atom, key_validator, value_validator );
+    }
+};
+
+
+class AtomCDictFactory
+{
+public:
+    PyObject* operator()( Member* member, CAtom* atom, Member* key_validator, Member* value_validator )
+    {
+        return atom::AtomCDict::New( atom, key_validator, value_validator, member );
+    }
+};
+
+
+PyObject*
+set_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
+{
+    return common_set_handler<AtomSetFactory>( member, atom, oldvalue, newvalue );
+}
+
+
+PyObject*
+container_set_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
+{
+    return common_set_handler<AtomCSetFactory>( member, atom, oldvalue, newvalue );
+}
+
+
+PyObject*
+dict_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
+{
+    return common_dict_handler<AtomDictFactory>( member, atom, oldvalue, newvalue );
+}
+
+
+PyObject*
+container_dict_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
+{
+    return common_dict_handler<AtomCDictFactory>( member, atom, oldvalue, newvalue );
+}
+
+
 PyObject*
 default_dict_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
 {
@@ -706,9 +1489,23 @@ default_dict_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject*
         return 0;
     }
 
-    if( atom::AtomDict::Update( atomdict_cast( newdict.get() ), newvalue ) < 0 )
+    bool prevalidated = prevalidated_dict( newvalue, key_validator, value_validator );
+    if( ( key_validator || value_validator ) && ( prevalidated || member->get_lazy_validation() ) )
     {
-        return 0;
+        if( atom::AtomDict::UpdateUnvalidated( atomdict_cast( newdict.get() ), newvalue ) < 0 )
+        {
+            return 0;
+        }
+        if( prevalidated )
+            atomdict_cast( newdict.get() )->unvalidated = false;
+    }
+    else
+    {
+        QuietValidation quiet( member, atom, key_validator, value_validator );
+        if( atom::AtomDict::Update( atomdict_cast( newdict.get() ), newvalue ) < 0 )
+        {
+            return 0;
+        }
     }
 
     return newdict.release();
@@ -718,12 +1515,19 @@ default_dict_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject*
 PyObject*
 non_optional_instance_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
 {
+    ValidateCache::Ref<TypeCheckCache> cache( member->validate_cache );
+    if( cache && cache->contains( Py_TYPE( newvalue ) ) )
+        return cppy::incref( newvalue );
     int res = PyObject_IsInstance( newvalue, member->validate_context );
     if( res < 0 )
         return 0;
     if( res == 1 )
+    {
+        if( cache && cache->add_instance_type( Py_TYPE( newvalue ), member->validate_context ) < 0 )
+            return 0;
         return cppy::incref( newvalue );
-    return validate_type_fail( member, atom, newvalue, name_from_type_tuple_types( member->validate_context ).c_str() );
+    }
+    return validate_type_fail( member, atom, newvalue, member->validate_context );
 }
 
 
@@ -761,6 +1565,8 @@ subclass_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* new
 
     if( !PyType_Check( newvalue ) )
     {
+        if( QuietValidation::fail( member, atom, PyExc_TypeError ) )
+            return 0;
         PyErr_Format(
             PyExc_TypeError,
             "The '%s' member on the '%s' object must be a subclass of '%s'. "
@@ -773,11 +1579,21 @@ subclass_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* new
         return 0;
     }
 
+    ValidateCache::Ref<TypeCheckCache> cache( member->validate_cache );
+    if( cache && cache->contains( pytype_cast( newvalue ) ) )
+        return cppy::incref( newvalue );
     int res = PyObject_IsSubclass( newvalue, member->validate_context );
     if( res < 0 )
         return 0;
     if( res == 1 )
+    {
+        if( cache )
+            cache->add( pytype_cast( newvalue ) );
         return cppy::incref( newvalue );
+    }
+
+    if( QuietValidation::fail( member, atom, PyExc_TypeError ) )
+        return 0;
 
     if( PyType_Check( newvalue ) )
     {
@@ -800,11 +1616,18 @@ subclass_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* new
 PyObject*
 enum_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
 {
-    int res = PySequence_Contains( member->validate_context, newvalue );
+    int res;
+    ValidateCache::Ref<EnumIndex> index( member->validate_cache );
+    if( index )
+        res = index->contains( member->validate_context, newvalue );
+    else
+        res = PySequence_Contains( member->validate_context, newvalue );
     if( res < 0 )
         return 0;
     if( res == 1 )
         return cppy::incref( newvalue );
+    if( QuietValidation::fail( member, atom, PyExc_ValueError ) )
+        return 0;
     return PyErr_Format(
         PyExc_ValueError,
         "invalid enum value for '%s' of '%s'",
@@ -836,22 +1659,12 @@ float_range_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject*
     if( low != Py_None )
     {
         if( PyFloat_AS_DOUBLE( low ) > value )
-            return  PyErr_Format(
-                PyExc_ValueError,
-                "range value for '%s' of '%s' too small",
-                PyUnicode_AsUTF8( member->name ),
-                Py_TYPE( pyobject_cast( atom ) )->tp_name
-            );
+            return range_fail( member, atom, "small" );
     }
     if( high != Py_None )
     {
         if( PyFloat_AS_DOUBLE( high ) < value )
-            return  PyErr_Format(
-                PyExc_ValueError,
-                "range value for '%s' of '%s' too large",
-                PyUnicode_AsUTF8( member->name ),
-                Py_TYPE( pyobject_cast( atom ) )->tp_name
-            );
+            return range_fail( member, atom, "large" );
     }
     return cppy::incref( newvalue );
 }
@@ -877,6 +1690,22 @@ range_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newval
 {
     if( !PyLong_Check( newvalue ) )
         return validate_type_fail( member, atom, newvalue, "int" );
+    // Comparing exact ints never runs arbitrary code so no reference is needed.
+    RangeBounds* bounds = static_cast<RangeBounds*>( member->validate_cache );
+    if( bounds && PyLong_CheckExact( newvalue ) )
+    {
+        switch( bounds->compare( newvalue ) )
+        {
+        case 0:
+            return cppy::incref( newvalue );
+        case -1:
+            return range_fail( member, atom, "small" );
+        case 1:
+            return range_fail( member, atom, "large" );
+        default:
+            break;
+        }
+    }
     PyObject* low = PyTuple_GET_ITEM( member->validate_context, 0 );
     PyObject* high = PyTuple_GET_ITEM( member->validate_context, 1 );
     if( low != Py_None )
@@ -886,12 +1715,7 @@ range_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newval
         case 0:
             break;
         case 1:
-            return  PyErr_Format(
-                PyExc_ValueError,
-                "range value for '%s' of '%s' too small",
-                PyUnicode_AsUTF8( member->name ),
-                Py_TYPE( pyobject_cast( atom ) )->tp_name
-            );
+            return range_fail( member, atom, "small" );
         default:
             return 0;
         }
@@ -903,12 +1727,7 @@ range_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newval
         case 0:
             break;
         case 1:
-            return  PyErr_Format(
-                PyExc_ValueError,
-                "range value for '%s' of '%s' too large",
-                PyUnicode_AsUTF8( member->name ),
-                Py_TYPE( pyobject_cast( atom ) )->tp_name
-            );
+            return range_fail( member, atom, "large" );
         default:
             return 0;
         }
@@ -920,22 +1739,47 @@ range_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newval
 PyObject*
 coerced_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
 {
-    PyObject* type = PyTuple_GET_ITEM( member->validate_context, 0 );
+    // Keep the context alive since the coercer may reset the validate mode.
+    cppy::ptr context( cppy::incref( member->validate_context ) );
+    PyObject* type = PyTuple_GET_ITEM( context.get(), 0 );
+    ValidateCache::Ref<CoercedCache> cache( member->validate_cache );
+    TypeCheckCache* types = cache ? cache->types() : 0;
+    if( types && types->contains( Py_TYPE( newvalue ) ) )
+        return cppy::incref( newvalue );
     int res = PyObject_IsInstance( newvalue, type );
     if( res == 1 )
+    {
+        if( types && types->add_instance_type( Py_TYPE( newvalue ), type ) < 0 )
+            return 0;
         return cppy::incref( newvalue );
+    }
     if( res == -1 )
         return 0;
-    PyObject* coercer = PyTuple_GET_ITEM( member->validate_context, 1 );
+    cppy::ptr key( cache ? cache->key( newvalue ) : 0 );
+    if( key )
+    {
+        PyObject* cached = cache->lookup( key.get() );
+        if( cached || PyErr_Occurred() )
+            return cached;
+    }
+    else if( PyErr_Occurred() )
+        return 0;
+    PyObject* coercer = PyTuple_GET_ITEM( context.get(), 1 );
     cppy::ptr coerced( PyObject_CallOneArg( coercer, newvalue ) );
     if( !coerced )
         return 0;
     res = PyObject_IsInstance( coerced.get(), type );
-    if( res == 1 )
-        return coerced.release();
     if( res == -1 )
         return 0;
-    return cppy::type_error( "could not coerce value to an appropriate type" );
+    if( res == 0 )
+    {
+        if( QuietValidation::fail( member, atom, PyExc_TypeError ) )
+            return 0;
+        return cppy::type_error( "could not coerce value to an appropriate type" );
+    }
+    if( key && !cache->store( key.get(), coerced.get() ) )
+        return 0;
+    return coerced.release();
 }
 
 
@@ -943,6 +1787,7 @@ PyObject*
 delegate_handler( Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
 {
     Member* delegate = member_cast( member->validate_context );
+    QuietValidation quiet( member, atom, delegate );
     return delegate->validate( atom, oldvalue, newvalue );
 }
 
@@ -952,7 +1797,10 @@ object_method_old_new_handler(
     Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
 {
     PyObject* args[] = { pyobject_cast( atom ), oldvalue, newvalue };
-    return PyObject_VectorcallMethod( member->validate_context, args, 3 | PY_VECTORCALL_ARGUMENTS_OFFSET, 0 );
+    PyObject* result = PyObject_VectorcallMethod( member->validate_context, args, 3 | PY_VECTORCALL_ARGUMENTS_OFFSET, 0 );
+    if( !result )
+        QuietValidation::record( member, atom );
+    return result;
 }
 
 
@@ -961,7 +1809,10 @@ object_method_name_old_new_handler(
     Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
 {
     PyObject* args[] = { pyobject_cast( atom ), member->name, oldvalue, newvalue };
-    return PyObject_VectorcallMethod( member->validate_context, args, 4 | PY_VECTORCALL_ARGUMENTS_OFFSET, 0 );
+    PyObject* result = PyObject_VectorcallMethod( member->validate_context, args, 4 | PY_VECTORCALL_ARGUMENTS_OFFSET, 0 );
+    if( !result )
+        QuietValidation::record( member, atom );
+    return result;
 }
 
 
@@ -970,7 +1821,10 @@ member_method_object_old_new_handler(
     Member* member, CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
 {
     PyObject* args[] = { pyobject_cast( member ), pyobject_cast( atom ), oldvalue, newvalue };
-    return PyObject_VectorcallMethod( member->validate_context, args, 4 | PY_VECTORCALL_ARGUMENTS_OFFSET, 0 );
+    PyObject* result = PyObject_VectorcallMethod( member->validate_context, args, 4 | PY_VECTORCALL_ARGUMENTS_OFFSET, 0 );
+    if( !result )
+        QuietValidation::record( member, atom );
+    return result;
 }
 
 
@@ -995,8 +1849,14 @@ handlers[] = {
     list_handler,
     container_list_handler,
     set_handler,
+    container_set_handler,
     dict_handler,
+    container_dict_handler,
     default_dict_handler,
+    numeric_list_handler,
+    int_set_handler,
+    sorted_map_handler,
+    deque_handler,
     instance_handler,
     non_optional_instance_handler,
     typed_handler,
@@ -1018,6 +1878,46 @@ handlers[] = {
 }  // namespace
 
 
+bool
+Member::equivalent_validators( Member* first, Member* second )
+{
+    // Identity is not enough since impure modes may depend on the atom.
+    if( !is_pure_validate_mode( first->get_validate_mode() ) ||
+        first->get_validate_mode() != second->get_validate_mode() ||
+        first->get_post_validate_mode() != PostValidate::NoOp ||
+        second->get_post_validate_mode() != PostValidate::NoOp )
+        return false;
+    return equivalent_contexts( first->validate_context, second->validate_context );
+}
+
+
+bool
+Member::update_validate_cache()
+{
+    // Detach the old cache first since releasing it may run arbitrary code.
+    ValidateCache* old = validate_cache;
+    validate_cache = 0;
+    if( old )
+        old->decref();
+    switch( get_validate_mode() )
+    {
+        case Validate::Enum:
+            return EnumIndex::Create( validate_context, &validate_cache );
+        case Validate::OptionalInstance:
+        case Validate::Instance:
+        case Validate::Subclass:
+            return TypeCheckCache::Create( validate_context, &validate_cache );
+        case Validate::Range:
+            return RangeBounds::Create( validate_context, &validate_cache );
+        case Validate::Coerced:
+            return CoercedCache::Create( validate_context, &validate_cache );
+        default:
+            break;
+    }
+    return true;
+}
+
+
 PyObject*
 Member::validate( CAtom* atom, PyObject* oldvalue, PyObject* newvalue )
 {
@@ -0,0 +1,97 @@
+/*-----------------------------------------------------------------------------
+| Copyright (c) 2013-2025, Nucleic Development Team.
+|
+| Distributed under the terms of the Modified BSD License.
+|
+| The full license is in the file LICENSE, distributed with this software.
+|----------------------------------------------------------------------------*/
+#pragma once
+#include <Python.h>
+
+
+namespace atom
+{
+
+// Data derived from the validate context of a member and used to speed up
+// the matching validate handler. A cache is owned by its member, rebuilt
+// each time the validate mode is set and never exposed to Python.
+//
+// Caches are reference counted so that a handler can keep the cache it is
+// using alive while running arbitrary code which may reset the validate
+// mode of the member (see ValidateCache::Ref).
+struct ValidateCache
+{
+    ValidateCache() : m_refcount( 1 ) {}
+    virtual ~ValidateCache() {}
+    virtual int traverse( visitproc visit, void* arg ) = 0;
+
+    // Statistics about the cache, as a tuple, or None if not relevant.
+    virtual PyObject* info()
+    {
+        Py_RETURN_NONE;
+    }
+
+    // Drop the cached entries and reset the statistics.
+    virtual void clear() {}
+
+    void incref()
+    {
+        ++m_refcount;
+    }
+
+    void decref()
+    {
+        if( --m_refcount == 0 )
+            delete this;
+    }
+
+    template<typename T>
+    class Ref
+    {
+
+    public:
+
+        Ref( ValidateCache* cache ) : m_cache( static_cast<T*>( cache ) )
+        {
+            if( m_cache )
+                m_cache->incref();
+        }
+
+        ~Ref()
+        {
+            if( m_cache )
+                m_cache->decref();
+        }
+
+        T* get() const
+        {
+            return m_cache;
+        }
+
+        T* operator->() const
+        {
+            return m_cache;
+        }
+
+        explicit operator bool() const
+        {
+            return m_cache != 0;
+        }
+
+    private:
+
+        Ref( const Ref& );
+        Ref& operator=( const Ref& );
+
+        T* m_cache;
+    };
+
+private:
+
+    ValidateCache( const ValidateCache& );
+    ValidateCache& operator=( const ValidateCache& );
+
+    Py_ssize_t m_refcount;
+};
+
+}  // namespace atom
@@ -0,0 +1,139 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+"""Benchmark the sortedmap of atom.datastructures.
+
+Run with ``python benchmarks/sortedmap_benchmark.py``. To compare with another
+implementation, build the extension from another revision and pass the path
+of the compiled module with ``--compare``, for example::
+
+    python benchmarks/sortedmap_benchmark.py --compare old/sortedmap.so
+
+"""
+
+import argparse
+import importlib.machinery
+import importlib.util
+import random
+import time
+
+
+def load_sortedmap(path):
+    """Load the sortedmap type from a compiled extension module."""
+    loader = importlib.machinery.ExtensionFileLoader("sortedmap", path)
+    spec = importlib.util.spec_from_file_location("sortedmap", path, loader=loader)
+    module = importlib.util.module_from_spec(spec)
+    loader.exec_module(module)
+    return module.sortedmap
+
+
+def timed(func):
+    """Return the best of three runs of func, in seconds."""
+    best = float("inf")
+    for _ in range(3):
+        start = time.perf_counter()
+        func()
+        best = min(best, time.perf_counter() - start)
+    return best
+
+
+def run(sortedmap, size):
+    """Time the main operations on a map of the given size."""
+    keys = list(range(size))
+    random.Random(0).shuffle(keys)
+    churn = [(k, k + size) for k in keys[: min(size, 20000)]]
+    pairs = [(k, k) for k in keys]
+    results = {}
+
+    results["construct"] = timed(lambda: sortedmap(pairs))
+    pairs.sort()
+    results["construct-s"] = timed(lambda: sortedmap(pairs))
+
+    def insert():
+        m = sortedmap()
+        for k in keys:
+            m[k] = k
+
+    results["insert"] = timed(insert)
+
+    full = sortedmap()
+    for k in keys:
+        full[k] = k
+
+    def lookup():
+        for k in keys:
+            full[k]
+
+    results["lookup"] = timed(lookup)
+    results["iterate"] = timed(lambda: list(full.items()))
+
+    def delete():
+        m = full.copy()
+        for k in keys:
+            del m[k]
+
+    results["copy+delete"] = timed(delete)
+
+    def churn_ops():
+        m = full.copy()
+        for old, new in churn:
+            del m[old]
+            m[new] = new
+
+    results["copy+churn"] = timed(churn_ops)
+
+    def merge():
+        m = full.copy()
+        m.update(churn)
+
+    if hasattr(full, "update"):
+        results["copy+update"] = timed(merge)
+
+    def tick():
+        # Snapshot the map before each batch of writes as a reader would.
+        m = full.copy()
+        for i in range(0, len(churn), 100):
+            m.snapshot()
+            for k, v in churn[i : i + 100]:
+                m[k] = v
+
+    if hasattr(full, "snapshot"):
+        results["snapshot"] = timed(tick)
+
+    if hasattr(full, "diff"):
+        changed = full.copy()
+        changed.update(churn)
+        results["diff"] = timed(lambda: full.diff(changed))
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--compare", help="path of another compiled sortedmap module")
+    parser.add_argument(
+        "--sizes", type=int, nargs="+", default=[100, 10_000, 100_000, 1_000_000]
+    )
+    args = parser.parse_args()
+
+    from atom.datastructures.api import sortedmap
+
+    impls = [("current", sortedmap)]
+    if args.compare:
+        impls.append(("compare", load_sortedmap(args.compare)))
+
+    print(f"{'size':>9} {'operation':<12}" + "".join(f"{n:>12}" for n, _ in impls))
+    for size in args.sizes:
+        timings = [run(impl, size) for _, impl in impls]
+        for op in timings[0]:
+            cells = "".join(
+                f"{t[op] * 1e3:>10.3f}ms" if op in t else f"{'-':>12}" for t in timings
+            )
+            print(f"{size:>9} {op:<12}{cells}")
+
+
+if __name__ == "__main__":
+    main()
@@ -23,6 +23,10 @@ ext_modules = [
             "atom/src/atomlist.cpp",
             "atom/src/atomdict.cpp",
             "atom/src/atomset.cpp",
+            "atom/src/atomnumlist.cpp",
+            "atom/src/atomintset.cpp",
+            "atom/src/atomsortedmap.cpp",
+            "atom/src/atomdeque.cpp",
             "atom/src/atomref.cpp",
             "atom/src/catom.cpp",
             "atom/src/catommodule.cpp",
@@ -32,6 +36,7 @@ ext_modules = [
             "atom/src/eventbinder.cpp",
             "atom/src/getattrbehavior.cpp",
             "atom/src/getstatebehavior.cpp",
+            "atom/src/changedetectionbehavior.cpp",
             "atom/src/member.cpp",
             "atom/src/memberchange.cpp",
             "atom/src/methodwrapper.cpp",
@@ -53,6 +58,18 @@ ext_modules = [
         include_dirs=["src"],
         language="c++",
     ),
+    Extension(
+        "atom.datastructures.sortedset",
+        ["atom/src/sortedset.cpp"],
+        include_dirs=["src"],
+        language="c++",
+    ),
+    Extension(
+        "atom.datastructures.intervalmap",
+        ["atom/src/intervalmap.cpp"],
+        include_dirs=["src"],
+        language="c++",
+    ),
 ]
 
 
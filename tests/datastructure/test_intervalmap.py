@@ -0,0 +1,149 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+"""Test the intervalmap of atom.datastructures."""
+
+import gc
+import random
+import weakref
+
+import pytest
+
+from atom.datastructures.api import intervalmap
+
+
+@pytest.fixture
+def imap():
+    """Intervalmap used for testing."""
+    return intervalmap({(0, 10): "a", (5, 8): "b", (8, 12): "c", (20, 30): "d"})
+
+
+def test_intervalmap_init():
+    """Test building an intervalmap from mappings and pairs."""
+    assert list(intervalmap()) == []
+    m = intervalmap([((3, 4), 1), ((1, 2), 2), ((3, 4), 3)])
+    assert list(m.items()) == [((1, 2), 2), ((3, 4), 3)]
+    assert list(intervalmap(m).values()) == [2, 3]
+    with pytest.raises(TypeError):
+        intervalmap([1])
+    with pytest.raises(TypeError):
+        intervalmap({1: 2})
+    with pytest.raises(ValueError):
+        intervalmap({(2, 1): 2})
+
+
+def test_mapping_protocol(imap):
+    """Test getting, setting and deleting intervals."""
+    assert imap[0, 10] == "a" and (5, 8) in imap and (5, 9) not in imap
+    assert imap.get((5, 9)) is None and imap.get((5, 9), 1) == 1
+    imap[0, 10] = "A"
+    imap[0, 5] = "e"
+    assert list(imap) == [(0, 5), (0, 10), (5, 8), (8, 12), (20, 30)]
+    assert imap.pop((0, 5)) == "e" and imap.pop((0, 5), None) is None
+    del imap[8, 12]
+    assert len(imap) == 3
+    with pytest.raises(KeyError):
+        del imap[8, 12]
+    with pytest.raises(KeyError):
+        imap.pop((8, 12))
+    with pytest.raises(ValueError):
+        imap[3, 3] = 1
+    with pytest.raises(TypeError):
+        imap[3] = 1
+    imap.clear()
+    assert len(imap) == 0
+
+
+def test_queries(imap):
+    """Test the stabbing and overlap queries."""
+    assert imap.at(5) == [((0, 10), "a"), ((5, 8), "b")]
+    assert imap.at(8) == [((0, 10), "a"), ((8, 12), "c")]
+    assert imap.at(12) == []
+    assert imap.at(29.5) == [((20, 30), "d")]
+    assert imap.overlap(10, 20) == [((8, 12), "c")]
+    assert imap.overlap(12, 20) == []
+    assert [k for k, _ in imap.overlap(-5, 100)] == list(imap)
+
+
+def test_queries_match_brute_force():
+    """Test the queries against a scan of all the intervals."""
+    rng = random.Random(3)
+    m = intervalmap()
+    ref = {}
+    for i in range(3000):
+        start = rng.randrange(1000)
+        key = (start, start + rng.randrange(1, 80))
+        if rng.random() < 0.7:
+            m[key] = i
+            ref[key] = i
+        elif ref:
+            key = rng.choice(list(ref))
+            assert m.pop(key) == ref.pop(key)
+    assert list(m.items()) == sorted(ref.items())
+    for _ in range(200):
+        lo = rng.randrange(1100)
+        hi = lo + rng.randrange(50)
+        expected = sorted(ref.items())
+        assert m.at(lo) == [(k, v) for k, v in expected if k[0] <= lo < k[1]]
+        assert m.overlap(lo, hi) == [
+            (k, v) for k, v in expected if k[0] < hi and lo < k[1]
+        ]
+    copy = m.copy()
+    m.clear()
+    assert copy.at(500) == [(k, v) for k, v in expected if k[0] <= 500 < k[1]]
+
+
+def test_mixed_bounds():
+    """Test intervals whose bounds are not all of the same kind."""
+    m = intervalmap({(1, 2): "a", (0.5, 1.5): "b"})
+    m["a", "c"] = "s"
+    assert m.at(1) == [((0.5, 1.5), "b"), ((1, 2), "a")]
+    assert m.at("b") == [(("a", "c"), "s")]
+
+
+def test_update_and_iteration(imap):
+    """Test updating a map and the detection of concurrent insertions."""
+    imap.update({(0, 10): "x", (40, 50): "y"})
+    imap.update([((1, 2), "z")])
+    assert imap[0, 10] == "x" and len(imap) == 6
+    it = iter(imap)
+    next(it)
+    imap[60, 70] = 1
+    with pytest.raises(RuntimeError):
+        next(it)
+
+
+def test_repr_and_sizeof(imap):
+    """Test the representation and the reported size of a map."""
+    assert repr(intervalmap({(1, 2): 3})) == "intervalmap([((1, 2), 3)])"
+    assert repr(intervalmap()) == "intervalmap([])"
+    large = intervalmap({(i, i + 1): i for i in range(1000)})
+    assert imap.__sizeof__() < large.__sizeof__()
+    assert large.__sizeof__() > 1000 * 48
+
+
+def test_values_are_released():
+    """Test that removed values and cycles are collected."""
+
+    class Probe:
+        pass
+
+    m = intervalmap()
+    p = Probe()
+    ref = weakref.ref(p)
+    m[0, 1] = p
+    m[0, 1] = 1
+    del p
+    assert ref() is None
+
+    p = Probe()
+    p.map = m
+    m[2, 3] = p
+    ref = weakref.ref(p)
+    del m, p
+    gc.collect()
+    assert ref() is None
@@ -8,6 +8,8 @@
 """Test the sortedmap that acts like an ordered dictionary."""
 
 import gc
+import random
+import weakref
 
 import pytest
 
@@ -102,6 +104,8 @@ def test_pop(smap):
     assert smap.pop("b", 1) == 1
     assert smap.keys() == ["a", "c"]
     assert smap.pop("d", 1) == 1
+    assert smap.pop("a", 5) == 1
+    assert "a" not in smap
 
     with pytest.raises(KeyError):
         smap.pop("b")
@@ -202,7 +206,441 @@ def test_sizeof(smap):
     smap.__sizeof__()
 
 
+def test_sizeof_after_splits():
+    """Test that leaves split by increasing keys do not keep unused room."""
+    smap = sortedmap()
+    for i in range(1000):
+        smap[i] = i
+    assert smap.__sizeof__() < 1.1 * sortedmap(smap.items()).__sizeof__()
+
+
 def test_clear(smap):
     """Test clearing a map."""
     smap.clear()
     assert not smap
+
+
+def test_large_map_matches_dict():
+    """Test inserting and deleting enough keys to grow and shrink the tree."""
+    rng = random.Random(0)
+    smap = sortedmap()
+    reference = {}
+    for i in range(20000):
+        key = rng.randrange(5000)
+        if rng.random() < 0.6:
+            smap[key] = i
+            reference[key] = i
+        elif key in reference:
+            if i % 2:
+                del smap[key]
+                del reference[key]
+            else:
+                assert smap.pop(key) == reference.pop(key)
+    assert len(smap) == len(reference)
+    assert smap.items() == sorted(reference.items())
+    copy = smap.copy()
+    for key in list(reference):
+        assert smap[key] == reference[key]
+        del smap[key]
+    assert not smap and smap.items() == []
+    assert copy.items() == sorted(reference.items())
+
+
+def test_removed_keys_are_released():
+    """Test that the tree keeps no reference to removed keys."""
+
+    class Key:
+        def __init__(self, value):
+            self.value = value
+
+        def __lt__(self, other):
+            return self.value < other.value
+
+        def __eq__(self, other):
+            return self.value == other.value
+
+        __hash__ = object.__hash__
+
+    keys = [Key(i) for i in range(2000)]
+    refs = [weakref.ref(k) for k in keys]
+    smap = sortedmap((k, None) for k in keys)
+    random.Random(0).shuffle(keys)
+    for key in keys[:1500]:
+        del smap[key]
+    del keys, key
+    gc.collect()
+    assert sum(r() is not None for r in refs) == len(smap) == 500
+
+
+@pytest.fixture
+def large_map():
+    """Sortedmap spanning several leaves holding the even keys below 1000."""
+    return sortedmap((k, -k) for k in range(0, 1000, 2))
+
+
+def test_bisect_and_index(large_map):
+    """Test locating keys by rank."""
+    assert large_map.bisect_left(10) == 5 and large_map.bisect_right(10) == 6
+    assert large_map.bisect_left(11) == large_map.bisect_right(11) == 6
+    assert large_map.bisect_left(-1) == 0 and large_map.bisect_right(5000) == 500
+    assert large_map.index(998) == 499
+    with pytest.raises(ValueError):
+        large_map.index(3)
+    assert large_map.peekitem() == (998, -998)
+    assert large_map.peekitem(0) == (0, 0) and large_map.peekitem(-2) == (996, -996)
+    assert large_map.peekitem(321) == (642, -642)
+    with pytest.raises(IndexError):
+        large_map.peekitem(500)
+    with pytest.raises(IndexError):
+        sortedmap().peekitem()
+    with pytest.raises(TypeError):
+        large_map.peekitem(0, 1)
+
+
+def test_floor_and_ceiling(large_map):
+    """Test finding the closest keys."""
+    assert large_map.floor_key(11) == 10 and large_map.floor_key(10) == 10
+    assert large_map.ceiling_key(11) == 12 and large_map.ceiling_key(12) == 12
+    assert large_map.floor_key(-1, None) is None
+    assert large_map.ceiling_key(999, "x") == "x"
+    with pytest.raises(KeyError):
+        large_map.floor_key(-1)
+    with pytest.raises(KeyError):
+        large_map.ceiling_key(999)
+    with pytest.raises(TypeError):
+        large_map.floor_key()
+
+
+def test_irange(large_map):
+    """Test iterating over a range of keys."""
+    assert list(large_map.irange(10, 16)) == [10, 12, 14, 16]
+    assert list(large_map.irange(10, 16, (False, False))) == [12, 14]
+    assert list(large_map.irange(9, 15, reverse=True)) == [14, 12, 10]
+    assert list(large_map.irange(maximum=4)) == [0, 2, 4]
+    assert list(large_map.irange(minimum=994)) == [994, 996, 998]
+    assert list(large_map.irange(20, 10)) == []
+    assert list(large_map.irange()) == large_map.keys()
+    assert list(large_map.irange(reverse=True)) == large_map.keys()[::-1]
+
+    it = large_map.irange()
+    next(it)
+    large_map[1] = 1
+    with pytest.raises(RuntimeError):
+        next(it)
+    # Updating the value of an existing key does not invalidate the iterator.
+    it = large_map.irange(0, 4)
+    next(it)
+    large_map[2] = "two"
+    assert list(it) == [1, 2, 4]
+
+
+def test_slice_deletion(large_map):
+    """Test deleting ranges of keys."""
+    del large_map[100:201]
+    assert large_map.bisect_left(100) == 50 and 200 not in large_map
+    assert large_map.floor_key(300) == 300 and large_map.ceiling_key(99) == 202
+    del large_map[900:]
+    assert large_map.peekitem() == (898, -898)
+    del large_map[:10]
+    assert large_map.peekitem(0) == (10, -10)
+    assert len(large_map) == 500 - 51 - 50 - 5
+    with pytest.raises(ValueError):
+        del large_map[::2]
+    with pytest.raises(TypeError):
+        large_map[1:2] = 3
+    del large_map[:]
+    assert not large_map
+
+
+def test_views_are_live(smap):
+    """Test that the views reflect the changes of the map."""
+    keys, values, items = smap.keys(), smap.values(), smap.items()
+    smap["d"] = 4
+    assert len(keys) == 4 and keys == ["a", "b", "c", "d"]
+    assert values == (1, 2, 3, 4) and items[-1] == ("d", 4)
+    assert "d" in keys and 4 in values and ("d", 4) in items
+    assert "e" not in keys and 5 not in values
+    assert ("d", 5) not in items and "d" not in items and ("e", 4) not in items
+    assert keys[1:3] == ["b", "c"] and values[::-2] == [4, 2]
+    assert list(reversed(items)) == [("d", 4), ("c", 3), ("b", 2), ("a", 1)]
+    assert list(reversed(smap)) == ["d", "c", "b", "a"]
+    assert keys != ["a", "b", "c", "e"] and keys != ["a"] and keys != "abcd"
+    assert keys == smap.copy().keys()
+    assert repr(keys) == "sortedmap_keys(['a', 'b', 'c', 'd'])"
+    with pytest.raises(IndexError):
+        keys[4]
+    with pytest.raises(TypeError):
+        hash(keys)
+
+
+def test_views_detect_mutation(large_map):
+    """Test that adding or removing keys while iterating is reported."""
+    for view in (large_map, large_map.keys(), large_map.values(), large_map.items()):
+        it = iter(view)
+        next(it)
+        large_map[-1] = None
+        with pytest.raises(RuntimeError):
+            next(it)
+        del large_map[-1]
+
+    class Evil:
+        def __eq__(self, other):
+            large_map[-1] = None
+            return False
+
+    with pytest.raises(RuntimeError):
+        Evil() in large_map.values()
+
+
+def test_bulk_construction():
+    """Test building a map from unsorted input holding duplicated keys."""
+    rng = random.Random(4)
+    pairs = [(rng.randrange(2000), rng.random()) for _ in range(5000)]
+    smap = sortedmap(pairs)
+    ref = dict(pairs)
+    assert list(smap.items()) == sorted(ref.items())
+    assert list(sortedmap(sorted(ref.items())).items()) == sorted(ref.items())
+    assert sortedmap(smap).items() == smap.items()
+    assert list(sortedmap({3: 1, 1: 2}).items()) == [(1, 2), (3, 1)]
+    assert len(sortedmap([])) == 0
+    key = 1.0
+    assert next(iter(sortedmap([(key, 1), (1, 2)]))) is key
+    with pytest.raises(TypeError):
+        sortedmap([(1, 2, 3)])
+    with pytest.raises(TypeError):
+        sortedmap(1)
+
+
+@pytest.mark.parametrize("count", [3, 300, 3000])
+def test_update_and_merge(large_map, count):
+    """Test adding items in place and building the union of two maps."""
+    rng = random.Random(count)
+    other = {rng.randrange(-500, 1500): rng.random() for _ in range(count)}
+    ref = dict(large_map.items())
+    merged = large_map.merge(other)
+    assert len(large_map) == 500
+    large_map.update(other)
+    ref.update(other)
+    assert list(large_map.items()) == sorted(ref.items())
+    assert merged.items() == large_map.items()
+    for k in range(-10, 1010, 7):
+        assert large_map.get(k) == ref.get(k)
+    large_map.update(((k, -k) for k in range(-3, 0)), x=1)
+    assert large_map["x"] == 1 and large_map[-2] == 2
+    large_map.update()
+    assert large_map.index("x") == len(large_map) - 1
+
+
+def test_update_invalidates_iterators(large_map):
+    """Test that merging new keys is reported to iterators."""
+    it = iter(large_map)
+    next(it)
+    large_map.update({k: k for k in range(1, 1000, 2)})
+    with pytest.raises(RuntimeError):
+        next(it)
+
+
+@pytest.mark.parametrize(
+    "keys",
+    [
+        list(range(-300, 300)),
+        [k / 4 for k in range(-300, 300)],
+        [f"k{k:04d}" for k in range(600)],
+        [b"k%04d" % k for k in range(600)],
+    ],
+)
+def test_native_keys(keys):
+    """Test maps whose keys all are exact ints, floats, strs or bytes."""
+    shuffled = keys[:]
+    random.Random(1).shuffle(shuffled)
+    smap = sortedmap()
+    for k in shuffled:
+        smap[k] = k
+    assert list(smap) == keys == list(sortedmap(zip(shuffled, shuffled)))
+    for k in shuffled[::7]:
+        assert smap[k] == k and smap.index(k) == keys.index(k)
+        assert smap.bisect_left(k) == keys.index(k)
+        assert smap.bisect_right(k) == keys.index(k) + 1
+    for k in shuffled[::2]:
+        del smap[k]
+    assert list(smap) == sorted(shuffled[1::2])
+
+
+def test_native_keys_mixed_with_other_keys():
+    """Test that keys of another kind are compared as before."""
+    smap = sortedmap((k, k) for k in range(100))
+    assert smap[1.0] == 1 and smap[True] == 1 and 2.5 not in smap
+    assert smap.bisect_left(2.5) == 3
+    smap[2**70] = "big"
+    smap[-0.5] = "float"
+    assert list(smap)[:2] == [-0.5, 0] and smap.peekitem() == (2**70, "big")
+    assert smap[50] == 50
+    fmap = sortedmap({0.5: 1, 1.0: 2})
+    assert fmap[1] == 2 and 0 not in fmap
+    nan = float("nan")
+    fmap[nan] = 3
+    assert fmap[nan] == 3
+    smap.clear()
+    smap["a"] = 1
+    assert smap["a"] == 1 and list(smap) == ["a"]
+
+
+def test_key_function():
+    """Test ordering the keys by the result of a key function."""
+    calls = []
+
+    def lower(key):
+        calls.append(key)
+        return key.lower()
+
+    smap = sortedmap({"b": 1, "A": 2}, key=lower)
+    assert smap.key is lower and sortedmap().key is None
+    assert list(smap.items()) == [("A", 2), ("b", 1)]
+    assert len(calls) == 2
+    smap["a"] = 3
+    assert len(calls) == 3 and list(smap.items()) == [("A", 3), ("b", 1)]
+    assert smap["B"] == 1 and "c" not in smap and smap.floor_key("Z") == "b"
+    assert list(smap.irange("a", "a")) == ["A"]
+    copy = smap.copy()
+    assert copy.key is lower and copy["a"] == 3
+    assert list(sortedmap(smap).items()) == [("A", 3), ("b", 1)]
+    merged = sortedmap({"C": 0}, key=str.lower).merge(smap)
+    assert list(merged) == ["A", "b", "C"] and merged.key is str.lower
+    smap.update({"B": 4, "d": 5})
+    assert list(smap.items()) == [("A", 3), ("b", 4), ("d", 5)]
+    with pytest.raises(AttributeError):
+        smap[1] = 0
+    with pytest.raises(AttributeError):
+        smap.get(1)
+    with pytest.raises(AttributeError):
+        1 in smap.keys()
+    with pytest.raises(TypeError):
+        sortedmap([(1, 0)], key=str.lower)
+    with pytest.raises(TypeError):
+        sortedmap(key=1)
+    rev = sortedmap(((k, k) for k in range(200)), key=lambda k: -k)
+    assert list(rev)[:3] == [199, 198, 197] and rev[5] == 5
+
+
+def test_key_function_cycle_is_collected():
+    """Test that the key function is visited by the garbage collector."""
+
+    class Key:
+        def __call__(self, key):
+            return key
+
+    key = Key()
+    key.map = sortedmap(key=key)
+    key.map[1] = key
+    ref = weakref.ref(key)
+    del key
+    gc.collect()
+    assert ref() is None
+
+
+@pytest.mark.parametrize("convert", [sortedmap, dict, lambda m: list(m.items())])
+def test_set_operations_and_diff(convert):
+    """Test the set algebra and the diff of two maps against dicts."""
+    rng = random.Random(2)
+    first = {k: rng.randrange(3) for k in rng.sample(range(3000), 1500)}
+    second = {k: rng.randrange(3) for k in rng.sample(range(3000), 1500)}
+    smap = sortedmap(first)
+    other = convert(sortedmap(second))
+    assert list(smap.union(other).items()) == sorted({**first, **second}.items())
+    common = sorted((k, v) for k, v in first.items() if k in second)
+    assert list(smap.intersection(other).items()) == common
+    only = sorted((k, v) for k, v in first.items() if k not in second)
+    assert list(smap.difference(other).items()) == only
+    added, removed, changed = smap.diff(other)
+    assert list(added.items()) == sorted(
+        (k, v) for k, v in second.items() if k not in first
+    )
+    assert list(removed.items()) == only
+    assert list(changed.items()) == sorted(
+        (k, (v, second[k])) for k, v in first.items() if k in second and second[k] != v
+    )
+    assert len(smap) == 1500
+
+
+def test_set_operations_edge_cases():
+    """Test set operations on empty maps, with key functions and errors."""
+    empty = sortedmap()
+    smap = sortedmap({"a": 1, "B": 2}, key=str.lower)
+    assert smap.intersection(empty).key is str.lower
+    assert len(smap.intersection({})) == 0
+    assert smap.difference({}).items() == smap.items()
+    assert list(smap.intersection({"b": 0})) == ["B"]
+    assert list(smap.difference(sortedmap({"A": 0}, key=str.lower))) == ["B"]
+    assert [list(m.items()) for m in empty.diff(smap)] == [
+        [("B", 2), ("a", 1)],
+        [],
+        [],
+    ]
+
+    class Uncomparable:
+        def __eq__(self, other):
+            raise ValueError()
+
+    with pytest.raises(ValueError):
+        sortedmap({1: Uncomparable()}).diff({1: 2})
+    with pytest.raises(TypeError):
+        smap.intersection(1)
+
+
+def test_snapshot_is_isolated():
+    """Test that a snapshot and its source can be modified independently."""
+    rng = random.Random(3)
+    smap = sortedmap((k, k) for k in range(2000))
+    models = [(smap, dict(smap.items()))]
+    for step in range(4000):
+        if step % 500 == 0:
+            source, model = models[rng.randrange(len(models))]
+            models.append((source.snapshot(), dict(model)))
+        target, model = models[rng.randrange(len(models))]
+        key = rng.randrange(3000)
+        op = rng.random()
+        if op < 0.45:
+            target[key] = step
+            model[key] = step
+        elif op < 0.9:
+            if key in model:
+                del target[key]
+                del model[key]
+        else:
+            del target[key : key + 50]
+            for k in [k for k in model if key <= k < key + 50]:
+                del model[k]
+    for target, model in models:
+        assert list(target.items()) == sorted(model.items())
+        assert target.peekitem(len(model) // 2) == sorted(model.items())[len(model) // 2]
+    assert smap.snapshot().key is None
+    assert sortedmap(key=abs).snapshot().key is abs
+
+
+def test_snapshot_releases_shared_items():
+    """Test that items shared by snapshots are released with the last map."""
+
+    class Value:
+        pass
+
+    smap = sortedmap((k, Value()) for k in range(500))
+    refs = [weakref.ref(v) for v in smap.values()]
+    snap = smap.snapshot()
+    smap.clear()
+    assert all(r() is not None for r in refs)
+    snap[0] = None
+    del snap
+    assert all(r() is None for r in refs)
+
+
+def test_iteration_survives_value_updates(large_map):
+    """Test that iterators follow the map when nodes are copied or rebuilt."""
+    snap = large_map.snapshot()
+    it = iter(large_map.items())
+    assert next(it) == (0, 0)
+    large_map[2] = "a"
+    assert next(it) == (2, "a")
+    large_map.update({k: "b" for k in range(4, 1000, 2)})
+    assert next(it) == (4, "b")
+    assert len(list(it)) == 497
+    assert snap[2] == -2 and snap[4] == -4
@@ -0,0 +1,185 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+"""Test the sortedset and sortedmultiset of atom.datastructures."""
+
+import bisect
+import gc
+import random
+import weakref
+
+import pytest
+
+from atom.datastructures.api import sortedmultiset, sortedset
+
+
+def test_sortedset_init():
+    """Test building sets from iterables, sorted or not."""
+    assert list(sortedset()) == []
+    assert list(sortedset([3, 1, 2, 1])) == [1, 2, 3]
+    assert list(sortedset(range(5))) == [0, 1, 2, 3, 4]
+    assert list(sortedmultiset([3, 1, 3, 1])) == [1, 1, 3, 3]
+    assert list(sortedset(sortedmultiset([2, 2, 1]))) == [1, 2]
+    with pytest.raises(TypeError):
+        sortedset(1)
+    with pytest.raises(TypeError):
+        sortedset(key=1)
+
+
+def test_add_and_remove():
+    """Test adding and removing values."""
+    s = sortedset()
+    s.add(2)
+    s.add(1)
+    s.add(2)
+    assert list(s) == [1, 2] and len(s) == 2
+    assert 1 in s and 3 not in s
+    s.discard(3)
+    s.remove(1)
+    assert list(s) == [2]
+    with pytest.raises(KeyError):
+        s.remove(1)
+
+    m = sortedmultiset()
+    for v in (2, 1, 2):
+        m.add(v)
+    assert list(m) == [1, 2, 2] and m.count(2) == 2 and m.count(5) == 0
+    m.remove(2)
+    assert list(m) == [1, 2]
+
+
+def test_multiset_keeps_insertion_order():
+    """Test that values with equal keys are kept in insertion order."""
+    m = sortedmultiset(key=lambda v: v[0])
+    for v in [(1, "a"), (0, "z"), (1, "b"), (1, "c")]:
+        m.add(v)
+    assert list(m) == [(0, "z"), (1, "a"), (1, "b"), (1, "c")]
+    m.update([(1, "d"), (0, "y")])
+    assert list(m) == [(0, "z"), (0, "y"), (1, "a"), (1, "b"), (1, "c"), (1, "d")]
+    assert m.index((1, "x")) == 2
+
+    s = sortedset(["b", "A", "a"], key=str.lower)
+    assert list(s) == ["A", "b"] and "B" in s
+    assert s.key is str.lower
+
+
+def test_indexing_and_slicing():
+    """Test accessing and deleting values by rank."""
+    values = list(range(0, 300, 3))
+    s = sortedset(values)
+    assert s[0] == 0 and s[-1] == 297
+    assert s[10:20:3] == values[10:20:3]
+    assert s[::-7] == values[::-7]
+    with pytest.raises(IndexError):
+        s[100]
+    with pytest.raises(TypeError):
+        s[0] = 1
+    del s[5]
+    del values[5]
+    del s[10:40:4]
+    del values[10:40:4]
+    del s[60:20:-3]
+    del values[60:20:-3]
+    del s[:5]
+    del values[:5]
+    assert list(s) == values
+    assert s.pop() == values.pop() and s.pop(0) == values.pop(0)
+    assert list(s) == values
+    with pytest.raises(IndexError):
+        sortedset().pop()
+
+
+def test_matches_sorted_list():
+    """Test a multiset against a sorted list through random operations."""
+    rng = random.Random(7)
+    m = sortedmultiset()
+    ref = []
+    for _ in range(5000):
+        v = rng.randrange(300)
+        if rng.random() < 0.6:
+            m.add(v)
+            bisect.insort_right(ref, v)
+        else:
+            m.discard(v)
+            if v in ref:
+                ref.remove(v)
+    assert list(m) == ref
+    assert list(reversed(m)) == ref[::-1]
+    for v in range(0, 300, 7):
+        assert m.bisect_left(v) == bisect.bisect_left(ref, v)
+        assert m.bisect_right(v) == bisect.bisect_right(ref, v)
+        assert m.count(v) == ref.count(v)
+    assert list(m.irange(10, 20, inclusive=(False, True))) == [
+        v for v in ref if 10 < v <= 20
+    ]
+    m.update(range(300))
+    assert list(m) == sorted(ref + list(range(300)))
+
+
+def test_set_operations():
+    """Test the set operations of sortedset."""
+    s = sortedset([1, 3, 5, 7])
+    assert list(s.union([2, 3])) == [1, 2, 3, 5, 7]
+    assert list(s.intersection([7, 3, 4])) == [3, 7]
+    assert list(s.difference(sortedset([1, 5]))) == [3, 7]
+    assert list(s.symmetric_difference([1, 2])) == [2, 3, 5, 7]
+    assert not hasattr(sortedmultiset(), "union")
+
+
+def test_comparison_and_copies():
+    """Test equality, copies and snapshots."""
+    s = sortedset([1, 2])
+    assert s == sortedset([2, 1]) and s != sortedset([1])
+    assert s != sortedmultiset([1, 2]) and s != [1, 2]
+    c = s.copy()
+    snap = s.snapshot()
+    s.add(3)
+    assert list(c) == [1, 2] and list(snap) == [1, 2]
+    assert type(sortedmultiset([1]).snapshot()) is sortedmultiset
+    assert repr(sortedmultiset([2, 1, 2])) == "sortedmultiset([1, 2, 2])"
+    assert repr(sortedset()) == "sortedset([])"
+
+
+def test_iteration_detects_mutation():
+    """Test that adding a value while iterating raises."""
+    s = sortedset(range(10))
+    it = iter(s)
+    next(it)
+    s.add(20)
+    with pytest.raises(RuntimeError):
+        next(it)
+
+
+def test_sizeof():
+    """Test that the reported size grows with the values."""
+    small = sortedset([1]).__sizeof__()
+    large = sortedset(range(10000)).__sizeof__()
+    assert 0 < small < large
+    assert large > 10000 * 24
+
+
+def test_values_are_released():
+    """Test that removed values and cycles are collected."""
+
+    class Probe:
+        pass
+
+    s = sortedmultiset(key=id)
+    p = Probe()
+    ref = weakref.ref(p)
+    s.add(p)
+    del p
+    s.clear()
+    assert ref() is None
+
+    p = Probe()
+    p.values = s
+    s.add(p)
+    ref = weakref.ref(p)
+    del s, p
+    gc.collect()
+    assert ref() is None
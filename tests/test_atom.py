@@ -23,6 +23,7 @@ import pytest
 from atom.api import (
     Atom,
     Int,
+    List,
     MissingMemberWarning,
     Str,
     Value,
@@ -265,6 +266,42 @@ def test_freezing():
         del ft.a
 
 
+def test_validate_record():
+    """Test validating a record without creating an Atom instance."""
+    from types import MappingProxyType
+
+    calls = []
+
+    class RecordTest(Atom):
+        a = Int()
+        b = List(Int())
+        c = Value()
+
+        def __init__(self, **kwargs):
+            calls.append(kwargs)
+            super().__init__(**kwargs)
+
+        def _observe_a(self, change):
+            calls.append(change)
+
+    validated, failures = RecordTest.validate_record({"a": 1, "b": [1, 2]})
+    assert validated == {"a": 1, "b": [1, 2]}
+    assert failures == []
+    assert calls == []
+
+    validated, failures = RecordTest.validate_record(
+        MappingProxyType({"a": "1", "b": [1, ""], "c": 1, "d": 2})
+    )
+    assert validated == {"c": 1}
+    assert [name for name, _ in failures] == ["a", "b", "d"]
+    assert isinstance(failures[0][1], TypeError)
+    assert isinstance(failures[1][1], TypeError)
+    assert isinstance(failures[2][1], AttributeError)
+
+    with pytest.raises(TypeError):
+        RecordTest.validate_record(1)
+
+
 def test_traverse_atom():
     """Test that we can break reference cycles involving Atom object."""
 
@@ -0,0 +1,160 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+"""Test the Deque member and the atomdeque container."""
+
+import gc
+import pickle
+import weakref
+
+import pytest
+
+from atom.api import Atom, Deque, Int, atomdeque
+
+
+class Model(Atom):
+    events = Deque(Int(), maxlen=3, default=[1, 2])
+
+    untyped = Deque(maxlen=2)
+
+
+def test_deque_storage():
+    """Test validation and the sequence protocol of the member value."""
+    m = Model()
+    assert type(m.events) is atomdeque and m.events.maxlen == 3
+    assert m.events == [1, 2] and len(m.events) == 2
+    m.events = (4, 5, 6, 7)
+    assert m.events.tolist() == [5, 6, 7]
+    assert m.events[0] == 5 and m.events[-1] == 7 and 6 in m.events
+    with pytest.raises(IndexError):
+        m.events[3]
+
+    with pytest.raises(TypeError) as excinfo:
+        m.events = {1, 2}
+    assert "'events' member on the 'Model' object" in excinfo.value.args[0]
+    with pytest.raises(TypeError):
+        m.events = ["a"]
+    with pytest.raises(TypeError):
+        m.events.append("a")
+    with pytest.raises(TypeError):
+        m.events.extend([8, "a"])
+    assert m.events == [5, 6, 7]
+
+    m.untyped = ["a", [1], None]
+    assert m.untyped == [[1], None]
+
+    with pytest.raises(ValueError):
+        Deque(maxlen=0)
+    with pytest.raises(TypeError):
+        Deque(maxlen="1")
+
+
+def test_deque_ring_buffer():
+    """Test that each end evicts the opposite one once the deque is full."""
+    d = atomdeque(3)
+    for i in range(10):
+        d.append(i)
+    assert d.tolist() == [7, 8, 9]
+    d.appendleft(6)
+    assert d.tolist() == [6, 7, 8]
+    assert d.popleft() == 6 and d.pop() == 8 and d.tolist() == [7]
+    d.extend(range(10, 15))
+    assert list(d) == [12, 13, 14] and d.count(13) == 1
+    d.clear()
+    with pytest.raises(IndexError):
+        d.pop()
+    with pytest.raises(IndexError):
+        d.popleft()
+
+    # Wrap the items around the end of the storage many times.
+    d = atomdeque(5)
+    expected = []
+    for i in range(100):
+        d.append(i)
+        expected = (expected + [i])[-5:]
+        if i % 3 == 0:
+            d.popleft()
+            expected.pop(0)
+        assert d.tolist() == expected
+
+    it = iter(d)
+    d.append(0)
+    with pytest.raises(RuntimeError):
+        next(it)
+
+
+def test_deque_notifications():
+    """Test that each change emits a single notification."""
+    m = Model()
+    changes = []
+    m.observe("events", changes.append)
+    m.events
+    changes.clear()
+
+    m.events.append(3)
+    m.events.append(4)
+    m.events.appendleft(0)
+    m.events.extend([5, 6])
+    assert m.events.popleft() == 3
+    assert m.events.pop() == 6
+    m.events.clear()
+    ops = [c["operation"] for c in changes]
+    assert ops == [
+        "append",
+        "append",
+        "appendleft",
+        "extend",
+        "popleft",
+        "pop",
+        "clear",
+    ]
+    assert changes[0]["item"] == 3 and "evicted" not in changes[0]
+    assert changes[1]["item"] == 4 and changes[1]["evicted"] == 1
+    assert changes[2]["item"] == 0 and changes[2]["evicted"] == 4
+    assert changes[3]["items"] == [5, 6] and changes[3]["evicted"] == [0, 2]
+    assert changes[4]["item"] == 3 and changes[5]["item"] == 6
+    assert changes[6]["items"] == [5] and changes[6]["value"] is m.events
+
+    # A copy or a standalone deque does not notify anything.
+    changes.clear()
+    m.events.copy().append(1)
+    atomdeque(2, [1]).append(2)
+    assert not changes
+
+
+def test_deque_version_and_copies():
+    """Test that copies share a version and modifications draw a new one."""
+    m1 = Model()
+    m2 = Model()
+    m2.events = m1.events
+    assert m2.events is not m1.events and m2.events.version == m1.events.version
+    version = m2.events.version
+    m2.events.append(3)
+    assert m2.events.version != version and m1.events == [1, 2]
+
+    copy = pickle.loads(pickle.dumps(m2.events))
+    assert type(copy) is atomdeque and copy.maxlen == 3 and copy == [1, 2, 3]
+    assert repr(copy) == "atomdeque([1, 2, 3], maxlen=3)"
+
+    # The default items are copied for each atom.
+    m1.events.append(9)
+    assert Model().events == [1, 2]
+
+
+def test_deque_is_collected():
+    """Test that a cycle through a deque stored on an atom is collected."""
+
+    class Probe:
+        pass
+
+    m = Model()
+    probe = Probe()
+    m.untyped = [m, probe]
+    ref = weakref.ref(probe)
+    del m, probe
+    gc.collect()
+    assert ref() is None
@@ -9,7 +9,17 @@
 
 import pytest
 
-from atom.api import Atom, Dict, Int, List, atomdict, atomlist
+from atom.api import (
+    Atom,
+    ContainerDict,
+    Dict,
+    Int,
+    List,
+    Str,
+    atomcdict,
+    atomdict,
+    atomlist,
+)
 
 
 @pytest.fixture
@@ -186,3 +196,197 @@ def test_update(atom_dict):
         atom_dict.fullytyped.update({"": 1})
     with pytest.raises(TypeError):
         atom_dict.fullytyped.update({"": ""})
+
+
+def test_lazy_validation():
+    """Test deferring the validation of the items of a dict."""
+    from atom.api import DefaultDict, Float
+
+    class DictAtom(Atom):
+        data = Dict(Float(), Float(), lazy=True)
+        default = DefaultDict(Int(), Float(), lazy=True)
+
+    a = DictAtom()
+    for read in (
+        lambda d: d[1.0],
+        lambda d: d.get(1.0),
+        lambda d: 1.0 in d,
+        list,
+        lambda d: d.keys(),
+        lambda d: d.values(),
+        lambda d: d.items(),
+        dict,
+    ):
+        a.data = {1: 2, 3.0: 4}
+        assert not a.data.validated
+        read(a.data)
+        assert a.data.validated
+        assert [type(k) for k in a.data] == [float, float]
+        assert [type(v) for v in a.data.values()] == [float, float]
+        assert list(a.data) == [1.0, 3.0]
+
+    a.data = {1: 2}
+    with pytest.raises(TypeError):
+        a.data[""] = 1.0
+    a.data[2.0] = 1
+    assert a.data == {1: 2, 2.0: 1.0}
+    a.data.validate_all()
+    assert a.data.validated
+
+    a.data = {1.0: ""}
+    with pytest.raises(TypeError):
+        a.data.get(1.0)
+    assert not a.data.validated
+
+    a.default = {1: 2}
+    assert not a.default.validated
+    assert a.default[2] == 0.0
+    assert a.default == {1: 2.0, 2: 0.0}
+    assert a.default.validated
+
+    # A dict outliving its atom cannot be validated
+    items = a.data
+    del a
+    assert items == {1.0: ""}
+    assert not items.validated
+
+
+@pytest.mark.parametrize(
+    "read",
+    [
+        repr,
+        reversed,
+        lambda d: d == {1: "x"},
+        lambda d: d.copy(),
+        lambda d: d.pop(1),
+        lambda d: d.popitem(),
+        lambda d: d.setdefault(1),
+        lambda d: d | {},
+        lambda d: {} | d,
+    ],
+)
+def test_lazy_validation_read_paths(read):
+    """Test that every read of a lazy dict validates its items first."""
+    from atom.api import DefaultDict
+
+    class DictAtom(Atom):
+        data = Dict(Int(), Int(), lazy=True)
+        default = DefaultDict(Int(), Int(), lazy=True)
+
+    a = DictAtom()
+    for name in ("data", "default"):
+        setattr(a, name, {1: "x"})
+        with pytest.raises(TypeError):
+            read(getattr(a, name))
+        assert not getattr(a, name).validated
+
+        setattr(a, name, {1: 2})
+        read(getattr(a, name))
+        assert getattr(a, name).validated
+
+
+def test_assign_prevalidated_dict():
+    """Test that dicts validated by equivalent validators are not revalidated."""
+    from atom.api import DefaultDict, Str
+
+    class Source(Atom):
+        data = Dict(Str(), Int())
+        keys = Dict(Str())
+
+    class Target(Atom):
+        data = Dict(Str(), Int())
+        default = DefaultDict(Str(), Int())
+        keys = Dict(Str())
+        values = Dict(Str(), Str())
+
+    s = Source()
+    s.data = {"a": 1}
+    dict.__setitem__(s.data, "b", "c")
+    s.keys = {"a": 1}
+    dict.__setitem__(s.keys, 1, 1)
+
+    t = Target()
+    t.data = s.data
+    assert t.data == {"a": 1, "b": "c"}
+    assert t.data.validated
+    t.default = s.data
+    assert t.default == {"a": 1, "b": "c"}
+    t.keys = s.keys
+    assert t.keys == {"a": 1, 1: 1}
+    with pytest.raises(TypeError):
+        t.values = s.data
+    with pytest.raises(TypeError):
+        t.data = s.keys
+
+
+def test_container_dict_notifications():
+    """Test the key level notifications emitted by a ContainerDict."""
+
+    class DictAtom(Atom):
+        data = ContainerDict(Str(), Int())
+
+    a = DictAtom()
+    assert isinstance(a.data, atomcdict)
+    changes = []
+    a.observe("data", changes.append)
+    changes.clear()
+
+    def last():
+        c = changes.pop()
+        assert not changes
+        assert c["type"] == "container"
+        assert c["name"] == "data"
+        assert c["object"] is a
+        assert c["value"] is a.data and c["oldvalue"] is a.data
+        header = ("type", "name", "object", "value", "oldvalue")
+        return {k: v for k, v in c.items() if k not in header}
+
+    a.data["a"] = 1
+    assert last() == {"operation": "__setitem__", "key": "a", "newitem": 1}
+    a.data["a"] = 2
+    assert last() == {
+        "operation": "__setitem__",
+        "key": "a",
+        "olditem": 1,
+        "newitem": 2,
+    }
+    del a.data["a"]
+    assert last() == {"operation": "__delitem__", "key": "a", "item": 2}
+
+    a.data.update(x=1, y=2)
+    assert last() == {
+        "operation": "update",
+        "items": {"x": 1, "y": 2},
+        "olditems": {},
+    }
+    a.data.update({"x": 3})
+    assert last() == {
+        "operation": "update",
+        "items": {"x": 3},
+        "olditems": {"x": 1},
+    }
+    a.data |= {"z": 4}
+    assert last() == {"operation": "__ior__", "items": {"z": 4}, "olditems": {}}
+
+    assert a.data.setdefault("x", 0) == 3
+    assert not changes
+    assert a.data.setdefault("q", 5) == 5
+    assert last() == {"operation": "__setitem__", "key": "q", "newitem": 5}
+
+    assert a.data.pop("x") == 3
+    assert last() == {"operation": "pop", "key": "x", "item": 3}
+    assert a.data.pop("x", None) is None
+    assert not changes
+    assert a.data.popitem() == ("q", 5)
+    assert last() == {"operation": "popitem", "key": "q", "item": 5}
+    a.data.clear()
+    assert last() == {"operation": "clear", "items": {"y": 2, "z": 4}}
+    a.data.clear()
+    assert not changes
+
+    with pytest.raises(TypeError):
+        a.data["a"] = "b"
+    with pytest.raises(TypeError):
+        a.data.update({1: 1})
+    assert a.data == {}
+    assert not changes
@@ -0,0 +1,195 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+"""Test the IntSet member and the atomintset container."""
+
+import pickle
+
+import pytest
+
+from atom.api import Atom, IntSet, atomintset
+
+
+class Model(Atom):
+    ids = IntSet(default={3, 1, 2})
+
+
+# Values spread over several chunks, some sparse and some dense.
+SPARSE = set(range(0, 3 * 2**16, 97))
+DENSE = set(range(2**16, 2**16 + 20000)) | {2**32 - 1}
+
+
+def test_int_set_storage():
+    """Test validation and the set protocol of the member value."""
+    m = Model()
+    assert type(m.ids) is atomintset
+    assert m.ids == {1, 2, 3} and list(m.ids) == [1, 2, 3]
+    m.ids = DENSE
+    assert m.ids == DENSE and len(m.ids) == len(DENSE)
+    assert 2**16 + 5 in m.ids and 5 not in m.ids and "a" not in m.ids
+    assert list(m.ids) == sorted(DENSE)
+    assert m.ids.__sizeof__() < 20000
+
+    with pytest.raises(TypeError):
+        m.ids = [1, 2]
+    with pytest.raises(TypeError) as excinfo:
+        m.ids = {1, "a"}
+    assert "'ids' member on the 'Model' object" in excinfo.value.args[0]
+    with pytest.raises(ValueError):
+        m.ids.add(-1)
+    with pytest.raises(ValueError):
+        m.ids.add(2**32)
+    assert m.ids == DENSE
+
+
+def test_int_set_default_is_copied():
+    """Test that each atom gets its own copy of the default."""
+    m1 = Model()
+    m2 = Model()
+    m1.ids.add(4)
+    assert m1.ids == {1, 2, 3, 4}
+    assert m2.ids == {1, 2, 3}
+
+
+def test_int_set_mutations():
+    """Test adding and removing values across the array/bitmap threshold."""
+    s = atomintset()
+    for i in range(5000):
+        s.add(i * 2)
+    s.add(0)
+    assert len(s) == 5000 and s == set(range(0, 10000, 2))
+    for i in range(0, 10000, 4):
+        s.discard(i)
+    assert s == set(range(2, 10000, 4))
+    s.remove(2)
+    with pytest.raises(KeyError):
+        s.remove(2)
+    assert s.pop() == 6
+    s.clear()
+    assert not s and repr(s) == "atomintset()"
+    with pytest.raises(KeyError):
+        s.pop()
+    assert repr(atomintset([2, 1])) == "atomintset({1, 2})"
+    big = [2**20, 70000, 3]
+    assert repr(atomintset(big)) == "atomintset({3, 70000, 1048576})"
+
+    with pytest.raises(RuntimeError):
+        s = atomintset([1, 2])
+        for i in s:
+            s.add(i + 10)
+
+
+@pytest.mark.parametrize(
+    "a, b",
+    [
+        (SPARSE, DENSE),
+        (DENSE, SPARSE),
+        (DENSE, set(range(2**16 + 10000, 2**16 + 40000))),
+        (set(range(0, 8000, 2)), set(range(0, 8000, 3))),
+    ],
+)
+def test_int_set_operations(a, b):
+    """Test the set operations against the builtin set."""
+    x = atomintset(a)
+    y = atomintset(b)
+    assert x | y == a | b and x & y == a & b
+    assert x - y == a - b and x ^ y == a ^ b
+    assert type(x | b) is atomintset and b - x == b - a
+    assert x.union(b) == a | b and x.intersection(b) == a & b
+    assert x.difference(b) == a - b and x.symmetric_difference(b) == a ^ b
+    assert x.union() == a and x.union() is not x
+    assert x.union(b, [1]) == a.union(b, [1])
+    assert x.intersection(b, y) == a.intersection(b, b)
+    assert x.difference(b, {0}) == a.difference(b, {0})
+    with pytest.raises(TypeError):
+        x.symmetric_difference(b, b)
+    with pytest.raises(TypeError):
+        x.union(b, ["a"])
+    assert (x & y) <= x and (x & y).issubset(y) and (x | y).issuperset(b)
+    assert x.isdisjoint(y) == a.isdisjoint(b)
+    assert (x < (x | y)) == (a < (a | b)) and not x < x
+    assert x.copy() == x and x.copy() is not x
+    for op in ("__ior__", "__iand__", "__isub__", "__ixor__"):
+        z = x.copy()
+        expected = set(a)
+        getattr(z, op)(y)
+        getattr(expected, op)(b)
+        assert z == expected and list(z) == sorted(expected)
+
+
+def test_int_set_comparisons():
+    """Test comparisons with builtin sets holding other objects."""
+    s = atomintset([1, 2])
+    assert s == {1, 2} and s == frozenset([1, 2]) and s != {1, 2, "a"}
+    assert s < {1, 2, "a"} and s <= {1, 2, "a"} and not s >= {1, 2, "a"}
+    assert s.issubset([1, 2, "a"]) and not s.issuperset([1, "a"])
+    assert s != [1, 2]
+    with pytest.raises(TypeError):
+        hash(s)
+    with pytest.raises(TypeError):
+        s | {"a"}
+    with pytest.raises(TypeError):
+        s | [1]
+
+
+def test_int_set_pickle():
+    """Test pickling standalone sets and members."""
+    s = atomintset(DENSE)
+    assert pickle.loads(pickle.dumps(s)) == s
+    m = Model()
+    m.ids = SPARSE
+    assert pickle.loads(pickle.dumps(m)).ids == SPARSE
+
+
+def test_int_set_notifications():
+    """Test that changes are notified like for a ContainerSet."""
+
+    class Observed(Atom):
+        ids = IntSet()
+
+    m = Observed(ids={1, 2, 3})
+    changes = []
+    m.observe("ids", changes.append)
+
+    m.ids.add(4)
+    m.ids.add(4)
+    m.ids.discard(1)
+    m.ids.discard(1)
+    m.ids ^= {2, 5}
+    m.ids.intersection_update({3, 9})
+    m.ids.clear()
+    ops = [c["operation"] for c in changes if c["type"] == "container"]
+    assert ops == ["add", "discard", "__ixor__", "intersection_update", "clear"]
+    assert changes[0]["item"] == 4
+    assert changes[2]["added"] == {5} and changes[2]["removed"] == {2}
+    assert "added" not in changes[3] and changes[3]["removed"] == {4, 5}
+    assert changes[4]["items"] == {3} and changes[4]["value"] is m.ids
+
+    # Items are reported as the stored ints
+    changes.clear()
+    m.ids.add(True)
+    m.ids.remove(True)
+    assert [type(c["item"]) for c in changes] == [int, int]
+
+    # A standalone set does not notify anything.
+    changes.clear()
+    m.ids.copy().add(1)
+    assert not changes
+
+
+def test_int_set_version():
+    """Test that copies share a version and modifications draw a new one."""
+    m1 = Model()
+    m2 = Model()
+    m2.ids = m1.ids
+    assert m2.ids is not m1.ids and m2.ids.version == m1.ids.version
+    version = m2.ids.version
+    m2.ids.add(1)
+    m2.ids |= {2}
+    assert m2.ids.version == version
+    m2.ids.add(5)
+    assert m2.ids.version != m1.ids.version
@@ -652,6 +652,64 @@ def test_container_repeat(container_model, kind):
         assert change["count"] == 2
 
 
+@pytest.mark.parametrize("kind", ("untyped", "typed"))
+def test_container_batch(container_model, kind):
+    """Test coalescing the changes of a list into a single notification."""
+    changes = []
+    container_model.observe(kind, changes.append)
+    mlist = getattr(container_model, kind)
+
+    with mlist.batch() as lst:
+        assert lst is mlist
+        for i in range(3):
+            mlist.append(i)
+        assert not changes
+    assert len(changes) == 1
+    verify_base_change(container_model, kind)
+    assert changes[0]["operation"] == "extend"
+    assert changes[0]["items"] == [0, 1, 2]
+
+    with mlist.batch():
+        mlist.append(3)
+        with mlist.batch():
+            mlist.pop()
+            mlist[0] = 5
+        mlist.append(6)
+        mlist.append(7)
+    assert len(changes) == 2
+    change = changes[1]
+    assert change["type"] == "container"
+    assert change["operation"] == "batch"
+    assert [c["operation"] for c in change["changes"]] == [
+        "append",
+        "pop",
+        "__setitem__",
+        "extend",
+    ]
+    assert change["changes"][-1]["items"] == [6, 7]
+    assert "name" not in change["changes"][0]
+
+    # Nothing is delivered for an empty batch, and changes are delivered
+    # when the batch exits on an error.
+    with mlist.batch():
+        pass
+    assert len(changes) == 2
+    with pytest.raises(RuntimeError):
+        with mlist.batch():
+            mlist.append(8)
+            raise RuntimeError()
+    assert len(changes) == 3
+    assert changes[2]["operation"] == "append"
+
+    mlist.begin_batch()
+    mlist.append(9)
+    mlist.end_batch()
+    assert len(changes) == 4
+    with pytest.raises(RuntimeError):
+        mlist.end_batch()
+    container_model.unobserve(kind, changes.append)
+
+
 def test_insert_args():
     class Obj(Atom):
         items = List()
@@ -682,3 +740,167 @@ def test_validate_seq_refcnt():
     gc.collect()
     assert sys.getrefcount(a) == rca
     assert sys.getrefcount(b) == rcb
+
+
+@pytest.mark.parametrize("member", [List, ContainerList])
+def test_lazy_validation(member):
+    """Test deferring the validation of the items of a list."""
+    from atom.api import Float
+
+    class Model(Atom):
+        data = member(Float(), lazy=True)
+        eager = member(Float())
+
+    assert Model.data.lazy_validation
+    assert not Model.eager.lazy_validation
+    assert Model.data.clone().lazy_validation
+
+    m = Model()
+    m.eager = [1.0, 2]
+    assert m.eager.validated
+    assert type(m.eager[1]) is float
+
+    # Validation happens on first read and promotes the items
+    m.data = [1.0, 2]
+    assert not m.data.validated
+    assert type(m.data[1]) is float
+    assert m.data.validated
+
+    for read in (iter, lambda lst: 2.0 in lst, lambda lst: lst[::-1]):
+        m.data = [1.0, 2]
+        read(m.data)
+        assert m.data.validated
+
+    # Mutations are validated eagerly
+    m.data = [1.0, 2]
+    m.data.append(3)
+    assert not m.data.validated
+    with pytest.raises(TypeError):
+        m.data.append("a")
+
+    # Invalid items are reported on access and the list stays unvalidated
+    m.data = [1.0, "a"]
+    with pytest.raises(TypeError):
+        m.data[0]
+    assert not m.data.validated
+    with pytest.raises(TypeError):
+        m.data.validate_all()
+    m.data[1] = 2.0
+    m.data.validate_all()
+    assert m.data.validated
+    assert list(m.data) == [1.0, 2.0]
+
+
+@pytest.mark.parametrize("member", [List, ContainerList])
+def test_lazy_validation_orphaned_and_reentrant(member):
+    """Test lazy lists whose atom is gone or whose validator reads them."""
+    from atom.api import Coerced
+
+    models = []
+
+    class Model(Atom):
+        data = member(Coerced(int, coercer=lambda v: len(models[0].data)), lazy=True)
+
+    m = Model()
+    models.append(m)
+    m.data = [1, "x"]
+    assert m.data == [1, 2]
+    assert m.data.validated
+
+    m.data = [1, "x"]
+    items = m.data
+    del m, models[:]
+    gc.collect()
+    assert list(items) == [1, "x"]
+    items.validate_all()
+    assert not items.validated
+
+
+@pytest.mark.parametrize("member", [List, ContainerList])
+@pytest.mark.parametrize(
+    "read",
+    [
+        lambda lst: lst.copy(),
+        lambda lst: lst.index(1),
+        lambda lst: lst.count(1),
+        lambda lst: lst.pop(),
+        lambda lst: lst.sort(),
+        reversed,
+        repr,
+        lambda lst: lst == [1, "x", 3],
+        lambda lst: [1, "x", 3] == lst,
+        lambda lst: lst + [4],
+        lambda lst: lst * 2,
+        dumps,
+    ],
+)
+def test_lazy_validation_read_paths(member, read):
+    """Test that every read of a lazy list validates its items first."""
+    import json
+
+    class Model(Atom):
+        data = member(Int(), lazy=True)
+
+    m = Model()
+    m.data = [1, "x", 3]
+    with pytest.raises(TypeError):
+        read(m.data)
+    assert not m.data.validated and list.__len__(m.data) == 3
+
+    m.data = [1, 2, 3]
+    read(m.data)
+    assert m.data.validated
+
+    m.data = [1, "x", 3]
+    with pytest.raises(TypeError):
+        json.dumps(m.data)
+    with pytest.raises(TypeError):
+        m.__getstate__()["data"] == [1, "x", 3]
+    m.data = [1, 2, 3]
+    assert json.dumps(m.data) == "[1, 2, 3]" and m.data.validated
+
+
+@pytest.mark.parametrize("member", [List, ContainerList])
+def test_assign_prevalidated_list(member):
+    """Test that lists validated by an equivalent validator are not revalidated."""
+    from atom.api import Range
+
+    class Source(Atom):
+        data = member(Int())
+        nested = member(List(Int()))
+        ranged = member(Range(0, 10))
+
+    class Target(Atom):
+        data = member(Int())
+        nested = member(List(Int()))
+        ranged = member(Range(0, 10))
+        narrow = member(Range(0, 5))
+        lazy = member(Int(), lazy=True)
+
+    s = Source()
+    s.data = [1, 2]
+    s.ranged = [1, 8]
+    # Sneak in an invalid item to observe whether items are validated.
+    list.append(s.data, "a")
+    list.append(s.ranged, 11)
+
+    t = Target()
+    t.data = s.data
+    assert t.data == [1, 2, "a"]
+    assert t.data is not s.data
+    assert t.data.validated
+    t.ranged = s.ranged
+    assert t.ranged == [1, 8, 11]
+    with pytest.raises(ValueError):
+        t.narrow = s.ranged
+
+    # A lazily validated source is always validated.
+    t.lazy = [1, "a"]
+    with pytest.raises(TypeError):
+        t.data = t.lazy
+
+    # Nested containers are copied rather than shared.
+    s.nested = [[1]]
+    t.nested = s.nested
+    assert t.nested == [[1]]
+    assert t.nested[0] is not s.nested[0]
@@ -0,0 +1,195 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+"""Test the NumericList member and the atomnumlist container."""
+
+import array
+import math
+import pickle
+
+import pytest
+
+from atom.api import Atom, NumericList, atomnumlist
+
+
+class Model(Atom):
+    floats = NumericList(float, default=(1, 2.5))
+
+    ints = NumericList(int)
+
+    bools = NumericList(bool)
+
+
+def test_numeric_list_storage():
+    """Test that items are stored in the native format of the kind."""
+    m = Model()
+    assert type(m.floats) is atomnumlist
+    assert m.floats == [1.0, 2.5]
+    assert type(m.floats[0]) is float
+    assert m.floats.kind is float and m.floats.itemsize == 8
+    assert m.bools.kind is bool and m.bools.itemsize == 1
+
+    m.ints = (1, 2, 3)
+    assert m.ints == [1, 2, 3] and m.ints.kind is int
+    assert m.ints != [1, 2]
+    assert m.ints == atomnumlist(float, [1, 2, 3])
+    assert m.ints.__sizeof__() > 3 * 8
+
+    with pytest.raises(TypeError):
+        NumericList(str)
+    with pytest.raises(TypeError):
+        m.ints = 1
+    with pytest.raises(TypeError) as excinfo:
+        m.ints = [1, 2.0]
+    assert "'ints' member on the 'Model' object" in excinfo.value.args[0]
+    with pytest.raises(ValueError):
+        m.ints = [2**63]
+    with pytest.raises(TypeError):
+        m.bools.append(1)
+    assert m.ints == [1, 2, 3]
+
+
+def test_numeric_list_default_is_copied():
+    """Test that each atom gets its own copy of the default."""
+    m1 = Model()
+    m2 = Model()
+    m1.floats.append(3)
+    assert m1.floats == [1.0, 2.5, 3.0]
+    assert m2.floats == [1.0, 2.5]
+
+
+def test_numeric_list_operations():
+    """Test the list interface of atomnumlist."""
+    lst = atomnumlist(int, [4, 1, 3])
+    lst.append(2)
+    lst.insert(-10, 0)
+    lst.extend(array.array("q", [7]))
+    lst += [5]
+    assert lst == [0, 4, 1, 3, 2, 7, 5]
+    assert lst.pop() == 5 and lst.pop(0) == 0
+    lst.remove(7)
+    assert lst.index(3) == 2 and lst.count(3) == 1
+    assert 3.0 in lst and 8 not in lst and 2**70 not in lst
+    with pytest.raises(ValueError):
+        lst.remove(8)
+    lst.sort()
+    assert lst == [1, 2, 3, 4]
+    lst.sort(reverse=True)
+    lst.reverse()
+    assert lst.tolist() == [1, 2, 3, 4]
+
+    assert lst[::2] == [1, 3] and type(lst[1:]) is atomnumlist
+    assert lst[-1] == 4
+    lst[1:3] = [9, 9, 9]
+    assert lst == [1, 9, 9, 9, 4]
+    lst[::2] = [0, 0, 0]
+    assert lst == [0, 9, 0, 9, 0]
+    with pytest.raises(ValueError):
+        lst[::2] = [1]
+    del lst[::-2]
+    assert lst == [9, 9]
+    del lst[0]
+    lst *= 3
+    assert lst == [9, 9, 9]
+    lst.clear()
+    assert len(lst) == 0
+    with pytest.raises(IndexError):
+        lst.pop()
+    with pytest.raises(IndexError):
+        lst[0]
+
+    floats = atomnumlist(float, [2.0, math.nan, 1.0])
+    floats.sort()
+    assert floats[:2] == [1.0, 2.0] and math.isnan(floats[2])
+    bools = atomnumlist(bool, [True, False, True])
+    bools.sort()
+    assert bools == [False, True, True]
+
+
+def test_numeric_list_buffer():
+    """Test the zero-copy buffer access and buffer assignment."""
+    m = Model()
+    m.ints = [1, 2, 3]
+    view = memoryview(m.ints)
+    assert view.readonly and view.format == "q" and view.shape == (3,)
+    assert view.tolist() == [1, 2, 3]
+    # The storage cannot move while it is exported but it can be modified.
+    with pytest.raises(BufferError):
+        m.ints.append(4)
+    m.ints[0] = 5
+    assert view[0] == 5
+    view.release()
+    m.ints.append(4)
+    assert memoryview(atomnumlist(float)).tolist() == []
+
+    m.floats = array.array("d", [0.5, 1.5])
+    assert m.floats == [0.5, 1.5]
+    m.floats = array.array("i", [1, 2])
+    assert m.floats == [1.0, 2.0]
+    assert atomnumlist.from_buffer(bool, b"\x00\x02") == [False, True]
+    with pytest.raises(ValueError):
+        atomnumlist.from_buffer(int, b"\x00")
+
+
+@pytest.mark.parametrize("protocol", [2, 5])
+def test_numeric_list_pickle(protocol):
+    """Test pickling the list in and out of band."""
+    lst = atomnumlist(float, [1.0, 2.0])
+    assert pickle.loads(pickle.dumps(lst, protocol=protocol)) == lst
+    m = Model()
+    m.ints = [1, 2]
+    loaded = pickle.loads(pickle.dumps(m, protocol=protocol))
+    assert loaded.ints == [1, 2] and loaded.floats == [1.0, 2.5]
+
+
+def test_numeric_list_out_of_band_pickle():
+    """Test that protocol 5 exposes the storage as an out-of-band buffer."""
+    lst = atomnumlist(int, range(10))
+    buffers = []
+    data = pickle.dumps(lst, protocol=5, buffer_callback=buffers.append)
+    assert len(buffers) == 1
+    assert bytes(buffers[0].raw()) == bytes(memoryview(lst))
+    assert pickle.loads(data, buffers=buffers) == lst
+
+
+def test_numeric_list_notifications():
+    """Test that changes are notified like for a ContainerList."""
+
+    class Observed(Atom):
+        values = NumericList(int)
+
+    m = Observed(values=[1, 2, 3])
+    changes = []
+    m.observe("values", changes.append)
+
+    m.values.append(4)
+    m.values[0] = 5
+    m.values[1:3] = [6]
+    del m.values[0]
+    m.values.sort(reverse=True)
+    ops = [c["operation"] for c in changes if c["type"] == "container"]
+    assert ops == ["append", "__setitem__", "__setitem__", "__delitem__", "sort"]
+    assert changes[1]["olditem"] == 1 and changes[1]["newitem"] == 5
+    assert changes[2]["olditem"] == [2, 3] and changes[2]["newitem"] == [6]
+    assert changes[-1]["value"] is m.values
+
+    # A standalone list does not notify anything.
+    changes.clear()
+    m.values.copy().append(1)
+    assert not changes
+
+
+def test_numeric_list_version():
+    """Test that copies share a version and modifications draw a new one."""
+    m1 = Model()
+    m2 = Model()
+    m1.ints = [1, 2]
+    m2.ints = m1.ints
+    assert m2.ints is not m1.ints and m2.ints.version == m1.ints.version
+    m2.ints.append(3)
+    assert m2.ints.version != m1.ints.version
+
@@ -11,7 +11,7 @@ from operator import iand, ior, isub, ixor
 
 import pytest
 
-from atom.api import Atom, Int, Set, atomset
+from atom.api import Atom, ContainerSet, Float, Int, Set, atomcset, atomset
 
 
 @pytest.fixture
@@ -151,3 +151,171 @@ def test_set_errors():
     with pytest.raises(ValueError) as excinfo:
         obj.items.update(IterableErrorSet("a"))
     assert "Bad iter" in excinfo.exconly()
+
+
+def test_lazy_validation():
+    """Test deferring the validation of the items of a set."""
+
+    class SetAtom(Atom):
+        data = Set(Float(), lazy=True)
+
+    a = SetAtom()
+    a.data = {1.0, 2}
+    assert not a.data.validated
+    assert 2.0 in a.data
+    assert a.data.validated
+    assert {type(v) for v in a.data} == {float}
+
+    a.data = {1, 2}
+    a.data.validate_all()
+    assert a.data.validated
+    assert {type(v) for v in a.data} == {float}
+
+    a.data = {1.0, "a"}
+    with pytest.raises(TypeError):
+        list(a.data)
+    assert not a.data.validated
+    with pytest.raises(TypeError):
+        a.data.add("b")
+
+    # A set outliving its atom cannot be validated
+    items = a.data
+    del a
+    assert items == {1.0, "a"}
+    assert not items.validated
+
+
+@pytest.mark.parametrize(
+    "read",
+    [
+        lambda s: s.copy(),
+        lambda s: s.pop(),
+        lambda s: s.union(),
+        lambda s: s.issubset(set()),
+        lambda s: s | set(),
+        lambda s: set() | s,
+        lambda s: s & {1},
+        lambda s: s - {1},
+        lambda s: s ^ {1},
+        lambda s: s == {1, "x"},
+        lambda s: s <= {1, "x"},
+        repr,
+    ],
+)
+def test_lazy_validation_read_paths(read):
+    """Test that every read of a lazy set validates its items first."""
+
+    class SetAtom(Atom):
+        data = Set(Int(), lazy=True)
+
+    a = SetAtom()
+    a.data = {1, "x"}
+    with pytest.raises(TypeError):
+        read(a.data)
+    assert not a.data.validated
+
+    a.data = {1, 2}
+    read(a.data)
+    assert a.data.validated
+
+
+def test_assign_prevalidated_set():
+    """Test that sets validated by an equivalent validator are not revalidated."""
+
+    class Source(Atom):
+        data = Set(Int())
+
+    class Target(Atom):
+        data = Set(Int())
+        strict = Set(Int(strict=False))
+
+    s = Source()
+    s.data = {1, 2}
+    set.add(s.data, "a")
+
+    t = Target()
+    t.data = s.data
+    assert t.data == {1, 2, "a"}
+    assert t.data.validated
+    with pytest.raises(TypeError):
+        t.strict = s.data
+
+
+def test_container_set_notifications():
+    """Test the incremental notifications emitted by a ContainerSet."""
+
+    class SetAtom(Atom):
+        data = ContainerSet(Int())
+
+    a = SetAtom()
+    assert isinstance(a.data, atomcset)
+    changes = []
+    a.observe("data", changes.append)
+    changes.clear()
+
+    def last():
+        c = changes.pop()
+        assert not changes
+        assert c["type"] == "container"
+        assert c["name"] == "data"
+        assert c["object"] is a
+        assert c["value"] is a.data and c["oldvalue"] is a.data
+        header = ("type", "name", "object", "value", "oldvalue")
+        return {k: v for k, v in c.items() if k not in header}
+
+    a.data.add(1)
+    assert last() == {"operation": "add", "item": 1}
+    a.data.add(1)
+    assert not changes
+    a.data.update({1, 2, 3})
+    assert last() == {"operation": "update", "added": {2, 3}}
+    a.data.discard(2)
+    assert last() == {"operation": "discard", "item": 2}
+    a.data.discard(2)
+    assert not changes
+    a.data.remove(3)
+    assert last() == {"operation": "remove", "item": 3}
+    with pytest.raises(KeyError):
+        a.data.remove(3)
+    assert not changes
+
+    a.data |= {4}
+    assert last() == {"operation": "__ior__", "added": {4}}
+    a.data &= {1, 4, 5}
+    assert not changes
+    a.data -= {1, 9}
+    assert last() == {"operation": "__isub__", "removed": {1}}
+    a.data ^= {4, 5}
+    assert last() == {"operation": "__ixor__", "added": {5}, "removed": {4}}
+    a.data.intersection_update({7})
+    assert last() == {"operation": "intersection_update", "removed": {5}}
+
+    a.data.update({1})
+    changes.clear()
+    assert a.data.pop() == 1
+    assert last() == {"operation": "pop", "item": 1}
+    a.data.update({1, 2})
+    changes.clear()
+    a.data.clear()
+    assert last() == {"operation": "clear", "items": {1, 2}}
+
+    # Removals report the item in the form the set stores it
+    class FloatSetAtom(Atom):
+        data = ContainerSet(Float())
+
+    b = FloatSetAtom(data={1.0, 2.0})
+    b.observe("data", changes.append)
+    b.data.discard(1)
+    b.data.remove(2)
+    assert [(c["operation"], type(c["item"])) for c in changes] == [
+        ("discard", float),
+        ("remove", float),
+    ]
+    changes.clear()
+
+    with pytest.raises(TypeError):
+        a.data.add("a")
+    with pytest.raises(TypeError):
+        a.data |= {"a"}
+    assert a.data == set()
+    assert not changes
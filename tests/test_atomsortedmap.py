@@ -0,0 +1,163 @@
+# --------------------------------------------------------------------------------------
+# Copyright (c) 2025, Nucleic Development Team.
+#
+# Distributed under the terms of the Modified BSD License.
+#
+# The full license is in the file LICENSE, distributed with this software.
+# --------------------------------------------------------------------------------------
+"""Test the SortedMap member and the atomsortedmap container."""
+
+import gc
+import weakref
+
+import pytest
+
+from atom.api import Atom, Int, SortedMap, Str, atomsortedmap
+from atom.datastructures.api import sortedmap
+
+
+class Model(Atom):
+    items = SortedMap(Int(), Str(), default={3: "c", 1: "a"})
+
+    untyped = SortedMap()
+
+
+def test_sorted_map_storage():
+    """Test validation and the map protocol of the member value."""
+    m = Model()
+    assert type(m.items) is atomsortedmap and isinstance(m.items, sortedmap)
+    assert list(m.items.items()) == [(1, "a"), (3, "c")]
+    m.items = {5: "e", 2: "b"}
+    assert list(m.items.keys()) == [2, 5] and m.items.bisect_left(3) == 1
+    m.items = sortedmap({4: "d"})
+    assert type(m.items) is atomsortedmap and list(m.items.items()) == [(4, "d")]
+
+    with pytest.raises(TypeError) as excinfo:
+        m.items = [(1, "a")]
+    assert "'items' member on the 'Model' object" in excinfo.value.args[0]
+    with pytest.raises(TypeError):
+        m.items = {1: 1}
+    with pytest.raises(TypeError):
+        m.items["a"] = "a"
+    with pytest.raises(TypeError):
+        m.items[1] = 1
+    with pytest.raises(TypeError):
+        m.items.update({1: 1})
+    with pytest.raises(TypeError):
+        m.items.update(a="a")
+    assert list(m.items.items()) == [(4, "d")]
+
+    m.untyped = {"b": 1, "a": [2]}
+    assert list(m.untyped.keys()) == ["a", "b"]
+
+
+def test_sorted_map_mutations():
+    """Test the mutating methods of a map stored on an atom."""
+    m = Model()
+    m.items[2] = "b"
+    m.items.update({5: "e"})
+    m.items.update([(0, "z")])
+    assert list(m.items.keys()) == [0, 1, 2, 3, 5]
+    assert m.items.pop(5) == "e" and m.items.pop(5, None) is None
+    assert m.items.pop(0, None) == "z" and 0 not in m.items
+    with pytest.raises(KeyError):
+        m.items.pop(5)
+    with pytest.raises(KeyError):
+        del m.items[5]
+    del m.items[2:]
+    assert list(m.items.items()) == [(1, "a")]
+    m.items.clear()
+    assert len(m.items) == 0
+
+
+def test_sorted_map_default_is_copied():
+    """Test that each atom gets its own map holding the default items."""
+    m1 = Model()
+    m2 = Model()
+    m1.items[2] = "b"
+    assert list(m1.items.keys()) == [1, 2, 3]
+    assert list(m2.items.keys()) == [1, 3]
+
+
+def test_sorted_map_notifications():
+    """Test that changes are notified like for a ContainerDict."""
+    m = Model()
+    changes = []
+    m.observe("items", changes.append)
+    m.items
+    changes.clear()
+
+    m.items[2] = "b"
+    m.items[2] = "bb"
+    m.items[2] = "bb"
+    del m.items[1]
+    m.items.update({4: "d", 3: "cc"})
+    m.items.update()
+    assert m.items.pop(4) == "d"
+    m.items.pop(4, None)
+    del m.items[10:]
+    del m.items[:3]
+    m.items.clear()
+    m.items.clear()
+    ops = [c["operation"] for c in changes]
+    assert ops == [
+        "__setitem__",
+        "__setitem__",
+        "__delitem__",
+        "update",
+        "pop",
+        "__delitem__",
+        "clear",
+    ]
+    assert changes[0]["key"] == 2 and changes[0]["newitem"] == "b"
+    assert "olditem" not in changes[0] and changes[1]["olditem"] == "b"
+    assert changes[2]["key"] == 1 and changes[2]["item"] == "a"
+    assert list(changes[3]["items"].items()) == [(3, "cc"), (4, "d")]
+    assert list(changes[3]["olditems"].items()) == [(3, "c")]
+    assert changes[4]["key"] == 4 and changes[4]["item"] == "d"
+    assert list(changes[5]["items"].items()) == [(2, "bb")]
+    assert list(changes[6]["items"].items()) == [(3, "cc")]
+    assert changes[6]["value"] is m.items
+
+    # A copy or a standalone map does not notify anything.
+    changes.clear()
+    m.items.copy()[1] = "a"
+    standalone = atomsortedmap({1: "a"})
+    standalone[2] = 2
+    standalone.update(b=1)
+    assert list(standalone.keys()) == [1, 2, "b"]
+    assert not changes
+
+
+def test_sorted_map_version():
+    """Test that copies share a version and modifications draw a new one."""
+    m1 = Model()
+    m2 = Model()
+    m2.items = m1.items
+    assert m2.items is not m1.items and m2.items.version == m1.items.version
+    version = m2.items.version
+    m2.items[1] = "b"
+    assert m2.items.version != version
+    assert list(m1.items.items()) == [(1, "a"), (3, "c")]
+
+    class Other(Atom):
+        items = SortedMap(Int())
+
+    # Items validated differently are copied anew.
+    o = Other(items=m1.items)
+    assert o.items.version != m1.items.version
+
+
+def test_sorted_map_is_collected():
+    """Test that a cycle through a map stored on an atom is collected."""
+
+    class Probe:
+        pass
+
+    m = Model()
+    probe = Probe()
+    m.untyped = {1: m, 2: probe}
+    ref = weakref.ref(probe)
+    del m, probe
+    gc.collect()
+    assert ref() is None
@@ -28,15 +28,18 @@ from atom.api import (
     Coerced,
     DefaultValue,
     Dict,
+    Float,
     FloatRange,
     ForwardInstance,
     ForwardSubclass,
     ForwardTyped,
     Instance,
+    Int,
     List,
     Member,
     Range,
     Set,
+    Str,
     Subclass,
     Typed,
     Value,
@@ -169,6 +172,74 @@ def test_set_handler():
     assert SetTest().default is not default_value
 
 
+@pytest.mark.parametrize(
+    "member, default",
+    [
+        (List(Int(), default=[1, 2]), [1, 2]),
+        (Set(Int(), default={1, 2}), {1, 2}),
+        (Dict(Int(), Int(), default={1: 2}), {1: 2}),
+        (List(Float(), default=[1, 2.0]), [1.0, 2.0]),
+        (List(List(Int()), default=[[1]]), [[1]]),
+    ],
+)
+def test_validated_default_container(member, default):
+    """Test that the validated default containers are private to each atom."""
+
+    class DefaultTest(Atom):
+        m = member
+
+    a, b = DefaultTest(), DefaultTest()
+    assert a.m == default
+    assert a.m is not b.m
+    assert a.m.validated
+    if isinstance(default, list) and type(default[0]) is float:
+        assert type(b.m[0]) is float
+    if isinstance(default, list) and type(default[0]) is list:
+        assert a.m[0] is not b.m[0]
+    a.m.clear()
+    assert DefaultTest().m == default
+
+    # Changing the validation of the member applies to the next defaults.
+    DefaultTest.m.set_validate_mode(*Int().validate_mode)
+    with pytest.raises(TypeError):
+        DefaultTest().m
+
+
+@pytest.mark.parametrize(
+    "member, default, items",
+    [
+        (List, [1, 2], lambda m: m.item),
+        (Set, {1, 2}, lambda m: m.item),
+        (
+            lambda item, default: Dict(Int(), item, default=default),
+            {1: 2},
+            lambda m: m.validate_mode[1][1],
+        ),
+    ],
+)
+def test_validated_default_container_changes(member, default, items):
+    """Test that the default containers follow their default and item validators."""
+
+    class DefaultTest(Atom):
+        m = member(Int(), default=default)
+
+    assert DefaultTest().m == default
+
+    # Modifying the declared default is reflected by the next atoms.
+    if isinstance(default, dict):
+        default[3] = 4
+    elif isinstance(default, set):
+        default.add(3)
+    else:
+        default.append(3)
+    assert DefaultTest().m == default
+
+    # Changing the validation of the items applies to the next defaults.
+    items(DefaultTest.m).set_validate_mode(*Str().validate_mode)
+    with pytest.raises(TypeError):
+        DefaultTest().m
+
+
 @pytest.mark.parametrize(
     "member, expected, mode",
     [
@@ -9,7 +9,7 @@
 
 import pytest
 
-from atom.api import Enum
+from atom.api import Atom, Enum
 
 
 def test_enum():
@@ -37,3 +37,36 @@ def test_enum():
 
     with pytest.raises(ValueError):
         Enum()
+
+
+def test_enum_membership():
+    """Test validating values against large and unhashable Enum items."""
+
+    class EnumTest(Atom):
+        large = Enum(*range(1000))
+        mixed = Enum("a", [1, 2], {"b": 1})
+        grown = Enum("a").added("b")
+        shrunk = Enum("a", "b", "c").removed("c")
+
+    et = EnumTest()
+    et.large = 999
+    assert et.large == 999
+    et.large = 5.0
+    assert et.large == 5.0
+    for value in (1000, "1", [1]):
+        with pytest.raises(ValueError):
+            et.large = value
+
+    et.mixed = [1, 2]
+    assert et.mixed == [1, 2]
+    et.mixed = {"b": 1}
+    assert et.mixed == {"b": 1}
+    for value in ([1], "b", {"b": 2}):
+        with pytest.raises(ValueError):
+            et.mixed = value
+
+    et.grown = "b"
+    assert et.grown == "b"
+    et.shrunk = "b"
+    with pytest.raises(ValueError):
+        et.shrunk = "c"
@@ -22,6 +22,9 @@ Methods:
     - del_slot
     - clone (Member, Delegator, Instance, List, Subclass, Typed)
     - tag
+    - try_set
+    - try_set_many
+    - validation_error
     # Tested in test_observe.py
     - has_observers
     - has_observer
@@ -39,10 +42,13 @@ Methods:
 
 """
 
+import threading
+
 import pytest
 
 from atom.api import (
     Atom,
+    Coerced,
     DefaultValue,
     Dict,
     Event,
@@ -52,6 +58,7 @@ from atom.api import (
     ForwardTyped,
     GetAttr,
     GetState,
+    Instance,
     Int,
     List,
     PostGetAttr,
@@ -387,3 +394,176 @@ def test_cloned_forward_validator(ForwardedMember, optional):
 
     Item().view  # Test validate
     assert Item.view.optional == optional
+
+
+def test_try_set():
+    """Test setting a value without raising on validation failures."""
+
+    class A(Atom):
+        i = Int()
+        l = List(Int())
+        inst = Instance((int, float))
+        e = Event(int)
+
+    notifications = []
+    a = A()
+    a.observe("i", notifications.append)
+
+    assert A.i.try_set(a, 1) is True
+    assert a.i == 1
+    assert len(notifications) == 1
+    assert A.i.try_set(a, "a") is False
+    assert a.i == 1
+    assert len(notifications) == 1
+
+    assert A.l.try_set(a, [1, 2]) is True
+    assert a.l == [1, 2]
+    assert A.l.try_set(a, [1, "a"]) is False
+    assert a.l == [1, 2]
+
+    assert A.inst.try_set(a, 1.0) is True
+    assert A.inst.try_set(a, "a") is False
+    assert a.inst == 1.0
+
+    # Members whose setattr mode is not slot go through their setattr handler.
+    events = []
+    a.observe("e", events.append)
+    assert A.e.try_set(a, 1) is True
+    assert A.e.try_set(a, "a") is False
+    assert len(events) == 1
+
+    # Errors unrelated to the validation are still raised.
+    def raise_error(change):
+        raise RuntimeError()
+
+    a.observe("i", raise_error)
+    with pytest.raises(RuntimeError):
+        A.i.try_set(a, 2)
+
+    with pytest.raises(TypeError):
+        A.i.try_set(1, 1)
+
+
+def test_try_set_reports_nested_failures():
+    """Test that validations nested in a quiet one report their failures."""
+
+    class B(Atom):
+        i = Int()
+
+    errors = []
+
+    def record(assign):
+        try:
+            assign()
+        except TypeError as e:
+            errors.append(str(e))
+
+    def coercer(value):
+        b = B()
+        record(lambda: setattr(b, "i", "a"))
+        record(lambda: setattr(a, "j", "a"))
+        thread = threading.Thread(target=record, args=(lambda: B(i="a"),))
+        thread.start()
+        thread.join()
+        return value
+
+    class A(Atom):
+        c = Coerced(int, coercer=coercer)
+        j = Int()
+
+    a = A()
+    assert A.c.try_set(a, "a") is False
+    assert len(errors) == 3
+    assert "'i' member on the 'B' object" in errors[0]
+    assert "'j' member on the 'A' object" in errors[1]
+    assert "'i' member on the 'B' object" in errors[2]
+
+
+def test_try_set_validation_scope():
+    """Test that only the failures of the validation itself are swallowed."""
+    from atom.api import Str
+
+    calls = []
+
+    def coercer(value):
+        calls.append(value)
+        if value == "bad":
+            raise TypeError("coercer failed")
+        return int(value)
+
+    class A(Atom):
+        c = Coerced(int, coercer=coercer)
+        v = Int()
+        l = List(Tuple(Int()))
+        d = Dict(Str(), Int())
+        t = FixedTuple(Int(), Str())
+        e = Event(Coerced(int, coercer=coercer))
+
+        def _post_validate_v(self, old, new):
+            if new < 0:
+                raise ValueError("negative")
+            return new
+
+    a = A()
+    assert A.c.try_set(a, "1") is True
+    assert calls == ["1"]
+    with pytest.raises(TypeError, match="coercer failed"):
+        A.c.try_set(a, "bad")
+    with pytest.raises(ValueError, match="negative"):
+        A.v.try_set(a, -1)
+    assert A.v.try_set(a, "a") is False
+
+    # Failures of the items validators are quiet as well
+    assert A.l.try_set(a, [(1,), (2, "a")]) is False
+    assert A.d.try_set(a, {"a": "b"}) is False
+    assert A.d.try_set(a, {1: 1}) is False
+    assert A.t.try_set(a, (1, 1)) is False
+    assert A.t.try_set(a, (1,)) is False
+    assert A.t.try_set(a, (1, "a")) is True
+
+    # Members whose setattr mode is not slot validate the value once
+    del calls[:]
+    assert A.e.try_set(a, "2") is True
+    assert calls == ["2"]
+
+    # A failed assignment made by an observer is reported in full
+    def observer(change):
+        a.v = "a"
+
+    a.observe("c", observer)
+    with pytest.raises(TypeError, match="'v' member on the 'A' object"):
+        A.c.try_set(a, 3)
+
+
+def test_try_set_many():
+    """Test setting values on many atoms without raising."""
+
+    class A(Atom):
+        i = Int()
+
+    atoms = [A() for _ in range(4)]
+    assert A.i.try_set_many(atoms, [1, "a", 3, None]) == [1, 3]
+    assert [a.i for a in atoms] == [1, 0, 3, 0]
+
+    with pytest.raises(ValueError):
+        A.i.try_set_many(atoms, [1])
+    with pytest.raises(TypeError):
+        A.i.try_set_many([1], [1])
+
+
+def test_validation_error():
+    """Test retrieving the error of a failed validation on request."""
+
+    class A(Atom):
+        i = Int()
+        inst = Instance((int, float))
+
+    a = A()
+    assert A.i.validation_error(a, 1) is None
+    err = A.i.validation_error(a, "a")
+    assert isinstance(err, TypeError)
+    assert "'i' member on the 'A' object" in str(err)
+    # The message is formatted even after a quiet failure.
+    assert A.inst.try_set(a, "a") is False
+    err = A.inst.validation_error(a, "a")
+    assert "(int, float)" in str(err)
@@ -11,6 +11,7 @@ import pytest
 
 from atom.api import (
     Atom,
+    ChangeDetection,
     ChangeType,
     ContainerList,
     Event,
@@ -878,3 +879,80 @@ def test_observe_decorator_change_type():
     w.items = [2]  # Update
     assert len(changes) == 1
     assert changes[0]["type"] == "update"
+
+
+@pytest.mark.parametrize(
+    "mode, context, notified",
+    [
+        (ChangeDetection.Equality, None, [False, True, True]),
+        (ChangeDetection.Identity, None, [True, True, True]),
+        (
+            ChangeDetection.Comparator,
+            lambda old, new: len(old) == len(new),
+            [False, False, True],
+        ),
+    ],
+)
+def test_change_detection_mode(mode, context, notified):
+    """Test the policies deciding whether an update is notified."""
+
+    class Widget(Atom):
+        value = Value()
+
+    Widget.value.set_change_detection_mode(mode, context)
+    assert Widget.value.change_detection_mode == (mode, context)
+
+    changes = []
+    w = Widget(value=[1])
+    w.observe("value", changes.append)
+    for value, expected in zip(([1], [2], [2, 3]), notified):
+        w.value = value
+        assert bool(changes) is expected
+        changes.clear()
+
+    with pytest.raises(TypeError):
+        Widget.value.set_change_detection_mode(ChangeDetection.Comparator, 1)
+
+
+def test_change_detection_comparator_error():
+    """Test that errors raised by a comparator are propagated."""
+
+    class Widget(Atom):
+        value = Value()
+
+    def compare(old, new):
+        raise ValueError()
+
+    Widget.value.set_change_detection_mode(ChangeDetection.Comparator, compare)
+    w = Widget(value=1)
+    w.observe("value", lambda change: None)
+    with pytest.raises(ValueError):
+        w.value = 2
+
+
+def test_change_detection_container_copies():
+    """Test that equality detection compares the items of container copies."""
+
+    class Widget(Atom):
+        items = List(Int())
+
+    changes = []
+    w = Widget(items=[1, 2])
+    w.observe("items", changes.append)
+    w.items = w.items
+    assert not changes
+    w.items = Widget(items=w.items).items
+    assert not changes
+
+    w.items.append(3)
+    w.items = [1, 2, 3]
+    assert not changes
+    w.items = [1, 2]
+    assert changes
+
+    # Modifications made through the base class are detected as well.
+    copy = Widget(items=w.items).items
+    changes.clear()
+    list.__init__(w.items, [4])
+    w.items = copy
+    assert changes
@@ -11,6 +11,7 @@ import pytest
 
 from atom.api import (
     Atom,
+    ChangeDetection,
     GetAttr,
     Int,
     Property,
@@ -143,6 +144,27 @@ def test_cached_property():
     assert pt.prop == 2
 
 
+def test_cached_property_change_detection():
+    """Test the change detection used when resetting a cached property."""
+
+    class PropertyTest(Atom):
+        @cached_property
+        def prop(self):
+            return [1]
+
+    changes = []
+    pt = PropertyTest()
+    pt.observe("prop", changes.append)
+    pt.prop
+    PropertyTest.prop.reset(pt)
+    assert not changes
+
+    PropertyTest.prop.set_change_detection_mode(ChangeDetection.Identity, None)
+    pt.prop
+    PropertyTest.prop.reset(pt)
+    assert len(changes) == 1
+
+
 def test_enforce_read_only_cached_property():
     """Check a cached property has to be read-only."""
 
@@ -45,6 +45,13 @@ from typing import List as TList, Optional, Sequence, Set as TSet, Union
 
 import pytest
 
+try:
+    import pytest_benchmark  # noqa: F401
+
+    BENCHMARK_INSTALLED = True
+except ImportError:
+    BENCHMARK_INSTALLED = False
+
 from atom.api import (
     Atom,
     Bool,
@@ -459,3 +466,187 @@ def test_validate_range_error():
         o.x = CustomInt(-1)
     with pytest.raises(TypeError):
         o.y = CustomInt(11)
+
+
+def test_cached_type_checks():
+    """Test that the cached results of type checks are invalidated properly."""
+    from abc import ABC
+
+    class Base:
+        pass
+
+    class Other:
+        pass
+
+    class Derived(Base):
+        pass
+
+    class Abstract(ABC):
+        pass
+
+    class Spoofing:
+        def __init__(self, cls):
+            self.cls = cls
+
+        @property
+        def __class__(self):
+            return self.cls
+
+    class Obj(Atom):
+        i = Instance(Base)
+        a = Instance(Abstract)
+        s = Subclass(Base)
+        c = Coerced(Base, coercer=lambda v: Base())
+
+    o = Obj()
+    for _ in range(2):
+        o.i = Derived()
+        o.s = Derived
+        o.c = Derived()
+    assert type(o.c) is Derived
+
+    Derived.__bases__ = (Other,)
+    o.s = Base
+    for _ in range(2):
+        with pytest.raises(TypeError):
+            o.i = Derived()
+        with pytest.raises(TypeError):
+            o.s = Derived
+    o.c = d = Derived()
+    assert type(o.c) is Base and o.c is not d
+
+    Abstract.register(Other)
+    for _ in range(2):
+        o.a = Other()
+
+    o.i = Spoofing(Base)
+    with pytest.raises(TypeError):
+        o.i = Spoofing(object)
+
+
+def test_validate_range_native_bounds():
+    """Test Range validation with values and bounds beyond 64 bits."""
+    big = 2**64
+
+    class Obj(Atom):
+        small = Range(-10, 10)
+        large = Range(-big, big)
+        mixed = Range(0, big)
+        low = Range(low=-(2**63))
+
+    o = Obj()
+    for value in (-10, 10, True):
+        o.small = value
+        assert o.small == value
+    for value in (-11, 11, big, -big):
+        with pytest.raises(ValueError):
+            o.small = value
+    o.large = big
+    o.large = -big
+    with pytest.raises(ValueError):
+        o.large = big + 1
+    o.mixed = big
+    with pytest.raises(ValueError):
+        o.mixed = -1
+    o.low = -(2**63)
+    with pytest.raises(ValueError):
+        o.low = -(2**63) - 1
+
+
+def test_tuple_validation_copy():
+    """Test that tuples are only copied when an item is altered by validation."""
+
+    class TupleSubclass(tuple):
+        pass
+
+    class Obj(Atom):
+        t = Tuple(Float())
+        ft = FixedTuple(Int(), Float())
+
+    o = Obj()
+    t = (1.0, 2.0, 3.0)
+    o.t = t
+    assert o.t is t
+    o.t = t = (1.0, 2, 3.0)
+    assert o.t is not t
+    assert o.t == (1.0, 2.0, 3.0)
+    assert [type(v) for v in o.t] == [float, float, float]
+    o.t = t = TupleSubclass((1.0,))
+    assert type(o.t) is tuple
+
+    ft = (1, 2.0)
+    o.ft = ft
+    assert o.ft is ft
+    o.ft = ft = (1, 2)
+    assert o.ft is not ft
+    assert o.ft == (1, 2.0)
+    assert type(o.ft[1]) is float
+
+
+@pytest.mark.skipif(not BENCHMARK_INSTALLED, reason="benchmark is not installed")
+@pytest.mark.benchmark(group="tuple-validation")
+@pytest.mark.parametrize("size", (3, 16, 1024))
+def test_bench_tuple_validation(benchmark, size):
+    class Obj(Atom):
+        t = Tuple(Int())
+
+    o = Obj()
+    values = (tuple(range(size)), tuple(range(1, size + 1)))
+
+    def task():
+        o.t = values[0]
+        o.t = values[1]
+
+    benchmark(task)
+
+
+def test_coerced_cache():
+    """Test the bounded cache of coerced values."""
+    calls = []
+
+    def coercer(value):
+        calls.append(value)
+        return str(value)
+
+    class Obj(Atom):
+        c = Coerced(str, coercer=coercer, cache_size=2)
+        n = Coerced(str, coercer=coercer)
+
+    o = Obj()
+    o.c = 1
+    o.c = 2
+    o.c = 1
+    assert calls == [1, 2]
+    assert Obj.c.cache_info() == (1, 2, 2, 2)
+
+    # Equal values of different types are cached separately
+    o.c = 1.0
+    assert o.c == "1.0"
+    assert calls == [1, 2, 1.0]
+
+    # The least recently used value (2) was evicted
+    o.c = 1
+    o.c = 2
+    assert calls == [1, 2, 1.0, 2]
+    assert Obj.c.cache_info() == (2, 4, 2, 2)
+
+    # Unhashable values are coerced but not cached
+    o.c = [1]
+    o.c = [1]
+    assert calls[-2:] == [[1], [1]]
+    assert Obj.c.cache_info() == (2, 4, 2, 2)
+
+    Obj.c.cache_clear()
+    assert Obj.c.cache_info() == (0, 0, 2, 0)
+    assert Obj.c.clone().cache_info() == (0, 0, 2, 0)
+
+    o.n = 1
+    o.n = 2
+    o.n = 1
+    assert calls[-3:] == [1, 2, 1]
+    assert Obj.n.cache_info() == (0, 0, 0, 0)
+
+    with pytest.raises(ValueError):
+        Coerced(str, coercer=str, cache_size=-1)
+    with pytest.raises(TypeError):
+        Obj.c.set_validate_mode(Validate.Coerced, (str, str, "1"))